@@ -104,6 +104,7 @@
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 1
 #define configUSE_TASK_NOTIFICATIONS            1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   2
 #define configUSE_MUTEXES                       1
 #define configUSE_RECURSIVE_MUTEXES             1
 #define configUSE_COUNTING_SEMAPHORES           1
@@ -126,8 +127,14 @@
 #define configUSE_MALLOC_FAILED_HOOK            1
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
-/* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+/* Run time and task stats gathering related definitions. The run time clock
+ * in microseconds is provided by task_monitor.c.
+ */
+#define configGENERATE_RUN_TIME_STATS           1
+extern void task_monitor_start_run_time_clock( void );
+extern uint32_t task_monitor_run_time_clock( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    task_monitor_start_run_time_clock()
+#define portGET_RUN_TIME_COUNTER_VALUE()            task_monitor_run_time_clock()
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
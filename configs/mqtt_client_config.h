@@ -59,6 +59,25 @@
  */
 #define MQTT_SECURE_CONNECTION            ( 0 )
 
+/* Set this macro to 1 to cache the TLS session of the last successful
+ * handshake of each MQTT connection and offer it on the next connection to
+ * the same broker, else 0. A resumed TLS 1.2 handshake (session ID or
+ * ticket) skips the certificate verification and the key exchange of a full
+ * handshake. Sessions larger than 'TLS_SESSION_CACHE_MAX_SIZE' bytes are not
+ * cached. A session that the broker refuses is replaced by the one of the
+ * full handshake; a session whose handshake fails is dropped, so that the
+ * next attempt is a full handshake.
+ *
+ * Note: The cache is driven by wrapping mbedtls_ssl_handshake(), which the
+ * secure-sockets library calls for the MQTT library; the Makefile wraps it
+ * for the GCC_ARM toolchain only. Applicable only when MQTT_SECURE_CONNECTION
+ * is 1.
+ */
+#define ENABLE_TLS_SESSION_CACHE          ( 1 )
+#if ENABLE_TLS_SESSION_CACHE
+    #define TLS_SESSION_CACHE_MAX_SIZE    ( 2048 )
+#endif
+
 /* Configure the user credentials to be sent as part of MQTT CONNECT packet */
 #define MQTT_USERNAME                     ""
 #define MQTT_PASSWORD                     ""
@@ -95,6 +114,138 @@
 #define MQTT_DEVICE_ON_MESSAGE            "TURN ON"
 #define MQTT_DEVICE_OFF_MESSAGE           "TURN OFF"
 
+/* Commands accepted on MQTT_SUB_TOPIC, one X(message, device state) entry per
+ * command; the message must be a string literal and the device state an
+ * 8-bit value for the subscriber task. The table is expanded into a perfect
+ * hash at startup, so a received message is resolved with one hash and one
+ * compare however many commands are listed here (up to 255).
+ */
+#define MQTT_DEVICE_COMMANDS(X)                                  \
+    X(MQTT_DEVICE_ON_MESSAGE,  DEVICE_ON_STATE)                  \
+    X(MQTT_DEVICE_OFF_MESSAGE, DEVICE_OFF_STATE)
+
+/* Set this macro to 1 to publish the device state as a CBOR message (see
+ * device_state.h) instead of MQTT_DEVICE_ON_MESSAGE/MQTT_DEVICE_OFF_MESSAGE,
+ * else 0. The subscriber accepts both forms whatever the setting.
+ */
+#define ENABLE_CBOR_DEVICE_STATE          ( 0 )
+
+/* Set this macro to 1 to enable the batched publish mode, else 0. In this mode
+ * the publisher task drains its queue and packs the messages to the same topic
+ * into one framed PUBLISH (see publish_batch.h for the format). A batch is sent
+ * when it holds 'PUBLISH_BATCH_MAX_RECORDS' messages, when the next message does
+ * not fit in 'PUBLISH_BATCH_MAX_BYTES', or 'PUBLISH_BATCH_LINGER_MS'
+ * milliseconds after its first message was dequeued. A batch holding a single
+ * message is sent as the plain message.
+ */
+#define ENABLE_PUBLISH_BATCHING           ( 0 )
+#if ENABLE_PUBLISH_BATCHING
+    #define PUBLISH_BATCH_MAX_RECORDS     ( 8 )
+    #define PUBLISH_BATCH_MAX_BYTES       ( 256 )
+    #define PUBLISH_BATCH_LINGER_MS       ( 20 )
+#endif
+
+/* Payloads queued with publisher_enqueue() are copied into statically
+ * allocated buffers of three size classes, which return to the pool once the
+ * publish completes. Configure the size (in bytes) and the number of buffers
+ * of each class. A request that finds its class empty is served by a larger
+ * class.
+ */
+#define PAYLOAD_POOL_SMALL_SIZE           ( 32 )
+#define PAYLOAD_POOL_SMALL_COUNT          ( 8 )
+#define PAYLOAD_POOL_MEDIUM_SIZE          ( 128 )
+#define PAYLOAD_POOL_MEDIUM_COUNT         ( 4 )
+#define PAYLOAD_POOL_LARGE_SIZE           ( 512 )
+#define PAYLOAD_POOL_LARGE_COUNT          ( 2 )
+
+/* Set this macro to 1 to compress the payloads published on the topics of
+ * 'PAYLOAD_COMPRESSION_TOPICS', one X(topic) entry per topic, else 0. A
+ * payload is compressed with a small LZ77 compressor (see payload_compress.h)
+ * and sent behind a one-byte header if that makes it shorter, else as is. The
+ * compressed form of a payload of up to 'PAYLOAD_COMPRESSION_MAX_SIZE' bytes
+ * is built in a static buffer; larger payloads are sent as is. The subscriber
+ * restores compressed payloads of up to 'PAYLOAD_COMPRESSION_MAX_SIZE' bytes
+ * received on the same topics; payloads of other topics are handed on as is.
+ */
+#define ENABLE_PAYLOAD_COMPRESSION        ( 0 )
+#if ENABLE_PAYLOAD_COMPRESSION
+    #define PAYLOAD_COMPRESSION_TOPICS(X) X(MQTT_PUB_TOPIC)
+#endif
+#define PAYLOAD_COMPRESSION_MAX_SIZE      ( PAYLOAD_POOL_LARGE_SIZE )
+
+/* Set this macro to 1 to keep the messages published while the MQTT
+ * connection is down in a store-and-forward outbox, else 0. The outbox holds
+ * up to 'PUBLISH_OUTBOX_LENGTH' messages of up to 'PUBLISH_OUTBOX_SLOT_SIZE'
+ * bytes in order; when it is full the oldest message is dropped. After the
+ * reconnection, the messages are flushed one every
+ * 'PUBLISH_OUTBOX_FLUSH_INTERVAL_MS' milliseconds ahead of new messages. With
+ * the outbox disabled, the user button is disabled while disconnected.
+ */
+#define ENABLE_PUBLISH_OUTBOX             ( 1 )
+#if ENABLE_PUBLISH_OUTBOX
+    #define PUBLISH_OUTBOX_LENGTH         ( 16 )
+    #define PUBLISH_OUTBOX_SLOT_SIZE      ( 128 )
+    #define PUBLISH_OUTBOX_FLUSH_INTERVAL_MS ( 50 )
+#endif
+
+/* Set this macro to 1 to keep the outbox in the external QSPI NOR flash
+ * instead of RAM, so that undelivered messages survive a reset or a power
+ * loss, else 0. The messages are appended to a log in the last
+ * 'PERSISTENT_OUTBOX_SIZE' bytes of the flash; when the log is full, its
+ * oldest sector is erased and reused. A message of up to
+ * 'PERSISTENT_OUTBOX_RECORD_SIZE' bytes (topic and payload) is accepted. The
+ * drained position is recorded every 'PERSISTENT_OUTBOX_ACK_INTERVAL'
+ * messages, which is the most a reset publishes again. Available on the kits
+ * that carry the Wi-Fi firmware in the QSPI flash; if the log cannot be
+ * mounted, the RAM outbox is used. The log leaves the XIP mode while it
+ * accesses the flash, so it takes the XIP lock of flash_log_qspi.h, which
+ * cy_wcm_init() holds while it reads the Wi-Fi firmware. Any other code
+ * placed in the external flash must take the lock as well.
+ */
+#if defined(CY_DEVICE_PSOC6A512K)
+#define ENABLE_PERSISTENT_OUTBOX          ( ENABLE_PUBLISH_OUTBOX )
+#else
+#define ENABLE_PERSISTENT_OUTBOX          ( 0 )
+#endif
+#if ENABLE_PERSISTENT_OUTBOX
+    #define PERSISTENT_OUTBOX_SIZE        ( 1024 * 1024 )
+    #define PERSISTENT_OUTBOX_RECORD_SIZE ( 256 )
+    #define PERSISTENT_OUTBOX_ACK_INTERVAL ( 8 )
+#endif
+
+/* Set this macro to 1 to limit the publish rate with token buckets, else 0.
+ * A message needs a token from the global bucket, refilled at
+ * 'PUBLISH_RATE_LIMIT_PER_SEC' messages per second up to
+ * 'PUBLISH_RATE_LIMIT_BURST', and one from the bucket of its topic, refilled
+ * at 'PUBLISH_TOPIC_RATE_LIMIT_PER_SEC' up to 'PUBLISH_TOPIC_RATE_LIMIT_BURST'
+ * (a rate of 0 is unlimited). Buckets are kept for up to
+ * 'PUBLISH_RATE_LIMIT_MAX_TOPICS' topics. The publisher task waits for the
+ * tokens, so bursts are smoothed on the device and the producers see the
+ * queue fill up instead of the broker seeing the burst.
+ */
+#define ENABLE_PUBLISH_RATE_LIMIT         ( 1 )
+#if ENABLE_PUBLISH_RATE_LIMIT
+    #define PUBLISH_RATE_LIMIT_PER_SEC    ( 100 )
+    #define PUBLISH_RATE_LIMIT_BURST      ( 20 )
+    #define PUBLISH_TOPIC_RATE_LIMIT_PER_SEC ( 100 )
+    #define PUBLISH_TOPIC_RATE_LIMIT_BURST ( 10 )
+    #define PUBLISH_RATE_LIMIT_MAX_TOPICS ( 4 )
+#endif
+
+/* Device state updates received by the MQTT subscription callback are handed
+ * to the subscriber task through a lock-free ring of
+ * 'SUBSCRIBER_INGEST_RING_LENGTH' entries (a power of two), so that the MQTT
+ * receive context never blocks. When the ring is full, the overflow policy
+ * decides which update is lost:
+ *   SPSC_RING_DROP_NEWEST      - the new update
+ *   SPSC_RING_DROP_OLDEST      - the oldest queued update
+ *   SPSC_RING_OVERWRITE_LATEST - the new update replaces the previous
+ *                                overflowing one, so the latest state is
+ *                                always applied
+ */
+#define SUBSCRIBER_INGEST_RING_LENGTH     ( 8 )
+#define SUBSCRIBER_INGEST_OVERFLOW_POLICY ( SPSC_RING_OVERWRITE_LATEST )
+
 
 /******************* OTHER MQTT CLIENT CONFIGURATION MACROS *******************/
 /* A unique client identifier to be used for every MQTT connection. */
@@ -114,6 +265,23 @@
  */
 #define GENERATE_UNIQUE_CLIENT_ID         ( 1 )
 
+/* Set this macro to 1 to connect with a persistent session (clean session
+ * flag cleared), else 0. The broker then keeps the subscriptions and queues
+ * the QoS 1 and QoS 2 messages for this client while it is offline, and the
+ * reconnection skips the subscribe round trips. A persistent session is bound
+ * to the client identifier, so with 'GENERATE_UNIQUE_CLIENT_ID' set to 1 the
+ * suffix is derived from the MAC address instead of a timestamp, which keeps
+ * it stable across reconnections and resets.
+ *
+ * Note: The MQTT library does not report the session present flag of the
+ * CONNACK; it is read by taking over MQTT_Connect() of coreMQTT with the GNU
+ * linker option --wrap, which the Makefile adds for the GCC_ARM toolchain
+ * only. The subscriptions are sent again unless the flag was set and they
+ * were acknowledged earlier in this power cycle, and always with the other
+ * toolchains.
+ */
+#define ENABLE_PERSISTENT_SESSION         ( 0 )
+
 /* The longest client identifier that an MQTT server must accept (as defined
  * by the MQTT 3.1.1 spec) is 23 characters. However some MQTT brokers support
  * longer client IDs. Configure this macro as per the MQTT broker specification.
@@ -156,11 +324,193 @@
  */
 #define MQTT_NETWORK_BUFFER_SIZE          ( 2 * CY_MQTT_MIN_NETWORK_BUFFER_SIZE )
 
+/* Size the network buffer from the largest MQTT packet sent or received,
+ * instead of 'MQTT_NETWORK_BUFFER_SIZE'. The largest packet is kept in
+ * internal flash on PSoC 6 devices and applies from the next start; until a
+ * profile has been saved, 'MQTT_NETWORK_BUFFER_SIZE' is allocated. The size is
+ * chosen at run time, so this macro must be 0 with ENABLE_STATIC_ALLOCATION.
+ */
+#define ENABLE_NETWORK_BUFFER_TUNING      ( 1 )
+
+#if ENABLE_NETWORK_BUFFER_TUNING
+/* Bounds of the network buffer size in bytes. */
+#define NETWORK_BUFFER_TUNING_MIN_SIZE    ( CY_MQTT_MIN_NETWORK_BUFFER_SIZE )
+#define NETWORK_BUFFER_TUNING_MAX_SIZE    ( 8 * CY_MQTT_MIN_NETWORK_BUFFER_SIZE )
+
+/* Headroom added to the largest packet, in percent. */
+#define NETWORK_BUFFER_TUNING_MARGIN_PERCENT ( 25 )
+#endif /* ENABLE_NETWORK_BUFFER_TUNING */
+
 /* Maximum MQTT connection re-connection limit. */
 #define MAX_MQTT_CONN_RETRIES            (150u)
 
-/* MQTT re-connection time interval in milliseconds. */
+/* MQTT re-connection time intervals in milliseconds. The retries back off
+ * exponentially with full jitter: the first retry waits a random time of up
+ * to 'MQTT_CONN_RETRY_FIRST_INTERVAL_MS', retry n (n >= 1) up to
+ * 'MQTT_CONN_RETRY_INTERVAL_MS' * 2^(n-1), capped at
+ * 'MQTT_CONN_RETRY_MAX_INTERVAL_MS'. The jitter spreads out the reconnections
+ * of devices that lose the broker at the same time.
+ */
+#define MQTT_CONN_RETRY_FIRST_INTERVAL_MS (250)
 #define MQTT_CONN_RETRY_INTERVAL_MS      (2000)
+#define MQTT_CONN_RETRY_MAX_INTERVAL_MS  (30000)
+
+/* Set this macro to 1 to connect the control connection to the fastest of
+ * the brokers in 'BROKER_FAILOVER_LIST', one X(hostname, port) entry per
+ * broker, else 0 to use 'MQTT_BROKER_ADDRESS' only. The brokers are ranked by
+ * the round trip time of a TCP connection to them, smoothed over the probes;
+ * unreachable brokers are ranked last. They are probed before every
+ * (re)connection and every 'BROKER_FAILOVER_RANK_INTERVAL_MS' milliseconds
+ * in the background; each probe gives up after
+ * 'BROKER_FAILOVER_PROBE_TIMEOUT_MS' milliseconds, and a ranking starts no
+ * new probe after 'BROKER_FAILOVER_RANK_BUDGET_MS' milliseconds, which bounds
+ * the time the MQTT client task spends ranking before it connects. The
+ * brokers are probed fastest first, so the budget is spent on the brokers
+ * most likely to be used. A connection starts at the
+ * fastest broker and moves down the list after
+ * 'BROKER_FAILOVER_ATTEMPTS_PER_BROKER' failed attempts on one broker; a
+ * running connection is not moved by the background ranking.
+ *
+ * Note: With MQTT_SECURE_CONNECTION, every broker must accept the same
+ * credentials, and 'MQTT_SNI_HOSTNAME' is sent to all of them.
+ */
+#define ENABLE_BROKER_FAILOVER            ( 0 )
+#if ENABLE_BROKER_FAILOVER
+    #define BROKER_FAILOVER_LIST(X)                                      \
+        X(MQTT_BROKER_ADDRESS, MQTT_PORT)                                \
+        X("broker.hivemq.com", 1883)                                     \
+        X("broker.emqx.io",    1883)
+    #define BROKER_FAILOVER_PROBE_TIMEOUT_MS    ( 2000 )
+    #define BROKER_FAILOVER_RANK_BUDGET_MS      ( 3000 )
+    #define BROKER_FAILOVER_RANK_INTERVAL_MS    ( 300000 )
+    #define BROKER_FAILOVER_ATTEMPTS_PER_BROKER ( 3u )
+#endif
+
+/* Set this macro to 1 to cache the IPv4 addresses of the broker host names,
+ * else 0. A reconnection then finds the address in the cache instead of
+ * waiting for a DNS round trip. Up to 'DNS_CACHE_SIZE' names of up to
+ * 'DNS_CACHE_HOSTNAME_MAX_LEN' characters are kept. An address is fresh for
+ * 'DNS_CACHE_TTL_S' seconds and refreshed in the background once half of
+ * that time has passed. When the resolver fails, the last address is served
+ * for up to 'DNS_CACHE_STALE_S' seconds past its expiry.
+ *
+ * Note: The resolver API does not report the TTL of the DNS records, so
+ * 'DNS_CACHE_TTL_S' applies to all of them; keep it at or below the TTL of
+ * the records of the brokers. The MQTT library resolves the names through
+ * the cache with the GCC_ARM toolchain only, as the cache takes over
+ * cy_socket_gethostbyname() using the GNU linker option --wrap (see the
+ * Makefile).
+ */
+#define ENABLE_DNS_CACHE                  ( 1 )
+#if ENABLE_DNS_CACHE
+    #define DNS_CACHE_SIZE                ( 4 )
+    #define DNS_CACHE_HOSTNAME_MAX_LEN    ( 64 )
+    #define DNS_CACHE_TTL_S               ( 300 )
+    #define DNS_CACHE_STALE_S             ( 86400 )
+#endif
+
+/* Set this macro to 1 to open a second MQTT connection for telemetry, else 0.
+ * The task monitor snapshots are then published on it with QoS
+ * 'MQTT_TELEMETRY_QOS' instead of through the publisher task, so that a
+ * telemetry backlog never delays the messages of the control connection
+ * used by the publisher and subscriber tasks. The connections share the
+ * Wi-Fi link and the security credentials; each one has its own broker,
+ * network buffer, client identifier ('MQTT_TELEMETRY_CLIENT_ID_SUFFIX' is
+ * inserted after 'MQTT_CLIENT_IDENTIFIER') and reconnection state. A
+ * telemetry connection that is not restored within
+ * 'MQTT_TELEMETRY_CONN_RETRIES' attempts is retried later without stopping
+ * the example. The RAM taken by each connection is printed once the
+ * publisher task is created.
+ *
+ * Note: The MQTT library serves up to 'CY_MQTT_MAX_HANDLE' connections.
+ */
+#define ENABLE_TELEMETRY_CONNECTION       ( 0 )
+#if ENABLE_TELEMETRY_CONNECTION
+    #define MQTT_TELEMETRY_BROKER_ADDRESS MQTT_BROKER_ADDRESS
+    #define MQTT_TELEMETRY_PORT           MQTT_PORT
+    #define MQTT_TELEMETRY_CLIENT_ID_SUFFIX "-t"
+    #define MQTT_TELEMETRY_QOS            ( 0 )
+    #define MQTT_TELEMETRY_CONN_RETRIES   ( 3u )
+    #define MQTT_TELEMETRY_NETWORK_BUFFER_SIZE ( CY_MQTT_MIN_NETWORK_BUFFER_SIZE )
+#endif
+
+
+/*********************** MEMORY CONFIGURATION MACROS **************************/
+/* Set this macro to 1 to create the tasks, queues and timers of this example
+ * with the static FreeRTOS APIs (xTaskCreateStatic(), xQueueCreateStatic(),
+ * xTimerCreateStatic()) and to place the MQTT network buffer in a static
+ * array, else 0. Their RAM is then reserved at link time instead of being
+ * taken from the heap; the bytes kept out of the heap and the startup time
+ * are printed once the publisher task is created. Requires
+ * configSUPPORT_STATIC_ALLOCATION in FreeRTOSConfig.h.
+ */
+#define ENABLE_STATIC_ALLOCATION          ( 0 )
+
+
+/*********************** LOGGING CONFIGURATION MACROS *************************/
+/* Set this macro to 1 to defer the log output, else 0 to print every log line
+ * synchronously on the debug UART. When deferred, a log call formats its line
+ * into a ring of 'APP_LOG_LINE_COUNT' lines of up to 'APP_LOG_LINE_SIZE'
+ * bytes and returns; a drain task of the lowest priority prints the lines.
+ * Lines written while the ring is full are dropped and counted, longer lines
+ * are truncated. 'APP_LOG_LINE_COUNT' must be a power of two.
+ */
+#define ENABLE_DEFERRED_LOGGING           ( 1 )
+#if ENABLE_DEFERRED_LOGGING
+    #define APP_LOG_LINE_COUNT            ( 32 )
+    #define APP_LOG_LINE_SIZE             ( 160 )
+    #define APP_LOG_DRAIN_INTERVAL_MS     ( 100 )
+#endif
+
+/* Log level of each module: APP_LOG_LEVEL_OFF, APP_LOG_LEVEL_ERR,
+ * APP_LOG_LEVEL_WARN, APP_LOG_LEVEL_INFO or APP_LOG_LEVEL_DEBUG. The log calls
+ * above the level of their module are removed at compile time.
+ */
+#define APP_LOG_LEVEL_MAIN                APP_LOG_LEVEL_INFO
+#define APP_LOG_LEVEL_MQTT_TASK           APP_LOG_LEVEL_INFO
+#define APP_LOG_LEVEL_PUBLISHER           APP_LOG_LEVEL_INFO
+#define APP_LOG_LEVEL_SUBSCRIBER          APP_LOG_LEVEL_INFO
+#define APP_LOG_LEVEL_HEAP_USAGE          APP_LOG_LEVEL_INFO
+#define APP_LOG_LEVEL_BUFFER_PROFILE      APP_LOG_LEVEL_INFO
+
+
+/********************* DIAGNOSTICS CONFIGURATION MACROS ***********************/
+/* Set this macro to 1 to time every publish from the button interrupt until
+ * cy_mqtt_publish() returns (i.e. until the PUBACK for QoS 1). The queueing,
+ * dispatch and network stages are collected in separate log2 histograms that
+ * are read using publish_latency_get_stats(), else 0.
+ */
+#define ENABLE_PUBLISH_LATENCY_STATS      ( 1 )
+
+/* Set this macro to 1 to run the task monitor, else 0. Every
+ * 'TASK_MONITOR_PERIOD_MS' milliseconds it samples all the RTOS tasks,
+ * including the ones of the MQTT library and the network stack, and
+ * publishes on 'TASK_MONITOR_TOPIC' a snapshot of the CPU usage of each task
+ * over the period and of its smallest stack headroom:
+ *
+ *   up=<s>;<task name>,<CPU %>,<free stack bytes>;...
+ *
+ * Up to 'TASK_MONITOR_MAX_TASKS' tasks are listed; the snapshot must fit in
+ * a payload pool buffer.
+ */
+#define ENABLE_TASK_MONITOR               ( 1 )
+#if ENABLE_TASK_MONITOR
+    #define TASK_MONITOR_PERIOD_MS        ( 30000 )
+    #define TASK_MONITOR_TOPIC            MQTT_PUB_TOPIC "/diagnostics"
+    #define TASK_MONITOR_MAX_TASKS        ( 16 )
+    #define TASK_MONITOR_SNAPSHOT_SIZE    ( PAYLOAD_POOL_LARGE_SIZE )
+#endif
+
+/* The heap usage is recorded into a ring buffer of 'HEAP_USAGE_RING_SIZE'
+ * samples every 'HEAP_USAGE_SAMPLE_INTERVAL_MS' milliseconds, off the message
+ * handling paths. The footprint is a high-water mark, while the peak in use
+ * is the largest sampled value; a shorter interval catches brief peaks. Set
+ * the interval to 0 to disable periodic sampling. The samples are printed using
+ * heap_usage_dump(); define PRINT_HEAP_USAGE to print them once the publisher
+ * and subscriber tasks are created.
+ */
+#define HEAP_USAGE_SAMPLE_INTERVAL_MS     ( 10000 )
+#define HEAP_USAGE_RING_SIZE              ( 16 )
 
 
 /**************** MQTT CLIENT CERTIFICATE CONFIGURATION MACROS ****************/
@@ -191,6 +541,10 @@
 extern cy_mqtt_broker_info_t broker_info;
 extern cy_awsport_ssl_credentials_t  *security_info;
 extern cy_mqtt_connect_info_t connection_info;
+#if ENABLE_TELEMETRY_CONNECTION
+extern cy_mqtt_broker_info_t telemetry_broker_info;
+extern cy_mqtt_connect_info_t telemetry_connection_info;
+#endif /* ENABLE_TELEMETRY_CONNECTION */
 
 
 #endif /* MQTT_CLIENT_CONFIG_H_ */
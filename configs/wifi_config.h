@@ -62,7 +62,14 @@
 /* Maximum Wi-Fi re-connection limit. */
 #define MAX_WIFI_CONN_RETRIES             (120u)
 
-/* Wi-Fi re-connection time interval in milliseconds. */
+/* Wi-Fi re-connection time intervals in milliseconds. The retries back off
+ * exponentially with full jitter: the first retry waits a random time of up
+ * to 'WIFI_CONN_RETRY_FIRST_INTERVAL_MS', retry n (n >= 1) up to
+ * 'WIFI_CONN_RETRY_INTERVAL_MS' * 2^(n-1), capped at
+ * 'WIFI_CONN_RETRY_MAX_INTERVAL_MS'.
+ */
+#define WIFI_CONN_RETRY_FIRST_INTERVAL_MS (500)
 #define WIFI_CONN_RETRY_INTERVAL_MS       (5000)
+#define WIFI_CONN_RETRY_MAX_INTERVAL_MS   (60000)
 
 #endif /* WIFI_CONFIG_H_ */
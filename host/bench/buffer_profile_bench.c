@@ -0,0 +1,252 @@
+/******************************************************************************
+* File Name:   buffer_profile_bench.c
+*
+* Description: Host test of the network buffer profile. Starts from an erased
+*              profile row, feeds the packets of a session, and resets: the
+*              first session must save its profile, and the next start must
+*              allocate the smaller buffer it calls for instead of the
+*              default one. A later, larger packet must grow the saved
+*              profile again. The flash row is emulated in RAM.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cyhal.h"
+#include "mqtt_client_config.h"
+#include "mqtt_task.h"
+#include "buffer_profile.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Packets of a typical session: CONNECT, a few PUBLISH in both directions. */
+#define CONNECT_PACKET_SIZE             (64u)
+#define SMALL_SESSION_MAX_PACKET        (300u)
+#define LARGE_SESSION_MAX_PACKET        (900u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Emulated flash row; an erased row reads as zeros. */
+static uint32_t flash_row[CY_FLASH_SIZEOF_ROW / sizeof(uint32_t)];
+static uint32_t flash_writes;
+
+/* Commands raised through mqtt_task_notify(). */
+static bool persist_requested;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool run_session(const char *name, uint32_t max_packet, uint32_t expected_buffer,
+                        bool expect_save);
+static uint32_t expected_buffer_size(uint32_t max_packet);
+
+/******************************************************************************
+ * Function Name: cyhal_flash_init / cyhal_flash_free / cyhal_flash_read /
+ *                cyhal_flash_write
+ ******************************************************************************
+ * Summary:
+ *  Flash driver of the HAL, emulated with a single row. The address is not
+ *  used, as the profile is the only user of the flash.
+ *
+ ******************************************************************************/
+cy_rslt_t cyhal_flash_init(cyhal_flash_t *obj)
+{
+    (void) obj;
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_flash_free(cyhal_flash_t *obj)
+{
+    (void) obj;
+}
+
+cy_rslt_t cyhal_flash_read(cyhal_flash_t *obj, uint32_t address, uint8_t *data, size_t size)
+{
+    (void) obj;
+    (void) address;
+    memcpy(data, flash_row, (size < sizeof(flash_row)) ? size : sizeof(flash_row));
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_flash_write(cyhal_flash_t *obj, uint32_t address, const uint32_t *data)
+{
+    (void) obj;
+    (void) address;
+    memcpy(flash_row, data, sizeof(flash_row));
+    flash_writes++;
+    return CY_RSLT_SUCCESS;
+}
+
+/******************************************************************************
+ * Function Name: mqtt_task_notify / app_log_write
+ ******************************************************************************
+ * Summary:
+ *  Stand-ins for the MQTT client task and the log drain task.
+ *
+ ******************************************************************************/
+void mqtt_task_notify(mqtt_task_cmd_t cmd)
+{
+    persist_requested |= (cmd == PERSIST_BUFFER_PROFILE);
+}
+
+void app_log_write(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    printf("[buffer-profile-bench] log: ");
+    vprintf(format, args);
+    va_end(args);
+}
+
+/******************************************************************************
+ * Function Name: expected_buffer_size
+ ******************************************************************************
+ * Summary:
+ *  Buffer size that a saved largest packet calls for, computed independently
+ *  of the module from the configured margin and bounds.
+ *
+ ******************************************************************************/
+static uint32_t expected_buffer_size(uint32_t max_packet)
+{
+    uint32_t size = max_packet + ((max_packet * NETWORK_BUFFER_TUNING_MARGIN_PERCENT) / 100u);
+
+    size = ((size + 63u) / 64u) * 64u;
+    if (size < NETWORK_BUFFER_TUNING_MIN_SIZE)
+    {
+        size = NETWORK_BUFFER_TUNING_MIN_SIZE;
+    }
+    if (size > NETWORK_BUFFER_TUNING_MAX_SIZE)
+    {
+        size = NETWORK_BUFFER_TUNING_MAX_SIZE;
+    }
+    return size;
+}
+
+/******************************************************************************
+ * Function Name: run_session
+ ******************************************************************************
+ * Summary:
+ *  Starts the device as after a reset, checks the buffer it allocates, feeds
+ *  a session whose largest packet is 'max_packet', and lets the MQTT client
+ *  task save the profile if asked to.
+ *
+ ******************************************************************************/
+static bool run_session(const char *name, uint32_t max_packet, uint32_t expected_buffer,
+                        bool expect_save)
+{
+    buffer_profile_stats_t stats;
+    uint32_t buffer_size;
+    uint32_t writes_before = flash_writes;
+    bool passed = true;
+
+    persist_requested = false;
+    buffer_profile_init();
+    buffer_size = buffer_profile_buffer_size();
+
+    buffer_profile_add(BUFFER_PROFILE_OUTGOING, CONNECT_PACKET_SIZE);
+    buffer_profile_add(BUFFER_PROFILE_INCOMING, max_packet / 2u);
+    buffer_profile_add(BUFFER_PROFILE_OUTGOING, max_packet);
+    buffer_profile_add(BUFFER_PROFILE_INCOMING, max_packet / 3u);
+
+    if (persist_requested)
+    {
+        buffer_profile_save();
+    }
+    buffer_profile_get_stats(&stats);
+
+    printf("[buffer-profile-bench] session=%s buffer=%u largest_packet=%u saved=%u "
+           "flash_writes=%u\n", name, (unsigned) buffer_size, (unsigned) max_packet,
+           (unsigned) stats.persisted_max, (unsigned) (flash_writes - writes_before));
+
+    if (buffer_size != expected_buffer)
+    {
+        printf("[buffer-profile-bench] %s: allocated %u bytes, expected %u\n",
+               name, (unsigned) buffer_size, (unsigned) expected_buffer);
+        passed = false;
+    }
+    if (persist_requested != expect_save)
+    {
+        printf("[buffer-profile-bench] %s: save %srequested\n",
+               name, persist_requested ? "" : "not ");
+        passed = false;
+    }
+    if ((flash_writes - writes_before) != (expect_save ? 1u : 0u))
+    {
+        printf("[buffer-profile-bench] %s: %u flash writes\n",
+               name, (unsigned) (flash_writes - writes_before));
+        passed = false;
+    }
+    return passed;
+}
+
+int main(void)
+{
+    bool passed = true;
+
+    /* A fresh device learns with the default buffer and saves its first
+     * profile.
+     */
+    passed &= run_session("fresh", SMALL_SESSION_MAX_PACKET, MQTT_NETWORK_BUFFER_SIZE, true);
+
+    /* The next start allocates the smaller buffer; nothing is written again. */
+    passed &= run_session("saved", SMALL_SESSION_MAX_PACKET,
+                          expected_buffer_size(SMALL_SESSION_MAX_PACKET), false);
+
+    /* A larger packet grows the profile, and the start after that uses it. */
+    passed &= run_session("grown", LARGE_SESSION_MAX_PACKET,
+                          expected_buffer_size(SMALL_SESSION_MAX_PACKET), true);
+    passed &= run_session("regrown", LARGE_SESSION_MAX_PACKET,
+                          expected_buffer_size(LARGE_SESSION_MAX_PACKET), false);
+
+    if (expected_buffer_size(SMALL_SESSION_MAX_PACKET) >= MQTT_NETWORK_BUFFER_SIZE)
+    {
+        printf("[buffer-profile-bench] the saved profile does not shrink the buffer\n");
+        passed = false;
+    }
+
+    printf("[buffer-profile-bench] %s\n", passed ? "passed" : "FAILED");
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,425 @@
+/******************************************************************************
+* File Name:   cbor_bench.c
+*
+* Description: Host microbenchmark of the CBOR codec. Times encoding and
+*              decoding the device state message and a telemetry message with
+*              the schema encoder of cbor.c against snprintf JSON encoding
+*              and a strstr/strtoul JSON parser, and reports the bytes on the
+*              wire of both. Every message is cross-checked through both
+*              round trips.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cbor.h"
+#include "device_state.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define MESSAGE_COUNT                   (256u)
+#define OPERATIONS_PER_RUN              (1000000u)
+#define ENCODED_SIZE                    (128u)
+#define FIRMWARE_SIZE                   (16u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Telemetry message of a sensor node, as a larger example than the device
+ * state. The floats are multiples of 1/4 so that the two-decimal JSON text
+ * holds them exactly.
+ */
+typedef struct
+{
+    float temperature;
+    float humidity;
+    uint32_t pressure_pa;
+    int8_t rssi_dbm;
+    bool charging;
+    char firmware[FIRMWARE_SIZE];
+} telemetry_t;
+
+static const cbor_schema_field_t telemetry_fields[] =
+{
+    CBOR_SCHEMA_FIELD(telemetry_t, 1u, temperature, CBOR_FIELD_FLOAT),
+    CBOR_SCHEMA_FIELD(telemetry_t, 2u, humidity,    CBOR_FIELD_FLOAT),
+    CBOR_SCHEMA_FIELD(telemetry_t, 3u, pressure_pa, CBOR_FIELD_UINT),
+    CBOR_SCHEMA_FIELD(telemetry_t, 4u, rssi_dbm,    CBOR_FIELD_INT),
+    CBOR_SCHEMA_FIELD(telemetry_t, 5u, charging,    CBOR_FIELD_BOOL),
+    CBOR_SCHEMA_FIELD(telemetry_t, 6u, firmware,    CBOR_FIELD_TEXT)
+};
+
+static const cbor_schema_t telemetry_schema =
+{
+    .fields = telemetry_fields,
+    .count = sizeof(telemetry_fields) / sizeof(telemetry_fields[0]),
+    .required = 0x3Fu
+};
+
+static device_state_t states[MESSAGE_COUNT];
+static telemetry_t telemetry[MESSAGE_COUNT];
+
+static uint8_t cbor_messages[MESSAGE_COUNT][ENCODED_SIZE];
+static size_t cbor_lens[MESSAGE_COUNT];
+static char json_messages[MESSAGE_COUNT][ENCODED_SIZE];
+static size_t json_lens[MESSAGE_COUNT];
+
+/* Sink for the results so that the loops are not optimized away. */
+static volatile unsigned long bench_sink;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static double now_ns(void);
+static void make_messages(void);
+static size_t json_encode_state(const device_state_t *message, char *buffer, size_t size);
+static bool json_decode_state(const char *text, device_state_t *message);
+static size_t json_encode_telemetry(const telemetry_t *message, char *buffer, size_t size);
+static bool json_decode_telemetry(const char *text, telemetry_t *message);
+static bool json_number(const char *text, const char *key, const char **value);
+static bool same_telemetry(const telemetry_t *a, const telemetry_t *b);
+
+/******************************************************************************
+ * Function Name: now_ns
+ ******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec * 1e9) + (double) ts.tv_nsec;
+}
+
+/******************************************************************************
+ * Function Name: make_messages
+ ******************************************************************************/
+static void make_messages(void)
+{
+    srand(1);
+
+    for (unsigned i = 0; i < MESSAGE_COUNT; i++)
+    {
+        states[i].state = (unsigned) rand() % 2u;
+        states[i].sequence = i * 37u;
+        states[i].uptime_ms = (uint32_t) rand();
+
+        telemetry[i].temperature = (float) ((rand() % 400) - 100) / 4.0f;
+        telemetry[i].humidity = (float) (rand() % 400) / 4.0f;
+        telemetry[i].pressure_pa = 95000u + ((unsigned) rand() % 10000u);
+        telemetry[i].rssi_dbm = (int8_t) -(rand() % 90);
+        telemetry[i].charging = ((rand() % 2) == 0);
+        snprintf(telemetry[i].firmware, FIRMWARE_SIZE, "v1.%u.%u", i % 7u, i);
+    }
+}
+
+/******************************************************************************
+ * Function Name: json_encode_state
+ ******************************************************************************/
+static size_t json_encode_state(const device_state_t *message, char *buffer, size_t size)
+{
+    return (size_t) snprintf(buffer, size, "{\"state\":%lu,\"sequence\":%lu,\"uptime_ms\":%lu}",
+                             (unsigned long) message->state, (unsigned long) message->sequence,
+                             (unsigned long) message->uptime_ms);
+}
+
+/******************************************************************************
+ * Function Name: json_number
+ ******************************************************************************
+ * Summary:
+ *  Finds the value of a key of a flat JSON object.
+ *
+ ******************************************************************************/
+static bool json_number(const char *text, const char *key, const char **value)
+{
+    const char *found = strstr(text, key);
+
+    if (found == NULL)
+    {
+        return false;
+    }
+    *value = found + strlen(key);
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: json_decode_state
+ ******************************************************************************/
+static bool json_decode_state(const char *text, device_state_t *message)
+{
+    const char *value;
+
+    if (!json_number(text, "\"state\":", &value))
+    {
+        return false;
+    }
+    message->state = (uint32_t) strtoul(value, NULL, 10);
+    if (json_number(text, "\"sequence\":", &value))
+    {
+        message->sequence = (uint32_t) strtoul(value, NULL, 10);
+    }
+    if (json_number(text, "\"uptime_ms\":", &value))
+    {
+        message->uptime_ms = (uint32_t) strtoul(value, NULL, 10);
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: json_encode_telemetry
+ ******************************************************************************/
+static size_t json_encode_telemetry(const telemetry_t *message, char *buffer, size_t size)
+{
+    return (size_t) snprintf(buffer, size,
+                             "{\"temperature\":%.2f,\"humidity\":%.2f,\"pressure_pa\":%lu,"
+                             "\"rssi_dbm\":%d,\"charging\":%s,\"firmware\":\"%s\"}",
+                             (double) message->temperature, (double) message->humidity,
+                             (unsigned long) message->pressure_pa, message->rssi_dbm,
+                             message->charging ? "true" : "false", message->firmware);
+}
+
+/******************************************************************************
+ * Function Name: json_decode_telemetry
+ ******************************************************************************/
+static bool json_decode_telemetry(const char *text, telemetry_t *message)
+{
+    const char *value;
+    const char *end;
+
+    if (!json_number(text, "\"temperature\":", &value))
+    {
+        return false;
+    }
+    message->temperature = strtof(value, NULL);
+    if (!json_number(text, "\"humidity\":", &value))
+    {
+        return false;
+    }
+    message->humidity = strtof(value, NULL);
+    if (!json_number(text, "\"pressure_pa\":", &value))
+    {
+        return false;
+    }
+    message->pressure_pa = (uint32_t) strtoul(value, NULL, 10);
+    if (!json_number(text, "\"rssi_dbm\":", &value))
+    {
+        return false;
+    }
+    message->rssi_dbm = (int8_t) strtol(value, NULL, 10);
+    if (!json_number(text, "\"charging\":", &value))
+    {
+        return false;
+    }
+    message->charging = (strncmp(value, "true", 4) == 0);
+    if (!json_number(text, "\"firmware\":\"", &value) ||
+        ((end = strchr(value, '"')) == NULL) || ((size_t) (end - value) >= FIRMWARE_SIZE))
+    {
+        return false;
+    }
+    memcpy(message->firmware, value, (size_t) (end - value));
+    message->firmware[end - value] = '\0';
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: same_telemetry
+ ******************************************************************************/
+static bool same_telemetry(const telemetry_t *a, const telemetry_t *b)
+{
+    return (a->temperature == b->temperature) && (a->humidity == b->humidity) &&
+           (a->pressure_pa == b->pressure_pa) && (a->rssi_dbm == b->rssi_dbm) &&
+           (a->charging == b->charging) && (strcmp(a->firmware, b->firmware) == 0);
+}
+
+int main(void)
+{
+    int status = EXIT_SUCCESS;
+    size_t cbor_bytes = 0u;
+    size_t json_bytes = 0u;
+    double start;
+    double cbor_encode_ns;
+    double cbor_decode_ns;
+    double json_encode_ns;
+    double json_decode_ns;
+
+    printf("[cbor-bench] operations=%u messages=%u\n", OPERATIONS_PER_RUN, MESSAGE_COUNT);
+
+    make_messages();
+
+    /* Device state: encode, decode, cross-check. */
+    for (unsigned i = 0; i < MESSAGE_COUNT; i++)
+    {
+        device_state_t from_cbor = { 0 };
+        device_state_t from_json = { 0 };
+        uint32_t fields = 0u;
+
+        cbor_lens[i] = device_state_encode(&states[i], DEVICE_STATE_FIELD_ALL,
+                                           cbor_messages[i], ENCODED_SIZE);
+        json_lens[i] = json_encode_state(&states[i], json_messages[i], ENCODED_SIZE);
+        cbor_bytes += cbor_lens[i];
+        json_bytes += json_lens[i];
+
+        if ((cbor_lens[i] == 0u) ||
+            !device_state_decode(cbor_messages[i], cbor_lens[i], &from_cbor, &fields) ||
+            (fields != DEVICE_STATE_FIELD_ALL) ||
+            !json_decode_state(json_messages[i], &from_json) ||
+            (memcmp(&from_cbor, &states[i], sizeof(from_cbor)) != 0) ||
+            (memcmp(&from_json, &states[i], sizeof(from_json)) != 0))
+        {
+            printf("[cbor-bench] device state %u does not round trip\n", i);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    start = now_ns();
+    for (unsigned i = 0; i < OPERATIONS_PER_RUN; i++)
+    {
+        unsigned m = i % MESSAGE_COUNT;
+        bench_sink += device_state_encode(&states[m], DEVICE_STATE_FIELD_ALL,
+                                          cbor_messages[m], ENCODED_SIZE);
+    }
+    cbor_encode_ns = (now_ns() - start) / OPERATIONS_PER_RUN;
+
+    start = now_ns();
+    for (unsigned i = 0; i < OPERATIONS_PER_RUN; i++)
+    {
+        unsigned m = i % MESSAGE_COUNT;
+        device_state_t message;
+        bench_sink += device_state_decode(cbor_messages[m], cbor_lens[m], &message, NULL);
+        bench_sink += message.sequence;
+    }
+    cbor_decode_ns = (now_ns() - start) / OPERATIONS_PER_RUN;
+
+    start = now_ns();
+    for (unsigned i = 0; i < OPERATIONS_PER_RUN; i++)
+    {
+        unsigned m = i % MESSAGE_COUNT;
+        bench_sink += json_encode_state(&states[m], json_messages[m], ENCODED_SIZE);
+    }
+    json_encode_ns = (now_ns() - start) / OPERATIONS_PER_RUN;
+
+    start = now_ns();
+    for (unsigned i = 0; i < OPERATIONS_PER_RUN; i++)
+    {
+        unsigned m = i % MESSAGE_COUNT;
+        device_state_t message;
+        bench_sink += json_decode_state(json_messages[m], &message);
+        bench_sink += message.sequence;
+    }
+    json_decode_ns = (now_ns() - start) / OPERATIONS_PER_RUN;
+
+    printf("[cbor-bench] message=device_state cbor_bytes=%.1f json_bytes=%.1f "
+           "cbor_encode_ns=%.1f json_encode_ns=%.1f cbor_decode_ns=%.1f json_decode_ns=%.1f\n",
+           (double) cbor_bytes / MESSAGE_COUNT, (double) json_bytes / MESSAGE_COUNT,
+           cbor_encode_ns, json_encode_ns, cbor_decode_ns, json_decode_ns);
+
+    /* Telemetry: encode, decode, cross-check. */
+    cbor_bytes = 0u;
+    json_bytes = 0u;
+    for (unsigned i = 0; i < MESSAGE_COUNT; i++)
+    {
+        telemetry_t from_cbor = { 0 };
+        telemetry_t from_json = { 0 };
+
+        cbor_lens[i] = cbor_schema_encode(&telemetry_schema, &telemetry[i], telemetry_schema.required,
+                                          cbor_messages[i], ENCODED_SIZE);
+        json_lens[i] = json_encode_telemetry(&telemetry[i], json_messages[i], ENCODED_SIZE);
+        cbor_bytes += cbor_lens[i];
+        json_bytes += json_lens[i];
+
+        if ((cbor_lens[i] == 0u) ||
+            !cbor_schema_decode(&telemetry_schema, cbor_messages[i], cbor_lens[i], &from_cbor, NULL) ||
+            !json_decode_telemetry(json_messages[i], &from_json) ||
+            !same_telemetry(&from_cbor, &telemetry[i]) ||
+            !same_telemetry(&from_json, &telemetry[i]))
+        {
+            printf("[cbor-bench] telemetry %u does not round trip\n", i);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    start = now_ns();
+    for (unsigned i = 0; i < OPERATIONS_PER_RUN; i++)
+    {
+        unsigned m = i % MESSAGE_COUNT;
+        bench_sink += cbor_schema_encode(&telemetry_schema, &telemetry[m], telemetry_schema.required,
+                                         cbor_messages[m], ENCODED_SIZE);
+    }
+    cbor_encode_ns = (now_ns() - start) / OPERATIONS_PER_RUN;
+
+    start = now_ns();
+    for (unsigned i = 0; i < OPERATIONS_PER_RUN; i++)
+    {
+        unsigned m = i % MESSAGE_COUNT;
+        telemetry_t message;
+        bench_sink += cbor_schema_decode(&telemetry_schema, cbor_messages[m], cbor_lens[m],
+                                         &message, NULL);
+        bench_sink += message.pressure_pa;
+    }
+    cbor_decode_ns = (now_ns() - start) / OPERATIONS_PER_RUN;
+
+    start = now_ns();
+    for (unsigned i = 0; i < OPERATIONS_PER_RUN; i++)
+    {
+        unsigned m = i % MESSAGE_COUNT;
+        bench_sink += json_encode_telemetry(&telemetry[m], json_messages[m], ENCODED_SIZE);
+    }
+    json_encode_ns = (now_ns() - start) / OPERATIONS_PER_RUN;
+
+    start = now_ns();
+    for (unsigned i = 0; i < OPERATIONS_PER_RUN; i++)
+    {
+        unsigned m = i % MESSAGE_COUNT;
+        telemetry_t message;
+        bench_sink += json_decode_telemetry(json_messages[m], &message);
+        bench_sink += message.pressure_pa;
+    }
+    json_decode_ns = (now_ns() - start) / OPERATIONS_PER_RUN;
+
+    printf("[cbor-bench] message=telemetry cbor_bytes=%.1f json_bytes=%.1f "
+           "cbor_encode_ns=%.1f json_encode_ns=%.1f cbor_decode_ns=%.1f json_decode_ns=%.1f\n",
+           (double) cbor_bytes / MESSAGE_COUNT, (double) json_bytes / MESSAGE_COUNT,
+           cbor_encode_ns, json_encode_ns, cbor_decode_ns, json_decode_ns);
+
+    return status;
+}
+
+/* [] END OF FILE */
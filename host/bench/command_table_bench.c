@@ -0,0 +1,231 @@
+/******************************************************************************
+* File Name:   command_table_bench.c
+*
+* Description: Host microbenchmark of the device command table. Builds tables
+*              of 2, 10 and 50 commands and times resolving a mix of received
+*              messages with command_table_lookup() against the length and
+*              strncmp chain of the original subscription callback. Every
+*              lookup is cross-checked between the two.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "command_table.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define COMMAND_TEXT_SIZE               (32u)
+#define MESSAGE_COUNT                   (256u)
+#define LOOKUPS_PER_RUN                 (1000000u)
+
+/* Every fifth message is not a command. */
+#define MISS_INTERVAL                   (5u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const unsigned command_counts[] = { 2u, 10u, 50u };
+
+static char command_texts[COMMAND_TABLE_MAX_COMMANDS][COMMAND_TEXT_SIZE];
+static command_entry_t commands[COMMAND_TABLE_MAX_COMMANDS];
+static char messages[MESSAGE_COUNT][COMMAND_TEXT_SIZE];
+static size_t message_lens[MESSAGE_COUNT];
+
+/* Sink for the lookup results so that the loops are not optimized away. */
+static volatile unsigned long lookup_sink;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static double now_ns(void);
+static void make_commands(unsigned count);
+static void make_messages(unsigned count);
+static int linear_lookup(unsigned count, const char *message, size_t message_len);
+
+/******************************************************************************
+ * Function Name: now_ns
+ ******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec * 1e9) + (double) ts.tv_nsec;
+}
+
+/******************************************************************************
+ * Function Name: make_commands
+ ******************************************************************************
+ * Summary:
+ *  Generates commands that share long prefixes, as the commands of a device
+ *  with several outputs do.
+ *
+ ******************************************************************************/
+static void make_commands(unsigned count)
+{
+    for (unsigned i = 0; i < count; i++)
+    {
+        snprintf(command_texts[i], COMMAND_TEXT_SIZE, "TURN %s OUTPUT %u",
+                 ((i % 2u) == 0u) ? "ON" : "OFF", i / 2u);
+        commands[i].text = command_texts[i];
+        commands[i].text_len = (uint16_t) strlen(command_texts[i]);
+        commands[i].value = (uint8_t) i;
+    }
+}
+
+/******************************************************************************
+ * Function Name: make_messages
+ ******************************************************************************
+ * Summary:
+ *  Picks received messages among the commands, with some invalid ones.
+ *
+ ******************************************************************************/
+static void make_messages(unsigned count)
+{
+    srand(1);
+
+    for (unsigned i = 0; i < MESSAGE_COUNT; i++)
+    {
+        unsigned k = (unsigned) rand() % count;
+
+        if ((i % MISS_INTERVAL) == 0u)
+        {
+            snprintf(messages[i], COMMAND_TEXT_SIZE, "TURN ON OUTPUT %u!", k);
+        }
+        else
+        {
+            memcpy(messages[i], command_texts[k], commands[k].text_len + 1u);
+        }
+        message_lens[i] = strlen(messages[i]);
+    }
+}
+
+/******************************************************************************
+ * Function Name: linear_lookup
+ ******************************************************************************
+ * Summary:
+ *  Baseline: compares the length and the text of every command in turn.
+ *
+ ******************************************************************************/
+static int linear_lookup(unsigned count, const char *message, size_t message_len)
+{
+    for (unsigned i = 0; i < count; i++)
+    {
+        if ((strlen(commands[i].text) == message_len) &&
+            (strncmp(commands[i].text, message, message_len) == 0))
+        {
+            return (int) commands[i].value;
+        }
+    }
+
+    return -1;
+}
+
+int main(void)
+{
+    int status = EXIT_SUCCESS;
+
+    printf("[command-bench] lookups=%u messages=%u\n", LOOKUPS_PER_RUN, MESSAGE_COUNT);
+
+    for (unsigned c = 0; c < (sizeof(command_counts) / sizeof(command_counts[0])); c++)
+    {
+        unsigned count = command_counts[c];
+        uint8_t slots[COMMAND_TABLE_SLOT_COUNT(COMMAND_TABLE_MAX_COMMANDS)];
+        uint16_t displacements[COMMAND_TABLE_BUCKET_COUNT(COMMAND_TABLE_MAX_COMMANDS)];
+        command_table_t table;
+        double start;
+        double build_ns;
+        double hash_ns;
+        double linear_ns;
+
+        make_commands(count);
+        make_messages(count);
+
+        start = now_ns();
+        if (!command_table_init(&table, commands, count, slots, displacements))
+        {
+            printf("[command-bench] failed to build the table of %u commands\n", count);
+            return EXIT_FAILURE;
+        }
+        build_ns = now_ns() - start;
+
+        /* Both methods must agree on every message. */
+        for (unsigned i = 0; i < MESSAGE_COUNT; i++)
+        {
+            const command_entry_t *entry = command_table_lookup(&table, messages[i], message_lens[i]);
+            int expected = linear_lookup(count, messages[i], message_lens[i]);
+            int actual = (entry != NULL) ? (int) entry->value : -1;
+
+            if (expected != actual)
+            {
+                printf("[command-bench] mismatch on '%s': linear=%d hash=%d\n",
+                       messages[i], expected, actual);
+                status = EXIT_FAILURE;
+            }
+        }
+
+        start = now_ns();
+        for (unsigned i = 0; i < LOOKUPS_PER_RUN; i++)
+        {
+            unsigned m = i % MESSAGE_COUNT;
+            lookup_sink += (command_table_lookup(&table, messages[m], message_lens[m]) != NULL);
+        }
+        hash_ns = (now_ns() - start) / LOOKUPS_PER_RUN;
+
+        start = now_ns();
+        for (unsigned i = 0; i < LOOKUPS_PER_RUN; i++)
+        {
+            unsigned m = i % MESSAGE_COUNT;
+            lookup_sink += (unsigned long) linear_lookup(count, messages[m], message_lens[m]);
+        }
+        linear_ns = (now_ns() - start) / LOOKUPS_PER_RUN;
+
+        printf("[command-bench] commands=%u slots=%u build_us=%.1f "
+               "hash_ns=%.1f linear_ns=%.1f speedup=%.1fx\n",
+               count, (unsigned) (table.slot_mask + 1u), build_ns / 1000.0,
+               hash_ns, linear_ns, linear_ns / hash_ns);
+    }
+
+    return status;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,375 @@
+/******************************************************************************
+* File Name:   compress_bench.c
+*
+* Description: Host microbenchmark of the payload compressor. Compresses
+*              corpora of representative payloads (JSON and CBOR telemetry,
+*              task monitor snapshots, batches of device commands, and log
+*              lines) and reports the compression ratio, the forms chosen and
+*              the time per byte to compress and to restore them. Every
+*              payload is cross-checked through the round trip.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "payload_compress.h"
+#include "publish_batch.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define PAYLOAD_COUNT                   (128u)
+#define PAYLOAD_MAX_SIZE                (512u)
+#define ROUNDS                          (200u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    void (*make)(unsigned index, uint8_t *payload, size_t *payload_len);
+} corpus_t;
+
+static uint8_t payloads[PAYLOAD_COUNT][PAYLOAD_MAX_SIZE];
+static size_t payload_lens[PAYLOAD_COUNT];
+static uint8_t compressed[PAYLOAD_COUNT][PAYLOAD_COMPRESS_BUFFER_SIZE(PAYLOAD_MAX_SIZE)];
+static const void *wire_payloads[PAYLOAD_COUNT];
+static size_t wire_lens[PAYLOAD_COUNT];
+static uint8_t restored[PAYLOAD_MAX_SIZE];
+
+static payload_compressor_t compressor;
+
+/* Sink for the results so that the loops are not optimized away. */
+static volatile unsigned long bench_sink;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static double now_ns(void);
+static void make_json_telemetry(unsigned index, uint8_t *payload, size_t *payload_len);
+static void make_json_series(unsigned index, uint8_t *payload, size_t *payload_len);
+static void make_cbor_telemetry(unsigned index, uint8_t *payload, size_t *payload_len);
+static void make_monitor_snapshot(unsigned index, uint8_t *payload, size_t *payload_len);
+static void make_command_batch(unsigned index, uint8_t *payload, size_t *payload_len);
+static void make_log_lines(unsigned index, uint8_t *payload, size_t *payload_len);
+
+static const corpus_t corpora[] =
+{
+    { "json_telemetry",   make_json_telemetry },
+    { "json_series",      make_json_series },
+    { "cbor_telemetry",   make_cbor_telemetry },
+    { "monitor_snapshot", make_monitor_snapshot },
+    { "command_batch",    make_command_batch },
+    { "log_lines",        make_log_lines }
+};
+
+/******************************************************************************
+ * Function Name: now_ns
+ ******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec * 1e9) + (double) ts.tv_nsec;
+}
+
+/******************************************************************************
+ * Function Name: make_json_telemetry
+ ******************************************************************************
+ * Summary:
+ *  Sensor readings formatted with snprintf, as a JSON publisher sends them.
+ *
+ ******************************************************************************/
+static void make_json_telemetry(unsigned index, uint8_t *payload, size_t *payload_len)
+{
+    *payload_len = (size_t) snprintf((char *) payload, PAYLOAD_MAX_SIZE,
+                                     "{\"device\":\"node-%02u\",\"seq\":%u,\"temperature\":%.2f,"
+                                     "\"humidity\":%.2f,\"pressure_pa\":%u,\"rssi_dbm\":%d,"
+                                     "\"charging\":%s,\"firmware\":\"v1.4.%u\"}",
+                                     index % 16u, index * 7u,
+                                     (double) ((rand() % 400) - 100) / 4.0,
+                                     (double) (rand() % 400) / 4.0,
+                                     95000u + ((unsigned) rand() % 10000u), -(rand() % 90),
+                                     ((rand() % 2) == 0) ? "true" : "false", index % 3u);
+}
+
+/******************************************************************************
+ * Function Name: make_json_series
+ ******************************************************************************
+ * Summary:
+ *  JSON arrays of 2 to 8 readings sampled between two publishes.
+ *
+ ******************************************************************************/
+static void make_json_series(unsigned index, uint8_t *payload, size_t *payload_len)
+{
+    unsigned readings = 2u + (index % 7u);
+    size_t len = (size_t) snprintf((char *) payload, PAYLOAD_MAX_SIZE, "{\"device\":\"node-%02u\",\"readings\":[",
+                                   index % 16u);
+
+    for (unsigned i = 0; i < readings; i++)
+    {
+        len += (size_t) snprintf((char *) &payload[len], PAYLOAD_MAX_SIZE - len,
+                                 "%s{\"t_ms\":%u,\"temperature\":%.2f,\"humidity\":%.2f}",
+                                 (i == 0u) ? "" : ",", (index * 1000u) + (i * 125u),
+                                 (double) (80 + (rand() % 8)) / 4.0,
+                                 (double) (160 + (rand() % 8)) / 4.0);
+    }
+    len += (size_t) snprintf((char *) &payload[len], PAYLOAD_MAX_SIZE - len, "]}");
+    *payload_len = len;
+}
+
+/******************************************************************************
+ * Function Name: make_cbor_telemetry
+ ******************************************************************************
+ * Summary:
+ *  The same readings as a CBOR map of integer keys, hand-encoded: little
+ *  redundancy is left for the compressor.
+ *
+ ******************************************************************************/
+static void make_cbor_telemetry(unsigned index, uint8_t *payload, size_t *payload_len)
+{
+    uint32_t pressure = 95000u + ((unsigned) rand() % 10000u);
+    size_t len = 0u;
+
+    payload[len++] = 0xA5;                              /* Map of 5 pairs */
+    payload[len++] = 0x01;                              /* seq */
+    payload[len++] = 0x19;
+    payload[len++] = (uint8_t)((index * 7u) >> 8);
+    payload[len++] = (uint8_t)(index * 7u);
+    payload[len++] = 0x02;                              /* temperature, half float */
+    payload[len++] = 0xF9;
+    payload[len++] = (uint8_t)(0x4C + (rand() % 4));
+    payload[len++] = (uint8_t) rand();
+    payload[len++] = 0x03;                              /* pressure */
+    payload[len++] = 0x1A;
+    payload[len++] = (uint8_t)(pressure >> 24);
+    payload[len++] = (uint8_t)(pressure >> 16);
+    payload[len++] = (uint8_t)(pressure >> 8);
+    payload[len++] = (uint8_t) pressure;
+    payload[len++] = 0x04;                              /* rssi */
+    payload[len++] = (uint8_t)(0x38);
+    payload[len++] = (uint8_t)(rand() % 90);
+    payload[len++] = 0x05;                              /* firmware */
+    len += (size_t) snprintf((char *) &payload[len], PAYLOAD_MAX_SIZE - len, "%cv1.4.%u",
+                             0x66, index % 3u);
+    *payload_len = len;
+}
+
+/******************************************************************************
+ * Function Name: make_monitor_snapshot
+ ******************************************************************************
+ * Summary:
+ *  Snapshots in the format of the task monitor: CPU usage and stack headroom
+ *  per task.
+ *
+ ******************************************************************************/
+static void make_monitor_snapshot(unsigned index, uint8_t *payload, size_t *payload_len)
+{
+    static const char *const task_names[] =
+    {
+        "MQTT Client task", "Subscriber task", "Publisher task", "Publish worker",
+        "Publish worker", "Publish worker", "Publish worker", "Task monitor",
+        "Log drain", "IDLE", "Tmr Svc", "WCM-WORKER"
+    };
+    size_t len = (size_t) snprintf((char *) payload, PAYLOAD_MAX_SIZE, "up=%u", index * 10u);
+
+    for (size_t i = 0; i < (sizeof(task_names) / sizeof(task_names[0])); i++)
+    {
+        unsigned permille = (unsigned) rand() % 300u;
+
+        len += (size_t) snprintf((char *) &payload[len], PAYLOAD_MAX_SIZE - len, ";%s,%u.%u,%u",
+                                 task_names[i], permille / 10u, permille % 10u,
+                                 200u + ((unsigned) rand() % 64u) * 4u);
+    }
+    *payload_len = len;
+}
+
+/******************************************************************************
+ * Function Name: make_command_batch
+ ******************************************************************************
+ * Summary:
+ *  Batches of device commands framed as by the batched publish mode.
+ *
+ ******************************************************************************/
+static void make_command_batch(unsigned index, uint8_t *payload, size_t *payload_len)
+{
+    publish_batch_t batch;
+    const uint8_t *batched;
+    unsigned records = 2u + (index % 30u);
+
+    publish_batch_init(&batch, payload, PAYLOAD_MAX_SIZE, PUBLISH_BATCH_MAX_RECORD_COUNT);
+    publish_batch_reset(&batch, "ledstatus");
+    for (unsigned i = 0; i < records; i++)
+    {
+        const char *command = ((rand() % 2) == 0) ? "TURN ON" : "TURN OFF";
+
+        (void) publish_batch_add(&batch, command, strlen(command));
+    }
+    batched = publish_batch_payload(&batch, payload_len);
+    memmove(payload, batched, *payload_len);
+}
+
+/******************************************************************************
+ * Function Name: make_log_lines
+ ******************************************************************************
+ * Summary:
+ *  Diagnostic log lines forwarded over MQTT.
+ *
+ ******************************************************************************/
+static void make_log_lines(unsigned index, uint8_t *payload, size_t *payload_len)
+{
+    size_t len = 0u;
+    unsigned lines = 1u + (index % 4u);
+
+    for (unsigned i = 0; i < lines; i++)
+    {
+        len += (size_t) snprintf((char *) &payload[len], PAYLOAD_MAX_SIZE - len,
+                                 "[%u] Publisher: Publishing 'TURN %s' on the topic 'ledstatus'\n",
+                                 (index * 100u) + ((unsigned) rand() % 100u),
+                                 ((rand() % 2) == 0) ? "ON" : "OFF");
+    }
+    *payload_len = len;
+}
+
+int main(void)
+{
+    int status = EXIT_SUCCESS;
+
+    printf("[compress-bench] payloads=%u rounds=%u window=%u hash_bits=%u\n",
+           PAYLOAD_COUNT, ROUNDS, PAYLOAD_COMPRESS_WINDOW_SIZE, PAYLOAD_COMPRESS_HASH_BITS);
+
+    srand(1);
+
+    for (size_t c = 0; c < (sizeof(corpora) / sizeof(corpora[0])); c++)
+    {
+        size_t bytes_in = 0u;
+        size_t bytes_out = 0u;
+        unsigned forms[PAYLOAD_COMPRESS_TOO_LARGE + 1] = { 0 };
+        double start;
+        double compress_ns;
+        double restore_ns;
+
+        for (unsigned i = 0; i < PAYLOAD_COUNT; i++)
+        {
+            corpora[c].make(i, payloads[i], &payload_lens[i]);
+        }
+
+        /* Every payload must come back unchanged. */
+        for (unsigned i = 0; i < PAYLOAD_COUNT; i++)
+        {
+            payload_compress_form_t form;
+            size_t restored_len;
+
+            form = payload_compress(&compressor, payloads[i], payload_lens[i],
+                                    compressed[i], sizeof(compressed[i]),
+                                    &wire_payloads[i], &wire_lens[i]);
+            forms[form]++;
+            bytes_in += payload_lens[i];
+            bytes_out += wire_lens[i];
+
+            if (form == PAYLOAD_COMPRESS_RAW)
+            {
+                if (payload_compress_is_framed(wire_payloads[i], wire_lens[i]))
+                {
+                    printf("[compress-bench] %s payload %u sent raw with a header byte\n",
+                           corpora[c].name, i);
+                    status = EXIT_FAILURE;
+                }
+                continue;
+            }
+
+            if (!payload_decompress(wire_payloads[i], wire_lens[i], restored, sizeof(restored),
+                                    &restored_len) ||
+                (restored_len != payload_lens[i]) ||
+                (memcmp(restored, payloads[i], restored_len) != 0))
+            {
+                printf("[compress-bench] %s payload %u does not round trip\n", corpora[c].name, i);
+                status = EXIT_FAILURE;
+            }
+        }
+
+        start = now_ns();
+        for (unsigned r = 0; r < ROUNDS; r++)
+        {
+            for (unsigned i = 0; i < PAYLOAD_COUNT; i++)
+            {
+                const void *wire;
+                size_t wire_len;
+
+                bench_sink += payload_compress(&compressor, payloads[i], payload_lens[i],
+                                               compressed[i], sizeof(compressed[i]),
+                                               &wire, &wire_len);
+                bench_sink += wire_len;
+            }
+        }
+        compress_ns = (now_ns() - start) / ((double) ROUNDS * (double) bytes_in);
+
+        start = now_ns();
+        for (unsigned r = 0; r < ROUNDS; r++)
+        {
+            for (unsigned i = 0; i < PAYLOAD_COUNT; i++)
+            {
+                size_t restored_len = 0u;
+
+                if (payload_compress_is_framed(wire_payloads[i], wire_lens[i]))
+                {
+                    bench_sink += payload_decompress(wire_payloads[i], wire_lens[i], restored,
+                                                     sizeof(restored), &restored_len);
+                }
+                bench_sink += restored_len;
+            }
+        }
+        restore_ns = (now_ns() - start) / ((double) ROUNDS * (double) bytes_in);
+
+        printf("[compress-bench] corpus=%s mean_bytes=%.1f mean_wire_bytes=%.1f ratio=%.2f "
+               "lz=%u stored=%u raw=%u compress_ns_per_byte=%.2f restore_ns_per_byte=%.2f\n",
+               corpora[c].name, (double) bytes_in / PAYLOAD_COUNT, (double) bytes_out / PAYLOAD_COUNT,
+               (double) bytes_in / (double) bytes_out, forms[PAYLOAD_COMPRESS_LZ],
+               forms[PAYLOAD_COMPRESS_STORED], forms[PAYLOAD_COMPRESS_RAW],
+               compress_ns, restore_ns);
+    }
+
+    return status;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,351 @@
+/******************************************************************************
+* File Name:   flash_log_bench.c
+*
+* Description: Host microbenchmark of the flash log behind the persistent
+*              publish outbox. Emulates a 1 MB region of a QSPI NOR flash
+*              with 256 KB sectors and 512-byte pages in a file, appends and
+*              drains messages, reboots by mounting the log again from the
+*              file, and cuts power in the middle of a page program. Reports
+*              the throughput, the mount time, the page programs and sector
+*              erases with the flash time they take on the S25FL512S, and the
+*              wear levelling.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "flash_log.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define REGION_SIZE                     (1024u * 1024u)
+#define SECTOR_SIZE                     (256u * 1024u)
+#define PAGE_SIZE                       (512u)
+
+/* Typical S25FL512S timings: page program, sector erase, quad read at
+ * 50 MHz.
+ */
+#define PAGE_PROGRAM_US                 (340.0)
+#define SECTOR_ERASE_US                 (520000.0)
+#define READ_BYTES_PER_US               (25.0)
+
+#define MESSAGE_COUNT                   (20000u)
+#define PAYLOAD_SIZE                    (64u)
+#define SYNC_INTERVAL                   (8u)
+#define ACK_INTERVAL                    (8u)
+#define TOPIC                           "mqtt/bench/outbox"
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static int flash_fd = -1;
+
+/* Bytes left to program before the emulated power loss; negative for none. */
+static long program_budget = -1;
+
+/* Flash operation counters. */
+static unsigned long bytes_read;
+static unsigned long programs;
+static unsigned long erases;
+
+static uint8_t page_buffer[PAGE_SIZE];
+static uint8_t record_buffer[256];
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static double now_ns(void);
+static bool file_read(uint32_t address, void *data, uint32_t length);
+static bool file_program(uint32_t address, const void *data, uint32_t length);
+static bool file_erase(uint32_t address);
+static double flash_time_ms(void);
+static void reset_counters(void);
+static bool append_messages(flash_log_t *log, uint32_t first, uint32_t count);
+static bool drain_messages(flash_log_t *log, uint32_t *drained, uint32_t *last_index);
+
+static const flash_log_device_t file_device =
+{
+    .size = REGION_SIZE,
+    .sector_size = SECTOR_SIZE,
+    .page_size = PAGE_SIZE,
+    .read = file_read,
+    .program = file_program,
+    .erase = file_erase
+};
+
+/******************************************************************************
+ * Function Name: now_ns
+ ******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec * 1e9) + (double) ts.tv_nsec;
+}
+
+/******************************************************************************
+ * Function Name: file_read / file_program / file_erase
+ ******************************************************************************
+ * Summary:
+ *  NOR flash emulated in a file: programming only clears bits, an erase sets
+ *  a whole sector to 0xFF, and a program never crosses a page.
+ *
+ ******************************************************************************/
+static bool file_read(uint32_t address, void *data, uint32_t length)
+{
+    bytes_read += length;
+    return pread(flash_fd, data, length, address) == (ssize_t) length;
+}
+
+static bool file_program(uint32_t address, const void *data, uint32_t length)
+{
+    uint8_t current[PAGE_SIZE];
+    const uint8_t *bytes = (const uint8_t *) data;
+
+    if (((address % PAGE_SIZE) + length > PAGE_SIZE) || !file_read(address, current, length))
+    {
+        return false;
+    }
+    bytes_read -= length;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        if (program_budget == 0)
+        {
+            /* Power lost: keep what has been programmed so far. */
+            (void) pwrite(flash_fd, current, i, address);
+            return false;
+        }
+        if (program_budget > 0)
+        {
+            program_budget--;
+        }
+        current[i] &= bytes[i];
+    }
+
+    programs++;
+    return pwrite(flash_fd, current, length, address) == (ssize_t) length;
+}
+
+static bool file_erase(uint32_t address)
+{
+    static uint8_t erased[SECTOR_SIZE];
+
+    memset(erased, 0xFF, sizeof(erased));
+    erases++;
+    return pwrite(flash_fd, erased, SECTOR_SIZE, address - (address % SECTOR_SIZE)) ==
+           (ssize_t) SECTOR_SIZE;
+}
+
+/******************************************************************************
+ * Function Name: flash_time_ms
+ ******************************************************************************
+ * Summary:
+ *  Time the counted operations take on the real flash.
+ *
+ ******************************************************************************/
+static double flash_time_ms(void)
+{
+    return ((programs * PAGE_PROGRAM_US) + (erases * SECTOR_ERASE_US) +
+            (bytes_read / READ_BYTES_PER_US)) / 1000.0;
+}
+
+static void reset_counters(void)
+{
+    bytes_read = 0;
+    programs = 0;
+    erases = 0;
+}
+
+/******************************************************************************
+ * Function Name: append_messages
+ ******************************************************************************
+ * Summary:
+ *  Appends numbered messages, syncing every SYNC_INTERVAL messages as the
+ *  publisher does when its queue runs dry.
+ *
+ ******************************************************************************/
+static bool append_messages(flash_log_t *log, uint32_t first, uint32_t count)
+{
+    char payload[PAYLOAD_SIZE];
+
+    memset(payload, 'x', sizeof(payload));
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        int length = snprintf(payload, sizeof(payload), "{\"index\":%u}", (unsigned) i);
+
+        payload[length] = ' ';
+        if (!flash_log_append(log, TOPIC, payload, sizeof(payload)) ||
+            ((((i + 1u) % SYNC_INTERVAL) == 0u) && !flash_log_sync(log)))
+        {
+            return false;
+        }
+    }
+    return flash_log_sync(log);
+}
+
+/******************************************************************************
+ * Function Name: drain_messages
+ ******************************************************************************
+ * Summary:
+ *  Drains the log, checking that the messages come out whole and in order.
+ *
+ ******************************************************************************/
+static bool drain_messages(flash_log_t *log, uint32_t *drained, uint32_t *last_index)
+{
+    flash_log_record_t record;
+    unsigned index;
+
+    *drained = 0;
+    while (flash_log_peek(log, &record, record_buffer, sizeof(record_buffer)))
+    {
+        if ((0 != strcmp(record.topic, TOPIC)) || (record.payload_len != PAYLOAD_SIZE) ||
+            (1 != sscanf((const char *) record.payload, "{\"index\":%u}", &index)) ||
+            ((*drained > 0u) && (index != *last_index + 1u)) || !flash_log_consume(log))
+        {
+            return false;
+        }
+        *last_index = index;
+        (*drained)++;
+    }
+    return true;
+}
+
+int main(void)
+{
+    char path[] = "/tmp/flash_log_bench_XXXXXX";
+    flash_log_t log;
+    uint32_t drained;
+    uint32_t last_index = 0;
+    uint32_t pending;
+    double start;
+    double elapsed_ns;
+    bool ok;
+
+    flash_fd = mkstemp(path);
+    if ((flash_fd < 0) || (ftruncate(flash_fd, REGION_SIZE) != 0))
+    {
+        perror("flash_log_bench");
+        return EXIT_FAILURE;
+    }
+    unlink(path);
+
+    printf("[flash-log-bench] region=%uKB sector=%uKB page=%uB messages=%u payload=%uB\n",
+           REGION_SIZE / 1024u, SECTOR_SIZE / 1024u, PAGE_SIZE, MESSAGE_COUNT, PAYLOAD_SIZE);
+
+    /* Fill the log well past its capacity while the connection is down. */
+    reset_counters();
+    start = now_ns();
+    ok = flash_log_format(&log, &file_device, page_buffer, ACK_INTERVAL) &&
+         append_messages(&log, 0u, MESSAGE_COUNT);
+    elapsed_ns = now_ns() - start;
+    if (!ok)
+    {
+        printf("append: FAILED\n");
+        return EXIT_FAILURE;
+    }
+    printf("append:  %8.0f msg/s host  %6lu page programs  %2lu erases  %8.1f ms flash  "
+           "kept=%u dropped=%u\n",
+           MESSAGE_COUNT / (elapsed_ns / 1e9), programs, erases, flash_time_ms(),
+           (unsigned) flash_log_pending(&log), (unsigned) log.stats.dropped);
+    pending = flash_log_pending(&log);
+
+    /* Reboot: recover the log from flash. */
+    reset_counters();
+    start = now_ns();
+    ok = flash_log_mount(&log, &file_device, page_buffer, ACK_INTERVAL);
+    elapsed_ns = now_ns() - start;
+    printf("mount:   %8.2f ms host  %8lu bytes read  %8.1f ms flash  recovered=%u %s\n",
+           elapsed_ns / 1e6, bytes_read, flash_time_ms(), (unsigned) flash_log_pending(&log),
+           (ok && (flash_log_pending(&log) == pending)) ? "OK" : "MISMATCH");
+    if (!ok || (flash_log_pending(&log) != pending))
+    {
+        return EXIT_FAILURE;
+    }
+
+    /* Drain half, reboot, and drain the rest: at most ACK_INTERVAL - 1
+     * messages are delivered again.
+     */
+    reset_counters();
+    start = now_ns();
+    for (uint32_t i = 0; i < pending / 2u; i++)
+    {
+        flash_log_record_t record;
+
+        ok = ok && flash_log_peek(&log, &record, record_buffer, sizeof(record_buffer)) &&
+             flash_log_consume(&log);
+    }
+    ok = ok && flash_log_mount(&log, &file_device, page_buffer, ACK_INTERVAL) &&
+         drain_messages(&log, &drained, &last_index);
+    elapsed_ns = now_ns() - start;
+    printf("drain:   %8.0f msg/s host  %6lu page programs  %2lu erases  %8.1f ms flash  "
+           "redelivered=%u last=%u %s\n",
+           pending / (elapsed_ns / 1e9), programs, erases, flash_time_ms(),
+           (unsigned)(drained - (pending - (pending / 2u))), (unsigned) last_index,
+           (ok && (last_index == MESSAGE_COUNT - 1u)) ? "OK" : "FAILED");
+    if (!ok || (last_index != MESSAGE_COUNT - 1u))
+    {
+        return EXIT_FAILURE;
+    }
+
+    /* Power loss in the middle of a page program: the messages synced
+     * before survive, the torn one is skipped.
+     */
+    ok = append_messages(&log, MESSAGE_COUNT, 2u * SYNC_INTERVAL);
+    program_budget = PAGE_SIZE / 3u;
+    (void) append_messages(&log, MESSAGE_COUNT + (2u * SYNC_INTERVAL), PAGE_SIZE / PAYLOAD_SIZE);
+    program_budget = -1;
+    ok = ok && flash_log_mount(&log, &file_device, page_buffer, ACK_INTERVAL) &&
+         drain_messages(&log, &drained, &last_index) && (drained >= 2u * SYNC_INTERVAL);
+    printf("torn:    recovered=%u corrupt=%u %s\n", (unsigned) drained,
+           (unsigned) log.stats.corrupt_records, ok ? "OK" : "FAILED");
+
+    printf("wear:    max erase count %u over %u sectors\n",
+           (unsigned) log.stats.max_erase_count, REGION_SIZE / SECTOR_SIZE);
+
+    close(flash_fd);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* [] END OF FILE */
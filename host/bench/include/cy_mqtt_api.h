@@ -0,0 +1,109 @@
+/******************************************************************************
+* File Name:   cy_mqtt_api.h
+*
+* Description: Microbenchmark stand-in for the MQTT library header, with the
+*              constants and types that the configuration and the module
+*              headers refer to.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_MQTT_API_H_
+#define CY_MQTT_API_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define CY_MQTT_MIN_NETWORK_BUFFER_SIZE     (256u)
+#define CY_MQTT_MAX_HANDLE                  (2u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+typedef void *cy_mqtt_t;
+
+typedef enum
+{
+    CY_MQTT_QOS0,
+    CY_MQTT_QOS1,
+    CY_MQTT_QOS2
+} cy_mqtt_qos_t;
+
+typedef struct
+{
+    cy_mqtt_qos_t qos;
+    bool retain;
+    bool dup;
+    const char *topic;
+    uint16_t topic_len;
+    const char *payload;
+    size_t payload_len;
+} cy_mqtt_publish_info_t;
+
+typedef struct
+{
+    const char *hostname;
+    uint16_t hostname_len;
+    uint16_t port;
+} cy_mqtt_broker_info_t;
+
+typedef struct
+{
+    const char *client_id;
+    uint16_t client_id_len;
+    const char *username;
+    uint16_t username_len;
+    const char *password;
+    uint16_t password_len;
+    bool clean_session;
+    uint16_t keep_alive_sec;
+    cy_mqtt_publish_info_t *will_info;
+} cy_mqtt_connect_info_t;
+
+typedef struct
+{
+    const char *root_ca;
+    size_t root_ca_size;
+} cy_awsport_ssl_credentials_t;
+
+#endif /* CY_MQTT_API_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,270 @@
+/******************************************************************************
+* File Name:   topic_trie_bench.c
+*
+* Description: Host microbenchmark of the topic filter trie. Registers 10,
+*              100 and 1000 topic filters with wildcards and times matching a
+*              mix of topics with topic_trie_match() against a linear scan of
+*              the filters with topic_filter_matches(). Every lookup is
+*              cross-checked between the two.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "topic_trie.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define FILTER_TEXT_SIZE                (48u)
+#define TOPIC_COUNT                     (256u)
+#define LOOKUPS_PER_RUN                 (200000u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const unsigned filter_counts[] = { 10u, 100u, 1000u };
+
+static char (*filters)[FILTER_TEXT_SIZE];
+static size_t *filter_lens;
+static char topics[TOPIC_COUNT][FILTER_TEXT_SIZE];
+static size_t topic_lens[TOPIC_COUNT];
+
+/* Sink for the match results so that the loops are not optimized away. */
+static volatile unsigned long match_sink;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static double now_ns(void);
+static void make_filters(unsigned count);
+static void make_topics(unsigned count);
+static unsigned linear_match(unsigned count, const char *topic, size_t topic_len);
+
+/******************************************************************************
+ * Function Name: now_ns
+ ******************************************************************************/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double) ts.tv_sec * 1e9) + (double) ts.tv_nsec;
+}
+
+/******************************************************************************
+ * Function Name: make_filters
+ ******************************************************************************
+ * Summary:
+ *  Generates a mix of literal, '+' and '#' filters as seen on a gateway
+ *  that serves many sites and devices.
+ *
+ ******************************************************************************/
+static void make_filters(unsigned count)
+{
+    for (unsigned i = 0; i < count; i++)
+    {
+        switch (i % 4u)
+        {
+            case 0:
+                snprintf(filters[i], FILTER_TEXT_SIZE, "site/%u/sensor/%u/temperature", i, i);
+                break;
+            case 1:
+                snprintf(filters[i], FILTER_TEXT_SIZE, "site/%u/+/status", i);
+                break;
+            case 2:
+                snprintf(filters[i], FILTER_TEXT_SIZE, "site/%u/#", i);
+                break;
+            default:
+                snprintf(filters[i], FILTER_TEXT_SIZE, "fleet/+/device/%u/cmd", i);
+                break;
+        }
+        filter_lens[i] = strlen(filters[i]);
+    }
+}
+
+/******************************************************************************
+ * Function Name: make_topics
+ ******************************************************************************
+ * Summary:
+ *  Generates incoming topics; most match one or more filters, some none.
+ *
+ ******************************************************************************/
+static void make_topics(unsigned count)
+{
+    srand(1);
+
+    for (unsigned i = 0; i < TOPIC_COUNT; i++)
+    {
+        /* Base of a group of four filters, see make_filters(). */
+        unsigned k = ((unsigned) rand() % count) & ~3u;
+
+        switch (i % 5u)
+        {
+            case 0:
+                snprintf(topics[i], FILTER_TEXT_SIZE, "site/%u/sensor/%u/temperature", k, k);
+                break;
+            case 1:
+                snprintf(topics[i], FILTER_TEXT_SIZE, "site/%u/door/status", k + 1u);
+                break;
+            case 2:
+                snprintf(topics[i], FILTER_TEXT_SIZE, "fleet/truck%u/device/%u/cmd", k, k + 3u);
+                break;
+            case 3:
+                snprintf(topics[i], FILTER_TEXT_SIZE, "site/%u/a/b/c", k + 2u);
+                break;
+            default:
+                snprintf(topics[i], FILTER_TEXT_SIZE, "unrelated/topic/%u", k);
+                break;
+        }
+        topic_lens[i] = strlen(topics[i]);
+    }
+}
+
+/******************************************************************************
+ * Function Name: linear_match
+ ******************************************************************************
+ * Summary:
+ *  Baseline: compares the topic with every filter in turn.
+ *
+ ******************************************************************************/
+static unsigned linear_match(unsigned count, const char *topic, size_t topic_len)
+{
+    unsigned matches = 0;
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (topic_filter_matches(filters[i], filter_lens[i], topic, topic_len))
+        {
+            matches++;
+        }
+    }
+
+    return matches;
+}
+
+int main(void)
+{
+    int status = EXIT_SUCCESS;
+
+    printf("[topic-bench] lookups=%u topics=%u\n", LOOKUPS_PER_RUN, TOPIC_COUNT);
+
+    for (unsigned c = 0; c < (sizeof(filter_counts) / sizeof(filter_counts[0])); c++)
+    {
+        unsigned count = filter_counts[c];
+        uint32_t max_nodes = (count * 6u) + 1u;
+        uint32_t slot_count = 1u;
+        topic_trie_t trie;
+        double start;
+        double trie_ns;
+        double linear_ns;
+        unsigned long total_matches = 0;
+
+        while (slot_count <= (max_nodes * 2u))
+        {
+            slot_count <<= 1;
+        }
+
+        filters = calloc(count, sizeof(*filters));
+        filter_lens = calloc(count, sizeof(*filter_lens));
+        topic_trie_node_t *nodes = calloc(max_nodes, sizeof(*nodes));
+        uint16_t *slots = calloc(slot_count, sizeof(*slots));
+        topic_trie_entry_t *entries = calloc(count, sizeof(*entries));
+
+        make_filters(count);
+        make_topics(count);
+
+        topic_trie_init(&trie, nodes, max_nodes, slots, slot_count, entries, count);
+        for (unsigned i = 0; i < count; i++)
+        {
+            if (!topic_trie_add(&trie, filters[i], filter_lens[i], NULL))
+            {
+                printf("[topic-bench] failed to add filter '%s'\n", filters[i]);
+                return EXIT_FAILURE;
+            }
+        }
+
+        /* Both methods must agree on every topic. */
+        for (unsigned i = 0; i < TOPIC_COUNT; i++)
+        {
+            unsigned expected = linear_match(count, topics[i], topic_lens[i]);
+            unsigned actual = topic_trie_match(&trie, topics[i], topic_lens[i], NULL, NULL);
+
+            if (expected != actual)
+            {
+                printf("[topic-bench] mismatch on '%s': linear=%u trie=%u\n",
+                       topics[i], expected, actual);
+                status = EXIT_FAILURE;
+            }
+            total_matches += expected;
+        }
+
+        start = now_ns();
+        for (unsigned i = 0; i < LOOKUPS_PER_RUN; i++)
+        {
+            unsigned t = i % TOPIC_COUNT;
+            match_sink += topic_trie_match(&trie, topics[t], topic_lens[t], NULL, NULL);
+        }
+        trie_ns = (now_ns() - start) / LOOKUPS_PER_RUN;
+
+        start = now_ns();
+        for (unsigned i = 0; i < LOOKUPS_PER_RUN; i++)
+        {
+            unsigned t = i % TOPIC_COUNT;
+            match_sink += linear_match(count, topics[t], topic_lens[t]);
+        }
+        linear_ns = (now_ns() - start) / LOOKUPS_PER_RUN;
+
+        printf("[topic-bench] filters=%u nodes=%u matches_per_topic=%.2f "
+               "trie_ns=%.1f linear_ns=%.1f speedup=%.1fx\n",
+               count, (unsigned) trie.node_count, (double) total_matches / TOPIC_COUNT,
+               trie_ns, linear_ns, linear_ns / trie_ns);
+
+        free(filters);
+        free(filter_lens);
+        free(nodes);
+        free(slots);
+        free(entries);
+    }
+
+    return status;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,76 @@
+/******************************************************************************
+* File Name:   cy_utils.h
+*
+* Description: Host (Linux) replacement for the core-lib utility header. It
+*              shadows the target version, whose halt and assert macros rely
+*              on Arm instructions.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_UTILS_H_
+#define CY_UTILS_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define CY_UNUSED_PARAMETER(x)              ( (void)(x) )
+#define CY_HALT()                           abort()
+#define CY_ARRAY_SIZE(x)                    (sizeof(x) / sizeof(x[0]))
+#define CY_MIN(a, b)                        (((a) < (b)) ? (a) : (b))
+#define CY_MAX(a, b)                        (((a) > (b)) ? (a) : (b))
+
+#if defined(NDEBUG)
+    #define CY_ASSERT(x)                    CY_UNUSED_PARAMETER(x)
+#else
+    #define CY_ASSERT(x)                                                    \
+                do                                                          \
+                {                                                           \
+                    if (!(x))                                               \
+                    {                                                       \
+                        fprintf(stderr, "Assertion failed: %s (%s:%d)\n",   \
+                                #x, __FILE__, __LINE__);                    \
+                        CY_HALT();                                          \
+                    }                                                       \
+                } while(0)
+#endif /* defined(NDEBUG) */
+
+#endif /* CY_UTILS_H_ */
+
+/* [] END OF FILE */
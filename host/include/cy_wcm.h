@@ -0,0 +1,132 @@
+/******************************************************************************
+* File Name:   cy_wcm.h
+*
+* Description: Host (Linux) stand-in for the Wi-Fi Connection Manager. The
+*              host network is always available; the link state can be
+*              scripted from the benchmark harness to exercise the
+*              reconnection paths.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_WCM_H_
+#define CY_WCM_H_
+
+#include <stdint.h>
+#include "cy_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define CY_WCM_MAX_SSID_LEN                 (32u)
+#define CY_WCM_MAX_PASSPHRASE_LEN           (63u)
+#define CY_WCM_MAC_ADDR_LEN                 (6u)
+
+/* Error returned by cy_wcm_connect_ap() while the scripted link is down. */
+#define CY_RSLT_WCM_CONNECT_FAILED          \
+            CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x10)
+
+/*******************************************************************************
+* Data types
+********************************************************************************/
+typedef enum
+{
+    CY_WCM_INTERFACE_TYPE_STA = 0,
+    CY_WCM_INTERFACE_TYPE_AP,
+    CY_WCM_INTERFACE_TYPE_AP_STA
+} cy_wcm_interface_t;
+
+typedef enum
+{
+    CY_WCM_SECURITY_OPEN,
+    CY_WCM_SECURITY_WPA2_AES_PSK,
+    CY_WCM_SECURITY_WPA3_SAE,
+    CY_WCM_SECURITY_UNKNOWN
+} cy_wcm_security_t;
+
+typedef enum
+{
+    CY_WCM_IP_VER_V4 = 4,
+    CY_WCM_IP_VER_V6 = 6
+} cy_wcm_ip_version_t;
+
+typedef uint8_t cy_wcm_ssid_t[CY_WCM_MAX_SSID_LEN + 1];
+typedef uint8_t cy_wcm_passphrase_t[CY_WCM_MAX_PASSPHRASE_LEN + 1];
+typedef uint8_t cy_wcm_mac_t[CY_WCM_MAC_ADDR_LEN];
+
+typedef struct
+{
+    cy_wcm_interface_t interface;
+} cy_wcm_config_t;
+
+typedef struct
+{
+    cy_wcm_ssid_t SSID;
+    cy_wcm_passphrase_t password;
+    cy_wcm_security_t security;
+} cy_wcm_ap_credentials_t;
+
+typedef struct
+{
+    cy_wcm_ip_version_t version;
+    union
+    {
+        uint32_t v4;
+        uint32_t v6[4];
+    } ip;
+} cy_wcm_ip_address_t;
+
+typedef struct
+{
+    cy_wcm_ap_credentials_t ap_credentials;
+    cy_wcm_mac_t BSSID;
+    cy_wcm_ip_address_t *static_ip_settings;
+} cy_wcm_connect_params_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t cy_wcm_init(cy_wcm_config_t *config);
+cy_rslt_t cy_wcm_deinit(void);
+cy_rslt_t cy_wcm_connect_ap(cy_wcm_connect_params_t *connect_params,
+                            cy_wcm_ip_address_t *ip_addr);
+cy_rslt_t cy_wcm_disconnect_ap(void);
+uint8_t cy_wcm_is_connected_to_ap(void);
+cy_rslt_t cy_wcm_get_mac_addr(cy_wcm_interface_t interface_type, cy_wcm_mac_t *mac_addr);
+
+#endif /* CY_WCM_H_ */
+
+/* [] END OF FILE */
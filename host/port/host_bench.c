@@ -0,0 +1,527 @@
+/******************************************************************************
+* File Name:   host_bench.c
+*
+* Description: Host (Linux) benchmark harness. It presses the virtual user
+*              button at a fixed rate and times each press until the
+*              subscriber drives the user LED, i.e. the full publish ->
+*              broker -> subscribe round trip of the unmodified example.
+*              Without a configured press count, each line read from stdin
+*              presses the button once.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "cybsp.h"
+#include "host_port.h"
+#include "publish_latency.h"
+#include "heap_usage.h"
+#include "reconnect_policy.h"
+#include "mqtt_task.h"
+#include "publisher_task.h"
+#include "task_monitor.h"
+#include "buffer_profile.h"
+#include "broker_failover.h"
+#include "dns_cache.h"
+#include "app_log.h"
+#include "mqtt_client_config.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Environment variables that configure a benchmark run, see README.md. */
+#define BENCH_ENV_COUNT                     "MQTT_HOST_BENCH_COUNT"
+#define BENCH_ENV_PERIOD_MS                 "MQTT_HOST_BENCH_PERIOD_MS"
+#define BENCH_ENV_LINK_DOWN_AT              "MQTT_HOST_BENCH_LINK_DOWN_AT"
+#define BENCH_ENV_LINK_DOWN_MS              "MQTT_HOST_BENCH_LINK_DOWN_MS"
+
+#define BENCH_DEFAULT_PERIOD_MS             (100u)
+#define BENCH_DEFAULT_LINK_DOWN_MS          (3000u)
+
+/* Interval between attempts while waiting for the publisher to arm the button. */
+#define BENCH_ARM_POLL_MS                   (100u)
+
+/* Time given to the log drain task to print the pending lines before and
+ * after the report.
+ */
+#define BENCH_LOG_FLUSH_TIMEOUT_MS          (2000u)
+
+/* Time allowed for outstanding round trips after the last press. */
+#define BENCH_DRAIN_TIMEOUT_MS              (10000u)
+
+#define BENCH_TASK_PRIORITY                 (1)
+#define BENCH_TASK_STACK_SIZE               (configMINIMAL_STACK_SIZE)
+
+/* Size of the name of a report line, i.e. the text before its counters. */
+#define BENCH_REPORT_NAME_SIZE              (96u)
+
+/* Prints a report line of counters; each field is { "key=", value }. */
+#define BENCH_PRINT_FIELDS(name, ...)                                       \
+            do                                                              \
+            {                                                               \
+                const bench_field_t fields_[] = { __VA_ARGS__ };            \
+                bench_print_fields((name), fields_,                         \
+                                   sizeof(fields_) / sizeof(fields_[0]));   \
+            } while (0)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Counter of a report line, printed as the key followed by the value. The
+ * key carries its relation, e.g. "max=" or "p99<=".
+ */
+typedef struct
+{
+    const char *key;
+    uint32_t value;
+} bench_field_t;
+
+/* Press timestamps waiting for their LED update, oldest first. */
+static uint64_t *inflight;
+static uint32_t inflight_head;
+static uint32_t inflight_tail;
+
+/* Measured round-trip latencies in microseconds. */
+static uint32_t *samples;
+static volatile uint32_t sample_count;
+
+static uint32_t press_target;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void bench_task(void *arg);
+static uint32_t env_u32(const char *name, uint32_t default_value);
+static void bench_report(uint32_t pressed, uint64_t elapsed_us);
+static void bench_print_fields(const char *name, const bench_field_t *fields, size_t count);
+static int compare_u32(const void *a, const void *b);
+
+static uint32_t env_u32(const char *name, uint32_t default_value)
+{
+    const char *value = getenv(name);
+    return (value != NULL) ? (uint32_t) strtoul(value, NULL, 0) : default_value;
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+/******************************************************************************
+ * Function Name: host_bench_start
+ ******************************************************************************
+ * Summary:
+ *  Creates the harness task. Called from cybsp_init() before the scheduler
+ *  starts.
+ *
+ ******************************************************************************/
+void host_bench_start(void)
+{
+    press_target = env_u32(BENCH_ENV_COUNT, 0u);
+
+    if (press_target > 0u)
+    {
+        inflight = calloc(press_target, sizeof(*inflight));
+        samples = calloc(press_target, sizeof(*samples));
+        if ((inflight == NULL) || (samples == NULL))
+        {
+            fprintf(stderr, "host bench: cannot allocate %u samples\n", (unsigned) press_target);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    xTaskCreate(bench_task, "Host bench", BENCH_TASK_STACK_SIZE, NULL,
+                BENCH_TASK_PRIORITY, NULL);
+}
+
+/******************************************************************************
+ * Function Name: host_bench_on_gpio_write
+ ******************************************************************************
+ * Summary:
+ *  Called for every GPIO write. A write to the user LED completes the oldest
+ *  outstanding round trip.
+ *
+ ******************************************************************************/
+void host_bench_on_gpio_write(cyhal_gpio_t pin, bool value)
+{
+    uint64_t now = host_time_us();
+
+    if (pin != CYBSP_USER_LED)
+    {
+        return;
+    }
+
+    printf("[host] User LED %s\n", (value == CYBSP_LED_STATE_ON) ? "ON" : "OFF");
+    if (press_target == 0u)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    if (inflight_head != inflight_tail)
+    {
+        samples[sample_count] = (uint32_t)(now - inflight[inflight_head]);
+        inflight_head++;
+        sample_count++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: bench_task
+ ******************************************************************************
+ * Summary:
+ *  Presses the button 'MQTT_HOST_BENCH_COUNT' times, one press every
+ *  'MQTT_HOST_BENCH_PERIOD_MS', once the publisher has armed it. Optionally
+ *  takes the Wi-Fi link down once to exercise reconnection. Prints the
+ *  results and terminates the process.
+ *
+ ******************************************************************************/
+static void bench_task(void *arg)
+{
+    uint32_t period_ms = env_u32(BENCH_ENV_PERIOD_MS, BENCH_DEFAULT_PERIOD_MS);
+    uint32_t link_down_at = env_u32(BENCH_ENV_LINK_DOWN_AT, 0u);
+    uint32_t link_down_ms = env_u32(BENCH_ENV_LINK_DOWN_MS, BENCH_DEFAULT_LINK_DOWN_MS);
+    uint32_t pressed = 0;
+    uint64_t start_us = 0;
+    uint32_t drain_start_ms;
+    TickType_t last_wake;
+
+    (void) arg;
+
+    /* Interactive mode: one press per line on stdin. */
+    if (press_target == 0u)
+    {
+        char line[64];
+
+        while (true)
+        {
+            struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+
+            if ((poll(&pfd, 1, 0) > 0) && (fgets(line, sizeof(line), stdin) != NULL))
+            {
+                if (!host_hal_press_button())
+                {
+                    printf("[host] Button is not armed yet\n");
+                }
+            }
+            vTaskDelay(pdMS_TO_TICKS(BENCH_ARM_POLL_MS));
+        }
+    }
+
+    last_wake = xTaskGetTickCount();
+    while (pressed < press_target)
+    {
+        bool accepted;
+
+        if ((link_down_at != 0u) && (pressed == link_down_at))
+        {
+            printf("[host] Taking the Wi-Fi link down for %u ms\n", (unsigned) link_down_ms);
+            host_wcm_set_link(false);
+            vTaskDelay(pdMS_TO_TICKS(link_down_ms));
+            host_wcm_set_link(true);
+            link_down_at = 0;
+        }
+
+        /* Queue the timestamp first: the round trip may complete before the
+         * button callback returns to this task.
+         */
+        taskENTER_CRITICAL();
+        inflight[inflight_tail++] = host_time_us();
+        taskEXIT_CRITICAL();
+
+        accepted = host_hal_press_button();
+
+        if (!accepted)
+        {
+            taskENTER_CRITICAL();
+            inflight_tail--;
+            taskEXIT_CRITICAL();
+
+            vTaskDelay(pdMS_TO_TICKS(BENCH_ARM_POLL_MS));
+            last_wake = xTaskGetTickCount();
+            continue;
+        }
+
+        if (pressed == 0u)
+        {
+            start_us = host_time_us();
+        }
+        pressed++;
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(period_ms));
+    }
+
+    drain_start_ms = (uint32_t)(host_time_us() / 1000u);
+    while ((sample_count < pressed) &&
+           ((uint32_t)(host_time_us() / 1000u) - drain_start_ms) < BENCH_DRAIN_TIMEOUT_MS)
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    bench_report(pressed, host_time_us() - start_us);
+    exit((sample_count == pressed) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/******************************************************************************
+ * Function Name: bench_report
+ ******************************************************************************
+ * Summary:
+ *  Prints throughput and round-trip latency percentiles in a form that is
+ *  easy to grep from CI logs.
+ *
+ ******************************************************************************/
+static void bench_report(uint32_t pressed, uint64_t elapsed_us)
+{
+    uint32_t count = sample_count;
+    char name[BENCH_REPORT_NAME_SIZE];
+    reconnect_stats_t reconnects;
+    mqtt_task_control_stats_t control;
+    mqtt_connection_stats_t connection;
+#if ENABLE_BROKER_FAILOVER
+    broker_failover_stats_t failover;
+    broker_failover_broker_t broker;
+#endif /* ENABLE_BROKER_FAILOVER */
+#if ENABLE_DNS_CACHE
+    dns_cache_stats_t dns;
+#endif /* ENABLE_DNS_CACHE */
+    publish_outbox_stats_t outbox;
+    publisher_rate_stats_t rate;
+    publisher_compression_stats_t compression;
+    task_monitor_stats_t monitor;
+    buffer_profile_stats_t buffers;
+    app_log_stats_t log;
+
+    (void) app_log_flush(BENCH_LOG_FLUSH_TIMEOUT_MS);
+    printf("\n[host-bench] presses=%u round_trips=%u lost=%u elapsed_ms=%llu\n",
+           (unsigned) pressed, (unsigned) count, (unsigned)(pressed - count),
+           (unsigned long long)(elapsed_us / 1000u));
+
+    if (count == 0u)
+    {
+        return;
+    }
+
+    qsort(samples, count, sizeof(samples[0]), compare_u32);
+    printf("[host-bench] throughput_msg_per_s=%.1f\n",
+           (elapsed_us > 0u) ? ((double) count * 1e6 / (double) elapsed_us) : 0.0);
+    BENCH_PRINT_FIELDS("rtt_us",
+                       { "min=", samples[0] },
+                       { "p50=", samples[(count * 50u) / 100u] },
+                       { "p90=", samples[(count * 90u) / 100u] },
+                       { "p99=", samples[(count * 99u) / 100u] },
+                       { "max=", samples[count - 1u] });
+
+    for (uint32_t stage = 0; stage < PUBLISH_STAGE_COUNT; stage++)
+    {
+        static const char *const stage_names[PUBLISH_STAGE_COUNT] =
+        {
+            "queue", "dispatch", "network", "total"
+        };
+        publish_latency_stats_t stats;
+
+        if (publish_latency_get_stats((publish_stage_t) stage, &stats))
+        {
+            (void) snprintf(name, sizeof(name), "publish_%s_us", stage_names[stage]);
+            BENCH_PRINT_FIELDS(name,
+                               { "n=", stats.count },
+                               { "mean=", stats.mean_us },
+                               { "p50<=", stats.p50_us },
+                               { "p99<=", stats.p99_us },
+                               { "max=", stats.max_us });
+        }
+    }
+
+    reconnect_get_stats(&reconnects);
+    if ((reconnects.episodes + reconnects.failed_episodes) > 0u)
+    {
+        BENCH_PRINT_FIELDS("reconnect_ms",
+                           { "n=", reconnects.episodes },
+                           { "failed=", reconnects.failed_episodes },
+                           { "mean=", reconnects.mean_duration_ms },
+                           { "p99<=", reconnects.p99_duration_ms },
+                           { "max=", reconnects.max_duration_ms },
+                           { "wifi_attempts=", reconnects.total_attempts[RECONNECT_LINK_WIFI] },
+                           { "mqtt_attempts=", reconnects.total_attempts[RECONNECT_LINK_MQTT] });
+    }
+
+    mqtt_task_get_control_stats(&control);
+    BENCH_PRINT_FIELDS("control",
+                       { "disconnects=", control.raised[HANDLE_DISCONNECTION] },
+                       { "coalesced=", control.coalesced[HANDLE_DISCONNECTION] },
+                       { "reconnect_cycles=", control.reconnect_cycles },
+                       { "stale_disconnects=", control.stale_disconnects },
+                       { "dropped=", control.dropped });
+
+    for (uint32_t id = 0; mqtt_task_get_connection_stats((mqtt_connection_id_t) id, &connection); id++)
+    {
+        BENCH_PRINT_FIELDS("connection",
+                           { "id=", id },
+                           { "connected=", connection.connected },
+                           { "buffer=", connection.network_buffer_size },
+                           { "static=", connection.static_bytes },
+                           { "create_heap=", connection.create_heap_bytes },
+                           { "connect_heap=", connection.connect_heap_bytes },
+                           { "connects=", connection.connects },
+                           { "disconnects=", connection.disconnects },
+                           { "last_connect_ms=", connection.last_connect_ms });
+    }
+
+#if ENABLE_BROKER_FAILOVER
+    broker_failover_get_stats(&failover);
+    BENCH_PRINT_FIELDS("failover",
+                       { "rankings=", failover.rankings },
+                       { "leader_changes=", failover.leader_changes },
+                       { "truncated=", failover.truncated_rankings },
+                       { "failovers=", failover.failovers });
+    for (uint32_t rank = 0; broker_failover_get_broker(rank, &broker); rank++)
+    {
+        (void) snprintf(name, sizeof(name), "broker rank=%u host=%.*s:%u", (unsigned) rank,
+                        (int) broker.info->hostname_len, broker.info->hostname,
+                        (unsigned) broker.info->port);
+        BENCH_PRINT_FIELDS(name,
+                           { "reachable=", broker.reachable },
+                           { "srtt_ms=", broker.srtt_ms },
+                           { "last_rtt_ms=", broker.last_rtt_ms },
+                           { "probes=", broker.probes },
+                           { "failed_probes=", broker.failed_probes });
+    }
+#endif /* ENABLE_BROKER_FAILOVER */
+
+#if ENABLE_DNS_CACHE
+    dns_cache_get_stats(&dns);
+    BENCH_PRINT_FIELDS("dns",
+                       { "hits=", dns.hits },
+                       { "stale_hits=", dns.stale_hits },
+                       { "misses=", dns.misses },
+                       { "failures=", dns.failures },
+                       { "bypassed=", dns.bypassed },
+                       { "refreshes=", dns.refreshes },
+                       { "evictions=", dns.evictions },
+                       { "resolve_mean_ms=", dns.resolve_mean_ms },
+                       { "saved_ms=", dns.saved_ms });
+#endif /* ENABLE_DNS_CACHE */
+
+    publisher_get_outbox_stats(&outbox);
+    if (outbox.stored > 0u)
+    {
+        BENCH_PRINT_FIELDS("outbox",
+                           { "stored=", outbox.stored },
+                           { "flushed=", outbox.flushed },
+                           { "dropped_overflow=", outbox.dropped_overflow },
+                           { "dropped_oversize=", outbox.dropped_oversize },
+                           { "peak_depth=", outbox.peak_depth },
+                           { "latency_ms p50<=", log2_histogram_percentile(&outbox.flush_latency_ms, 50u) },
+                           { "p99<=", log2_histogram_percentile(&outbox.flush_latency_ms, 99u) },
+                           { "max=", outbox.flush_latency_ms.max });
+    }
+
+    publisher_get_rate_stats(&rate);
+    BENCH_PRINT_FIELDS("rate",
+                       { "passed=", rate.limiter.passed },
+                       { "throttled=", rate.limiter.throttled },
+                       { "max_wait_ms=", rate.limiter.max_wait_ms },
+                       { "throttle_ms=", rate.throttle_ms },
+                       { "would_block=", rate.would_block },
+                       { "dropped=", rate.dropped });
+
+    publisher_get_compression_stats(&compression);
+    if (compression.bytes_in > 0u)
+    {
+        BENCH_PRINT_FIELDS("compress",
+                           { "lz=", compression.compressed },
+                           { "stored=", compression.stored },
+                           { "raw=", compression.raw },
+                           { "too_large=", compression.too_large },
+                           { "bytes_in=", compression.bytes_in },
+                           { "bytes_out=", compression.bytes_out });
+    }
+
+    task_monitor_get_stats(&monitor);
+    BENCH_PRINT_FIELDS("monitor",
+                       { "snapshots=", monitor.snapshots },
+                       { "published=", monitor.published },
+                       { "truncated=", monitor.truncated });
+
+    buffer_profile_get_stats(&buffers);
+    BENCH_PRINT_FIELDS("buffer",
+                       { "size=", buffers.buffer_size },
+                       { "max_in=", buffers.packets[BUFFER_PROFILE_INCOMING].max },
+                       { "p99_in<=", log2_histogram_percentile(&buffers.packets[BUFFER_PROFILE_INCOMING], 99u) },
+                       { "max_out=", buffers.packets[BUFFER_PROFILE_OUTGOING].max },
+                       { "p99_out<=", log2_histogram_percentile(&buffers.packets[BUFFER_PROFILE_OUTGOING], 99u) },
+                       { "persisted_max=", buffers.persisted_max },
+                       { "oversize=", buffers.oversize },
+                       { "saves=", buffers.saves });
+
+    heap_usage_dump();
+    (void) app_log_flush(BENCH_LOG_FLUSH_TIMEOUT_MS);
+
+    app_log_get_stats(&log);
+    BENCH_PRINT_FIELDS("log",
+                       { "written=", log.written },
+                       { "dropped=", log.dropped },
+                       { "truncated=", log.truncated },
+                       { "high_water=", log.high_water });
+}
+
+/******************************************************************************
+ * Function Name: bench_print_fields
+ ******************************************************************************
+ * Summary:
+ *  Prints a report line: the name followed by the counters, separated by
+ *  spaces.
+ *
+ ******************************************************************************/
+static void bench_print_fields(const char *name, const bench_field_t *fields, size_t count)
+{
+    printf("[host-bench] %s", name);
+    for (size_t i = 0; i < count; i++)
+    {
+        printf(" %s%u", fields[i].key, (unsigned) fields[i].value);
+    }
+    printf("\n");
+}
+
+/* [] END OF FILE */
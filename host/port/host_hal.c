@@ -0,0 +1,177 @@
+/******************************************************************************
+* File Name:   host_hal.c
+*
+* Description: Host (Linux) implementation of the HAL, BSP, and retarget-io
+*              subset used by the example. The user button and LED are
+*              virtual pins driven by the benchmark harness.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <arpa/inet.h>
+
+#include "cyhal.h"
+#include "cybsp.h"
+#include "cy_retarget_io.h"
+#include "lwip/netif.h"
+
+#include "host_port.h"
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Callback registered for the user button and whether its event is enabled. */
+static cyhal_gpio_callback_data_t *button_callback_data;
+static volatile bool button_event_enabled;
+
+/******************************************************************************
+ * Function Name: cybsp_init
+ ******************************************************************************
+ * Summary:
+ *  Board initialization. On the host, this only starts the benchmark harness
+ *  so that main.c can be used unchanged.
+ *
+ ******************************************************************************/
+cy_rslt_t cybsp_init(void)
+{
+    /* Line-buffer stdout so that interleaved task output stays readable. */
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    host_bench_start();
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_retarget_io_init(cyhal_gpio_t tx, cyhal_gpio_t rx, uint32_t baudrate)
+{
+    (void) tx;
+    (void) rx;
+    (void) baudrate;
+    return CY_RSLT_SUCCESS;
+}
+
+void cy_retarget_io_deinit(void)
+{
+}
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val)
+{
+    (void) pin;
+    (void) direction;
+    (void) drive_mode;
+    (void) init_val;
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_gpio_free(cyhal_gpio_t pin)
+{
+    if (pin == CYBSP_USER_BTN)
+    {
+        button_event_enabled = false;
+    }
+}
+
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value)
+{
+    host_bench_on_gpio_write(pin, value);
+}
+
+bool cyhal_gpio_read(cyhal_gpio_t pin)
+{
+    (void) pin;
+    return CYBSP_BTN_OFF;
+}
+
+void cyhal_gpio_register_callback(cyhal_gpio_t pin,
+                                  cyhal_gpio_callback_data_t *callback_data)
+{
+    if (pin == CYBSP_USER_BTN)
+    {
+        button_callback_data = callback_data;
+    }
+}
+
+void cyhal_gpio_enable_event(cyhal_gpio_t pin, cyhal_gpio_event_t event,
+                             uint8_t intr_priority, bool enable)
+{
+    (void) event;
+    (void) intr_priority;
+
+    if (pin == CYBSP_USER_BTN)
+    {
+        button_event_enabled = enable;
+    }
+}
+
+/******************************************************************************
+ * Function Name: host_hal_press_button
+ ******************************************************************************
+ * Summary:
+ *  Invokes the registered user button callback as the GPIO interrupt would
+ *  on a falling edge.
+ *
+ * Return:
+ *  bool : true if the callback was invoked, false if the button interrupt is
+ *         currently disabled.
+ *
+ ******************************************************************************/
+bool host_hal_press_button(void)
+{
+    cyhal_gpio_callback_data_t *cb = button_callback_data;
+
+    if ((!button_event_enabled) || (cb == NULL) || (cb->callback == NULL))
+    {
+        return false;
+    }
+
+    cb->callback(cb->callback_arg, CYHAL_GPIO_IRQ_FALL);
+    return true;
+}
+
+char *ip4addr_ntoa(const ip4_addr_t *addr)
+{
+    static char str[INET_ADDRSTRLEN];
+    return (char *) inet_ntop(AF_INET, &addr->addr, str, sizeof(str));
+}
+
+char *ip6addr_ntoa(const ip6_addr_t *addr)
+{
+    static char str[INET6_ADDRSTRLEN];
+    return (char *) inet_ntop(AF_INET6, addr->addr, str, sizeof(str));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,76 @@
+/******************************************************************************
+* File Name:   host_port.h
+*
+* Description: Internal interface shared between the host (Linux) port files:
+*              the benchmark harness, the HAL and Wi-Fi stand-ins, and the
+*              socket layer.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOST_PORT_H_
+#define HOST_PORT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cyhal.h"
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+/* Monotonic time in microseconds. */
+uint64_t host_time_us(void);
+
+/* Benchmark harness (host_bench.c). */
+void host_bench_start(void);
+void host_bench_on_gpio_write(cyhal_gpio_t pin, bool value);
+
+/* HAL stand-in (host_hal.c): raise the user button interrupt. Returns false
+ * if the publisher has not enabled the button interrupt yet.
+ */
+bool host_hal_press_button(void);
+
+/* Wi-Fi stand-in (host_wcm.c): bring the simulated AP link up or down. */
+void host_wcm_set_link(bool up);
+
+/* Socket layer (host_sockets.c): reset all open connections, as a real link
+ * loss would.
+ */
+void host_sockets_drop_all(void);
+
+#endif /* HOST_PORT_H_ */
+
+/* [] END OF FILE */
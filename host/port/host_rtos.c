@@ -0,0 +1,110 @@
+/******************************************************************************
+* File Name:   host_rtos.c
+*
+* Description: Host (Linux) FreeRTOS application hooks: memory for the idle
+*              and timer tasks, and a wrapper around xTaskCreate() that
+*              scales task stacks up to what a pthread on the POSIX port
+*              needs.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* glibc's stdio alone needs more than the 1-2 KB stacks sized for the target;
+ * every stack depth requested through xTaskCreate() is multiplied by this
+ * factor and raised to at least configMINIMAL_STACK_SIZE.
+ */
+#define HOST_STACK_SCALE                    (8u)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+BaseType_t __real_xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName,
+                              const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters,
+                              UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask);
+
+/******************************************************************************
+ * Function Name: __wrap_xTaskCreate
+ ******************************************************************************
+ * Summary:
+ *  Linked in place of xTaskCreate() (-Wl,--wrap=xTaskCreate) so that the
+ *  example and the libraries keep their target stack sizes in the source.
+ *
+ ******************************************************************************/
+BaseType_t __wrap_xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName,
+                              const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters,
+                              UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    configSTACK_DEPTH_TYPE depth = usStackDepth * HOST_STACK_SCALE;
+
+    if (depth < configMINIMAL_STACK_SIZE)
+    {
+        depth = configMINIMAL_STACK_SIZE;
+    }
+
+    return __real_xTaskCreate(pxTaskCode, pcName, depth, pvParameters, uxPriority, pxCreatedTask);
+}
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t idle_tcb;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+    *ppxIdleTaskTCBBuffer = &idle_tcb;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    static StaticTask_t timer_tcb;
+    static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+
+    *ppxTimerTaskTCBBuffer = &timer_tcb;
+    *ppxTimerTaskStackBuffer = timer_stack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+/* [] END OF FILE */
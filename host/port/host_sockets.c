@@ -0,0 +1,577 @@
+/******************************************************************************
+* File Name:   host_sockets.c
+*
+* Description: Host (Linux) implementation of the secure sockets API on top
+*              of BSD sockets. Only plain TCP is supported; the MQTT
+*              library's transport port runs on it unchanged. Sockets are
+*              non-blocking and waits are done with vTaskDelay() so that the
+*              FreeRTOS POSIX port keeps scheduling while a task waits on the
+*              network.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "cy_secure_sockets.h"
+#include "host_port.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Maximum number of sockets open at the same time. */
+#define HOST_MAX_SOCKETS                    (8u)
+
+/* Send and receive timeout used until the socket user configures one. */
+#define HOST_DEFAULT_TIMEOUT_MS             (10000u)
+
+/* Upper bound for a TCP connect to complete. */
+#define HOST_CONNECT_TIMEOUT_MS             (10000u)
+
+/* Period of the task that turns readable/closed sockets into callbacks. */
+#define HOST_SOCKET_POLL_PERIOD_MS          (1u)
+
+#define HOST_SOCKET_TASK_PRIORITY           (configMAX_PRIORITIES - 1)
+#define HOST_SOCKET_TASK_STACK_SIZE         (configMINIMAL_STACK_SIZE)
+
+/* Environment variable that overrides the broker address, see README.md. */
+#define HOST_BROKER_ENV                     "MQTT_HOST_BROKER"
+#define HOST_BROKER_DEFAULT                 "127.0.0.1"
+#define HOST_BROKER_USE_CONFIGURED          "configured"
+
+/******************************************************************************
+* Data types
+******************************************************************************/
+typedef struct
+{
+    bool in_use;
+    int fd;
+    bool connected;
+    bool nonblocking;
+    uint32_t recv_timeout_ms;
+    uint32_t send_timeout_ms;
+    cy_socket_opt_callback_t receive_cb;
+    cy_socket_opt_callback_t disconnect_cb;
+    volatile bool rx_signalled;
+    volatile bool close_signalled;
+} host_socket_t;
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+static host_socket_t sockets[HOST_MAX_SOCKETS];
+static SemaphoreHandle_t sockets_mutex;
+static TaskHandle_t socket_task_handle;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void host_socket_task(void *arg);
+static bool wait_ms(uint32_t start_ms, uint32_t timeout_ms);
+static uint32_t now_ms(void);
+
+static uint32_t now_ms(void)
+{
+    return (uint32_t)(host_time_us() / 1000u);
+}
+
+/* Yields for one tick. Returns false once 'timeout_ms' has elapsed. */
+static bool wait_ms(uint32_t start_ms, uint32_t timeout_ms)
+{
+    if ((uint32_t)(now_ms() - start_ms) >= timeout_ms)
+    {
+        return false;
+    }
+    vTaskDelay(1);
+    return true;
+}
+
+cy_rslt_t cy_socket_init(void)
+{
+    if (sockets_mutex == NULL)
+    {
+        sockets_mutex = xSemaphoreCreateMutex();
+        if (sockets_mutex == NULL)
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+        }
+    }
+
+    if ((socket_task_handle == NULL) &&
+        (pdPASS != xTaskCreate(host_socket_task, "Host sockets", HOST_SOCKET_TASK_STACK_SIZE,
+                               NULL, HOST_SOCKET_TASK_PRIORITY, &socket_task_handle)))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_deinit(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_create(int domain, int type, int protocol, cy_socket_t *handle)
+{
+    cy_rslt_t result = CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+
+    if ((handle == NULL) || (domain != CY_SOCKET_DOMAIN_AF_INET) ||
+        (type != CY_SOCKET_TYPE_STREAM))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    /* TLS is not available on the host; the broker must be plain TCP. */
+    if (protocol != CY_SOCKET_IPPROTO_TCP)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_PROTOCOL_NOT_SUPPORTED;
+    }
+
+    xSemaphoreTake(sockets_mutex, portMAX_DELAY);
+    for (uint32_t i = 0; i < HOST_MAX_SOCKETS; i++)
+    {
+        if (!sockets[i].in_use)
+        {
+            int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            int one = 1;
+
+            if (fd < 0)
+            {
+                result = CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR;
+                break;
+            }
+
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            memset(&sockets[i], 0, sizeof(sockets[i]));
+            sockets[i].in_use = true;
+            sockets[i].fd = fd;
+            sockets[i].recv_timeout_ms = HOST_DEFAULT_TIMEOUT_MS;
+            sockets[i].send_timeout_ms = HOST_DEFAULT_TIMEOUT_MS;
+            *handle = (cy_socket_t) &sockets[i];
+            result = CY_RSLT_SUCCESS;
+            break;
+        }
+    }
+    xSemaphoreGive(sockets_mutex);
+
+    return result;
+}
+
+cy_rslt_t cy_socket_setsockopt(cy_socket_t handle, int level, int optname,
+                               const void *optval, uint32_t optlen)
+{
+    host_socket_t *sock = (host_socket_t *) handle;
+
+    (void) optlen;
+
+    if ((sock == NULL) || (optval == NULL))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    /* Options that have no meaning on the host are accepted and ignored. */
+    if (level != CY_SOCKET_SOL_SOCKET)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    switch (optname)
+    {
+        case CY_SOCKET_SO_RCVTIMEO:
+            sock->recv_timeout_ms = *(const uint32_t *) optval;
+            break;
+
+        case CY_SOCKET_SO_SNDTIMEO:
+            sock->send_timeout_ms = *(const uint32_t *) optval;
+            break;
+
+        case CY_SOCKET_SO_NONBLOCK:
+            sock->nonblocking = (*(const uint32_t *) optval != 0u);
+            break;
+
+        case CY_SOCKET_SO_RECEIVE_CALLBACK:
+            sock->receive_cb = *(const cy_socket_opt_callback_t *) optval;
+            break;
+
+        case CY_SOCKET_SO_DISCONNECT_CALLBACK:
+            sock->disconnect_cb = *(const cy_socket_opt_callback_t *) optval;
+            break;
+
+        default:
+            break;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_getsockopt(cy_socket_t handle, int level, int optname,
+                               void *optval, uint32_t *optlen)
+{
+    host_socket_t *sock = (host_socket_t *) handle;
+
+    if ((sock == NULL) || (optval == NULL) || (optlen == NULL) ||
+        (level != CY_SOCKET_SOL_SOCKET) || (*optlen < sizeof(uint32_t)))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    switch (optname)
+    {
+        case CY_SOCKET_SO_RCVTIMEO:
+            *(uint32_t *) optval = sock->recv_timeout_ms;
+            break;
+
+        case CY_SOCKET_SO_SNDTIMEO:
+            *(uint32_t *) optval = sock->send_timeout_ms;
+            break;
+
+        default:
+            return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    *optlen = sizeof(uint32_t);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_connect(cy_socket_t handle, cy_socket_sockaddr_t *address,
+                            uint32_t address_length)
+{
+    host_socket_t *sock = (host_socket_t *) handle;
+    struct sockaddr_in addr;
+    uint32_t start_ms = now_ms();
+
+    (void) address_length;
+
+    if ((sock == NULL) || (address == NULL) ||
+        (address->ip_address.version != CY_SOCKET_IP_VER_V4))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(address->port);
+    addr.sin_addr.s_addr = address->ip_address.ip.v4;
+
+    if ((connect(sock->fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) &&
+        (errno != EINPROGRESS))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR;
+    }
+
+    while (true)
+    {
+        struct pollfd pfd = { .fd = sock->fd, .events = POLLOUT };
+        int err = 0;
+        socklen_t err_len = sizeof(err);
+
+        if (poll(&pfd, 1, 0) > 0)
+        {
+            getsockopt(sock->fd, SOL_SOCKET, SO_ERROR, &err, &err_len);
+            if (err != 0)
+            {
+                return CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR;
+            }
+            sock->connected = true;
+            return CY_RSLT_SUCCESS;
+        }
+
+        if (!wait_ms(start_ms, HOST_CONNECT_TIMEOUT_MS))
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+        }
+    }
+}
+
+cy_rslt_t cy_socket_disconnect(cy_socket_t handle, uint32_t timeout)
+{
+    host_socket_t *sock = (host_socket_t *) handle;
+
+    (void) timeout;
+
+    if (sock == NULL)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    sock->connected = false;
+    shutdown(sock->fd, SHUT_RDWR);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_send(cy_socket_t handle, const void *buffer, uint32_t length,
+                         int flags, uint32_t *bytes_sent)
+{
+    host_socket_t *sock = (host_socket_t *) handle;
+    uint32_t sent = 0;
+    uint32_t start_ms = now_ms();
+
+    (void) flags;
+
+    if ((sock == NULL) || (buffer == NULL) || (bytes_sent == NULL))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    *bytes_sent = 0;
+    if (!sock->connected)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOT_CONNECTED;
+    }
+
+    while (sent < length)
+    {
+        ssize_t n = send(sock->fd, (const uint8_t *) buffer + sent, length - sent,
+                         MSG_DONTWAIT | MSG_NOSIGNAL);
+
+        if (n > 0)
+        {
+            sent += (uint32_t) n;
+            continue;
+        }
+        if ((n < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        {
+            *bytes_sent = sent;
+            return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+        }
+        if (sock->nonblocking || !wait_ms(start_ms, sock->send_timeout_ms))
+        {
+            break;
+        }
+    }
+
+    *bytes_sent = sent;
+    return ((sent == 0u) && (length > 0u)) ? CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT : CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_recv(cy_socket_t handle, void *buffer, uint32_t length,
+                         int flags, uint32_t *bytes_received)
+{
+    host_socket_t *sock = (host_socket_t *) handle;
+    uint32_t start_ms = now_ms();
+
+    (void) flags;
+
+    if ((sock == NULL) || (buffer == NULL) || (bytes_received == NULL))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    *bytes_received = 0;
+    if (!sock->connected)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOT_CONNECTED;
+    }
+
+    while (true)
+    {
+        ssize_t n;
+
+        /* Re-arm the receive callback before draining, so that data arriving
+         * after this call is signalled again by the socket task.
+         */
+        sock->rx_signalled = false;
+        n = recv(sock->fd, buffer, length, MSG_DONTWAIT);
+
+        if (n > 0)
+        {
+            *bytes_received = (uint32_t) n;
+            return CY_RSLT_SUCCESS;
+        }
+        if (n == 0)
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+        }
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+        }
+        if (sock->nonblocking || !wait_ms(start_ms, sock->recv_timeout_ms))
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+        }
+    }
+}
+
+cy_rslt_t cy_socket_gethostbyname(const char *hostname, cy_socket_ip_version_t ip_ver,
+                                  cy_socket_ip_address_t *addr)
+{
+    struct addrinfo hints;
+    struct addrinfo *info = NULL;
+    const char *broker = getenv(HOST_BROKER_ENV);
+
+    if ((hostname == NULL) || (addr == NULL) || (ip_ver != CY_SOCKET_IP_VER_V4))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    /* Point the example at the local broker unless told otherwise. */
+    if (broker == NULL)
+    {
+        broker = HOST_BROKER_DEFAULT;
+    }
+    if (strcmp(broker, HOST_BROKER_USE_CONFIGURED) != 0)
+    {
+        hostname = broker;
+    }
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if ((getaddrinfo(hostname, NULL, &hints, &info) != 0) || (info == NULL))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_HOST_NOT_FOUND;
+    }
+
+    memset(addr, 0, sizeof(*addr));
+    addr->version = CY_SOCKET_IP_VER_V4;
+    addr->ip.v4 = ((struct sockaddr_in *) info->ai_addr)->sin_addr.s_addr;
+    freeaddrinfo(info);
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_delete(cy_socket_t handle)
+{
+    host_socket_t *sock = (host_socket_t *) handle;
+
+    if (sock == NULL)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    xSemaphoreTake(sockets_mutex, portMAX_DELAY);
+    close(sock->fd);
+    memset(sock, 0, sizeof(*sock));
+    xSemaphoreGive(sockets_mutex);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/******************************************************************************
+ * Function Name: host_sockets_drop_all
+ ******************************************************************************
+ * Summary:
+ *  Resets every connected socket. The peers see the connection go away and
+ *  the local users get their disconnect callbacks from the socket task.
+ *
+ ******************************************************************************/
+void host_sockets_drop_all(void)
+{
+    for (uint32_t i = 0; i < HOST_MAX_SOCKETS; i++)
+    {
+        if (sockets[i].in_use && sockets[i].connected)
+        {
+            shutdown(sockets[i].fd, SHUT_RDWR);
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: host_socket_task
+ ******************************************************************************
+ * Summary:
+ *  Stands in for the network stack thread: invokes the receive callback once
+ *  per batch of readable data and the disconnect callback once when the peer
+ *  closes the connection.
+ *
+ ******************************************************************************/
+static void host_socket_task(void *arg)
+{
+    (void) arg;
+
+    while (true)
+    {
+        for (uint32_t i = 0; i < HOST_MAX_SOCKETS; i++)
+        {
+            host_socket_t *sock = &sockets[i];
+            cy_socket_opt_callback_t cb = { 0 };
+            struct pollfd pfd;
+            uint8_t peek;
+            ssize_t n;
+
+            xSemaphoreTake(sockets_mutex, portMAX_DELAY);
+            if (sock->in_use && sock->connected && !sock->close_signalled)
+            {
+                pfd.fd = sock->fd;
+                pfd.events = POLLIN;
+                pfd.revents = 0;
+
+                if (poll(&pfd, 1, 0) > 0)
+                {
+                    n = recv(sock->fd, &peek, sizeof(peek), MSG_PEEK | MSG_DONTWAIT);
+                    if ((n > 0) && !sock->rx_signalled)
+                    {
+                        sock->rx_signalled = true;
+                        cb = sock->receive_cb;
+                    }
+                    else if ((n == 0) ||
+                             ((n < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK)))
+                    {
+                        sock->close_signalled = true;
+                        cb = sock->disconnect_cb;
+                    }
+                }
+            }
+            xSemaphoreGive(sockets_mutex);
+
+            if (cb.callback != NULL)
+            {
+                cb.callback((cy_socket_t) sock, cb.arg);
+            }
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(HOST_SOCKET_POLL_PERIOD_MS));
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name:   host_tls_stubs.c
+*
+* Description: Host (Linux) placeholders for the TLS identity functions
+*              referenced by the MQTT library's transport port. TLS is not
+*              supported by the host socket layer, so every call fails.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdint.h>
+#include "cy_result.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define HOST_TLS_UNSUPPORTED                \
+            CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x7F)
+
+/* The prototypes are intentionally not taken from cy_tls.h: the transport
+ * port only needs the symbols to link, and the calls are unreachable as long
+ * as MQTT_SECURE_CONNECTION is 0.
+ */
+cy_rslt_t cy_tls_create_identity(const char *certificate_data, const uint32_t certificate_len,
+                                 const char *private_key, uint32_t private_key_len,
+                                 void **tls_identity)
+{
+    (void) certificate_data;
+    (void) certificate_len;
+    (void) private_key;
+    (void) private_key_len;
+    (void) tls_identity;
+    return HOST_TLS_UNSUPPORTED;
+}
+
+cy_rslt_t cy_tls_delete_identity(void *tls_identity)
+{
+    (void) tls_identity;
+    return HOST_TLS_UNSUPPORTED;
+}
+
+cy_rslt_t cy_tls_load_global_root_ca_certificates(const char *trusted_ca_certificates,
+                                                  const uint32_t cert_length)
+{
+    (void) trusted_ca_certificates;
+    (void) cert_length;
+    return HOST_TLS_UNSUPPORTED;
+}
+
+cy_rslt_t cy_tls_release_global_root_ca_certificates(void)
+{
+    return HOST_TLS_UNSUPPORTED;
+}
+
+/* [] END OF FILE */
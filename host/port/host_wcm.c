@@ -0,0 +1,135 @@
+/******************************************************************************
+* File Name:   host_wcm.c
+*
+* Description: Host (Linux) implementation of the Wi-Fi Connection Manager
+*              subset used by the example. The simulated AP is reachable
+*              unless the benchmark harness takes the link down.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+#include "cy_wcm.h"
+#include "host_port.h"
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* State of the simulated AP link and of the station association. */
+static volatile bool link_up = true;
+static volatile bool associated = false;
+
+cy_rslt_t cy_wcm_init(cy_wcm_config_t *config)
+{
+    (void) config;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_wcm_deinit(void)
+{
+    associated = false;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_wcm_connect_ap(cy_wcm_connect_params_t *connect_params,
+                            cy_wcm_ip_address_t *ip_addr)
+{
+    (void) connect_params;
+
+    if (!link_up)
+    {
+        return CY_RSLT_WCM_CONNECT_FAILED;
+    }
+
+    associated = true;
+    if (ip_addr != NULL)
+    {
+        memset(ip_addr, 0, sizeof(*ip_addr));
+        ip_addr->version = CY_WCM_IP_VER_V4;
+        ip_addr->ip.v4 = htonl(INADDR_LOOPBACK);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_wcm_disconnect_ap(void)
+{
+    associated = false;
+    return CY_RSLT_SUCCESS;
+}
+
+uint8_t cy_wcm_is_connected_to_ap(void)
+{
+    return (link_up && associated) ? 1u : 0u;
+}
+
+cy_rslt_t cy_wcm_get_mac_addr(cy_wcm_interface_t interface_type, cy_wcm_mac_t *mac_addr)
+{
+    /* Derive a locally administered MAC address that is stable per machine. */
+    uint32_t host_id = (uint32_t) gethostid();
+
+    (void) interface_type;
+    (*mac_addr)[0] = 0x02u;
+    (*mac_addr)[1] = 0x00u;
+    (*mac_addr)[2] = (uint8_t)(host_id >> 24);
+    (*mac_addr)[3] = (uint8_t)(host_id >> 16);
+    (*mac_addr)[4] = (uint8_t)(host_id >> 8);
+    (*mac_addr)[5] = (uint8_t)(host_id);
+    return CY_RSLT_SUCCESS;
+}
+
+/******************************************************************************
+ * Function Name: host_wcm_set_link
+ ******************************************************************************
+ * Summary:
+ *  Brings the simulated AP link up or down. Taking the link down drops the
+ *  association and resets every open connection.
+ *
+ ******************************************************************************/
+void host_wcm_set_link(bool up)
+{
+    link_up = up;
+    if (!up)
+    {
+        associated = false;
+        host_sockets_drop_all();
+    }
+}
+
+/* [] END OF FILE */
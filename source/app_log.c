@@ -0,0 +1,408 @@
+/******************************************************************************
+* File Name:   app_log.c
+*
+* Description: This file implements the deferred log: log calls format their
+*              line into a lock-free ring and return; a drain task of the
+*              lowest priority prints the lines on the debug UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+#include "app_log.h"
+#include "static_alloc.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define LOAD_ACQUIRE(ptr)               __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(ptr, value)       __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+
+#if ENABLE_DEFERRED_LOGGING
+#define APP_LOG_LINE_MASK               (APP_LOG_LINE_COUNT - 1u)
+
+/* Time between two checks of app_log_flush(). */
+#define APP_LOG_FLUSH_POLL_MS           (10u)
+#endif /* ENABLE_DEFERRED_LOGGING */
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if ENABLE_DEFERRED_LOGGING
+/* A line of the ring. 'seq' tells who owns the slot: it equals the position a
+ * producer may claim it at, that position + 1 once the line is written, and
+ * the position + APP_LOG_LINE_COUNT once the drain task printed it.
+ */
+typedef struct
+{
+    volatile uint32_t seq;
+    uint32_t len;
+    char text[APP_LOG_LINE_SIZE];
+} log_line_t;
+
+static log_line_t log_lines[APP_LOG_LINE_COUNT];
+
+/* Positions ever claimed by the producers and printed by the drain task. */
+static volatile uint32_t enqueue_pos;
+static volatile uint32_t dequeue_pos;
+
+static volatile app_log_stats_t log_stats;
+
+static TaskHandle_t app_log_task_handle = NULL;
+
+#if ENABLE_STATIC_ALLOCATION
+/* Static storage of the drain task. */
+static StackType_t app_log_task_stack[STATIC_ALLOC_STACK_DEPTH(APP_LOG_TASK_STACK_SIZE)];
+static StaticTask_t app_log_task_tcb;
+#endif /* ENABLE_STATIC_ALLOCATION */
+#endif /* ENABLE_DEFERRED_LOGGING */
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if ENABLE_DEFERRED_LOGGING
+static bool compare_and_swap(volatile uint32_t *target, uint32_t expected, uint32_t desired);
+static void atomic_increment(volatile uint32_t *counter);
+static void app_log_task(void *pvParameters);
+static void drain_lines(void);
+#endif /* ENABLE_DEFERRED_LOGGING */
+
+#if ENABLE_DEFERRED_LOGGING
+/******************************************************************************
+ * Function Name: compare_and_swap
+ ******************************************************************************
+ * Summary:
+ *  Atomically replaces '*target' by 'desired' if it equals 'expected'. As in
+ *  spsc_ring.c, ARMv6-M (CM0+) masks interrupts for a few instructions
+ *  instead.
+ *
+ ******************************************************************************/
+static bool compare_and_swap(volatile uint32_t *target, uint32_t expected, uint32_t desired)
+{
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask;
+    bool swapped = false;
+
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+    if (*target == expected)
+    {
+        *target = desired;
+        swapped = true;
+    }
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+
+    return swapped;
+#else
+    return __atomic_compare_exchange_n(target, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif /* defined(__ARM_ARCH_6M__) */
+}
+
+/******************************************************************************
+ * Function Name: atomic_increment
+ ******************************************************************************
+ * Summary:
+ *  Increments a counter shared by the producers.
+ *
+ ******************************************************************************/
+static void atomic_increment(volatile uint32_t *counter)
+{
+    uint32_t value;
+
+    do
+    {
+        value = LOAD_ACQUIRE(counter);
+    } while (!compare_and_swap(counter, value, value + 1u));
+}
+#endif /* ENABLE_DEFERRED_LOGGING */
+
+/******************************************************************************
+ * Function Name: app_log_init
+ ******************************************************************************
+ * Summary:
+ *  Empties the ring and creates the drain task. Lines written before the
+ *  scheduler starts are printed once it runs.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool : true if the drain task was created, or logging is synchronous
+ *
+ ******************************************************************************/
+bool app_log_init(void)
+{
+#if ENABLE_DEFERRED_LOGGING
+    for (uint32_t i = 0; i < APP_LOG_LINE_COUNT; i++)
+    {
+        log_lines[i].seq = i;
+    }
+    enqueue_pos = 0u;
+    dequeue_pos = 0u;
+
+    return (pdPASS == STATIC_ALLOC_TASK_CREATE(app_log_task, "Log drain task",
+                                               APP_LOG_TASK_STACK_SIZE, NULL,
+                                               APP_LOG_TASK_PRIORITY, &app_log_task_handle,
+                                               app_log_task_stack, &app_log_task_tcb));
+#else
+    return true;
+#endif /* ENABLE_DEFERRED_LOGGING */
+}
+
+/******************************************************************************
+ * Function Name: app_log_write
+ ******************************************************************************
+ * Summary:
+ *  Formats a log line like printf(). With ENABLE_DEFERRED_LOGGING, the line
+ *  is formatted into a slot of the ring claimed with a compare-and-swap and
+ *  the call returns without waiting for the UART; when the ring is full the
+ *  line is dropped and counted. Called from tasks, or before the scheduler
+ *  starts; not from interrupts.
+ *
+ * Parameters:
+ *  const char *format : printf() format string
+ *  ... : Arguments of the format string
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void app_log_write(const char *format, ...)
+{
+    va_list args;
+#if ENABLE_DEFERRED_LOGGING
+    uint32_t pos = LOAD_ACQUIRE(&enqueue_pos);
+    log_line_t *line;
+    int len;
+
+    /* Claim the next free slot. */
+    while (true)
+    {
+        int32_t lag;
+
+        line = &log_lines[pos & APP_LOG_LINE_MASK];
+        lag = (int32_t)(LOAD_ACQUIRE(&line->seq) - pos);
+        if (lag == 0)
+        {
+            if (compare_and_swap(&enqueue_pos, pos, pos + 1u))
+            {
+                break;
+            }
+        }
+        else if (lag < 0)
+        {
+            /* The slot still holds a line that was not printed. */
+            atomic_increment(&log_stats.dropped);
+            return;
+        }
+        pos = LOAD_ACQUIRE(&enqueue_pos);
+    }
+
+    va_start(args, format);
+    len = vsnprintf(line->text, sizeof(line->text), format, args);
+    va_end(args);
+
+    if (len < 0)
+    {
+        len = 0;
+    }
+    else if ((uint32_t) len >= sizeof(line->text))
+    {
+        len = (int)(sizeof(line->text) - 1u);
+        atomic_increment(&log_stats.truncated);
+    }
+    line->len = (uint32_t) len;
+    STORE_RELEASE(&line->seq, pos + 1u);
+    atomic_increment(&log_stats.written);
+
+    /* The drain task sleeps once it reached this slot. */
+    if ((pos == LOAD_ACQUIRE(&dequeue_pos)) && (app_log_task_handle != NULL) &&
+        (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        xTaskNotifyGive(app_log_task_handle);
+    }
+#else
+    va_start(args, format);
+    (void) vprintf(format, args);
+    va_end(args);
+#endif /* ENABLE_DEFERRED_LOGGING */
+}
+
+/******************************************************************************
+ * Function Name: app_log_flush
+ ******************************************************************************
+ * Summary:
+ *  Waits until the drain task printed every line written so far, e.g. before
+ *  other output that must not interleave with the log.
+ *
+ * Parameters:
+ *  uint32_t timeout_ms : Maximum time to wait
+ *
+ * Return:
+ *  bool : true if the ring was drained in time
+ *
+ ******************************************************************************/
+bool app_log_flush(uint32_t timeout_ms)
+{
+#if ENABLE_DEFERRED_LOGGING
+    uint32_t target = LOAD_ACQUIRE(&enqueue_pos);
+    uint32_t waited_ms = 0u;
+
+    while ((int32_t)(target - LOAD_ACQUIRE(&dequeue_pos)) > 0)
+    {
+        if (waited_ms >= timeout_ms)
+        {
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(APP_LOG_FLUSH_POLL_MS));
+        waited_ms += APP_LOG_FLUSH_POLL_MS;
+    }
+#else
+    (void) timeout_ms;
+#endif /* ENABLE_DEFERRED_LOGGING */
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: app_log_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the counters of the deferred log.
+ *
+ * Parameters:
+ *  app_log_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void app_log_get_stats(app_log_stats_t *stats)
+{
+#if ENABLE_DEFERRED_LOGGING
+    stats->written = log_stats.written;
+    stats->dropped = log_stats.dropped;
+    stats->truncated = log_stats.truncated;
+    stats->high_water = log_stats.high_water;
+#else
+    stats->written = 0u;
+    stats->dropped = 0u;
+    stats->truncated = 0u;
+    stats->high_water = 0u;
+#endif /* ENABLE_DEFERRED_LOGGING */
+}
+
+#if ENABLE_DEFERRED_LOGGING
+/******************************************************************************
+ * Function Name: drain_lines
+ ******************************************************************************
+ * Summary:
+ *  Prints the lines written so far, oldest first, and reports the lines
+ *  dropped since the last report. Stops at a slot that is claimed but not
+ *  written yet; its writer wakes the drain task again.
+ *
+ ******************************************************************************/
+static void drain_lines(void)
+{
+    static uint32_t reported_drops = 0u;
+    uint32_t pos = dequeue_pos;
+    uint32_t waiting = LOAD_ACQUIRE(&enqueue_pos) - pos;
+    uint32_t drops;
+
+    if (waiting > log_stats.high_water)
+    {
+        log_stats.high_water = waiting;
+    }
+
+    while (true)
+    {
+        log_line_t *line = &log_lines[pos & APP_LOG_LINE_MASK];
+
+        if (LOAD_ACQUIRE(&line->seq) != (pos + 1u))
+        {
+            break;
+        }
+
+        (void) fwrite(line->text, 1u, line->len, stdout);
+
+        STORE_RELEASE(&line->seq, pos + APP_LOG_LINE_COUNT);
+        pos++;
+        STORE_RELEASE(&dequeue_pos, pos);
+    }
+
+    drops = LOAD_ACQUIRE(&log_stats.dropped);
+    if (drops != reported_drops)
+    {
+        printf("\n[log: %u line(s) dropped]\n", (unsigned)(drops - reported_drops));
+        reported_drops = drops;
+    }
+    (void) fflush(stdout);
+}
+
+/******************************************************************************
+ * Function Name: app_log_task
+ ******************************************************************************
+ * Summary:
+ *  Drain task: prints the log lines whenever a writer finds it idle, and at
+ *  least every 'APP_LOG_DRAIN_INTERVAL_MS' milliseconds.
+ *
+ * Parameters:
+ *  void *pvParameters : Task parameter (unused)
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void app_log_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    while (true)
+    {
+        drain_lines();
+        (void) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(APP_LOG_DRAIN_INTERVAL_MS));
+    }
+}
+#endif /* ENABLE_DEFERRED_LOGGING */
+
+/* [] END OF FILE */
@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name:   app_log.h
+*
+* Description: This file is the public interface of app_log.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef APP_LOG_H_
+#define APP_LOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Include the MQTT client configuration header file. */
+#include "mqtt_client_config.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Task parameters for the log drain task. It runs above the idle task only. */
+#define APP_LOG_TASK_PRIORITY               (1)
+#define APP_LOG_TASK_STACK_SIZE             (1024 * 1)
+
+/* Log levels; a module prints the messages at or below its level. */
+#define APP_LOG_LEVEL_OFF                   (0)
+#define APP_LOG_LEVEL_ERR                   (1)
+#define APP_LOG_LEVEL_WARN                  (2)
+#define APP_LOG_LEVEL_INFO                  (3)
+#define APP_LOG_LEVEL_DEBUG                 (4)
+
+/* Log calls of a module. The module defines APP_LOG_MODULE_LEVEL as one of
+ * the APP_LOG_LEVEL_* settings of mqtt_client_config.h; the calls above that
+ * level compile to nothing, arguments included.
+ */
+#define APP_LOG(level, ...)                                     \
+                     do                                         \
+                     {                                          \
+                         if ((level) <= (APP_LOG_MODULE_LEVEL)) \
+                         {                                      \
+                             app_log_write(__VA_ARGS__);        \
+                         }                                      \
+                     } while(0)
+
+#define APP_LOG_ERR(...)                    APP_LOG(APP_LOG_LEVEL_ERR, __VA_ARGS__)
+#define APP_LOG_WARN(...)                   APP_LOG(APP_LOG_LEVEL_WARN, __VA_ARGS__)
+#define APP_LOG_INFO(...)                   APP_LOG(APP_LOG_LEVEL_INFO, __VA_ARGS__)
+#define APP_LOG_DEBUG(...)                  APP_LOG(APP_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/* Lets GCC and Clang check the arguments of the log calls like printf(). */
+#if defined(__GNUC__)
+#define APP_LOG_FORMAT_CHECK                __attribute__((format(printf, 1, 2)))
+#else
+#define APP_LOG_FORMAT_CHECK
+#endif
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Counters of the deferred log. */
+typedef struct
+{
+    uint32_t written;               /* Lines stored in the ring */
+    uint32_t dropped;               /* Lines lost because the ring was full */
+    uint32_t truncated;             /* Lines cut to APP_LOG_LINE_SIZE */
+    uint32_t high_water;            /* Most lines waiting for the drain task */
+} app_log_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+bool app_log_init(void);
+void app_log_write(const char *format, ...) APP_LOG_FORMAT_CHECK;
+bool app_log_flush(uint32_t timeout_ms);
+void app_log_get_stats(app_log_stats_t *stats);
+
+#endif /* APP_LOG_H_ */
+
+/* [] END OF FILE */
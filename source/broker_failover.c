@@ -0,0 +1,396 @@
+/******************************************************************************
+* File Name:   broker_failover.c
+*
+* Description: This file ranks the MQTT brokers of BROKER_FAILOVER_LIST by
+*              the time a TCP connection to them takes, and walks down the
+*              ranking when a broker fails.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "broker_failover.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+/* Middleware libraries */
+#include "cy_secure_sockets.h"
+
+#if ENABLE_BROKER_FAILOVER
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Broker information of one X(hostname, port) entry of BROKER_FAILOVER_LIST. */
+#define BROKER_INFO_ENTRY(host, port_number)                        \
+    { .hostname = (host), .hostname_len = sizeof(host) - 1, .port = (port_number) },
+
+/* Weight of the previous smoothed round trip time, in quarters. The probes
+ * are minutes apart, so a new one weighs more than a sample in the smoothed
+ * RTT of TCP.
+ */
+#define SRTT_HISTORY_QUARTERS           (3u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* The configured brokers, in the order of BROKER_FAILOVER_LIST. */
+static cy_mqtt_broker_info_t broker_infos[] =
+{
+    BROKER_FAILOVER_LIST(BROKER_INFO_ENTRY)
+};
+
+#define BROKER_COUNT                    (sizeof(broker_infos) / sizeof(broker_infos[0]))
+
+/* Probe results, indexed like broker_infos. */
+static broker_failover_broker_t brokers[BROKER_COUNT];
+
+/* Indexes of the brokers, fastest first, and the index of the broker in use. */
+static uint8_t ranking[BROKER_COUNT];
+static uint32_t current;
+
+static broker_failover_stats_t failover_stats;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static bool probe_broker(const cy_mqtt_broker_info_t *info, uint32_t *rtt_ms);
+static bool ranks_before(uint8_t a, uint8_t b);
+
+/*******************************************************************************
+* Function Definitions
+********************************************************************************/
+
+/*******************************************************************************
+* Function Name: broker_failover_init
+********************************************************************************
+* Summary:
+* Forgets the probe results and ranks the brokers in the configured order.
+*
+*******************************************************************************/
+void broker_failover_init(void)
+{
+    taskENTER_CRITICAL();
+    for (uint32_t index = 0; index < BROKER_COUNT; index++)
+    {
+        memset(&brokers[index], 0, sizeof(brokers[index]));
+        brokers[index].info = &broker_infos[index];
+        brokers[index].srtt_ms = BROKER_FAILOVER_RTT_UNKNOWN;
+        ranking[index] = (uint8_t) index;
+    }
+    current = 0u;
+    memset(&failover_stats, 0, sizeof(failover_stats));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: broker_failover_rank
+********************************************************************************
+* Summary:
+* Probes the brokers in the order of the current ranking and ranks them: the
+* brokers that answered the last probe by their smoothed round trip time, then
+* the others in the configured order. No further broker is probed once
+* 'BROKER_FAILOVER_RANK_BUDGET_MS' have passed; the brokers left out keep the
+* result of their previous probe. If no broker answered, e.g. while the Wi-Fi
+* link is down, the ranking is left as it was. Blocks for up to the budget plus
+* one 'BROKER_FAILOVER_PROBE_TIMEOUT_MS' (longer where the network stack does
+* not apply the socket timeouts to connect).
+*
+* Return:
+*  bool : true if at least one broker answered
+*
+*******************************************************************************/
+bool broker_failover_rank(void)
+{
+    bool answered = false;
+    bool truncated = false;
+    uint32_t rtt_ms;
+    uint8_t order[BROKER_COUNT];
+    uint8_t leader;
+    TickType_t start_ticks = xTaskGetTickCount();
+
+    taskENTER_CRITICAL();
+    memcpy(order, ranking, sizeof(order));
+    taskEXIT_CRITICAL();
+    leader = order[0];
+
+    for (uint32_t position = 0; position < BROKER_COUNT; position++)
+    {
+        uint8_t index = order[position];
+        bool reachable;
+        broker_failover_broker_t *broker = &brokers[index];
+
+        if (((xTaskGetTickCount() - start_ticks) * portTICK_PERIOD_MS) >=
+            BROKER_FAILOVER_RANK_BUDGET_MS)
+        {
+            truncated = true;
+            break;
+        }
+
+        reachable = probe_broker(&broker_infos[index], &rtt_ms);
+
+        taskENTER_CRITICAL();
+        broker->probes++;
+        broker->reachable = reachable;
+        if (reachable)
+        {
+            broker->last_rtt_ms = rtt_ms;
+            broker->srtt_ms = (broker->srtt_ms == BROKER_FAILOVER_RTT_UNKNOWN) ? rtt_ms :
+                              ((broker->srtt_ms * SRTT_HISTORY_QUARTERS) + rtt_ms) / 4u;
+        }
+        else
+        {
+            broker->failed_probes++;
+        }
+        taskEXIT_CRITICAL();
+        answered = answered || reachable;
+    }
+
+    taskENTER_CRITICAL();
+    failover_stats.rankings++;
+    if (truncated)
+    {
+        failover_stats.truncated_rankings++;
+    }
+    if (answered)
+    {
+        /* Insertion sort: the list is short and mostly in order already. */
+        for (uint32_t i = 1; i < BROKER_COUNT; i++)
+        {
+            uint8_t index = ranking[i];
+            uint32_t j = i;
+
+            while ((j > 0u) && ranks_before(index, ranking[j - 1u]))
+            {
+                ranking[j] = ranking[j - 1u];
+                j--;
+            }
+            ranking[j] = index;
+        }
+
+        if (ranking[0] != leader)
+        {
+            failover_stats.leader_changes++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return answered;
+}
+
+/*******************************************************************************
+* Function Name: broker_failover_first
+********************************************************************************
+* Summary:
+* Selects the fastest broker of the current ranking.
+*
+* Return:
+*  cy_mqtt_broker_info_t * : Broker to connect to
+*
+*******************************************************************************/
+cy_mqtt_broker_info_t *broker_failover_first(void)
+{
+    taskENTER_CRITICAL();
+    current = ranking[0];
+    taskEXIT_CRITICAL();
+    return &broker_infos[current];
+}
+
+/*******************************************************************************
+* Function Name: broker_failover_next
+********************************************************************************
+* Summary:
+* Fails over from the broker in use to the next one of the ranking, or back to
+* the fastest one after the last.
+*
+* Return:
+*  cy_mqtt_broker_info_t * : Broker to connect to
+*
+*******************************************************************************/
+cy_mqtt_broker_info_t *broker_failover_next(void)
+{
+    uint32_t rank = 0u;
+
+    taskENTER_CRITICAL();
+    while ((rank < BROKER_COUNT) && (ranking[rank] != current))
+    {
+        rank++;
+    }
+    current = ranking[(rank + 1u) % BROKER_COUNT];
+    failover_stats.failovers++;
+    taskEXIT_CRITICAL();
+    return &broker_infos[current];
+}
+
+/*******************************************************************************
+* Function Name: broker_failover_count
+********************************************************************************
+* Summary:
+* Returns the number of brokers in BROKER_FAILOVER_LIST.
+*
+*******************************************************************************/
+uint32_t broker_failover_count(void)
+{
+    return BROKER_COUNT;
+}
+
+/*******************************************************************************
+* Function Name: broker_failover_get_broker
+********************************************************************************
+* Summary:
+* Copies the probe results of the broker at a rank of the current ranking.
+*
+* Parameters:
+*  uint32_t rank : Rank, 0 for the fastest broker
+*  broker_failover_broker_t *broker : Pointer to store the results
+*
+* Return:
+*  bool : false if 'rank' is not below broker_failover_count()
+*
+*******************************************************************************/
+bool broker_failover_get_broker(uint32_t rank, broker_failover_broker_t *broker)
+{
+    if (rank >= BROKER_COUNT)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *broker = brokers[ranking[rank]];
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: broker_failover_get_stats
+********************************************************************************
+* Summary:
+* Returns the counters of the broker ranking.
+*
+* Parameters:
+*  broker_failover_stats_t *stats : Pointer to store the counters
+*
+*******************************************************************************/
+void broker_failover_get_stats(broker_failover_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = failover_stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: probe_broker
+********************************************************************************
+* Summary:
+* Opens a TCP connection to a broker and closes it again. The name resolution
+* is not part of the measured time.
+*
+* Parameters:
+*  const cy_mqtt_broker_info_t *info : Broker to probe
+*  uint32_t *rtt_ms : Time the TCP connection took, in milliseconds
+*
+* Return:
+*  bool : true if the broker accepted the connection
+*
+*******************************************************************************/
+static bool probe_broker(const cy_mqtt_broker_info_t *info, uint32_t *rtt_ms)
+{
+    cy_socket_t probe_socket;
+    cy_socket_sockaddr_t address;
+    uint32_t timeout_ms = BROKER_FAILOVER_PROBE_TIMEOUT_MS;
+    TickType_t start_ticks;
+    cy_rslt_t result;
+
+    memset(&address, 0, sizeof(address));
+    if (CY_RSLT_SUCCESS != cy_socket_gethostbyname(info->hostname, CY_SOCKET_IP_VER_V4,
+                                                   &address.ip_address))
+    {
+        return false;
+    }
+    address.port = info->port;
+
+    if (CY_RSLT_SUCCESS != cy_socket_create(CY_SOCKET_DOMAIN_AF_INET, CY_SOCKET_TYPE_STREAM,
+                                            CY_SOCKET_IPPROTO_TCP, &probe_socket))
+    {
+        return false;
+    }
+    (void) cy_socket_setsockopt(probe_socket, CY_SOCKET_SOL_SOCKET, CY_SOCKET_SO_SNDTIMEO,
+                                &timeout_ms, sizeof(timeout_ms));
+    (void) cy_socket_setsockopt(probe_socket, CY_SOCKET_SOL_SOCKET, CY_SOCKET_SO_RCVTIMEO,
+                                &timeout_ms, sizeof(timeout_ms));
+
+    start_ticks = xTaskGetTickCount();
+    result = cy_socket_connect(probe_socket, &address, sizeof(address));
+    *rtt_ms = (uint32_t)((xTaskGetTickCount() - start_ticks) * portTICK_PERIOD_MS);
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        (void) cy_socket_disconnect(probe_socket, 0u);
+    }
+    (void) cy_socket_delete(probe_socket);
+    return (CY_RSLT_SUCCESS == result);
+}
+
+/*******************************************************************************
+* Function Name: ranks_before
+********************************************************************************
+* Summary:
+* Tells whether broker 'a' ranks before broker 'b': reachable brokers first,
+* then by smoothed round trip time, then in the configured order.
+*
+*******************************************************************************/
+static bool ranks_before(uint8_t a, uint8_t b)
+{
+    if (brokers[a].reachable != brokers[b].reachable)
+    {
+        return brokers[a].reachable;
+    }
+    if (brokers[a].reachable && (brokers[a].srtt_ms != brokers[b].srtt_ms))
+    {
+        return (brokers[a].srtt_ms < brokers[b].srtt_ms);
+    }
+    return (a < b);
+}
+
+#endif /* ENABLE_BROKER_FAILOVER */
+
+/* [] END OF FILE */
@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name:   broker_failover.h
+*
+* Description: This file is the public interface of broker_failover.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef BROKER_FAILOVER_H_
+#define BROKER_FAILOVER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_mqtt_api.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Round trip time of a broker that never answered a probe. */
+#define BROKER_FAILOVER_RTT_UNKNOWN         (UINT32_MAX)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Probe results of one broker of BROKER_FAILOVER_LIST. */
+typedef struct
+{
+    const cy_mqtt_broker_info_t *info;
+    bool reachable;                 /* The last probe connected */
+    uint32_t srtt_ms;               /* Smoothed TCP connect time, or
+                                     * BROKER_FAILOVER_RTT_UNKNOWN */
+    uint32_t last_rtt_ms;           /* TCP connect time of the last probe that
+                                     * connected */
+    uint32_t probes;
+    uint32_t failed_probes;
+} broker_failover_broker_t;
+
+/* Counters of the broker ranking. */
+typedef struct
+{
+    uint32_t rankings;              /* broker_failover_rank() calls */
+    uint32_t leader_changes;        /* Rankings that changed the fastest broker */
+    uint32_t truncated_rankings;    /* Rankings that ran out of
+                                     * BROKER_FAILOVER_RANK_BUDGET_MS */
+    uint32_t failovers;             /* Moves down the list */
+} broker_failover_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void broker_failover_init(void);
+bool broker_failover_rank(void);
+cy_mqtt_broker_info_t *broker_failover_first(void);
+cy_mqtt_broker_info_t *broker_failover_next(void);
+uint32_t broker_failover_count(void);
+bool broker_failover_get_broker(uint32_t rank, broker_failover_broker_t *broker);
+void broker_failover_get_stats(broker_failover_stats_t *stats);
+
+#endif /* BROKER_FAILOVER_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,403 @@
+/******************************************************************************
+* File Name:   buffer_profile.c
+*
+* Description: This file tracks the sizes of the MQTT packets sent and
+*              received, keeps the largest one in internal flash, and sizes
+*              the MQTT network buffer from it on the next start.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cyhal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+#include "buffer_profile.h"
+#include "mqtt_task.h"
+#include "app_log.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Log level of this module. */
+#define APP_LOG_MODULE_LEVEL            APP_LOG_LEVEL_BUFFER_PROFILE
+
+/* The profile is kept in a row of the internal flash of PSoC 6 devices. On
+ * other devices and on the host it lasts until the next reset only.
+ */
+#if ENABLE_NETWORK_BUFFER_TUNING && defined(COMPONENT_CAT1A) && defined(CY_FLASH_SIZEOF_ROW)
+#define BUFFER_PROFILE_IN_FLASH
+#endif
+
+/* Network buffer sizes are multiples of this. */
+#define BUFFER_SIZE_GRANULE             (64u)
+
+/* Marks a row that holds a profile ("MQBP"). */
+#define BUFFER_PROFILE_MAGIC            (0x4D514250u)
+
+/* MQTT PUBLISH: fixed header byte, topic length field, packet identifier. */
+#define MQTT_FIXED_HEADER_TYPE_SIZE     (1u)
+#define MQTT_TOPIC_LENGTH_SIZE          (2u)
+#define MQTT_PACKET_ID_SIZE             (2u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+#ifdef BUFFER_PROFILE_IN_FLASH
+/* Record stored at the start of the flash row. */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t max_packet;
+    uint32_t max_packet_inverted;   /* ~max_packet */
+} buffer_profile_record_t;
+
+/* Flash row reserved for the profile, erased when the application is
+ * programmed, and the image written to it.
+ */
+CY_ALIGN(CY_FLASH_SIZEOF_ROW)
+static const uint8_t buffer_profile_row[CY_FLASH_SIZEOF_ROW] = { 0u };
+static uint32_t buffer_profile_row_image[CY_FLASH_SIZEOF_ROW / sizeof(uint32_t)];
+#endif /* BUFFER_PROFILE_IN_FLASH */
+
+static buffer_profile_stats_t profile;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t buffer_size_for(uint32_t max_packet);
+static bool profile_grown(uint32_t max_packet);
+
+/******************************************************************************
+ * Function Name: buffer_size_for
+ ******************************************************************************
+ * Summary:
+ *  Network buffer size for a largest packet: the packet plus
+ *  'NETWORK_BUFFER_TUNING_MARGIN_PERCENT', rounded up and bounded. Without
+ *  a saved profile, 'MQTT_NETWORK_BUFFER_SIZE' is used while it is learnt.
+ *
+ ******************************************************************************/
+static uint32_t buffer_size_for(uint32_t max_packet)
+{
+#if ENABLE_NETWORK_BUFFER_TUNING
+    uint32_t size;
+
+    if (max_packet == 0u)
+    {
+        return MQTT_NETWORK_BUFFER_SIZE;
+    }
+
+    size = max_packet + ((max_packet * NETWORK_BUFFER_TUNING_MARGIN_PERCENT) / 100u);
+    size = (size + BUFFER_SIZE_GRANULE - 1u) & ~(BUFFER_SIZE_GRANULE - 1u);
+
+    if (size < NETWORK_BUFFER_TUNING_MIN_SIZE)
+    {
+        size = NETWORK_BUFFER_TUNING_MIN_SIZE;
+    }
+    if (size > NETWORK_BUFFER_TUNING_MAX_SIZE)
+    {
+        size = NETWORK_BUFFER_TUNING_MAX_SIZE;
+    }
+    return size;
+#else
+    (void) max_packet;
+    return MQTT_NETWORK_BUFFER_SIZE;
+#endif /* ENABLE_NETWORK_BUFFER_TUNING */
+}
+
+/******************************************************************************
+ * Function Name: profile_grown
+ ******************************************************************************
+ * Summary:
+ *  Tells whether a largest packet is worth saving: no profile was saved yet,
+ *  or the packet calls for a larger buffer than the saved profile. Called
+ *  with the profile locked.
+ *
+ ******************************************************************************/
+static bool profile_grown(uint32_t max_packet)
+{
+    if (max_packet == 0u)
+    {
+        return false;
+    }
+
+    return (profile.persisted_max == 0u) ||
+           (buffer_size_for(max_packet) > buffer_size_for(profile.persisted_max));
+}
+
+/******************************************************************************
+ * Function Name: buffer_profile_init
+ ******************************************************************************
+ * Summary:
+ *  Clears the histograms and loads the largest packet of the saved profile.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void buffer_profile_init(void)
+{
+    memset(&profile, 0, sizeof(profile));
+
+#ifdef BUFFER_PROFILE_IN_FLASH
+    {
+        cyhal_flash_t flash;
+        buffer_profile_record_t record;
+
+        if ((CY_RSLT_SUCCESS == cyhal_flash_init(&flash)) &&
+            (CY_RSLT_SUCCESS == cyhal_flash_read(&flash, (uint32_t) buffer_profile_row,
+                                                 (uint8_t *) &record, sizeof(record))) &&
+            (record.magic == BUFFER_PROFILE_MAGIC) &&
+            (record.max_packet == ~record.max_packet_inverted))
+        {
+            profile.persisted_max = record.max_packet;
+        }
+        cyhal_flash_free(&flash);
+    }
+#endif /* BUFFER_PROFILE_IN_FLASH */
+}
+
+/******************************************************************************
+ * Function Name: buffer_profile_buffer_size
+ ******************************************************************************
+ * Summary:
+ *  Returns the size of the network buffer to allocate, from the saved
+ *  profile, and remembers it as the buffer in use.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t : Size of the network buffer in bytes.
+ *
+ ******************************************************************************/
+uint32_t buffer_profile_buffer_size(void)
+{
+    profile.buffer_size = buffer_size_for(profile.persisted_max);
+    return profile.buffer_size;
+}
+
+/******************************************************************************
+ * Function Name: buffer_profile_packet_size
+ ******************************************************************************
+ * Summary:
+ *  Returns the size of an MQTT packet from its remaining length: the fixed
+ *  header byte and the variable-length encoding of the remaining length are
+ *  added.
+ *
+ * Parameters:
+ *  uint32_t remaining_length : Variable header and payload length
+ *
+ * Return:
+ *  uint32_t : Size of the packet in bytes.
+ *
+ ******************************************************************************/
+uint32_t buffer_profile_packet_size(uint32_t remaining_length)
+{
+    uint32_t length_bytes = (remaining_length < 128u) ? 1u :
+                            (remaining_length < 16384u) ? 2u :
+                            (remaining_length < 2097152u) ? 3u : 4u;
+
+    return MQTT_FIXED_HEADER_TYPE_SIZE + length_bytes + remaining_length;
+}
+
+/******************************************************************************
+ * Function Name: buffer_profile_publish_packet_size
+ ******************************************************************************
+ * Summary:
+ *  Returns the size of a PUBLISH packet.
+ *
+ * Parameters:
+ *  size_t topic_len : Length of the topic
+ *  size_t payload_len : Length of the payload
+ *  uint8_t qos : QoS of the message; QoS 1 and 2 carry a packet identifier
+ *
+ * Return:
+ *  uint32_t : Size of the packet in bytes.
+ *
+ ******************************************************************************/
+uint32_t buffer_profile_publish_packet_size(size_t topic_len, size_t payload_len, uint8_t qos)
+{
+    return buffer_profile_packet_size((uint32_t)(MQTT_TOPIC_LENGTH_SIZE + topic_len +
+                                                 ((qos > 0u) ? MQTT_PACKET_ID_SIZE : 0u) +
+                                                 payload_len));
+}
+
+/******************************************************************************
+ * Function Name: buffer_profile_add
+ ******************************************************************************
+ * Summary:
+ *  Adds a packet to the profile. When no profile was saved yet, or the
+ *  packet calls for a larger buffer than the saved profile, the MQTT client
+ *  task is asked to save the profile; the next start then allocates the
+ *  buffer it calls for. Safe to call from any task, including the MQTT
+ *  library callback.
+ *
+ * Parameters:
+ *  buffer_profile_direction_t direction : Incoming or outgoing packet
+ *  uint32_t packet_size : Size of the packet in bytes
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void buffer_profile_add(buffer_profile_direction_t direction, uint32_t packet_size)
+{
+    bool grown;
+    bool oversize;
+
+    taskENTER_CRITICAL();
+    log2_histogram_add(&profile.packets[direction], packet_size);
+    oversize = (profile.buffer_size != 0u) && (packet_size > profile.buffer_size);
+    profile.oversize += oversize ? 1u : 0u;
+    grown = profile_grown(profile.packets[BUFFER_PROFILE_INCOMING].max) ||
+            profile_grown(profile.packets[BUFFER_PROFILE_OUTGOING].max);
+    taskEXIT_CRITICAL();
+
+    if (oversize)
+    {
+        APP_LOG_WARN("MQTT packet of %u bytes exceeds the %u-byte network buffer!\n",
+                     (unsigned) packet_size, (unsigned) profile.buffer_size);
+    }
+
+    if (grown)
+    {
+        mqtt_task_notify(PERSIST_BUFFER_PROFILE);
+    }
+}
+
+/******************************************************************************
+ * Function Name: buffer_profile_save
+ ******************************************************************************
+ * Summary:
+ *  Saves the largest packet seen so far if no profile was saved yet, or if it
+ *  calls for a larger buffer than the saved profile. The flash is written
+ *  once for the first profile and then only when the buffer size grows, i.e.
+ *  a bounded number of times over the life of the device. Called from the
+ *  MQTT client task.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void buffer_profile_save(void)
+{
+    uint32_t max_packet;
+
+    taskENTER_CRITICAL();
+    max_packet = profile.packets[BUFFER_PROFILE_INCOMING].max;
+    if (profile.packets[BUFFER_PROFILE_OUTGOING].max > max_packet)
+    {
+        max_packet = profile.packets[BUFFER_PROFILE_OUTGOING].max;
+    }
+    taskEXIT_CRITICAL();
+
+    if (!profile_grown(max_packet))
+    {
+        return;
+    }
+
+#ifdef BUFFER_PROFILE_IN_FLASH
+    {
+        cyhal_flash_t flash;
+        buffer_profile_record_t record =
+        {
+            .magic = BUFFER_PROFILE_MAGIC,
+            .max_packet = max_packet,
+            .max_packet_inverted = ~max_packet
+        };
+        cy_rslt_t result;
+
+        memset(buffer_profile_row_image, 0, sizeof(buffer_profile_row_image));
+        memcpy(buffer_profile_row_image, &record, sizeof(record));
+
+        result = cyhal_flash_init(&flash);
+        if (CY_RSLT_SUCCESS == result)
+        {
+            result = cyhal_flash_write(&flash, (uint32_t) buffer_profile_row,
+                                       buffer_profile_row_image);
+            cyhal_flash_free(&flash);
+        }
+        if (CY_RSLT_SUCCESS != result)
+        {
+            APP_LOG_ERR("Failed to save the network buffer profile!\n");
+            return;
+        }
+    }
+#endif /* BUFFER_PROFILE_IN_FLASH */
+
+    taskENTER_CRITICAL();
+    profile.persisted_max = max_packet;
+    profile.saves++;
+    taskEXIT_CRITICAL();
+
+    APP_LOG_INFO("Network buffer profile: largest packet %u bytes, %u-byte buffer from the next start.\n",
+                 (unsigned) max_packet, (unsigned) buffer_size_for(max_packet));
+}
+
+/******************************************************************************
+ * Function Name: buffer_profile_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the packet size histograms and the buffer sizing state.
+ *
+ * Parameters:
+ *  buffer_profile_stats_t *stats : Pointer to store the profile
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void buffer_profile_get_stats(buffer_profile_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = profile;
+    taskEXIT_CRITICAL();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name:   buffer_profile.h
+*
+* Description: This file is the public interface of buffer_profile.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BUFFER_PROFILE_H_
+#define BUFFER_PROFILE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "log2_histogram.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Direction of an MQTT packet. */
+typedef enum
+{
+    BUFFER_PROFILE_INCOMING,
+    BUFFER_PROFILE_OUTGOING,
+    BUFFER_PROFILE_DIRECTIONS
+} buffer_profile_direction_t;
+
+/* Packet size profile of the MQTT connection. */
+typedef struct
+{
+    log2_histogram_t packets[BUFFER_PROFILE_DIRECTIONS];    /* Packet sizes in bytes */
+    uint32_t persisted_max;         /* Largest packet saved in flash */
+    uint32_t buffer_size;           /* Size of the network buffer in use */
+    uint32_t oversize;              /* Packets larger than the buffer in use */
+    uint32_t saves;                 /* Profile writes to flash */
+} buffer_profile_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void buffer_profile_init(void);
+uint32_t buffer_profile_buffer_size(void);
+uint32_t buffer_profile_packet_size(uint32_t remaining_length);
+uint32_t buffer_profile_publish_packet_size(size_t topic_len, size_t payload_len, uint8_t qos);
+void buffer_profile_add(buffer_profile_direction_t direction, uint32_t packet_size);
+void buffer_profile_save(void);
+void buffer_profile_get_stats(buffer_profile_stats_t *stats);
+
+#endif /* BUFFER_PROFILE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,954 @@
+/******************************************************************************
+* File Name:   cbor.c
+*
+* Description: This file implements a streaming CBOR (RFC 8949) encoder and
+*              decoder working on user buffers without any allocation, and
+*              the encoding of messages described by a schema of their fields
+*              as maps of integer keys.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "cbor.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Major types, in the top three bits of the initial byte. */
+#define CBOR_MAJOR_UINT                 (0u)
+#define CBOR_MAJOR_NEGINT               (1u)
+#define CBOR_MAJOR_BYTES                (2u)
+#define CBOR_MAJOR_TEXT                 (3u)
+#define CBOR_MAJOR_ARRAY                (4u)
+#define CBOR_MAJOR_MAP                  (5u)
+#define CBOR_MAJOR_TAG                  (6u)
+#define CBOR_MAJOR_SIMPLE               (7u)
+
+/* Additional information, in the low five bits of the initial byte. */
+#define CBOR_AI_MAX_IMMEDIATE           (23u)
+#define CBOR_AI_1_BYTE                  (24u)
+#define CBOR_AI_2_BYTES                 (25u)
+#define CBOR_AI_4_BYTES                 (26u)
+#define CBOR_AI_8_BYTES                 (27u)
+
+#define CBOR_SIMPLE_FALSE               (20u)
+#define CBOR_SIMPLE_TRUE                (21u)
+#define CBOR_SIMPLE_NULL                (22u)
+#define CBOR_SIMPLE_UNDEFINED           (23u)
+
+#define CBOR_INITIAL_BYTE(major, ai)    ((uint8_t)(((major) << 5) | (ai)))
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool encode_raw(cbor_encoder_t *encoder, const void *data, size_t length);
+static bool encode_header(cbor_encoder_t *encoder, uint8_t major, uint32_t value);
+static bool read_argument(cbor_decoder_t *decoder, uint8_t ai, uint64_t *argument);
+static float half_to_float(uint16_t half);
+static bool encode_field(cbor_encoder_t *encoder, const cbor_schema_field_t *field,
+                         const uint8_t *member);
+static bool decode_field(const cbor_schema_field_t *field, const cbor_item_t *item,
+                         uint8_t *member);
+
+/******************************************************************************
+ * Function Name: encode_raw
+ ******************************************************************************
+ * Summary:
+ *  Appends bytes to the encoded data, or sets the overflow flag.
+ *
+ ******************************************************************************/
+static bool encode_raw(cbor_encoder_t *encoder, const void *data, size_t length)
+{
+    if (encoder->overflow || (length > (encoder->size - encoder->length)))
+    {
+        encoder->overflow = true;
+        return false;
+    }
+
+    memcpy(&encoder->buffer[encoder->length], data, length);
+    encoder->length += length;
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: encode_header
+ ******************************************************************************
+ * Summary:
+ *  Appends the initial byte of an item and its argument in the shortest
+ *  form, big-endian.
+ *
+ ******************************************************************************/
+static bool encode_header(cbor_encoder_t *encoder, uint8_t major, uint32_t value)
+{
+    uint8_t header[CBOR_MAX_HEADER_SIZE];
+    size_t length;
+
+    if (value <= CBOR_AI_MAX_IMMEDIATE)
+    {
+        header[0] = CBOR_INITIAL_BYTE(major, value);
+        length = 1u;
+    }
+    else if (value <= UINT8_MAX)
+    {
+        header[0] = CBOR_INITIAL_BYTE(major, CBOR_AI_1_BYTE);
+        header[1] = (uint8_t) value;
+        length = 2u;
+    }
+    else if (value <= UINT16_MAX)
+    {
+        header[0] = CBOR_INITIAL_BYTE(major, CBOR_AI_2_BYTES);
+        header[1] = (uint8_t)(value >> 8);
+        header[2] = (uint8_t) value;
+        length = 3u;
+    }
+    else
+    {
+        header[0] = CBOR_INITIAL_BYTE(major, CBOR_AI_4_BYTES);
+        header[1] = (uint8_t)(value >> 24);
+        header[2] = (uint8_t)(value >> 16);
+        header[3] = (uint8_t)(value >> 8);
+        header[4] = (uint8_t) value;
+        length = 5u;
+    }
+
+    return encode_raw(encoder, header, length);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encoder_init
+ ******************************************************************************
+ * Summary:
+ *  Starts encoding into the given buffer.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder to initialize
+ *  void *buffer : Buffer for the encoded data
+ *  size_t size : Size of the buffer in bytes
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void cbor_encoder_init(cbor_encoder_t *encoder, void *buffer, size_t size)
+{
+    encoder->buffer = (uint8_t *) buffer;
+    encoder->size = size;
+    encoder->length = 0u;
+    encoder->overflow = false;
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_uint
+ ******************************************************************************
+ * Summary:
+ *  Encodes an unsigned integer.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *  uint32_t value : Value to encode
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_uint(cbor_encoder_t *encoder, uint32_t value)
+{
+    return encode_header(encoder, CBOR_MAJOR_UINT, value);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_int
+ ******************************************************************************
+ * Summary:
+ *  Encodes a signed integer; negative values are encoded as -1 - n.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *  int32_t value : Value to encode
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_int(cbor_encoder_t *encoder, int32_t value)
+{
+    if (value < 0)
+    {
+        return encode_header(encoder, CBOR_MAJOR_NEGINT, ~(uint32_t) value);
+    }
+    return encode_header(encoder, CBOR_MAJOR_UINT, (uint32_t) value);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_bool
+ ******************************************************************************
+ * Summary:
+ *  Encodes true or false.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *  bool value : Value to encode
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_bool(cbor_encoder_t *encoder, bool value)
+{
+    uint8_t byte = CBOR_INITIAL_BYTE(CBOR_MAJOR_SIMPLE, value ? CBOR_SIMPLE_TRUE : CBOR_SIMPLE_FALSE);
+
+    return encode_raw(encoder, &byte, 1u);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_null
+ ******************************************************************************
+ * Summary:
+ *  Encodes null.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_null(cbor_encoder_t *encoder)
+{
+    uint8_t byte = CBOR_INITIAL_BYTE(CBOR_MAJOR_SIMPLE, CBOR_SIMPLE_NULL);
+
+    return encode_raw(encoder, &byte, 1u);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_float
+ ******************************************************************************
+ * Summary:
+ *  Encodes a single precision floating point number.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *  float value : Value to encode
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_float(cbor_encoder_t *encoder, float value)
+{
+    uint8_t data[CBOR_MAX_HEADER_SIZE];
+    uint32_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    data[0] = CBOR_INITIAL_BYTE(CBOR_MAJOR_SIMPLE, CBOR_AI_4_BYTES);
+    data[1] = (uint8_t)(bits >> 24);
+    data[2] = (uint8_t)(bits >> 16);
+    data[3] = (uint8_t)(bits >> 8);
+    data[4] = (uint8_t) bits;
+
+    return encode_raw(encoder, data, sizeof(data));
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_bytes
+ ******************************************************************************
+ * Summary:
+ *  Encodes a byte string.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *  const void *data : Bytes to encode
+ *  size_t length : Number of bytes
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_bytes(cbor_encoder_t *encoder, const void *data, size_t length)
+{
+    return encode_header(encoder, CBOR_MAJOR_BYTES, (uint32_t) length) &&
+           encode_raw(encoder, data, length);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_text
+ ******************************************************************************
+ * Summary:
+ *  Encodes a UTF-8 text string.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *  const char *text : Text to encode, not necessarily NUL-terminated
+ *  size_t length : Length of the text in bytes
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_text(cbor_encoder_t *encoder, const char *text, size_t length)
+{
+    return encode_header(encoder, CBOR_MAJOR_TEXT, (uint32_t) length) &&
+           encode_raw(encoder, text, length);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_array
+ ******************************************************************************
+ * Summary:
+ *  Starts an array; the next 'count' items encoded are its elements.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *  uint32_t count : Number of elements
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_array(cbor_encoder_t *encoder, uint32_t count)
+{
+    return encode_header(encoder, CBOR_MAJOR_ARRAY, count);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encode_map
+ ******************************************************************************
+ * Summary:
+ *  Starts a map; the next 2 * 'count' items encoded are its keys and values,
+ *  in turn.
+ *
+ * Parameters:
+ *  cbor_encoder_t *encoder : Encoder
+ *  uint32_t count : Number of key and value pairs
+ *
+ * Return:
+ *  bool : false if the buffer is full
+ *
+ ******************************************************************************/
+bool cbor_encode_map(cbor_encoder_t *encoder, uint32_t count)
+{
+    return encode_header(encoder, CBOR_MAJOR_MAP, count);
+}
+
+/******************************************************************************
+ * Function Name: cbor_encoder_finish
+ ******************************************************************************
+ * Summary:
+ *  Returns the length of the encoded data.
+ *
+ * Parameters:
+ *  const cbor_encoder_t *encoder : Encoder
+ *
+ * Return:
+ *  size_t : Length in bytes, 0 if an item did not fit in the buffer
+ *
+ ******************************************************************************/
+size_t cbor_encoder_finish(const cbor_encoder_t *encoder)
+{
+    return encoder->overflow ? 0u : encoder->length;
+}
+
+/******************************************************************************
+ * Function Name: cbor_decoder_init
+ ******************************************************************************
+ * Summary:
+ *  Starts decoding the given data.
+ *
+ * Parameters:
+ *  cbor_decoder_t *decoder : Decoder to initialize
+ *  const void *buffer : Encoded data
+ *  size_t size : Length of the data in bytes
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void cbor_decoder_init(cbor_decoder_t *decoder, const void *buffer, size_t size)
+{
+    decoder->buffer = (const uint8_t *) buffer;
+    decoder->size = size;
+    decoder->offset = 0u;
+}
+
+/******************************************************************************
+ * Function Name: read_argument
+ ******************************************************************************
+ * Summary:
+ *  Reads the big-endian argument that follows the initial byte. Indefinite
+ *  lengths and reserved values are rejected.
+ *
+ ******************************************************************************/
+static bool read_argument(cbor_decoder_t *decoder, uint8_t ai, uint64_t *argument)
+{
+    size_t length;
+
+    if (ai <= CBOR_AI_MAX_IMMEDIATE)
+    {
+        *argument = ai;
+        return true;
+    }
+    if (ai > CBOR_AI_8_BYTES)
+    {
+        return false;
+    }
+
+    length = (size_t) 1u << (ai - CBOR_AI_1_BYTE);
+    if (length > (decoder->size - decoder->offset))
+    {
+        return false;
+    }
+
+    *argument = 0u;
+    for (size_t i = 0; i < length; i++)
+    {
+        *argument = (*argument << 8) | decoder->buffer[decoder->offset++];
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: half_to_float
+ ******************************************************************************
+ * Summary:
+ *  Converts a half precision number, exactly.
+ *
+ ******************************************************************************/
+static float half_to_float(uint16_t half)
+{
+    uint32_t sign = ((uint32_t) half & 0x8000u) << 16;
+    uint32_t exponent = ((uint32_t) half >> 10) & 0x1Fu;
+    uint32_t mantissa = (uint32_t) half & 0x3FFu;
+    uint32_t bits;
+    float value;
+
+    if (exponent == 0u)
+    {
+        /* Zero and subnormals: mantissa * 2^-24. */
+        value = (float) mantissa * (1.0f / 16777216.0f);
+        return (sign != 0u) ? -value : value;
+    }
+
+    if (exponent == 0x1Fu)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + (127u - 15u)) << 23) | (mantissa << 13);
+    }
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/******************************************************************************
+ * Function Name: cbor_decode_next
+ ******************************************************************************
+ * Summary:
+ *  Reads the next item. For an array, a map or a tag, only the header is
+ *  read; its elements are the next items. Integers are limited to 32 bits.
+ *
+ * Parameters:
+ *  cbor_decoder_t *decoder : Decoder
+ *  cbor_item_t *item : Item read
+ *
+ * Return:
+ *  bool : false at the end of the data, or if the item is malformed or not
+ *         supported (indefinite lengths, 64-bit integers, simple values)
+ *
+ ******************************************************************************/
+bool cbor_decode_next(cbor_decoder_t *decoder, cbor_item_t *item)
+{
+    uint8_t initial;
+    uint8_t major;
+    uint8_t ai;
+    uint64_t argument;
+
+    if (decoder->offset >= decoder->size)
+    {
+        return false;
+    }
+
+    initial = decoder->buffer[decoder->offset++];
+    major = initial >> 5;
+    ai = initial & 0x1Fu;
+
+    if (!read_argument(decoder, ai, &argument))
+    {
+        return false;
+    }
+
+    item->data = NULL;
+    item->number = 0.0f;
+
+    if (major == CBOR_MAJOR_SIMPLE)
+    {
+        item->value = 0u;
+        switch (ai)
+        {
+            case CBOR_SIMPLE_FALSE:     item->type = CBOR_TYPE_FALSE;     return true;
+            case CBOR_SIMPLE_TRUE:      item->type = CBOR_TYPE_TRUE;      return true;
+            case CBOR_SIMPLE_NULL:      item->type = CBOR_TYPE_NULL;      return true;
+            case CBOR_SIMPLE_UNDEFINED: item->type = CBOR_TYPE_UNDEFINED; return true;
+            case CBOR_AI_2_BYTES:
+            {
+                item->type = CBOR_TYPE_FLOAT;
+                item->number = half_to_float((uint16_t) argument);
+                return true;
+            }
+            case CBOR_AI_4_BYTES:
+            {
+                uint32_t bits = (uint32_t) argument;
+
+                item->type = CBOR_TYPE_FLOAT;
+                memcpy(&item->number, &bits, sizeof(item->number));
+                return true;
+            }
+            case CBOR_AI_8_BYTES:
+            {
+                double number;
+
+                item->type = CBOR_TYPE_FLOAT;
+                memcpy(&number, &argument, sizeof(number));
+                item->number = (float) number;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    if (argument > UINT32_MAX)
+    {
+        return false;
+    }
+    item->value = (uint32_t) argument;
+
+    switch (major)
+    {
+        case CBOR_MAJOR_UINT:   item->type = CBOR_TYPE_UINT;   break;
+        case CBOR_MAJOR_NEGINT: item->type = CBOR_TYPE_NEGINT; break;
+        case CBOR_MAJOR_ARRAY:  item->type = CBOR_TYPE_ARRAY;  break;
+        case CBOR_MAJOR_MAP:    item->type = CBOR_TYPE_MAP;    break;
+        case CBOR_MAJOR_TAG:    item->type = CBOR_TYPE_TAG;    break;
+        default:
+        {
+            /* Byte and text strings. */
+            if (item->value > (decoder->size - decoder->offset))
+            {
+                return false;
+            }
+            item->type = (major == CBOR_MAJOR_BYTES) ? CBOR_TYPE_BYTES : CBOR_TYPE_TEXT;
+            item->data = &decoder->buffer[decoder->offset];
+            decoder->offset += item->value;
+            break;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: cbor_decode_skip
+ ******************************************************************************
+ * Summary:
+ *  Skips the elements of an array, a map or a tag just read, nested ones
+ *  included, without recursion. Does nothing for other items.
+ *
+ * Parameters:
+ *  cbor_decoder_t *decoder : Decoder
+ *  const cbor_item_t *item : Item just read by cbor_decode_next()
+ *
+ * Return:
+ *  bool : false if an element is malformed or missing
+ *
+ ******************************************************************************/
+bool cbor_decode_skip(cbor_decoder_t *decoder, const cbor_item_t *item)
+{
+    uint64_t pending;
+    cbor_item_t element;
+
+    switch (item->type)
+    {
+        case CBOR_TYPE_ARRAY: pending = item->value;               break;
+        case CBOR_TYPE_MAP:   pending = 2u * (uint64_t) item->value; break;
+        case CBOR_TYPE_TAG:   pending = 1u;                        break;
+        default:              return true;
+    }
+
+    while (pending > 0u)
+    {
+        /* Every element takes at least one byte. */
+        if (pending > (decoder->size - decoder->offset))
+        {
+            return false;
+        }
+        if (!cbor_decode_next(decoder, &element))
+        {
+            return false;
+        }
+        pending--;
+
+        if (element.type == CBOR_TYPE_ARRAY)
+        {
+            pending += element.value;
+        }
+        else if (element.type == CBOR_TYPE_MAP)
+        {
+            pending += 2u * (uint64_t) element.value;
+        }
+        else if (element.type == CBOR_TYPE_TAG)
+        {
+            pending++;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: cbor_decoder_done
+ ******************************************************************************
+ * Summary:
+ *  Checks whether all the data was read.
+ *
+ * Parameters:
+ *  const cbor_decoder_t *decoder : Decoder
+ *
+ * Return:
+ *  bool : true if no byte is left
+ *
+ ******************************************************************************/
+bool cbor_decoder_done(const cbor_decoder_t *decoder)
+{
+    return decoder->offset == decoder->size;
+}
+
+/******************************************************************************
+ * Function Name: encode_field
+ ******************************************************************************
+ * Summary:
+ *  Encodes the value of a member of a schema-described message.
+ *
+ ******************************************************************************/
+static bool encode_field(cbor_encoder_t *encoder, const cbor_schema_field_t *field,
+                         const uint8_t *member)
+{
+    switch (field->type)
+    {
+        case CBOR_FIELD_UINT:
+        {
+            uint32_t value = (field->size == 1u) ? *member :
+                             (field->size == 2u) ? *(const uint16_t *) member :
+                                                   *(const uint32_t *) member;
+            return cbor_encode_uint(encoder, value);
+        }
+        case CBOR_FIELD_INT:
+        {
+            int32_t value = (field->size == 1u) ? *(const int8_t *) member :
+                            (field->size == 2u) ? *(const int16_t *) member :
+                                                  *(const int32_t *) member;
+            return cbor_encode_int(encoder, value);
+        }
+        case CBOR_FIELD_BOOL:
+            return cbor_encode_bool(encoder, *(const bool *) member);
+        case CBOR_FIELD_FLOAT:
+            return cbor_encode_float(encoder, *(const float *) member);
+        case CBOR_FIELD_TEXT:
+        {
+            const char *text = (const char *) member;
+            size_t length = 0u;
+
+            while ((length < field->size) && (text[length] != '\0'))
+            {
+                length++;
+            }
+            return cbor_encode_text(encoder, text, length);
+        }
+        default:
+            return false;
+    }
+}
+
+/******************************************************************************
+ * Function Name: decode_field
+ ******************************************************************************
+ * Summary:
+ *  Stores a decoded value into a member of a schema-described message if it
+ *  has the type of the field and fits in the member.
+ *
+ ******************************************************************************/
+static bool decode_field(const cbor_schema_field_t *field, const cbor_item_t *item,
+                         uint8_t *member)
+{
+    switch (field->type)
+    {
+        case CBOR_FIELD_UINT:
+        {
+            uint32_t limit = (field->size == 1u) ? UINT8_MAX :
+                             (field->size == 2u) ? UINT16_MAX : UINT32_MAX;
+
+            if ((item->type != CBOR_TYPE_UINT) || (item->value > limit))
+            {
+                return false;
+            }
+            if (field->size == 1u)
+            {
+                *member = (uint8_t) item->value;
+            }
+            else if (field->size == 2u)
+            {
+                *(uint16_t *) member = (uint16_t) item->value;
+            }
+            else
+            {
+                *(uint32_t *) member = item->value;
+            }
+            return true;
+        }
+        case CBOR_FIELD_INT:
+        {
+            /* Largest magnitude of the positive values of the member; the
+             * negative ones reach one more.
+             */
+            uint32_t limit = (field->size == 1u) ? (uint32_t) INT8_MAX :
+                             (field->size == 2u) ? (uint32_t) INT16_MAX : (uint32_t) INT32_MAX;
+            int32_t value;
+
+            if ((item->type == CBOR_TYPE_UINT) && (item->value <= limit))
+            {
+                value = (int32_t) item->value;
+            }
+            else if ((item->type == CBOR_TYPE_NEGINT) && (item->value <= limit))
+            {
+                value = -1 - (int32_t) item->value;
+            }
+            else
+            {
+                return false;
+            }
+
+            if (field->size == 1u)
+            {
+                *(int8_t *) member = (int8_t) value;
+            }
+            else if (field->size == 2u)
+            {
+                *(int16_t *) member = (int16_t) value;
+            }
+            else
+            {
+                *(int32_t *) member = value;
+            }
+            return true;
+        }
+        case CBOR_FIELD_BOOL:
+        {
+            if ((item->type != CBOR_TYPE_TRUE) && (item->type != CBOR_TYPE_FALSE))
+            {
+                return false;
+            }
+            *(bool *) member = (item->type == CBOR_TYPE_TRUE);
+            return true;
+        }
+        case CBOR_FIELD_FLOAT:
+        {
+            if (item->type == CBOR_TYPE_FLOAT)
+            {
+                *(float *) member = item->number;
+            }
+            else if (item->type == CBOR_TYPE_UINT)
+            {
+                *(float *) member = (float) item->value;
+            }
+            else if (item->type == CBOR_TYPE_NEGINT)
+            {
+                *(float *) member = -1.0f - (float) item->value;
+            }
+            else
+            {
+                return false;
+            }
+            return true;
+        }
+        case CBOR_FIELD_TEXT:
+        {
+            if ((item->type != CBOR_TYPE_TEXT) || (item->value >= field->size))
+            {
+                return false;
+            }
+            memcpy(member, item->data, item->value);
+            member[item->value] = '\0';
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/******************************************************************************
+ * Function Name: cbor_schema_encode
+ ******************************************************************************
+ * Summary:
+ *  Encodes the selected fields of a message as a map of their integer keys to
+ *  their values.
+ *
+ * Parameters:
+ *  const cbor_schema_t *schema : Fields of the message
+ *  const void *object : Message to encode
+ *  uint32_t fields : Mask of the fields to encode
+ *  void *buffer : Buffer for the encoded message
+ *  size_t size : Size of the buffer in bytes
+ *
+ * Return:
+ *  size_t : Length of the encoded message, 0 if it does not fit
+ *
+ ******************************************************************************/
+size_t cbor_schema_encode(const cbor_schema_t *schema, const void *object, uint32_t fields,
+                          void *buffer, size_t size)
+{
+    cbor_encoder_t encoder;
+    uint32_t count = 0u;
+
+    for (uint32_t i = 0; i < schema->count; i++)
+    {
+        count += (fields >> i) & 1u;
+    }
+
+    cbor_encoder_init(&encoder, buffer, size);
+    (void) cbor_encode_map(&encoder, count);
+
+    for (uint32_t i = 0; i < schema->count; i++)
+    {
+        const cbor_schema_field_t *field = &schema->fields[i];
+
+        if (((fields >> i) & 1u) != 0u)
+        {
+            (void) cbor_encode_uint(&encoder, field->key);
+            (void) encode_field(&encoder, field, (const uint8_t *) object + field->offset);
+        }
+    }
+
+    return cbor_encoder_finish(&encoder);
+}
+
+/******************************************************************************
+ * Function Name: cbor_schema_decode
+ ******************************************************************************
+ * Summary:
+ *  Decodes a message encoded by cbor_schema_encode(). Keys that are not in
+ *  the schema are skipped, so that newer senders may add fields; the members
+ *  of the fields that are absent are left untouched.
+ *
+ * Parameters:
+ *  const cbor_schema_t *schema : Fields of the message
+ *  const void *buffer : Encoded message
+ *  size_t length : Length of the encoded message
+ *  void *object : Message to store the decoded fields into
+ *  uint32_t *fields : Mask of the fields found; may be NULL
+ *
+ * Return:
+ *  bool : false if the data is not a single map, a field has the wrong type
+ *         or range, or a required field is missing
+ *
+ ******************************************************************************/
+bool cbor_schema_decode(const cbor_schema_t *schema, const void *buffer, size_t length,
+                        void *object, uint32_t *fields)
+{
+    cbor_decoder_t decoder;
+    cbor_item_t item;
+    uint32_t found = 0u;
+    uint32_t pairs;
+
+    cbor_decoder_init(&decoder, buffer, length);
+    if (!cbor_decode_next(&decoder, &item) || (item.type != CBOR_TYPE_MAP))
+    {
+        return false;
+    }
+
+    for (pairs = item.value; pairs > 0u; pairs--)
+    {
+        cbor_item_t key;
+        const cbor_schema_field_t *field = NULL;
+        uint32_t index = 0u;
+
+        if (!cbor_decode_next(&decoder, &key) || !cbor_decode_skip(&decoder, &key))
+        {
+            return false;
+        }
+
+        if (key.type == CBOR_TYPE_UINT)
+        {
+            for (index = 0; index < schema->count; index++)
+            {
+                if (schema->fields[index].key == key.value)
+                {
+                    field = &schema->fields[index];
+                    break;
+                }
+            }
+        }
+
+        if (!cbor_decode_next(&decoder, &item))
+        {
+            return false;
+        }
+
+        if (field == NULL)
+        {
+            if (!cbor_decode_skip(&decoder, &item))
+            {
+                return false;
+            }
+            continue;
+        }
+
+        if (!decode_field(field, &item, (uint8_t *) object + field->offset))
+        {
+            return false;
+        }
+        found |= (1lu << index);
+    }
+
+    if (fields != NULL)
+    {
+        *fields = found;
+    }
+
+    return cbor_decoder_done(&decoder) && ((found & schema->required) == schema->required);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,164 @@
+/******************************************************************************
+* File Name:   cbor.h
+*
+* Description: This file is the public interface of cbor.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CBOR_H_
+#define CBOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Size of the largest item header: the initial byte and a 32-bit argument. */
+#define CBOR_MAX_HEADER_SIZE                (5u)
+
+/* Schema field of 'member' of 'type_name', under the integer map key 'key'. */
+#define CBOR_SCHEMA_FIELD(type_name, key, member, field_type)               \
+    { (key), (field_type), (uint16_t) offsetof(type_name, member),          \
+      (uint16_t) sizeof(((type_name *) 0)->member) }
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Types of the items returned by cbor_decode_next(). */
+typedef enum
+{
+    CBOR_TYPE_UINT,
+    CBOR_TYPE_NEGINT,               /* Value is -1 - 'value' */
+    CBOR_TYPE_BYTES,
+    CBOR_TYPE_TEXT,
+    CBOR_TYPE_ARRAY,                /* 'value' items follow */
+    CBOR_TYPE_MAP,                  /* 'value' key and value pairs follow */
+    CBOR_TYPE_TAG,                  /* The tagged item follows */
+    CBOR_TYPE_FALSE,
+    CBOR_TYPE_TRUE,
+    CBOR_TYPE_NULL,
+    CBOR_TYPE_UNDEFINED,
+    CBOR_TYPE_FLOAT                 /* Half, single or double precision */
+} cbor_type_t;
+
+/* Item read by cbor_decode_next(). Strings point into the decoded buffer. */
+typedef struct
+{
+    cbor_type_t type;
+    uint32_t value;                 /* Integer, string length or item count */
+    float number;                   /* CBOR_TYPE_FLOAT */
+    const uint8_t *data;            /* CBOR_TYPE_BYTES and CBOR_TYPE_TEXT */
+} cbor_item_t;
+
+/* Encoder writing into a buffer provided by the user. After the first item
+ * that does not fit, every call fails and cbor_encoder_finish() returns 0.
+ */
+typedef struct
+{
+    uint8_t *buffer;
+    size_t size;
+    size_t length;
+    bool overflow;
+} cbor_encoder_t;
+
+/* Decoder reading items from a buffer in turn. */
+typedef struct
+{
+    const uint8_t *buffer;
+    size_t size;
+    size_t offset;
+} cbor_decoder_t;
+
+/* C types of the fields of a schema-described message. */
+typedef enum
+{
+    CBOR_FIELD_UINT,                /* uint8_t, uint16_t or uint32_t member */
+    CBOR_FIELD_INT,                 /* int8_t, int16_t or int32_t member */
+    CBOR_FIELD_BOOL,                /* bool member */
+    CBOR_FIELD_FLOAT,               /* float member */
+    CBOR_FIELD_TEXT                 /* char array member, NUL-terminated */
+} cbor_field_type_t;
+
+/* Field of a schema-described message; see CBOR_SCHEMA_FIELD(). */
+typedef struct
+{
+    uint8_t key;                    /* Map key, 0 to 23 encode in one byte */
+    uint8_t type;                   /* cbor_field_type_t */
+    uint16_t offset;
+    uint16_t size;
+} cbor_schema_field_t;
+
+/* Message encoded as a map of integer keys to the values of the fields. Bit
+ * 'n' of a field mask stands for fields[n].
+ */
+typedef struct
+{
+    const cbor_schema_field_t *fields;
+    uint32_t count;                 /* Up to 32 fields */
+    uint32_t required;              /* Fields a decoded message must carry */
+} cbor_schema_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void cbor_encoder_init(cbor_encoder_t *encoder, void *buffer, size_t size);
+bool cbor_encode_uint(cbor_encoder_t *encoder, uint32_t value);
+bool cbor_encode_int(cbor_encoder_t *encoder, int32_t value);
+bool cbor_encode_bool(cbor_encoder_t *encoder, bool value);
+bool cbor_encode_null(cbor_encoder_t *encoder);
+bool cbor_encode_float(cbor_encoder_t *encoder, float value);
+bool cbor_encode_bytes(cbor_encoder_t *encoder, const void *data, size_t length);
+bool cbor_encode_text(cbor_encoder_t *encoder, const char *text, size_t length);
+bool cbor_encode_array(cbor_encoder_t *encoder, uint32_t count);
+bool cbor_encode_map(cbor_encoder_t *encoder, uint32_t count);
+size_t cbor_encoder_finish(const cbor_encoder_t *encoder);
+
+void cbor_decoder_init(cbor_decoder_t *decoder, const void *buffer, size_t size);
+bool cbor_decode_next(cbor_decoder_t *decoder, cbor_item_t *item);
+bool cbor_decode_skip(cbor_decoder_t *decoder, const cbor_item_t *item);
+bool cbor_decoder_done(const cbor_decoder_t *decoder);
+
+size_t cbor_schema_encode(const cbor_schema_t *schema, const void *object, uint32_t fields,
+                          void *buffer, size_t size);
+bool cbor_schema_decode(const cbor_schema_t *schema, const void *buffer, size_t length,
+                        void *object, uint32_t *fields);
+
+#endif /* CBOR_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,324 @@
+/******************************************************************************
+* File Name:   command_table.c
+*
+* Description: Perfect hash table mapping the text of a command message to
+*              its value. The table is built once from a constant command
+*              list.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "command_table.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Index of a free slot. */
+#define COMMAND_TABLE_FREE_SLOT         (0xFFu)
+
+/* Largest bucket the build can place. With two slots per bucket, buckets
+ * hardly ever get more than a few commands.
+ */
+#define COMMAND_TABLE_MAX_BUCKET_SIZE   (16u)
+
+/* FNV-1a parameters. */
+#define FNV_OFFSET_BASIS                (2166136261u)
+#define FNV_PRIME                       (16777619u)
+
+/* Spreads consecutive displacements over the hash space. */
+#define DISPLACEMENT_STEP               (0x9E3779B9u)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t command_hash(const char *text, size_t text_len);
+static uint32_t command_slot(const command_table_t *table, uint32_t hash, uint32_t displacement);
+static uint32_t bucket_members(const command_table_t *table, uint32_t bucket,
+                               uint8_t *members, uint32_t *hashes);
+static bool place_bucket(command_table_t *table, uint32_t bucket, const uint8_t *members,
+                         const uint32_t *hashes, uint32_t size);
+
+/******************************************************************************
+ * Function Name: command_hash
+ ******************************************************************************
+ * Summary:
+ *  32-bit FNV-1a hash of a message.
+ *
+ ******************************************************************************/
+static uint32_t command_hash(const char *text, size_t text_len)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    size_t i;
+
+    for (i = 0; i < text_len; i++)
+    {
+        hash = (hash ^ (uint8_t) text[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/******************************************************************************
+ * Function Name: command_slot
+ ******************************************************************************
+ * Summary:
+ *  Slot of a hash under a displacement. The finalizer of MurmurHash3 mixes
+ *  all the bits of the hash into the slot index.
+ *
+ ******************************************************************************/
+static uint32_t command_slot(const command_table_t *table, uint32_t hash, uint32_t displacement)
+{
+    uint32_t mixed = hash + (displacement * DISPLACEMENT_STEP);
+
+    mixed ^= mixed >> 16;
+    mixed *= 0x85EBCA6Bu;
+    mixed ^= mixed >> 13;
+    mixed *= 0xC2B2AE35u;
+    mixed ^= mixed >> 16;
+    return mixed & table->slot_mask;
+}
+
+/******************************************************************************
+ * Function Name: bucket_members
+ ******************************************************************************
+ * Summary:
+ *  Collects the commands whose hash selects the given bucket.
+ *
+ * Return:
+ *  uint32_t : Number of commands in the bucket; may exceed
+ *             'COMMAND_TABLE_MAX_BUCKET_SIZE', in which case only the first
+ *             ones are stored.
+ *
+ ******************************************************************************/
+static uint32_t bucket_members(const command_table_t *table, uint32_t bucket,
+                               uint8_t *members, uint32_t *hashes)
+{
+    uint32_t size = 0;
+    uint32_t i;
+
+    for (i = 0; i < table->count; i++)
+    {
+        uint32_t hash = command_hash(table->entries[i].text, table->entries[i].text_len);
+
+        if ((hash & (table->bucket_count - 1u)) == bucket)
+        {
+            if (size < COMMAND_TABLE_MAX_BUCKET_SIZE)
+            {
+                members[size] = (uint8_t) i;
+                hashes[size] = hash;
+            }
+            size++;
+        }
+    }
+    return size;
+}
+
+/******************************************************************************
+ * Function Name: place_bucket
+ ******************************************************************************
+ * Summary:
+ *  Searches the first displacement that moves all the commands of a bucket
+ *  to distinct free slots, and takes these slots.
+ *
+ * Return:
+ *  bool : false if no displacement fits.
+ *
+ ******************************************************************************/
+static bool place_bucket(command_table_t *table, uint32_t bucket, const uint8_t *members,
+                         const uint32_t *hashes, uint32_t size)
+{
+    uint32_t displacement;
+    uint32_t placed[COMMAND_TABLE_MAX_BUCKET_SIZE];
+    uint32_t i;
+    uint32_t j;
+
+    for (displacement = 0; displacement <= UINT16_MAX; displacement++)
+    {
+        for (i = 0; i < size; i++)
+        {
+            placed[i] = command_slot(table, hashes[i], displacement);
+            if (table->slots[placed[i]] != COMMAND_TABLE_FREE_SLOT)
+            {
+                break;
+            }
+            for (j = 0; (j < i) && (placed[j] != placed[i]); j++)
+            {
+            }
+            if (j < i)
+            {
+                break;
+            }
+        }
+
+        if (i == size)
+        {
+            for (i = 0; i < size; i++)
+            {
+                table->slots[placed[i]] = members[i];
+            }
+            table->displacements[bucket] = (uint16_t) displacement;
+            return true;
+        }
+    }
+    return false;
+}
+
+/******************************************************************************
+ * Function Name: command_table_init
+ ******************************************************************************
+ * Summary:
+ *  Builds the perfect hash of a command list. The largest buckets are placed
+ *  first, while most slots are still free.
+ *
+ * Parameters:
+ *  command_table_t *table : Table to build
+ *  const command_entry_t *entries : Commands; must outlive the table
+ *  uint32_t count : Number of commands
+ *  uint8_t *slots : COMMAND_TABLE_SLOT_COUNT(count) slots
+ *  uint16_t *displacements : COMMAND_TABLE_BUCKET_COUNT(count) displacements
+ *
+ * Return:
+ *  bool : false if there are too many commands, a command is listed twice,
+ *         or two commands have the same hash.
+ *
+ ******************************************************************************/
+bool command_table_init(command_table_t *table, const command_entry_t *entries,
+                        uint32_t count, uint8_t *slots, uint16_t *displacements)
+{
+    uint8_t members[COMMAND_TABLE_MAX_BUCKET_SIZE];
+    uint32_t hashes[COMMAND_TABLE_MAX_BUCKET_SIZE];
+    uint32_t largest = 0;
+    uint32_t size;
+    uint32_t bucket;
+    uint32_t i;
+    uint32_t j;
+
+    if (count > COMMAND_TABLE_MAX_COMMANDS)
+    {
+        return false;
+    }
+
+    table->entries = entries;
+    table->count = count;
+    table->slots = slots;
+    table->displacements = displacements;
+    table->slot_mask = COMMAND_TABLE_SLOT_COUNT(count) - 1u;
+    table->bucket_count = COMMAND_TABLE_BUCKET_COUNT(count);
+    memset(slots, COMMAND_TABLE_FREE_SLOT, COMMAND_TABLE_SLOT_COUNT(count));
+    memset(displacements, 0, table->bucket_count * sizeof(*displacements));
+
+    for (bucket = 0; bucket < table->bucket_count; bucket++)
+    {
+        size = bucket_members(table, bucket, members, hashes);
+        if (size > COMMAND_TABLE_MAX_BUCKET_SIZE)
+        {
+            return false;
+        }
+        largest = (size > largest) ? size : largest;
+
+        /* Commands with equal hashes can never be separated. */
+        for (i = 1; i < size; i++)
+        {
+            for (j = 0; j < i; j++)
+            {
+                if (hashes[i] == hashes[j])
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    for (size = largest; size > 0u; size--)
+    {
+        for (bucket = 0; bucket < table->bucket_count; bucket++)
+        {
+            if ((bucket_members(table, bucket, members, hashes) == size) &&
+                !place_bucket(table, bucket, members, hashes, size))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: command_table_lookup
+ ******************************************************************************
+ * Summary:
+ *  Looks up a message: one hash selects the only slot that can hold it, and
+ *  one compare confirms the command.
+ *
+ * Parameters:
+ *  const command_table_t *table : Table
+ *  const char *text : Message; need not be NUL-terminated
+ *  size_t text_len : Length of the message
+ *
+ * Return:
+ *  const command_entry_t * : The command, or NULL if the message is not one.
+ *
+ ******************************************************************************/
+const command_entry_t *command_table_lookup(const command_table_t *table,
+                                            const char *text, size_t text_len)
+{
+    const command_entry_t *entry;
+    uint32_t hash;
+    uint8_t index;
+
+    if (table->count == 0u)
+    {
+        return NULL;
+    }
+
+    hash = command_hash(text, text_len);
+    index = table->slots[command_slot(table, hash,
+                                      table->displacements[hash & (table->bucket_count - 1u)])];
+    if (index == COMMAND_TABLE_FREE_SLOT)
+    {
+        return NULL;
+    }
+
+    entry = &table->entries[index];
+    if ((entry->text_len != text_len) || (memcmp(entry->text, text, text_len) != 0))
+    {
+        return NULL;
+    }
+    return entry;
+}
+
+/* [] END OF FILE */
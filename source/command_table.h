@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name:   command_table.h
+*
+* Description: Perfect hash table mapping the text of a command message to
+*              its value.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef COMMAND_TABLE_H_
+#define COMMAND_TABLE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Maximum number of commands of a table. */
+#define COMMAND_TABLE_MAX_COMMANDS          (255u)
+
+/* Number of slots of a table of 'n' commands: the next power of two. Use it to
+ * size the 'slots' array passed to command_table_init().
+ */
+#define COMMAND_TABLE_SLOT_COUNT(n)                                            \
+    (((n) <= 4u) ? 4u : ((n) <= 8u) ? 8u : ((n) <= 16u) ? 16u :              \
+     ((n) <= 32u) ? 32u : ((n) <= 64u) ? 64u : ((n) <= 128u) ? 128u : 256u)
+
+/* Number of displacements of a table of 'n' commands: one per bucket of two
+ * slots. Use it to size the 'displacements' array passed to
+ * command_table_init().
+ */
+#define COMMAND_TABLE_BUCKET_COUNT(n)       (COMMAND_TABLE_SLOT_COUNT(n) / 2u)
+
+/* Initializer of a command_entry_t from a string literal; the length is
+ * computed by the compiler.
+ */
+#define COMMAND_ENTRY(text, value)          { (text), (uint16_t)(sizeof(text) - 1u), (value) }
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Command: message text, its length and the value it maps to. */
+typedef struct
+{
+    const char *text;
+    uint16_t text_len;
+    uint8_t value;
+} command_entry_t;
+
+/* Perfect hash of a constant set of commands (hash and displace). The hash of
+ * a message selects a bucket; the displacement of the bucket, chosen when the
+ * table is built, moves the commands of the bucket to distinct slots. A
+ * lookup therefore costs one hash of the message and one compare, whatever
+ * the number of commands.
+ */
+typedef struct
+{
+    const command_entry_t *entries;
+    uint32_t count;
+    uint8_t *slots;                     /* Entry index per slot; 0xFF if free */
+    uint16_t *displacements;            /* Displacement per bucket */
+    uint32_t slot_mask;
+    uint32_t bucket_count;
+} command_table_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+bool command_table_init(command_table_t *table, const command_entry_t *entries,
+                        uint32_t count, uint8_t *slots, uint16_t *displacements);
+const command_entry_t *command_table_lookup(const command_table_t *table,
+                                            const char *text, size_t text_len);
+
+#endif /* COMMAND_TABLE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name:   device_state.c
+*
+* Description: This file describes the device state message exchanged on the
+*              MQTT topics and encodes it with the CBOR codec of cbor.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "device_state.h"
+#include "cbor.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Keys of the fields in the encoded map. Never reuse a key for another
+ * meaning: receivers skip unknown keys but trust known ones.
+ */
+#define DEVICE_STATE_KEY_STATE              (1u)
+#define DEVICE_STATE_KEY_SEQUENCE           (2u)
+#define DEVICE_STATE_KEY_UPTIME             (3u)
+
+/******************************************************************************
+* Global Variables
+******************************************************************************/
+/* In the order of the DEVICE_STATE_FIELD_* bits. */
+static const cbor_schema_field_t device_state_fields[] =
+{
+    CBOR_SCHEMA_FIELD(device_state_t, DEVICE_STATE_KEY_STATE,    state,     CBOR_FIELD_UINT),
+    CBOR_SCHEMA_FIELD(device_state_t, DEVICE_STATE_KEY_SEQUENCE, sequence,  CBOR_FIELD_UINT),
+    CBOR_SCHEMA_FIELD(device_state_t, DEVICE_STATE_KEY_UPTIME,   uptime_ms, CBOR_FIELD_UINT)
+};
+
+static const cbor_schema_t device_state_schema =
+{
+    .fields = device_state_fields,
+    .count = sizeof(device_state_fields) / sizeof(device_state_fields[0]),
+    .required = DEVICE_STATE_FIELD_STATE
+};
+
+/******************************************************************************
+ * Function Name: device_state_encode
+ ******************************************************************************
+ * Summary:
+ *  Encodes the selected fields of a device state message.
+ *
+ * Parameters:
+ *  const device_state_t *message : Message to encode
+ *  uint32_t fields : DEVICE_STATE_FIELD_* bits of the fields to encode
+ *  void *buffer : Buffer for the encoded message
+ *  size_t size : Size of the buffer; DEVICE_STATE_MAX_ENCODED_SIZE always fits
+ *
+ * Return:
+ *  size_t : Length of the encoded message, 0 if it does not fit
+ *
+ ******************************************************************************/
+size_t device_state_encode(const device_state_t *message, uint32_t fields,
+                           void *buffer, size_t size)
+{
+    return cbor_schema_encode(&device_state_schema, message, fields, buffer, size);
+}
+
+/******************************************************************************
+ * Function Name: device_state_decode
+ ******************************************************************************
+ * Summary:
+ *  Decodes a device state message. The fields absent from the message are
+ *  left untouched.
+ *
+ * Parameters:
+ *  const void *buffer : Encoded message
+ *  size_t length : Length of the encoded message
+ *  device_state_t *message : Decoded message
+ *  uint32_t *fields : DEVICE_STATE_FIELD_* bits of the fields found; may be NULL
+ *
+ * Return:
+ *  bool : false if the data is not a device state message
+ *
+ ******************************************************************************/
+bool device_state_decode(const void *buffer, size_t length, device_state_t *message,
+                         uint32_t *fields)
+{
+    return cbor_schema_decode(&device_state_schema, buffer, length, message, fields);
+}
+
+/* [] END OF FILE */
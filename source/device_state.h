@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name:   device_state.h
+*
+* Description: This file is the public interface of device_state.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef DEVICE_STATE_H_
+#define DEVICE_STATE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Fields of a device state message, as bits of the 'fields' masks. */
+#define DEVICE_STATE_FIELD_STATE            (1u << 0)
+#define DEVICE_STATE_FIELD_SEQUENCE         (1u << 1)
+#define DEVICE_STATE_FIELD_UPTIME           (1u << 2)
+#define DEVICE_STATE_FIELD_ALL              (DEVICE_STATE_FIELD_STATE |              \
+                                             DEVICE_STATE_FIELD_SEQUENCE |           \
+                                             DEVICE_STATE_FIELD_UPTIME)
+
+/* Largest encoded device state message: a map header, and one key and a
+ * 32-bit value per field.
+ */
+#define DEVICE_STATE_MAX_ENCODED_SIZE       (1u + (3u * (1u + 5u)))
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Device state message, encoded as a CBOR map of integer keys (see
+ * device_state.c). Only 'state' is required; a receiver ignores the keys it
+ * does not know, so that fields can be added without breaking older devices.
+ */
+typedef struct
+{
+    uint32_t state;                 /* DEVICE_ON_STATE or DEVICE_OFF_STATE */
+    uint32_t sequence;              /* Incremented by the sender per message */
+    uint32_t uptime_ms;             /* Uptime of the sender */
+} device_state_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+size_t device_state_encode(const device_state_t *message, uint32_t fields,
+                           void *buffer, size_t size);
+bool device_state_decode(const void *buffer, size_t length, device_state_t *message,
+                         uint32_t *fields);
+
+#endif /* DEVICE_STATE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,414 @@
+/******************************************************************************
+* File Name:   dns_cache.c
+*
+* Description: This file contains a cache of the IPv4 addresses of host
+*              names, which the MQTT library resolves on every connection.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dns_cache.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+/* Middleware libraries */
+#include "cy_secure_sockets.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#if defined(DNS_CACHE_LINKER_WRAP)
+/* cy_socket_gethostbyname() of the secure-sockets library; the references to
+ * cy_socket_gethostbyname() are linked to __wrap_cy_socket_gethostbyname().
+ */
+#define RESOLVE_HOSTNAME                __real_cy_socket_gethostbyname
+#else
+#define RESOLVE_HOSTNAME                cy_socket_gethostbyname
+#endif /* DNS_CACHE_LINKER_WRAP */
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+#if defined(DNS_CACHE_LINKER_WRAP)
+cy_rslt_t __real_cy_socket_gethostbyname(const char *hostname, cy_socket_ip_version_t ip_ver,
+                                         cy_socket_ip_address_t *addr);
+cy_rslt_t __wrap_cy_socket_gethostbyname(const char *hostname, cy_socket_ip_version_t ip_ver,
+                                         cy_socket_ip_address_t *addr);
+#endif /* DNS_CACHE_LINKER_WRAP */
+
+#if ENABLE_DNS_CACHE
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Age limits of the cached addresses. In ticks rather than through
+ * pdMS_TO_TICKS(), which overflows for a day in milliseconds.
+ */
+#define FRESH_TICKS                     ((TickType_t) DNS_CACHE_TTL_S * configTICK_RATE_HZ)
+#define REFRESH_TICKS                   (FRESH_TICKS / 2u)
+#define STALE_TICKS                     ((TickType_t)(DNS_CACHE_TTL_S + DNS_CACHE_STALE_S) * \
+                                         configTICK_RATE_HZ)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Cached address of a host name. */
+typedef struct
+{
+    char hostname[DNS_CACHE_HOSTNAME_MAX_LEN + 1];
+    cy_socket_ip_address_t address;
+    TickType_t resolved_ticks;      /* Tick count of the last successful lookup */
+    TickType_t used_ticks;          /* Tick count of the last use, for the eviction */
+    bool valid;
+} dns_cache_entry_t;
+
+static dns_cache_entry_t entries[DNS_CACHE_SIZE];
+
+static dns_cache_stats_t cache_stats;
+
+/* Lookups timed for resolve_mean_ms and their total time. */
+static uint32_t resolve_count;
+static uint32_t resolve_total_ms;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static dns_cache_entry_t *find_entry(const char *hostname);
+static cy_rslt_t timed_resolve(const char *hostname, cy_socket_ip_address_t *address);
+static void store_entry(const char *hostname, const cy_socket_ip_address_t *address);
+
+/*******************************************************************************
+* Function Definitions
+********************************************************************************/
+
+/*******************************************************************************
+* Function Name: dns_cache_resolve
+********************************************************************************
+* Summary:
+* Looks up the IPv4 address of a host name. A fresh cached address is returned
+* without a DNS round trip. Otherwise, the name is resolved and the address
+* cached; if that fails, an address that expired less than
+* 'DNS_CACHE_STALE_S' seconds ago is returned instead. IPv6 lookups and names
+* longer than 'DNS_CACHE_HOSTNAME_MAX_LEN' go straight to the resolver.
+*
+* Parameters:
+*  const char *hostname : host name to look up
+*  cy_socket_ip_version_t ip_ver : IP version of the address
+*  cy_socket_ip_address_t *address : the address, on success
+*
+* Return:
+*  cy_rslt_t : CY_RSLT_SUCCESS, or the result of the failed lookup
+*
+*******************************************************************************/
+cy_rslt_t dns_cache_resolve(const char *hostname, cy_socket_ip_version_t ip_ver,
+                            cy_socket_ip_address_t *address)
+{
+    dns_cache_entry_t *entry;
+    cy_rslt_t result;
+    TickType_t now;
+
+    if ((CY_SOCKET_IP_VER_V4 != ip_ver) ||
+        (strlen(hostname) > DNS_CACHE_HOSTNAME_MAX_LEN))
+    {
+        taskENTER_CRITICAL();
+        cache_stats.bypassed++;
+        taskEXIT_CRITICAL();
+        return RESOLVE_HOSTNAME(hostname, ip_ver, address);
+    }
+
+    taskENTER_CRITICAL();
+    now = xTaskGetTickCount();
+    entry = find_entry(hostname);
+    if ((NULL != entry) && ((now - entry->resolved_ticks) < FRESH_TICKS))
+    {
+        *address = entry->address;
+        entry->used_ticks = now;
+        cache_stats.hits++;
+        cache_stats.saved_ms += cache_stats.resolve_mean_ms;
+        taskEXIT_CRITICAL();
+        return CY_RSLT_SUCCESS;
+    }
+    taskEXIT_CRITICAL();
+
+    /* The resolver blocks, so it runs outside of the critical section. */
+    result = timed_resolve(hostname, address);
+
+    taskENTER_CRITICAL();
+    if (CY_RSLT_SUCCESS == result)
+    {
+        cache_stats.misses++;
+        store_entry(hostname, address);
+    }
+    else
+    {
+        now = xTaskGetTickCount();
+        entry = find_entry(hostname);
+        if ((NULL != entry) && ((now - entry->resolved_ticks) < STALE_TICKS))
+        {
+            *address = entry->address;
+            entry->used_ticks = now;
+            cache_stats.stale_hits++;
+            result = CY_RSLT_SUCCESS;
+        }
+        else
+        {
+            cache_stats.failures++;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: dns_cache_refresh
+********************************************************************************
+* Summary:
+* Resolves the cached names again once half of their TTL has passed, so that
+* a lookup keeps finding a fresh address. An address the resolver could not
+* refresh is kept until it is too stale to be served. Blocks for the DNS
+* round trips; call it from a task that may wait, at least every quarter of
+* 'DNS_CACHE_TTL_S'.
+*
+*******************************************************************************/
+void dns_cache_refresh(void)
+{
+    char hostname[DNS_CACHE_HOSTNAME_MAX_LEN + 1];
+    cy_socket_ip_address_t address;
+    dns_cache_entry_t *entry;
+    bool refresh;
+
+    for (uint32_t index = 0; index < DNS_CACHE_SIZE; index++)
+    {
+        taskENTER_CRITICAL();
+        entry = &entries[index];
+        refresh = entry->valid &&
+                  ((xTaskGetTickCount() - entry->resolved_ticks) >= REFRESH_TICKS);
+        if (refresh)
+        {
+            memcpy(hostname, entry->hostname, sizeof(hostname));
+        }
+        taskEXIT_CRITICAL();
+
+        if (!refresh)
+        {
+            continue;
+        }
+
+        memset(&address, 0, sizeof(address));
+        if (CY_RSLT_SUCCESS == timed_resolve(hostname, &address))
+        {
+            taskENTER_CRITICAL();
+            cache_stats.refreshes++;
+            store_entry(hostname, &address);
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            /* Drop the address once it can no longer be served, before the
+             * tick count wraps around and makes it look fresh again.
+             */
+            taskENTER_CRITICAL();
+            entry = find_entry(hostname);
+            if ((NULL != entry) &&
+                ((xTaskGetTickCount() - entry->resolved_ticks) >= STALE_TICKS))
+            {
+                entry->valid = false;
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: dns_cache_get_stats
+********************************************************************************
+* Summary:
+* Copies the counters of the cache.
+*
+* Parameters:
+*  dns_cache_stats_t *stats : the counters
+*
+*******************************************************************************/
+void dns_cache_get_stats(dns_cache_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = cache_stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: find_entry
+********************************************************************************
+* Summary:
+* Finds the cache entry of a host name. Call it in a critical section.
+*
+* Parameters:
+*  const char *hostname : host name
+*
+* Return:
+*  dns_cache_entry_t * : the entry, or NULL if the name is not cached
+*
+*******************************************************************************/
+static dns_cache_entry_t *find_entry(const char *hostname)
+{
+    for (uint32_t index = 0; index < DNS_CACHE_SIZE; index++)
+    {
+        if (entries[index].valid && (0 == strcmp(entries[index].hostname, hostname)))
+        {
+            return &entries[index];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: timed_resolve
+********************************************************************************
+* Summary:
+* Resolves a host name with the resolver of the secure-sockets library and
+* adds the time it took to the mean resolver time.
+*
+* Parameters:
+*  const char *hostname : host name
+*  cy_socket_ip_address_t *address : the IPv4 address, on success
+*
+* Return:
+*  cy_rslt_t : result of the resolver
+*
+*******************************************************************************/
+static cy_rslt_t timed_resolve(const char *hostname, cy_socket_ip_address_t *address)
+{
+    TickType_t start_ticks = xTaskGetTickCount();
+    cy_rslt_t result = RESOLVE_HOSTNAME(hostname, CY_SOCKET_IP_VER_V4, address);
+    uint32_t elapsed_ms = (uint32_t)((xTaskGetTickCount() - start_ticks) * portTICK_PERIOD_MS);
+
+    /* Failed lookups count too: a timeout is what a hit saves at worst. */
+    taskENTER_CRITICAL();
+    resolve_count++;
+    resolve_total_ms += elapsed_ms;
+    cache_stats.resolve_mean_ms = resolve_total_ms / resolve_count;
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: store_entry
+********************************************************************************
+* Summary:
+* Caches the freshly resolved address of a host name, in its own entry, a free
+* one or else the least recently used one. Call it in a critical section.
+*
+* Parameters:
+*  const char *hostname : host name, at most 'DNS_CACHE_HOSTNAME_MAX_LEN' long
+*  const cy_socket_ip_address_t *address : its address
+*
+*******************************************************************************/
+static void store_entry(const char *hostname, const cy_socket_ip_address_t *address)
+{
+    TickType_t now = xTaskGetTickCount();
+    dns_cache_entry_t *entry = find_entry(hostname);
+
+    if (NULL == entry)
+    {
+        for (uint32_t index = 0; index < DNS_CACHE_SIZE; index++)
+        {
+            if (!entries[index].valid)
+            {
+                entry = &entries[index];
+                break;
+            }
+            if ((NULL == entry) ||
+                ((now - entries[index].used_ticks) > (now - entry->used_ticks)))
+            {
+                entry = &entries[index];
+            }
+        }
+        if (entry->valid)
+        {
+            cache_stats.evictions++;
+        }
+        strcpy(entry->hostname, hostname);
+        entry->used_ticks = now;
+        entry->valid = true;
+    }
+
+    entry->address = *address;
+    entry->resolved_ticks = now;
+}
+
+#endif /* ENABLE_DNS_CACHE */
+
+#if defined(DNS_CACHE_LINKER_WRAP)
+/*******************************************************************************
+* Function Name: __wrap_cy_socket_gethostbyname
+********************************************************************************
+* Summary:
+* Takes the place of cy_socket_gethostbyname() in the image (see the Makefile),
+* so that the MQTT library and the broker probes resolve through the cache.
+*
+* Parameters:
+*  const char *hostname : host name to look up
+*  cy_socket_ip_version_t ip_ver : IP version of the address
+*  cy_socket_ip_address_t *addr : the address, on success
+*
+* Return:
+*  cy_rslt_t : result of the lookup
+*
+*******************************************************************************/
+cy_rslt_t __wrap_cy_socket_gethostbyname(const char *hostname, cy_socket_ip_version_t ip_ver,
+                                         cy_socket_ip_address_t *addr)
+{
+#if ENABLE_DNS_CACHE
+    return dns_cache_resolve(hostname, ip_ver, addr);
+#else
+    return __real_cy_socket_gethostbyname(hostname, ip_ver, addr);
+#endif /* ENABLE_DNS_CACHE */
+}
+#endif /* DNS_CACHE_LINKER_WRAP */
+
+
+/* [] END OF FILE */
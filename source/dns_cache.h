@@ -0,0 +1,82 @@
+/******************************************************************************
+* File Name:   dns_cache.h
+*
+* Description: This file is the public interface of dns_cache.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef DNS_CACHE_H_
+#define DNS_CACHE_H_
+
+#include <stdint.h>
+#include "cy_secure_sockets.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Counters of the DNS cache. A lookup is a hit when a fresh address was
+ * found, a stale hit when the resolver failed and an expired address was
+ * served, else a miss. The time saved is the mean resolver time for every
+ * hit.
+ */
+typedef struct
+{
+    uint32_t hits;
+    uint32_t stale_hits;
+    uint32_t misses;
+    uint32_t failures;              /* Lookups the resolver failed and no address
+                                     * could be served */
+    uint32_t bypassed;              /* Lookups of IPv6 addresses or of names too
+                                     * long to be cached */
+    uint32_t refreshes;             /* Addresses resolved again in the background */
+    uint32_t evictions;             /* Names dropped for a new one */
+    uint32_t resolve_mean_ms;       /* Mean time of the resolver */
+    uint32_t saved_ms;              /* Resolver time saved by the hits */
+} dns_cache_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t dns_cache_resolve(const char *hostname, cy_socket_ip_version_t ip_ver,
+                            cy_socket_ip_address_t *address);
+void dns_cache_refresh(void);
+void dns_cache_get_stats(dns_cache_stats_t *stats);
+
+#endif /* DNS_CACHE_H_ */
+
+/* [] END OF FILE */
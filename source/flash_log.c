@@ -0,0 +1,951 @@
+/******************************************************************************
+* File Name:   flash_log.c
+*
+* Description: This file implements an append-only, CRC-protected message log
+*              on a NOR flash region. Records are written sequentially in
+*              page-sized programs, the sectors are reused in a circle for
+*              wear levelling, and the read position is kept in
+*              acknowledgement records so that undrained messages survive a
+*              reset.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "flash_log.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define SECTOR_MAGIC                    (0x474F4C46u)   /* "FLOG" */
+#define RECORD_MAGIC                    (0x4552u)       /* "RE" */
+
+/* Record types. */
+#define RECORD_TYPE_DATA                (0x01u)
+#define RECORD_TYPE_ACK                 (0x02u)
+
+/* Value of erased flash. */
+#define ERASED_BYTE                     (0xFFu)
+
+/* CRC-32 (IEEE 802.3, reflected) polynomial and initial value. */
+#define CRC32_POLYNOMIAL                (0xEDB88320u)
+#define CRC32_INITIAL                   (0xFFFFFFFFu)
+
+/* Chunk size used to checksum records directly from flash. */
+#define CRC_CHUNK_SIZE                  (64u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Decoded record header. */
+typedef struct
+{
+    uint16_t magic;
+    uint8_t type;
+    uint8_t topic_len;
+    uint16_t payload_len;
+    uint32_t sequence;
+    uint32_t crc;
+} record_header_t;
+
+/* Result of reading the record at an address. */
+typedef enum
+{
+    RECORD_VALID,
+    RECORD_END,             /* Erased flash: no more records in the sector */
+    RECORD_TORN,            /* Not a record: interrupted write */
+    RECORD_CORRUPT          /* Plausible header, bad CRC */
+} record_status_t;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t crc32_update(uint32_t crc, const void *data, size_t length);
+static void put_u16(uint8_t *buffer, uint16_t value);
+static void put_u32(uint8_t *buffer, uint32_t value);
+static uint16_t get_u16(const uint8_t *buffer);
+static uint32_t get_u32(const uint8_t *buffer);
+static bool is_erased(const uint8_t *data, size_t length);
+static uint32_t sector_start(const flash_log_t *log, uint32_t sector);
+static uint32_t sector_of(const flash_log_t *log, uint32_t address);
+static bool read_sector_header(const flash_log_t *log, uint32_t sector,
+                               uint32_t *sequence, uint32_t *erase_count);
+static record_status_t read_record(flash_log_t *log, uint32_t address,
+                                   record_header_t *header);
+static bool write_bytes(flash_log_t *log, const void *data, uint32_t length);
+static bool append_record(flash_log_t *log, uint8_t type, uint32_t sequence,
+                          const char *topic, const void *payload, size_t payload_len);
+static bool start_sector(flash_log_t *log, uint32_t sector);
+static bool start_next_sector(flash_log_t *log);
+static bool setup(flash_log_t *log, const flash_log_device_t *device,
+                  uint8_t *page_buffer, uint32_t ack_interval);
+
+/******************************************************************************
+ * Function Name: crc32_update
+ ******************************************************************************
+ * Summary:
+ *  Adds data to a running CRC-32, four bits at a time.
+ *
+ ******************************************************************************/
+static uint32_t crc32_update(uint32_t crc, const void *data, size_t length)
+{
+    static const uint32_t nibble_table[16] =
+    {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+        0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+    };
+    const uint8_t *bytes = (const uint8_t *) data;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0Fu];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0Fu];
+    }
+    return crc;
+}
+
+/******************************************************************************
+ * Function Name: put_u16 / put_u32 / get_u16 / get_u32
+ ******************************************************************************
+ * Summary:
+ *  Little-endian encoding of the header fields.
+ *
+ ******************************************************************************/
+static void put_u16(uint8_t *buffer, uint16_t value)
+{
+    buffer[0] = (uint8_t) value;
+    buffer[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t *buffer, uint32_t value)
+{
+    put_u16(buffer, (uint16_t) value);
+    put_u16(&buffer[2], (uint16_t)(value >> 16));
+}
+
+static uint16_t get_u16(const uint8_t *buffer)
+{
+    return (uint16_t)(buffer[0] | ((uint16_t) buffer[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *buffer)
+{
+    return get_u16(buffer) | ((uint32_t) get_u16(&buffer[2]) << 16);
+}
+
+/******************************************************************************
+ * Function Name: is_erased
+ ******************************************************************************
+ * Summary:
+ *  Tells whether all bytes hold the erased value.
+ *
+ ******************************************************************************/
+static bool is_erased(const uint8_t *data, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        if (data[i] != ERASED_BYTE)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: sector_start / sector_of
+ ******************************************************************************
+ * Summary:
+ *  Converts between sector indices and record addresses.
+ *
+ ******************************************************************************/
+static uint32_t sector_start(const flash_log_t *log, uint32_t sector)
+{
+    return sector * log->device->sector_size;
+}
+
+static uint32_t sector_of(const flash_log_t *log, uint32_t address)
+{
+    /* Record addresses lie behind the sector header, so the end of a sector
+     * belongs to that sector.
+     */
+    return (address - 1u) / log->device->sector_size;
+}
+
+/******************************************************************************
+ * Function Name: read_sector_header
+ ******************************************************************************
+ * Summary:
+ *  Reads and verifies the header of a sector.
+ *
+ * Return:
+ *  bool : true if the sector holds a valid header.
+ *
+ ******************************************************************************/
+static bool read_sector_header(const flash_log_t *log, uint32_t sector,
+                               uint32_t *sequence, uint32_t *erase_count)
+{
+    uint8_t header[FLASH_LOG_SECTOR_HEADER_SIZE];
+
+    if (!log->device->read(sector_start(log, sector), header, sizeof(header)) ||
+        (get_u32(header) != SECTOR_MAGIC) ||
+        (get_u32(&header[12]) != ~crc32_update(CRC32_INITIAL, header, 12u)))
+    {
+        return false;
+    }
+
+    *sequence = get_u32(&header[4]);
+    *erase_count = get_u32(&header[8]);
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: read_record
+ ******************************************************************************
+ * Summary:
+ *  Reads the record header at an address and verifies the CRC of the record
+ *  directly from flash.
+ *
+ ******************************************************************************/
+static record_status_t read_record(flash_log_t *log, uint32_t address,
+                                   record_header_t *header)
+{
+    uint8_t raw[FLASH_LOG_RECORD_HEADER_SIZE];
+    uint8_t chunk[CRC_CHUNK_SIZE];
+    uint32_t sector_end = sector_start(log, sector_of(log, address)) + log->device->sector_size;
+    uint32_t body_len;
+    uint32_t crc;
+
+    if ((address + FLASH_LOG_RECORD_HEADER_SIZE > sector_end) ||
+        !log->device->read(address, raw, sizeof(raw)))
+    {
+        return RECORD_END;
+    }
+
+    if (is_erased(raw, sizeof(raw)))
+    {
+        return RECORD_END;
+    }
+
+    header->magic = get_u16(raw);
+    header->type = raw[2];
+    header->topic_len = raw[3];
+    header->payload_len = get_u16(&raw[4]);
+    header->sequence = get_u32(&raw[8]);
+    header->crc = get_u32(&raw[12]);
+    body_len = (uint32_t) header->topic_len + header->payload_len;
+
+    if ((header->magic != RECORD_MAGIC) ||
+        ((header->type != RECORD_TYPE_DATA) && (header->type != RECORD_TYPE_ACK)) ||
+        (address + FLASH_LOG_RECORD_HEADER_SIZE + body_len > sector_end))
+    {
+        return RECORD_TORN;
+    }
+
+    crc = crc32_update(CRC32_INITIAL, raw, 12u);
+    address += FLASH_LOG_RECORD_HEADER_SIZE;
+    while (body_len > 0u)
+    {
+        uint32_t length = (body_len < sizeof(chunk)) ? body_len : sizeof(chunk);
+
+        if (!log->device->read(address, chunk, length))
+        {
+            return RECORD_CORRUPT;
+        }
+        crc = crc32_update(crc, chunk, length);
+        address += length;
+        body_len -= length;
+    }
+
+    return (~crc == header->crc) ? RECORD_VALID : RECORD_CORRUPT;
+}
+
+/******************************************************************************
+ * Function Name: write_bytes
+ ******************************************************************************
+ * Summary:
+ *  Appends bytes at the write address through the page image. A page is
+ *  programmed as soon as it is complete, so that the flash sees sequential
+ *  page-sized programs; flash_log_sync() programs a partial page.
+ *
+ ******************************************************************************/
+static bool write_bytes(flash_log_t *log, const void *data, uint32_t length)
+{
+    const uint8_t *bytes = (const uint8_t *) data;
+    uint32_t page_size = log->device->page_size;
+
+    while (length > 0u)
+    {
+        uint32_t offset = log->write_address % page_size;
+        uint32_t chunk = page_size - offset;
+
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+
+        memcpy(&log->page[offset], bytes, chunk);
+        log->write_address += chunk;
+        bytes += chunk;
+        length -= chunk;
+
+        if ((log->write_address % page_size) == 0u)
+        {
+            if (!flash_log_sync(log))
+            {
+                return false;
+            }
+            memset(log->page, ERASED_BYTE, page_size);
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: append_record
+ ******************************************************************************
+ * Summary:
+ *  Appends a record, starting the next sector if it does not fit in the
+ *  current one.
+ *
+ ******************************************************************************/
+static bool append_record(flash_log_t *log, uint8_t type, uint32_t sequence,
+                          const char *topic, const void *payload, size_t payload_len)
+{
+    uint8_t header[FLASH_LOG_RECORD_HEADER_SIZE];
+    size_t topic_len = (topic != NULL) ? (strlen(topic) + 1u) : 0u;
+    uint32_t record_len = FLASH_LOG_RECORD_HEADER_SIZE + (uint32_t)(topic_len + payload_len);
+    uint32_t crc;
+
+    if ((topic_len > UINT8_MAX) || (payload_len > UINT16_MAX) ||
+        (record_len > log->device->sector_size - FLASH_LOG_SECTOR_HEADER_SIZE))
+    {
+        return false;
+    }
+
+    if (log->write_address + record_len >
+        sector_start(log, log->head_sector) + log->device->sector_size)
+    {
+        if (!start_next_sector(log))
+        {
+            return false;
+        }
+    }
+
+    put_u16(header, RECORD_MAGIC);
+    header[2] = type;
+    header[3] = (uint8_t) topic_len;
+    put_u16(&header[4], (uint16_t) payload_len);
+    put_u16(&header[6], 0xFFFFu);
+    put_u32(&header[8], sequence);
+
+    crc = crc32_update(CRC32_INITIAL, header, 12u);
+    crc = crc32_update(crc, topic, topic_len);
+    crc = crc32_update(crc, payload, payload_len);
+    put_u32(&header[12], ~crc);
+
+    return write_bytes(log, header, sizeof(header)) &&
+           write_bytes(log, topic, (uint32_t) topic_len) &&
+           write_bytes(log, payload, (uint32_t) payload_len);
+}
+
+/******************************************************************************
+ * Function Name: start_sector
+ ******************************************************************************
+ * Summary:
+ *  Erases a sector, writes its header with the next sector sequence and
+ *  makes it the head sector.
+ *
+ ******************************************************************************/
+static bool start_sector(flash_log_t *log, uint32_t sector)
+{
+    uint8_t header[FLASH_LOG_SECTOR_HEADER_SIZE];
+    uint32_t sequence;
+    uint32_t erase_count = 0u;
+
+    (void) read_sector_header(log, sector, &sequence, &erase_count);
+
+    if (!log->device->erase(sector_start(log, sector)))
+    {
+        return false;
+    }
+    log->stats.sectors_erased++;
+    erase_count++;
+    if (erase_count > log->stats.max_erase_count)
+    {
+        log->stats.max_erase_count = erase_count;
+    }
+
+    log->sector_sequence++;
+    put_u32(header, SECTOR_MAGIC);
+    put_u32(&header[4], log->sector_sequence);
+    put_u32(&header[8], erase_count);
+    put_u32(&header[12], ~crc32_update(CRC32_INITIAL, header, 12u));
+
+    if (!log->device->program(sector_start(log, sector), header, sizeof(header)))
+    {
+        return false;
+    }
+
+    log->head_sector = sector;
+    log->write_address = sector_start(log, sector) + FLASH_LOG_SECTOR_HEADER_SIZE;
+    log->programmed_address = log->write_address;
+    memset(log->page, ERASED_BYTE, log->device->page_size);
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: start_next_sector
+ ******************************************************************************
+ * Summary:
+ *  Moves the head to the next sector. When the log is full, the oldest
+ *  sector is reclaimed and its undrained records are counted as dropped.
+ *
+ ******************************************************************************/
+static bool start_next_sector(flash_log_t *log)
+{
+    uint32_t next = (log->head_sector + 1u) % log->sector_count;
+
+    if (!flash_log_sync(log))
+    {
+        return false;
+    }
+
+    if (next == log->oldest_sector)
+    {
+        log->oldest_sector = (next + 1u) % log->sector_count;
+
+        if (sector_of(log, log->read_address) == next)
+        {
+            record_header_t header;
+            uint32_t address = log->read_address;
+            uint32_t sector_end = sector_start(log, next) + log->device->sector_size;
+
+            /* Count the undrained records that are about to be erased. */
+            while (address < sector_end)
+            {
+                record_status_t status = read_record(log, address, &header);
+
+                if ((status == RECORD_END) || (status == RECORD_TORN))
+                {
+                    break;
+                }
+                if ((status == RECORD_VALID) && (header.type == RECORD_TYPE_DATA) &&
+                    (log->pending > 0u))
+                {
+                    log->pending--;
+                    log->stats.dropped++;
+                }
+                address += FLASH_LOG_RECORD_HEADER_SIZE + header.topic_len + header.payload_len;
+            }
+
+            log->read_address = sector_start(log, log->oldest_sector) + FLASH_LOG_SECTOR_HEADER_SIZE;
+        }
+    }
+
+    return start_sector(log, next);
+}
+
+/******************************************************************************
+ * Function Name: setup
+ ******************************************************************************
+ * Summary:
+ *  Checks the geometry of the device and resets the state of the log.
+ *
+ ******************************************************************************/
+static bool setup(flash_log_t *log, const flash_log_device_t *device,
+                  uint8_t *page_buffer, uint32_t ack_interval)
+{
+    if ((device == NULL) || (page_buffer == NULL) || (device->page_size == 0u) ||
+        (device->sector_size % device->page_size != 0u) ||
+        (device->sector_size <= FLASH_LOG_SECTOR_HEADER_SIZE + FLASH_LOG_RECORD_HEADER_SIZE) ||
+        (device->size / device->sector_size < 2u))
+    {
+        return false;
+    }
+
+    memset(log, 0, sizeof(*log));
+    log->device = device;
+    log->page = page_buffer;
+    log->sector_count = device->size / device->sector_size;
+    log->ack_interval = (ack_interval > 0u) ? ack_interval : 1u;
+    log->next_sequence = 1u;
+    memset(log->page, ERASED_BYTE, device->page_size);
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: flash_log_format
+ ******************************************************************************
+ * Summary:
+ *  Discards the contents of the log and starts an empty log in the first
+ *  sector.
+ *
+ * Parameters:
+ *  flash_log_t *log : Log
+ *  const flash_log_device_t *device : Flash region holding the log
+ *  uint8_t *page_buffer : Buffer of 'page_size' bytes for the page image
+ *  uint32_t ack_interval : Drained records per acknowledgement record
+ *
+ * Return:
+ *  bool : true on success, false on a flash error or an invalid geometry.
+ *
+ ******************************************************************************/
+bool flash_log_format(flash_log_t *log, const flash_log_device_t *device,
+                      uint8_t *page_buffer, uint32_t ack_interval)
+{
+    if (!setup(log, device, page_buffer, ack_interval))
+    {
+        return false;
+    }
+
+    for (uint32_t sector = 1u; sector < log->sector_count; sector++)
+    {
+        if (!device->erase(sector_start(log, sector)))
+        {
+            return false;
+        }
+    }
+
+    if (!start_sector(log, 0u))
+    {
+        return false;
+    }
+    log->oldest_sector = 0u;
+    log->read_address = log->write_address;
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: flash_log_mount
+ ******************************************************************************
+ * Summary:
+ *  Recovers the log from flash after a reset: finds the head and the oldest
+ *  sector, the last acknowledged record and the end of the written data, and
+ *  places the read address on the first undrained record. A record torn by a
+ *  reset during a write is skipped by continuing in a fresh sector. An empty
+ *  or unreadable region is formatted.
+ *
+ * Parameters:
+ *  flash_log_t *log : Log
+ *  const flash_log_device_t *device : Flash region holding the log
+ *  uint8_t *page_buffer : Buffer of 'page_size' bytes for the page image
+ *  uint32_t ack_interval : Drained records per acknowledgement record; up to
+ *                          this many records are drained again after a reset
+ *
+ * Return:
+ *  bool : true on success, false on a flash error or an invalid geometry.
+ *
+ ******************************************************************************/
+bool flash_log_mount(flash_log_t *log, const flash_log_device_t *device,
+                     uint8_t *page_buffer, uint32_t ack_interval)
+{
+    record_header_t header;
+    record_status_t status = RECORD_END;
+    uint32_t sequence;
+    uint32_t erase_count;
+    uint32_t max_sequence = 0u;
+    uint32_t acked_sequence = 0u;
+    uint32_t address = 0u;
+    bool found = false;
+
+    if (!setup(log, device, page_buffer, ack_interval))
+    {
+        return false;
+    }
+
+    /* The head is the sector with the highest sequence, the oldest sector
+     * the first valid one after it.
+     */
+    for (uint32_t sector = 0u; sector < log->sector_count; sector++)
+    {
+        if (read_sector_header(log, sector, &sequence, &erase_count))
+        {
+            if (!found || (sequence > log->sector_sequence))
+            {
+                log->head_sector = sector;
+                log->sector_sequence = sequence;
+            }
+            if (erase_count > log->stats.max_erase_count)
+            {
+                log->stats.max_erase_count = erase_count;
+            }
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        return flash_log_format(log, device, page_buffer, ack_interval);
+    }
+
+    log->oldest_sector = log->head_sector;
+    for (uint32_t i = 1u; i < log->sector_count; i++)
+    {
+        uint32_t sector = (log->head_sector + i) % log->sector_count;
+
+        if (read_sector_header(log, sector, &sequence, &erase_count))
+        {
+            log->oldest_sector = sector;
+            break;
+        }
+    }
+
+    /* First pass: highest sequence, last acknowledgement and end of data. */
+    for (uint32_t sector = log->oldest_sector; ; sector = (sector + 1u) % log->sector_count)
+    {
+        address = sector_start(log, sector) + FLASH_LOG_SECTOR_HEADER_SIZE;
+        while (true)
+        {
+            status = read_record(log, address, &header);
+            if ((status == RECORD_END) || (status == RECORD_TORN))
+            {
+                break;
+            }
+            if (status == RECORD_VALID)
+            {
+                max_sequence = (header.sequence > max_sequence) ? header.sequence : max_sequence;
+                if ((header.type == RECORD_TYPE_ACK) && (header.sequence > acked_sequence))
+                {
+                    acked_sequence = header.sequence;
+                }
+            }
+            address += FLASH_LOG_RECORD_HEADER_SIZE + header.topic_len + header.payload_len;
+        }
+
+        if (sector == log->head_sector)
+        {
+            break;
+        }
+    }
+
+    log->write_address = address;
+    log->programmed_address = address;
+    log->next_sequence = max_sequence + 1u;
+    log->drained_sequence = acked_sequence;
+    log->read_address = address;
+
+    /* Second pass: first undrained record and the number of them. */
+    found = false;
+    for (uint32_t sector = log->oldest_sector; ; sector = (sector + 1u) % log->sector_count)
+    {
+        uint32_t record_address = sector_start(log, sector) + FLASH_LOG_SECTOR_HEADER_SIZE;
+
+        while (record_address < ((sector == log->head_sector) ? log->write_address :
+                                 sector_start(log, sector) + device->sector_size))
+        {
+            record_status_t record_status = read_record(log, record_address, &header);
+
+            if ((record_status == RECORD_END) || (record_status == RECORD_TORN))
+            {
+                break;
+            }
+            if ((record_status == RECORD_VALID) && (header.type == RECORD_TYPE_DATA) &&
+                (header.sequence > acked_sequence))
+            {
+                if (!found)
+                {
+                    log->read_address = record_address;
+                    found = true;
+                }
+                log->pending++;
+            }
+            record_address += FLASH_LOG_RECORD_HEADER_SIZE + header.topic_len + header.payload_len;
+        }
+
+        if (sector == log->head_sector)
+        {
+            break;
+        }
+    }
+
+    /* Never write behind a torn record. */
+    if (status == RECORD_TORN)
+    {
+        bool read_at_end = (log->read_address == log->write_address);
+
+        if (!start_next_sector(log))
+        {
+            return false;
+        }
+        if (read_at_end)
+        {
+            log->read_address = log->write_address;
+        }
+    }
+    else if (log->write_address % device->page_size != 0u)
+    {
+        /* Continue the partially programmed page. */
+        uint32_t page_base = log->write_address - (log->write_address % device->page_size);
+
+        if (!device->read(page_base, log->page, device->page_size))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: flash_log_append
+ ******************************************************************************
+ * Summary:
+ *  Appends a message to the log. The record is staged in the page image and
+ *  is durable once its page is programmed or flash_log_sync() is called. When
+ *  the log is full, the oldest sector is reclaimed.
+ *
+ * Parameters:
+ *  flash_log_t *log : Log
+ *  const char *topic : MQTT topic of the message (up to 254 characters)
+ *  const void *payload : Payload of the message
+ *  size_t payload_len : Length of the payload in bytes
+ *
+ * Return:
+ *  bool : true if the message was appended, false if it is too large for a
+ *         sector or on a flash error.
+ *
+ ******************************************************************************/
+bool flash_log_append(flash_log_t *log, const char *topic, const void *payload,
+                      size_t payload_len)
+{
+    if (!append_record(log, RECORD_TYPE_DATA, log->next_sequence, topic, payload, payload_len))
+    {
+        return false;
+    }
+
+    log->next_sequence++;
+    log->pending++;
+    log->stats.appended++;
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: flash_log_sync
+ ******************************************************************************
+ * Summary:
+ *  Programs the staged bytes of the current page, making all appended
+ *  records durable. Only bytes that were not programmed before are written.
+ *
+ * Parameters:
+ *  flash_log_t *log : Log
+ *
+ * Return:
+ *  bool : true on success, false on a flash error.
+ *
+ ******************************************************************************/
+bool flash_log_sync(flash_log_t *log)
+{
+    uint32_t page_size = log->device->page_size;
+    uint32_t offset = log->programmed_address % page_size;
+    uint32_t length = log->write_address - log->programmed_address;
+
+    if (length == 0u)
+    {
+        return true;
+    }
+
+    if (!log->device->program(log->programmed_address, &log->page[offset], length))
+    {
+        return false;
+    }
+
+    log->programmed_address = log->write_address;
+    log->stats.pages_programmed++;
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: flash_log_peek
+ ******************************************************************************
+ * Summary:
+ *  Reads the oldest undrained message without draining it. Acknowledgement
+ *  records are skipped, as are records with a bad CRC.
+ *
+ * Parameters:
+ *  flash_log_t *log : Log
+ *  flash_log_record_t *record : Pointer to store the message
+ *  uint8_t *buffer : Buffer for the topic and payload of the message
+ *  size_t buffer_size : Size of the buffer in bytes
+ *
+ * Return:
+ *  bool : true if a message was read, false if the log is drained or on a
+ *         flash error.
+ *
+ ******************************************************************************/
+bool flash_log_peek(flash_log_t *log, flash_log_record_t *record, uint8_t *buffer,
+                    size_t buffer_size)
+{
+    record_header_t header;
+
+    while ((log->pending > 0u) && (log->read_address != log->write_address))
+    {
+        uint32_t sector = sector_of(log, log->read_address);
+        record_status_t status;
+        uint32_t body_len;
+
+        /* Records must be in flash before they are read back. */
+        if ((sector == log->head_sector) && (log->programmed_address != log->write_address) &&
+            !flash_log_sync(log))
+        {
+            return false;
+        }
+
+        status = read_record(log, log->read_address, &header);
+        if ((status == RECORD_END) || (status == RECORD_TORN))
+        {
+            if (sector == log->head_sector)
+            {
+                break;
+            }
+            log->read_address = sector_start(log, (sector + 1u) % log->sector_count) +
+                                FLASH_LOG_SECTOR_HEADER_SIZE;
+            continue;
+        }
+
+        body_len = (uint32_t) header.topic_len + header.payload_len;
+        if (status == RECORD_CORRUPT)
+        {
+            /* Not counted as pending by flash_log_mount(). */
+            log->stats.corrupt_records++;
+            log->read_address += FLASH_LOG_RECORD_HEADER_SIZE + body_len;
+            continue;
+        }
+        if ((header.type != RECORD_TYPE_DATA) || (body_len > buffer_size) ||
+            (header.topic_len == 0u))
+        {
+            if (header.type == RECORD_TYPE_DATA)
+            {
+                log->pending--;
+                log->stats.dropped++;
+            }
+            log->read_address += FLASH_LOG_RECORD_HEADER_SIZE + body_len;
+            continue;
+        }
+
+        if (!log->device->read(log->read_address + FLASH_LOG_RECORD_HEADER_SIZE, buffer, body_len))
+        {
+            return false;
+        }
+        buffer[header.topic_len - 1u] = '\0';
+
+        record->topic = (const char *) buffer;
+        record->payload = &buffer[header.topic_len];
+        record->payload_len = header.payload_len;
+        record->sequence = header.sequence;
+
+        log->peeked_next_address = log->read_address + FLASH_LOG_RECORD_HEADER_SIZE + body_len;
+        log->peeked_sequence = header.sequence;
+        return true;
+    }
+
+    log->pending = 0u;
+    return false;
+}
+
+/******************************************************************************
+ * Function Name: flash_log_consume
+ ******************************************************************************
+ * Summary:
+ *  Drains the message returned by the last flash_log_peek(). Every
+ *  'ack_interval' messages, and when the log runs empty, an acknowledgement
+ *  record is appended and synced so that the read position survives a reset.
+ *
+ * Parameters:
+ *  flash_log_t *log : Log
+ *
+ * Return:
+ *  bool : true on success, false on a flash error.
+ *
+ ******************************************************************************/
+bool flash_log_consume(flash_log_t *log)
+{
+    if (log->pending == 0u)
+    {
+        return true;
+    }
+
+    log->read_address = log->peeked_next_address;
+    log->drained_sequence = log->peeked_sequence;
+    log->pending--;
+    log->unacked++;
+    log->stats.drained++;
+
+    if ((log->unacked >= log->ack_interval) || (log->pending == 0u))
+    {
+        bool read_at_end = (log->read_address == log->write_address);
+
+        if (!append_record(log, RECORD_TYPE_ACK, log->drained_sequence, NULL, NULL, 0u) ||
+            !flash_log_sync(log))
+        {
+            return false;
+        }
+        log->unacked = 0u;
+
+        /* Step over the acknowledgement when it was appended right at the
+         * read position.
+         */
+        if (read_at_end)
+        {
+            log->read_address = log->write_address;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: flash_log_pending
+ ******************************************************************************
+ * Summary:
+ *  Returns the number of messages waiting to be drained.
+ *
+ * Parameters:
+ *  const flash_log_t *log : Log
+ *
+ * Return:
+ *  uint32_t : Number of messages
+ *
+ ******************************************************************************/
+uint32_t flash_log_pending(const flash_log_t *log)
+{
+    return log->pending;
+}
+
+/* [] END OF FILE */
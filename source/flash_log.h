@@ -0,0 +1,149 @@
+/******************************************************************************
+* File Name:   flash_log.h
+*
+* Description: This file is the public interface of flash_log.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FLASH_LOG_H_
+#define FLASH_LOG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Every sector of the log starts with a sector header, followed by records.
+ * A record is a record header followed by the NUL-terminated topic and the
+ * payload. All fields are little-endian.
+ *
+ *   sector header: | magic:4 | sequence:4 | erase count:4 | crc32:4 |
+ *   record header: | magic:2 | type:1 | topic len:1 | payload len:2 |
+ *                  | 0xFFFF:2 | sequence:4 | crc32:4 |
+ *
+ * The CRC of a record covers its header (without the CRC) and its body.
+ */
+#define FLASH_LOG_SECTOR_HEADER_SIZE       (16u)
+#define FLASH_LOG_RECORD_HEADER_SIZE       (16u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Flash region holding the log. Addresses are relative to the start of the
+ * region. 'sector_size' is the erase unit and a multiple of 'page_size', the
+ * program unit; the region holds at least two sectors. Programming only
+ * clears bits, as on NOR flash.
+ */
+typedef struct
+{
+    uint32_t size;
+    uint32_t sector_size;
+    uint32_t page_size;
+    bool (*read)(uint32_t address, void *data, uint32_t length);
+    bool (*program)(uint32_t address, const void *data, uint32_t length);
+    bool (*erase)(uint32_t address);
+} flash_log_device_t;
+
+/* Log counters. */
+typedef struct
+{
+    uint32_t appended;
+    uint32_t drained;
+    uint32_t dropped;               /* Undrained records lost to sector reclaim */
+    uint32_t corrupt_records;       /* Records skipped for a bad CRC */
+    uint32_t pages_programmed;
+    uint32_t sectors_erased;
+    uint32_t max_erase_count;       /* Highest erase count of any sector */
+} flash_log_stats_t;
+
+/* Record returned by flash_log_peek(). The pointers refer to the buffer
+ * passed to it.
+ */
+typedef struct
+{
+    const char *topic;
+    const uint8_t *payload;
+    uint16_t payload_len;
+    uint32_t sequence;
+} flash_log_record_t;
+
+/* Append-only message log. Records are appended at the write address and
+ * drained from the read address; the sectors are used in a circle, which
+ * spreads the erases evenly. Drained records are marked by acknowledgement
+ * records, so that the read position survives a reset.
+ */
+typedef struct
+{
+    const flash_log_device_t *device;
+    uint8_t *page;                  /* Image of the page being written */
+    uint32_t sector_count;
+    uint32_t head_sector;           /* Sector being written */
+    uint32_t oldest_sector;
+    uint32_t sector_sequence;       /* Sequence of the head sector */
+    uint32_t write_address;
+    uint32_t programmed_address;    /* Bytes below it are in flash */
+    uint32_t read_address;
+    uint32_t peeked_next_address;   /* Record after the peeked one */
+    uint32_t peeked_sequence;
+    uint32_t next_sequence;
+    uint32_t drained_sequence;      /* Last drained record */
+    uint32_t ack_interval;
+    uint32_t unacked;               /* Drained records not acknowledged yet */
+    uint32_t pending;               /* Records waiting to be drained */
+    flash_log_stats_t stats;
+} flash_log_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+bool flash_log_mount(flash_log_t *log, const flash_log_device_t *device,
+                     uint8_t *page_buffer, uint32_t ack_interval);
+bool flash_log_format(flash_log_t *log, const flash_log_device_t *device,
+                      uint8_t *page_buffer, uint32_t ack_interval);
+bool flash_log_append(flash_log_t *log, const char *topic, const void *payload,
+                      size_t payload_len);
+bool flash_log_sync(flash_log_t *log);
+bool flash_log_peek(flash_log_t *log, flash_log_record_t *record, uint8_t *buffer,
+                    size_t buffer_size);
+bool flash_log_consume(flash_log_t *log);
+uint32_t flash_log_pending(const flash_log_t *log);
+
+#endif /* FLASH_LOG_H_ */
+
+/* [] END OF FILE */
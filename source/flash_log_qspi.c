@@ -0,0 +1,218 @@
+/******************************************************************************
+* File Name:   flash_log_qspi.c
+*
+* Description: This file exposes the top of the external QSPI NOR flash as
+*              the flash region of the persistent publish outbox, using the
+*              serial flash library.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "mqtt_client_config.h"
+#include "flash_log_qspi.h"
+
+#if ENABLE_PERSISTENT_OUTBOX
+
+#include "cy_serial_flash_qspi.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Start of the region in the serial flash. */
+static uint32_t region_base;
+
+static flash_log_device_t qspi_device;
+
+/* Held while the XIP mode is off, or while another user reads through it. */
+static SemaphoreHandle_t xip_lock;
+static StaticSemaphore_t xip_lock_buffer;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool qspi_read(uint32_t address, void *data, uint32_t length);
+static bool qspi_program(uint32_t address, const void *data, uint32_t length);
+static bool qspi_erase(uint32_t address);
+
+/******************************************************************************
+ * Function Name: flash_log_qspi_init
+ ******************************************************************************
+ * Summary:
+ *  Creates the lock that serializes the flash operations of the region with
+ *  the other users of the XIP mode. Called by main() once the XIP mode is
+ *  enabled, before any task runs.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void flash_log_qspi_init(void)
+{
+    xip_lock = xSemaphoreCreateMutexStatic(&xip_lock_buffer);
+}
+
+/******************************************************************************
+ * Function Name: flash_log_qspi_xip_lock / flash_log_qspi_xip_unlock
+ ******************************************************************************
+ * Summary:
+ *  Keeps the XIP mode on between the two calls. Every code path that reads
+ *  the flash through XIP after the scheduler starts must hold the lock. In
+ *  this application, the only such path is the download of the Wi-Fi
+ *  firmware and the CLM blob by cy_wcm_init(); no code or data is placed in
+ *  the external flash otherwise.
+ *
+ ******************************************************************************/
+void flash_log_qspi_xip_lock(void)
+{
+    if (xip_lock != NULL)
+    {
+        (void) xSemaphoreTake(xip_lock, portMAX_DELAY);
+    }
+}
+
+void flash_log_qspi_xip_unlock(void)
+{
+    if (xip_lock != NULL)
+    {
+        (void) xSemaphoreGive(xip_lock);
+    }
+}
+
+/******************************************************************************
+ * Function Name: flash_log_qspi_device
+ ******************************************************************************
+ * Summary:
+ *  Describes the last 'region_size' bytes of the serial flash, which must be
+ *  initialized by main(). The Wi-Fi firmware is read from the start of the
+ *  flash in XIP mode, so the region must not overlap it.
+ *
+ * Parameters:
+ *  uint32_t region_size : Size of the region in bytes
+ *
+ * Return:
+ *  const flash_log_device_t * : The region, or NULL if the flash is smaller
+ *                               than the region or its erase size is not
+ *                               uniform over the region.
+ *
+ ******************************************************************************/
+const flash_log_device_t *flash_log_qspi_device(uint32_t region_size)
+{
+    uint32_t flash_size = (uint32_t) cy_serial_flash_qspi_get_size();
+
+    /* Without the lock, the region could leave the XIP mode under the Wi-Fi
+     * stack.
+     */
+    if ((xip_lock == NULL) || (region_size == 0u) || (flash_size < region_size))
+    {
+        return NULL;
+    }
+
+    region_base = flash_size - region_size;
+    qspi_device.size = region_size;
+    qspi_device.sector_size = (uint32_t) cy_serial_flash_qspi_get_erase_size(region_base);
+    qspi_device.page_size = (uint32_t) cy_serial_flash_qspi_get_prog_size(region_base);
+    qspi_device.read = qspi_read;
+    qspi_device.program = qspi_program;
+    qspi_device.erase = qspi_erase;
+
+    /* Hybrid-sector parts have small sectors only at the ends of the flash;
+     * reject a region that straddles them.
+     */
+    if ((qspi_device.sector_size == 0u) || (region_base % qspi_device.sector_size != 0u) ||
+        (cy_serial_flash_qspi_get_erase_size(flash_size - 1u) != qspi_device.sector_size))
+    {
+        return NULL;
+    }
+
+    return &qspi_device;
+}
+
+/******************************************************************************
+ * Function Name: qspi_read / qspi_program / qspi_erase
+ ******************************************************************************
+ * Summary:
+ *  Flash operations of the region. The memory-mapped (XIP) mode is left for
+ *  the duration of the operation and entered again afterwards, with the XIP
+ *  lock held so that no other user reads the flash in between.
+ *
+ ******************************************************************************/
+static bool qspi_read(uint32_t address, void *data, uint32_t length)
+{
+    cy_rslt_t result;
+
+    flash_log_qspi_xip_lock();
+    cy_serial_flash_qspi_enable_xip(false);
+    result = cy_serial_flash_qspi_read(region_base + address, length, (uint8_t *) data);
+    cy_serial_flash_qspi_enable_xip(true);
+    flash_log_qspi_xip_unlock();
+
+    return (CY_RSLT_SUCCESS == result);
+}
+
+static bool qspi_program(uint32_t address, const void *data, uint32_t length)
+{
+    cy_rslt_t result;
+
+    flash_log_qspi_xip_lock();
+    cy_serial_flash_qspi_enable_xip(false);
+    result = cy_serial_flash_qspi_write(region_base + address, length, (const uint8_t *) data);
+    cy_serial_flash_qspi_enable_xip(true);
+    flash_log_qspi_xip_unlock();
+
+    return (CY_RSLT_SUCCESS == result);
+}
+
+static bool qspi_erase(uint32_t address)
+{
+    cy_rslt_t result;
+
+    flash_log_qspi_xip_lock();
+    cy_serial_flash_qspi_enable_xip(false);
+    result = cy_serial_flash_qspi_erase(region_base + address, qspi_device.sector_size);
+    cy_serial_flash_qspi_enable_xip(true);
+    flash_log_qspi_xip_unlock();
+
+    return (CY_RSLT_SUCCESS == result);
+}
+
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+
+/* [] END OF FILE */
@@ -1,9 +1,13 @@
 /******************************************************************************
 * File Name:   heap_usage.c
 *
-* Description: This file contains the code for printing heap usage.
-*              Supports only GCC_ARM compiler. Define PRINT_HEAP_USAGE for
-*              printing the heap usage numbers.
+* Description: This file contains the heap telemetry sampler. Heap usage
+*              is read using mallinfo() and recorded into a small ring
+*              buffer, periodically from a software timer and whenever a new
+*              allocation high-water mark is observed. The ring buffer is
+*              printed on demand using heap_usage_dump(). Supports only
+*              GCC_ARM compiler; the functions do nothing with other
+*              compilers.
 *
 * Related Document: See README.md
 *
@@ -45,19 +49,74 @@
  * Header file includes
  ******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include <inttypes.h>
 #include <stdio.h>
 
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+#include "heap_usage.h"
+#include "static_alloc.h"
+#include "app_log.h"
+
 /* ARM compiler also defines __GNUC__ */
 #if defined (__GNUC__) && !defined(__ARMCC_VERSION)
 #include <malloc.h>
+#define HEAP_USAGE_SUPPORTED
 #endif /* #if defined (__GNUC__) && !defined(__ARMCC_VERSION) */
 
 
 /*******************************************************************************
  * Macros
  ******************************************************************************/
-#define TO_KB(size_bytes)  ((float)(size_bytes)/1024)
+/* Log level of this module. */
+#define APP_LOG_MODULE_LEVEL            APP_LOG_LEVEL_HEAP_USAGE
+
+/* Bytes to KB with one decimal, as an integer number of tenths. */
+#define TO_KB_TENTHS(size_bytes)        ((uint32_t)(((uint64_t)(size_bytes) * 10u) / 1024u))
+
+/* glibc (host build) deprecates mallinfo() in favour of mallinfo2(). */
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 33)))
+#define HEAP_MALLINFO()                 mallinfo2()
+#define HEAP_MALLINFO_T                 struct mallinfo2
+#else
+#define HEAP_MALLINFO()                 mallinfo()
+#define HEAP_MALLINFO_T                 struct mallinfo
+#endif
+
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+#ifdef HEAP_USAGE_SUPPORTED
+/* Ring buffer of heap samples; 'sample_head' counts every sample ever taken. */
+static heap_usage_sample_t sample_ring[HEAP_USAGE_RING_SIZE];
+static uint32_t sample_head;
+
+/* Largest 'in_use' and 'footprint' recorded so far. */
+static uint32_t peak_in_use;
+static uint32_t peak_footprint;
+
+/* Software timer that takes the periodic samples. */
+static TimerHandle_t heap_sample_timer;
+#if ENABLE_STATIC_ALLOCATION
+static StaticTimer_t heap_sample_timer_buffer;
+#endif /* ENABLE_STATIC_ALLOCATION */
+#endif /* HEAP_USAGE_SUPPORTED */
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+#ifdef HEAP_USAGE_SUPPORTED
+static void take_sample(const char *tag);
+static void heap_sample_timer_callback(TimerHandle_t timer);
+#endif /* HEAP_USAGE_SUPPORTED */
 
 
 /*******************************************************************************
@@ -65,37 +124,214 @@
  ******************************************************************************/
 
 /*******************************************************************************
-* Function Name: print_heap_usage
+* Function Name: heap_usage_sampler_init
+********************************************************************************
+* Summary:
+* Starts the software timer that records a heap sample every
+* HEAP_USAGE_SAMPLE_INTERVAL_MS milliseconds. Periodic sampling is disabled
+* when the interval is 0. The message handling paths take no samples:
+* mallinfo() takes the allocator lock and walks the free bins.
+*
+*******************************************************************************/
+void heap_usage_sampler_init(void)
+{
+#ifdef HEAP_USAGE_SUPPORTED
+#if (HEAP_USAGE_SAMPLE_INTERVAL_MS > 0)
+    if (heap_sample_timer == NULL)
+    {
+#if ENABLE_STATIC_ALLOCATION
+        heap_sample_timer = xTimerCreateStatic("Heap sampler",
+                                               pdMS_TO_TICKS(HEAP_USAGE_SAMPLE_INTERVAL_MS),
+                                               pdTRUE, NULL, heap_sample_timer_callback,
+                                               &heap_sample_timer_buffer);
+        static_alloc_account(sizeof(heap_sample_timer_buffer));
+#else
+        heap_sample_timer = xTimerCreate("Heap sampler",
+                                         pdMS_TO_TICKS(HEAP_USAGE_SAMPLE_INTERVAL_MS),
+                                         pdTRUE, NULL, heap_sample_timer_callback);
+#endif /* ENABLE_STATIC_ALLOCATION */
+        if ((heap_sample_timer == NULL) || (xTimerStart(heap_sample_timer, 0) != pdPASS))
+        {
+            APP_LOG_ERR("Failed to start the heap usage sampler!\n");
+        }
+    }
+#endif /* (HEAP_USAGE_SAMPLE_INTERVAL_MS > 0) */
+#endif /* HEAP_USAGE_SUPPORTED */
+}
+
+/*******************************************************************************
+* Function Name: heap_usage_sample
+********************************************************************************
+* Summary:
+* Records the current heap usage into the ring buffer.
+*
+* Parameters:
+*  const char *tag : Static string naming the sampling point; it is stored by
+*                    reference.
+*
+*******************************************************************************/
+void heap_usage_sample(const char *tag)
+{
+#ifdef HEAP_USAGE_SUPPORTED
+    take_sample(tag);
+#else
+    (void) tag;
+#endif /* HEAP_USAGE_SUPPORTED */
+}
+
+/*******************************************************************************
+* Function Name: heap_usage_in_use
+********************************************************************************
+* Summary:
+* Returns the bytes allocated from the heap at this point, without recording a
+* sample. Used to measure the heap taken by an operation.
+*
+* Return:
+*  uint32_t : Bytes allocated, or 0 where mallinfo() is not available
+*
+*******************************************************************************/
+uint32_t heap_usage_in_use(void)
+{
+#ifdef HEAP_USAGE_SUPPORTED
+    HEAP_MALLINFO_T mall_info = HEAP_MALLINFO();
+
+    return (uint32_t) mall_info.uordblks;
+#else
+    return 0u;
+#endif /* HEAP_USAGE_SUPPORTED */
+}
+
+/*******************************************************************************
+* Function Name: heap_usage_get_samples
 ********************************************************************************
 * Summary:
-* Prints the available heap and utilized heap by using mallinfo().
+* Copies the samples held in the ring buffer, oldest first.
+*
+* Parameters:
+*  heap_usage_sample_t *samples : Array to copy the samples into
+*  uint32_t max_samples : Number of entries in 'samples'
+*
+* Return:
+*  uint32_t : Number of samples copied
 *
 *******************************************************************************/
-void print_heap_usage(char *msg)
+uint32_t heap_usage_get_samples(heap_usage_sample_t *samples, uint32_t max_samples)
 {
-    /* ARM compiler also defines __GNUC__ */
-#if defined(PRINT_HEAP_USAGE) && defined (__GNUC__) && !defined(__ARMCC_VERSION)
-    struct mallinfo mall_info = mallinfo();
+#ifdef HEAP_USAGE_SUPPORTED
+    uint32_t copied = 0;
+
+    taskENTER_CRITICAL();
+    uint32_t available = (sample_head < HEAP_USAGE_RING_SIZE) ? sample_head : HEAP_USAGE_RING_SIZE;
+    uint32_t first = sample_head - available;
+
+    /* Keep the newest samples if the caller's array is smaller. */
+    if (available > max_samples)
+    {
+        first += available - max_samples;
+        available = max_samples;
+    }
+
+    for (copied = 0; copied < available; copied++)
+    {
+        samples[copied] = sample_ring[(first + copied) % HEAP_USAGE_RING_SIZE];
+    }
+    taskEXIT_CRITICAL();
+
+    return copied;
+#else
+    (void) samples;
+    (void) max_samples;
+    return 0;
+#endif /* HEAP_USAGE_SUPPORTED */
+}
+
+/*******************************************************************************
+* Function Name: heap_usage_dump
+********************************************************************************
+* Summary:
+* Prints the samples held in the ring buffer. Only integer formatting is used.
+*
+*******************************************************************************/
+void heap_usage_dump(void)
+{
+#ifdef HEAP_USAGE_SUPPORTED
+    heap_usage_sample_t samples[HEAP_USAGE_RING_SIZE];
+    uint32_t count = heap_usage_get_samples(samples, HEAP_USAGE_RING_SIZE);
+
+    APP_LOG_INFO("\r\n\n********** Heap Usage **********\r\n");
 
+#if defined(__arm__)
     extern uint8_t __HeapBase;  /* Symbol exported by the linker. */
     extern uint8_t __HeapLimit; /* Symbol exported by the linker. */
 
-    uint8_t* heap_base = (uint8_t *)&__HeapBase;
-    uint8_t* heap_limit = (uint8_t *)&__HeapLimit;
-    uint32_t heap_size = (uint32_t)(heap_limit - heap_base);
+    uint32_t heap_size = (uint32_t)((uint8_t *)&__HeapLimit - (uint8_t *)&__HeapBase);
 
-    printf("\r\n\n********** Heap Usage **********\r\n");
-    printf(msg);
-    printf("\r\nTotal available heap        : %"PRIu32" bytes/%.2f KB\r\n", heap_size, TO_KB(heap_size));
+    APP_LOG_INFO("Total available heap        : %"PRIu32" bytes/%"PRIu32".%"PRIu32" KB\r\n",
+                 heap_size, TO_KB_TENTHS(heap_size) / 10u, TO_KB_TENTHS(heap_size) % 10u);
+#endif /* defined(__arm__) */
 
-    printf("Maximum heap utilized so far: %u bytes/%.2f KB, %.2f%% of available heap\r\n",
-            mall_info.arena, TO_KB(mall_info.arena), ((float) mall_info.arena * 100u)/heap_size);
+    APP_LOG_INFO("Maximum heap utilized so far: %"PRIu32" bytes/%"PRIu32".%"PRIu32" KB\r\n",
+                 peak_footprint, TO_KB_TENTHS(peak_footprint) / 10u, TO_KB_TENTHS(peak_footprint) % 10u);
+    APP_LOG_INFO("Peak heap in use            : %"PRIu32" bytes/%"PRIu32".%"PRIu32" KB\r\n",
+                 peak_in_use, TO_KB_TENTHS(peak_in_use) / 10u, TO_KB_TENTHS(peak_in_use) % 10u);
 
-    printf("Heap in use at this point   : %u bytes/%.2f KB, %.2f%% of available heap\r\n",
-            mall_info.uordblks, TO_KB(mall_info.uordblks), ((float) mall_info.uordblks * 100u)/heap_size);
+    APP_LOG_INFO("%"PRIu32" of %"PRIu32" samples:\r\n", count, sample_head);
+    APP_LOG_INFO("      tick    in use      peak footprint  tag\r\n");
+    for (uint32_t i = 0; i < count; i++)
+    {
+        APP_LOG_INFO("%10"PRIu32" %9"PRIu32" %9"PRIu32" %9"PRIu32"  %s\r\n",
+                     samples[i].tick, samples[i].in_use, samples[i].peak_in_use,
+                     samples[i].footprint, (samples[i].tag != NULL) ? samples[i].tag : "");
+    }
 
-    printf("********************************\r\n\n");
-#endif /* #if defined(PRINT_HEAP_USAGE) && defined (__GNUC__) && !defined(__ARMCC_VERSION) */
+    APP_LOG_INFO("********************************\r\n\n");
+#endif /* HEAP_USAGE_SUPPORTED */
+}
+
+#ifdef HEAP_USAGE_SUPPORTED
+/*******************************************************************************
+* Function Name: take_sample
+********************************************************************************
+* Summary:
+* Reads the heap usage using mallinfo() and appends it to the ring buffer,
+* overwriting the oldest sample when the buffer is full.
+*
+* Parameters:
+*  const char *tag : Static string naming the sampling point
+*
+*******************************************************************************/
+static void take_sample(const char *tag)
+{
+    HEAP_MALLINFO_T mall_info = HEAP_MALLINFO();
+    uint32_t in_use = (uint32_t) mall_info.uordblks;
+    uint32_t footprint = (uint32_t) mall_info.arena;
+
+    taskENTER_CRITICAL();
+    peak_in_use = (in_use > peak_in_use) ? in_use : peak_in_use;
+    peak_footprint = (footprint > peak_footprint) ? footprint : peak_footprint;
+
+    heap_usage_sample_t *sample = &sample_ring[sample_head % HEAP_USAGE_RING_SIZE];
+    sample->tick = (uint32_t) xTaskGetTickCount();
+    sample->in_use = in_use;
+    sample->peak_in_use = peak_in_use;
+    sample->footprint = footprint;
+    sample->tag = tag;
+    sample_head++;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: heap_sample_timer_callback
+********************************************************************************
+* Summary:
+* Software timer callback that takes the periodic heap sample.
+*
+*******************************************************************************/
+static void heap_sample_timer_callback(TimerHandle_t timer)
+{
+    (void) timer;
+    take_sample("periodic");
 }
+#endif /* HEAP_USAGE_SUPPORTED */
 
 /* [] END OF FILE */
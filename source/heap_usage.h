@@ -0,0 +1,71 @@
+/******************************************************************************
+* File Name:   heap_usage.h
+*
+* Description: This file is the public interface of heap_usage.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HEAP_USAGE_H_
+#define HEAP_USAGE_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* One entry of the heap telemetry ring buffer. */
+typedef struct
+{
+    uint32_t tick;          /* RTOS tick count when the sample was taken */
+    uint32_t in_use;        /* Bytes allocated at this point */
+    uint32_t peak_in_use;   /* Largest 'in_use' observed so far */
+    uint32_t footprint;     /* Bytes claimed from the heap region (sbrk high-water) */
+    const char *tag;        /* Static string naming the sampling point */
+} heap_usage_sample_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void heap_usage_sampler_init(void);
+void heap_usage_sample(const char *tag);
+uint32_t heap_usage_in_use(void);
+uint32_t heap_usage_get_samples(heap_usage_sample_t *samples, uint32_t max_samples);
+void heap_usage_dump(void);
+
+#endif /* HEAP_USAGE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,187 @@
+/******************************************************************************
+* File Name:   log2_histogram.c
+*
+* Description: This file contains a fixed-size histogram with power-of-two
+*              bucket boundaries. Adding a sample is a handful of integer
+*              operations, so it can be used on hot paths; percentiles are
+*              resolved to the upper bound of the containing bucket.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "log2_histogram.h"
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t bucket_index(uint32_t value);
+
+/******************************************************************************
+ * Function Name: bucket_index
+ ******************************************************************************
+ * Summary:
+ *  Returns the bucket for the value, i.e. the number of significant bits of
+ *  the value, capped to the last bucket.
+ *
+ ******************************************************************************/
+static uint32_t bucket_index(uint32_t value)
+{
+    uint32_t bits = 0;
+
+    /* Binary search for the most significant bit; portable across the
+     * supported toolchains and cores.
+     */
+    if (value >= (1lu << 16)) { value >>= 16; bits += 16; }
+    if (value >= (1lu << 8))  { value >>= 8;  bits += 8; }
+    if (value >= (1lu << 4))  { value >>= 4;  bits += 4; }
+    if (value >= (1lu << 2))  { value >>= 2;  bits += 2; }
+    if (value >= (1lu << 1))  { value >>= 1;  bits += 1; }
+    bits += value;
+
+    return (bits < LOG2_HISTOGRAM_BUCKETS) ? bits : (LOG2_HISTOGRAM_BUCKETS - 1u);
+}
+
+/******************************************************************************
+ * Function Name: log2_histogram_reset
+ ******************************************************************************
+ * Summary:
+ *  Clears all buckets and the aggregate values of the histogram.
+ *
+ * Parameters:
+ *  log2_histogram_t *histogram : Histogram to be cleared
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void log2_histogram_reset(log2_histogram_t *histogram)
+{
+    memset(histogram, 0, sizeof(*histogram));
+}
+
+/******************************************************************************
+ * Function Name: log2_histogram_add
+ ******************************************************************************
+ * Summary:
+ *  Adds one sample to the histogram.
+ *
+ * Parameters:
+ *  log2_histogram_t *histogram : Histogram to be updated
+ *  uint32_t value : Sample value
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void log2_histogram_add(log2_histogram_t *histogram, uint32_t value)
+{
+    histogram->buckets[bucket_index(value)]++;
+    histogram->count++;
+    histogram->sum += value;
+    if (value > histogram->max)
+    {
+        histogram->max = value;
+    }
+}
+
+/******************************************************************************
+ * Function Name: log2_histogram_percentile
+ ******************************************************************************
+ * Summary:
+ *  Returns an upper bound of the given percentile: the upper limit of the
+ *  bucket that contains the percentile, but never more than the largest
+ *  sample seen.
+ *
+ * Parameters:
+ *  const log2_histogram_t *histogram : Histogram to be evaluated
+ *  uint32_t percent : Percentile in the range 0 to 100
+ *
+ * Return:
+ *  uint32_t : Percentile value, or 0 if the histogram is empty
+ *
+ ******************************************************************************/
+uint32_t log2_histogram_percentile(const log2_histogram_t *histogram, uint32_t percent)
+{
+    uint64_t rank;
+    uint64_t seen = 0;
+
+    if (histogram->count == 0u)
+    {
+        return 0u;
+    }
+
+    /* Rank of the sample that marks the percentile, rounded up (1-based). */
+    rank = (((uint64_t) histogram->count * percent) + 99u) / 100u;
+    if (rank == 0u)
+    {
+        rank = 1u;
+    }
+
+    for (uint32_t i = 0; i < LOG2_HISTOGRAM_BUCKETS; i++)
+    {
+        seen += histogram->buckets[i];
+        if (seen >= rank)
+        {
+            /* The last bucket is open-ended; its only known bound is max. */
+            uint32_t upper = (i == (LOG2_HISTOGRAM_BUCKETS - 1u)) ? histogram->max :
+                             (uint32_t)((1lu << i) - 1u);
+            return (upper < histogram->max) ? upper : histogram->max;
+        }
+    }
+
+    return histogram->max;
+}
+
+/******************************************************************************
+ * Function Name: log2_histogram_mean
+ ******************************************************************************
+ * Summary:
+ *  Returns the arithmetic mean of all samples.
+ *
+ * Parameters:
+ *  const log2_histogram_t *histogram : Histogram to be evaluated
+ *
+ * Return:
+ *  uint32_t : Mean value, or 0 if the histogram is empty
+ *
+ ******************************************************************************/
+uint32_t log2_histogram_mean(const log2_histogram_t *histogram)
+{
+    return (histogram->count == 0u) ? 0u : (uint32_t)(histogram->sum / histogram->count);
+}
+
+/* [] END OF FILE */
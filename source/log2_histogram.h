@@ -0,0 +1,77 @@
+/******************************************************************************
+* File Name:   log2_histogram.h
+*
+* Description: This file is the public interface of log2_histogram.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LOG2_HISTOGRAM_H_
+#define LOG2_HISTOGRAM_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Bucket 0 counts zero values; bucket 'n' (n >= 1) counts values in the range
+ * [2^(n-1), 2^n). The last bucket also absorbs everything above its range.
+ */
+#define LOG2_HISTOGRAM_BUCKETS             (32u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Fixed-size histogram with power-of-two bucket boundaries. */
+typedef struct
+{
+    uint32_t buckets[LOG2_HISTOGRAM_BUCKETS];
+    uint32_t count;
+    uint32_t max;
+    uint64_t sum;
+} log2_histogram_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void log2_histogram_reset(log2_histogram_t *histogram);
+void log2_histogram_add(log2_histogram_t *histogram, uint32_t value);
+uint32_t log2_histogram_percentile(const log2_histogram_t *histogram, uint32_t percent);
+uint32_t log2_histogram_mean(const log2_histogram_t *histogram);
+
+#endif /* LOG2_HISTOGRAM_H_ */
+
+/* [] END OF FILE */
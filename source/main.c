@@ -44,6 +44,9 @@
 #include "cy_retarget_io.h"
 
 #include "mqtt_task.h"
+#include "static_alloc.h"
+#include "app_log.h"
+#include "mqtt_client_config.h"
 
 #include "FreeRTOS.h"
 #include "task.h"
@@ -54,8 +57,24 @@
 #if defined(CY_DEVICE_PSOC6A512K)
 #include "cy_serial_flash_qspi.h"
 #include "cycfg_qspi_memslot.h"
+#include "flash_log_qspi.h"
 #endif
 
+/******************************************************************************
+* Macros
+*******************************************************************************/
+/* Log level of this module. */
+#define APP_LOG_MODULE_LEVEL            APP_LOG_LEVEL_MAIN
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if ENABLE_STATIC_ALLOCATION
+/* Static storage of the MQTT client task. */
+static StackType_t mqtt_client_task_stack[STATIC_ALLOC_STACK_DEPTH(MQTT_CLIENT_TASK_STACK_SIZE)];
+static StaticTask_t mqtt_client_task_tcb;
+#endif /* ENABLE_STATIC_ALLOCATION */
+
 /******************************************************************************
  * Function Name: main
  ******************************************************************************
@@ -106,27 +125,41 @@ int main()
 
     /* Enable the XIP mode to get the Wi-Fi firmware from the external flash. */
     cy_serial_flash_qspi_enable_xip(true);
+
+#if ENABLE_PERSISTENT_OUTBOX
+    /* The outbox log leaves the XIP mode; serialize it with the Wi-Fi stack. */
+    flash_log_qspi_init();
+#endif /* ENABLE_PERSISTENT_OUTBOX */
 #endif
 
+    /* Start the log drain task; the lines below are printed once the
+     * scheduler runs.
+     */
+    if (!app_log_init())
+    {
+        printf("Failed to create the Log drain task, log output disabled!\n");
+    }
+
     /* \x1b[2J\x1b[;H - ANSI ESC sequence to clear screen. */
-    printf("\x1b[2J\x1b[;H");
-    printf("===============================================================\n");
+    APP_LOG_INFO("\x1b[2J\x1b[;H");
+    APP_LOG_INFO("===============================================================\n");
 #if defined(COMPONENT_CM0P)
-    printf("CE229889 - MQTT Client running on CM0+\n");
+    APP_LOG_INFO("CE229889 - MQTT Client running on CM0+\n");
 #endif
 
 #if defined(COMPONENT_CM4)
-    printf("CE229889 - MQTT Client running on CM4\n");
+    APP_LOG_INFO("CE229889 - MQTT Client running on CM4\n");
 #endif
 
 #if defined(COMPONENT_CM7)
-    printf("CE229889 - MQTT Client running on CM7\n");
+    APP_LOG_INFO("CE229889 - MQTT Client running on CM7\n");
 #endif
-    printf("===============================================================\n\n");
+    APP_LOG_INFO("===============================================================\n\n");
 
     /* Create the MQTT Client task. */
-    xTaskCreate(mqtt_client_task, "MQTT Client task", MQTT_CLIENT_TASK_STACK_SIZE,
-                NULL, MQTT_CLIENT_TASK_PRIORITY, NULL);
+    STATIC_ALLOC_TASK_CREATE(mqtt_client_task, "MQTT Client task", MQTT_CLIENT_TASK_STACK_SIZE,
+                             NULL, MQTT_CLIENT_TASK_PRIORITY, &mqtt_client_task_handle,
+                             mqtt_client_task_stack, &mqtt_client_task_tcb);
 
     /* Start the FreeRTOS scheduler. */
     vTaskStartScheduler();
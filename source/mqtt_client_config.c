@@ -143,7 +143,7 @@ cy_mqtt_connect_info_t connection_info =
     .username_len = 0,
     .password = NULL,
     .password_len = 0,
-    .clean_session = true,
+    .clean_session = !ENABLE_PERSISTENT_SESSION,
     .keep_alive_sec = MQTT_KEEP_ALIVE_SECONDS,
 #if ENABLE_LWT_MESSAGE
     .will_info = &will_msg_info
@@ -152,6 +152,32 @@ cy_mqtt_connect_info_t connection_info =
 #endif /* ENABLE_LWT_MESSAGE */
 };
 
+#if ENABLE_TELEMETRY_CONNECTION
+/* MQTT Broker/Server details of the telemetry connection */
+cy_mqtt_broker_info_t telemetry_broker_info =
+{
+    .hostname = MQTT_TELEMETRY_BROKER_ADDRESS,
+    .hostname_len = sizeof(MQTT_TELEMETRY_BROKER_ADDRESS) - 1,
+    .port = MQTT_TELEMETRY_PORT
+};
+
+/* Connection information of the telemetry connection. It subscribes to
+ * nothing, so it needs neither a persistent session nor a will message.
+ */
+cy_mqtt_connect_info_t telemetry_connection_info =
+{
+    .client_id = NULL,
+    .client_id_len = 0,
+    .username = NULL,
+    .username_len = 0,
+    .password = NULL,
+    .password_len = 0,
+    .clean_session = true,
+    .keep_alive_sec = MQTT_KEEP_ALIVE_SECONDS,
+    .will_info = NULL
+};
+#endif /* ENABLE_TELEMETRY_CONNECTION */
+
 /* Check for a valid QoS setting - QoS 0, QoS 1, or QoS 2. */
 #if ((MQTT_MESSAGES_QOS != 0) && (MQTT_MESSAGES_QOS != 1) && (MQTT_MESSAGES_QOS != 2))
     #error "Invalid QoS setting! MQTT_MESSAGES_QOS must be either 0 or 1."
@@ -50,15 +50,28 @@
 /* FreeRTOS header files */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "timers.h"
 
 /* Task header files */
 #include "mqtt_task.h"
 #include "subscriber_task.h"
 #include "publisher_task.h"
+#include "heap_usage.h"
+#include "reconnect_policy.h"
+#include "static_alloc.h"
+#include "task_monitor.h"
+#include "buffer_profile.h"
+#include "broker_failover.h"
+#include "dns_cache.h"
+#include "app_log.h"
+#include "tls_session_cache.h"
 
 /* Configuration file for Wi-Fi and MQTT client */
 #include "wifi_config.h"
 #include "mqtt_client_config.h"
+#if ENABLE_PERSISTENT_OUTBOX
+#include "flash_log_qspi.h"
+#endif /* ENABLE_PERSISTENT_OUTBOX */
 
 /* Middleware libraries */
 #include "cy_retarget_io.h"
@@ -67,21 +80,40 @@
 #include "cy_mqtt_api.h"
 #include "clock.h"
 
+#if defined(MQTT_CONNECT_LINKER_WRAP)
+#include "core_mqtt.h"
+#endif /* MQTT_CONNECT_LINKER_WRAP */
+
 /* LwIP header files */
 #include "lwip/netif.h"
 
 /******************************************************************************
 * Macros
 ******************************************************************************/
-/* Queue length of a message queue that is used to communicate the status of 
- * various operations.
+/* Log level of this module. */
+#define APP_LOG_MODULE_LEVEL            APP_LOG_LEVEL_MQTT_TASK
+
+/* Index of the task notification that carries the commands of this task, one
+ * bit per mqtt_task_cmd_t. Index 0 is left to the libraries.
  */
-#define MQTT_TASK_QUEUE_LENGTH           (3u)
+#define MQTT_TASK_NOTIFY_INDEX           (1u)
+#define MQTT_TASK_CMD_BIT(cmd)           (1lu << (uint32_t)(cmd))
+#define MQTT_TASK_CMD_ALL_BITS           (MQTT_TASK_CMD_BIT(MQTT_TASK_CMD_COUNT) - 1u)
+
+/* Storage of a timer of start_command_timer(). */
+#if ENABLE_STATIC_ALLOCATION
+#define STATIC_TIMER_BUFFER(buffer)      (&(buffer))
+#else
+#define STATIC_TIMER_BUFFER(buffer)      (NULL)
+#endif /* ENABLE_STATIC_ALLOCATION */
 
 /* Time in milliseconds to wait before creating the publisher task. */
 #define TASK_CREATION_DELAY_MS           (2000u)
 
-/* Flag Masks for tracking which cleanup functions must be called. */
+/* Flag Masks for tracking which cleanup functions must be called. The Wi-Fi
+ * and library flags are kept in status_flag, the buffer and connection flags
+ * in the flags of each connection.
+ */
 #define WCM_INITIALIZED                  (1lu << 0)
 #define WIFI_CONNECTED                   (1lu << 1)
 #define LIBS_INITIALIZED                 (1lu << 2)
@@ -89,25 +121,41 @@
 #define MQTT_INSTANCE_CREATED            (1lu << 4)
 #define MQTT_CONNECTION_SUCCESS          (1lu << 5)
 #define MQTT_MSG_RECEIVED                (1lu << 6)
+#define MQTT_SESSION_PRESENT             (1lu << 7)
 
 /*String that describes the MQTT handle that is being created in order to uniquely identify it*/
 #define MQTT_HANDLE_DESCRIPTOR            "MQTThandleID"
+#define MQTT_TELEMETRY_HANDLE_DESCRIPTOR  "MQTThandleTLM"
+
+/* Number of MQTT connections sharing the Wi-Fi link. */
+#define MQTT_CONNECTION_COUNT            (1u + ENABLE_TELEMETRY_CONNECTION)
+
+#if defined(CY_MQTT_MAX_HANDLE) && (MQTT_CONNECTION_COUNT > CY_MQTT_MAX_HANDLE)
+    #error "ENABLE_TELEMETRY_CONNECTION needs CY_MQTT_MAX_HANDLE of 2 or more in the MQTT library."
+#endif
+
+/* A static network buffer is sized at link time, so a tuned size would save
+ * no RAM.
+ */
+#if ENABLE_STATIC_ALLOCATION && ENABLE_NETWORK_BUFFER_TUNING
+    #error "ENABLE_NETWORK_BUFFER_TUNING sizes the network buffer at run time; set it to 0 with ENABLE_STATIC_ALLOCATION."
+#endif
 
 /* Macro to check if the result of an operation was successful and set the 
- * corresponding bit in the status_flag based on 'init_mask' parameter. When 
- * it has failed, print the error message and return the result to the 
- * calling function.
+ * corresponding bit in the 'flags' (status_flag or the flags of a
+ * connection) based on 'init_mask' parameter. When it has failed, print the
+ * error message and return the result to the calling function.
  */
-#define CHECK_RESULT(result, init_mask, error_message...)      \
+#define CHECK_RESULT(result, flags, init_mask, error_message...) \
                      do                                        \
                      {                                         \
                          if ((int)result == CY_RSLT_SUCCESS)   \
                          {                                     \
-                             status_flag |= init_mask;         \
+                             (flags) |= init_mask;             \
                          }                                     \
                          else                                  \
                          {                                     \
-                             printf(error_message);            \
+                             APP_LOG_ERR(error_message);       \
                              return result;                    \
                          }                                     \
                      } while(0)
@@ -115,38 +163,161 @@
 /******************************************************************************
 * Global Variables
 *******************************************************************************/
-/* MQTT connection handle. */
+/* MQTT connection handle of the control connection, used by the publisher and
+ * subscriber tasks.
+ */
 cy_mqtt_t mqtt_connection;
 
-/* Queue handle used to communicate results of various operations - MQTT 
- * Publish, MQTT Subscribe, MQTT connection, and Wi-Fi connection between tasks 
- * and callbacks.
+/* Handle of this task, notified with the results of various operations - MQTT
+ * Publish, MQTT Subscribe, MQTT connection, and Wi-Fi connection - by other
+ * tasks and callbacks.
  */
-QueueHandle_t mqtt_task_q;
+TaskHandle_t mqtt_client_task_handle = NULL;
+
+/* Commands raised and handled. */
+static mqtt_task_control_stats_t control_stats;
+
+#if defined(MQTT_CONNECT_LINKER_WRAP)
+/* Session present flag of the last CONNACK, see __wrap_MQTT_Connect(). */
+static bool connack_session_present;
+#endif /* MQTT_CONNECT_LINKER_WRAP */
+
+#if ENABLE_STATIC_ALLOCATION
+/* Software timers that raise the background work of this task. */
+#if ENABLE_BROKER_FAILOVER
+static StaticTimer_t broker_rank_timer_buffer;
+#endif /* ENABLE_BROKER_FAILOVER */
+#if ENABLE_DNS_CACHE
+static StaticTimer_t dns_refresh_timer_buffer;
+#endif /* ENABLE_DNS_CACHE */
+#endif /* ENABLE_STATIC_ALLOCATION */
 
 /* Flag to denote initialization status of various operations. */
 uint32_t status_flag;
 
-/* Pointer to the network buffer needed by the MQTT library for MQTT send and 
- * receive operations.
+#if ENABLE_STATIC_ALLOCATION
+/* Static storage of the network buffers, and of the subscriber and publisher
+ * tasks.
+ */
+static uint8_t mqtt_network_buffer_storage[MQTT_NETWORK_BUFFER_SIZE];
+#if ENABLE_TELEMETRY_CONNECTION
+static uint8_t mqtt_telemetry_network_buffer_storage[MQTT_TELEMETRY_NETWORK_BUFFER_SIZE];
+#endif /* ENABLE_TELEMETRY_CONNECTION */
+static StackType_t subscriber_task_stack[STATIC_ALLOC_STACK_DEPTH(SUBSCRIBER_TASK_STACK_SIZE)];
+static StaticTask_t subscriber_task_tcb;
+static StackType_t publisher_task_stack[STATIC_ALLOC_STACK_DEPTH(PUBLISHER_TASK_STACK_SIZE)];
+static StaticTask_t publisher_task_tcb;
+#endif /* ENABLE_STATIC_ALLOCATION */
+
+/* State of one MQTT connection. The MQTT library serves each one with its
+ * own handle and network buffer; the Wi-Fi link is shared.
+ */
+typedef struct
+{
+    const char *name;                   /* Name used in the log */
+    char *descriptor;                   /* Unique descriptor of the MQTT handle */
+    const char *client_id_suffix;       /* Inserted after MQTT_CLIENT_IDENTIFIER */
+    cy_mqtt_broker_info_t *broker_info;
+    cy_mqtt_connect_info_t *connect_info;
+    uint32_t max_retries;               /* Connection attempts before giving up */
+#if ENABLE_STATIC_ALLOCATION
+    uint8_t *buffer_storage;
+    uint32_t buffer_storage_size;
+#endif /* ENABLE_STATIC_ALLOCATION */
+    cy_mqtt_t handle;
+    uint8_t *network_buffer;            /* Needed by the MQTT library for MQTT
+                                         * send and receive operations */
+    uint32_t flags;                     /* BUFFER_INITIALIZED, MQTT_INSTANCE_CREATED,
+                                         * MQTT_CONNECTION_SUCCESS and
+                                         * MQTT_SESSION_PRESENT */
+    reconnect_backoff_t backoff;        /* Kept across the attempts until one
+                                         * succeeds */
+    char client_id[(MQTT_CLIENT_IDENTIFIER_MAX_LEN + 1)];
+    mqtt_connection_stats_t stats;
+} mqtt_connection_context_t;
+
+/* The MQTT connections, indexed by mqtt_connection_id_t. The network buffer
+ * size of the control connection is taken from the network buffer profile.
  */
-uint8_t *mqtt_network_buffer = NULL;
+static mqtt_connection_context_t connections[MQTT_CONNECTION_COUNT] =
+{
+    [MQTT_CONNECTION_CONTROL] =
+    {
+        .name = "control",
+        .descriptor = MQTT_HANDLE_DESCRIPTOR,
+        .client_id_suffix = "",
+        .broker_info = &broker_info,
+        .connect_info = &connection_info,
+        .max_retries = MAX_MQTT_CONN_RETRIES,
+#if ENABLE_STATIC_ALLOCATION
+        .buffer_storage = mqtt_network_buffer_storage,
+        .buffer_storage_size = sizeof(mqtt_network_buffer_storage),
+#endif /* ENABLE_STATIC_ALLOCATION */
+    },
+#if ENABLE_TELEMETRY_CONNECTION
+    [MQTT_CONNECTION_TELEMETRY] =
+    {
+        .name = "telemetry",
+        .descriptor = MQTT_TELEMETRY_HANDLE_DESCRIPTOR,
+        .client_id_suffix = MQTT_TELEMETRY_CLIENT_ID_SUFFIX,
+        .broker_info = &telemetry_broker_info,
+        .connect_info = &telemetry_connection_info,
+        .max_retries = MQTT_TELEMETRY_CONN_RETRIES,
+#if ENABLE_STATIC_ALLOCATION
+        .buffer_storage = mqtt_telemetry_network_buffer_storage,
+        .buffer_storage_size = sizeof(mqtt_telemetry_network_buffer_storage),
+#endif /* ENABLE_STATIC_ALLOCATION */
+        .stats.network_buffer_size = MQTT_TELEMETRY_NETWORK_BUFFER_SIZE
+    },
+#endif /* ENABLE_TELEMETRY_CONNECTION */
+};
 
 /******************************************************************************
 * Function Prototypes
 *******************************************************************************/
 static cy_rslt_t wifi_connect(void);
 static cy_rslt_t mqtt_init(void);
-static cy_rslt_t mqtt_connect(void);
+static cy_rslt_t mqtt_create_connection(mqtt_connection_context_t *connection);
+static cy_rslt_t mqtt_create_instance(mqtt_connection_context_t *connection);
+static cy_rslt_t mqtt_connect(mqtt_connection_context_t *connection);
+static void report_startup(void);
+static void print_connection_stats(void);
+static uint32_t heap_growth(uint32_t in_use_before);
+static uint32_t connect_packet_size(const cy_mqtt_connect_info_t *info);
+static bool handle_disconnection(void);
 
 static void mqtt_event_callback(cy_mqtt_t mqtt_handle, cy_mqtt_event_t event, void *user_data);
 static void cleanup(void);
-void print_heap_usage(char *msg);
+static void seed_reconnect_policy(void);
+static void print_reconnect_stats(void);
+static bool mqtt_session_present(void);
+
+#if ENABLE_BROKER_FAILOVER
+static void rank_brokers(void);
+static cy_rslt_t mqtt_use_broker(mqtt_connection_context_t *connection,
+                                 cy_mqtt_broker_info_t *info);
+#endif /* ENABLE_BROKER_FAILOVER */
+
+#if ENABLE_BROKER_FAILOVER || ENABLE_DNS_CACHE
+static void start_command_timer(const char *name, TickType_t period, mqtt_task_cmd_t cmd,
+                                StaticTimer_t *buffer);
+static void command_timer_callback(TimerHandle_t timer);
+#endif /* ENABLE_BROKER_FAILOVER || ENABLE_DNS_CACHE */
 
 #if GENERATE_UNIQUE_CLIENT_ID
-static cy_rslt_t mqtt_get_unique_client_identifier(char *mqtt_client_identifier);
+static cy_rslt_t mqtt_get_unique_client_identifier(char *mqtt_client_identifier,
+                                                   const char *suffix);
 #endif /* GENERATE_UNIQUE_CLIENT_ID */
 
+#if defined(MQTT_CONNECT_LINKER_WRAP)
+MQTTStatus_t __real_MQTT_Connect(MQTTContext_t *pContext, const MQTTConnectInfo_t *pConnectInfo,
+                                 const MQTTPublishInfo_t *pWillInfo, uint32_t timeoutMs,
+                                 bool *pSessionPresent);
+MQTTStatus_t __wrap_MQTT_Connect(MQTTContext_t *pContext, const MQTTConnectInfo_t *pConnectInfo,
+                                 const MQTTPublishInfo_t *pWillInfo, uint32_t timeoutMs,
+                                 bool *pSessionPresent);
+#endif /* MQTT_CONNECT_LINKER_WRAP */
+
 /******************************************************************************
  * Function Name: mqtt_client_task
  ******************************************************************************
@@ -155,6 +326,8 @@ static cy_rslt_t mqtt_get_unique_client_identifier(char *mqtt_client_identifier)
  *  The task also creates and manages the subscriber and publisher tasks upon 
  *  successful MQTT connection. The task also handles the WiFi and MQTT 
  *  connections by initiating reconnection on the event of disconnections.
+ *  With ENABLE_TELEMETRY_CONNECTION, a second MQTT connection for telemetry
+ *  is kept over the same Wi-Fi link.
  *
  * Parameters:
  *  void *pvParameters : Task parameter defined during task creation (unused)
@@ -168,9 +341,8 @@ void mqtt_client_task(void *pvParameters)
     /* Structures that store the data to be sent/received to/from various
      * message queues.
      */
-    mqtt_task_cmd_t mqtt_status;
-    subscriber_data_t subscriber_q_data;
-    publisher_data_t publisher_q_data;
+    uint32_t mqtt_status;
+    cy_rslt_t result;
 
     /* Configure the Wi-Fi interface as a Wi-Fi STA (i.e. Client). */
     cy_wcm_config_t config = {.interface = CY_WCM_INTERFACE_TYPE_STA};
@@ -178,15 +350,30 @@ void mqtt_client_task(void *pvParameters)
     /* To avoid compiler warnings */
     (void) pvParameters;
 
-    /* Create a message queue to communicate with other tasks and callbacks. */
-    mqtt_task_q = xQueueCreate(MQTT_TASK_QUEUE_LENGTH, sizeof(mqtt_task_cmd_t));
+    /* Load the sizes of the MQTT packets seen before the last reset. */
+    buffer_profile_init();
+
+    /* Start recording the heap usage and the task states in the background. */
+    heap_usage_sampler_init();
+    if (!task_monitor_start())
+    {
+        APP_LOG_ERR("Failed to create the Task monitor!\n");
+    }
 
     /* Initialize the Wi-Fi Connection Manager and jump to the cleanup block 
      * upon failure.
      */
-    if (CY_RSLT_SUCCESS != cy_wcm_init(&config))
+#if ENABLE_PERSISTENT_OUTBOX
+    /* cy_wcm_init() reads the Wi-Fi firmware and the CLM blob through XIP. */
+    flash_log_qspi_xip_lock();
+    result = cy_wcm_init(&config);
+    flash_log_qspi_xip_unlock();
+#else
+    result = cy_wcm_init(&config);
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+    if (CY_RSLT_SUCCESS != result)
     {
-        printf("\nWi-Fi Connection Manager initialization failed!\n");
+        APP_LOG_ERR("\nWi-Fi Connection Manager initialization failed!\n");
         goto exit_cleanup;
     }
 
@@ -194,7 +381,22 @@ void mqtt_client_task(void *pvParameters)
      * WCM initialization.
      */
     status_flag |= WCM_INITIALIZED;
-    printf("\nWi-Fi Connection Manager initialized.\n");
+    APP_LOG_INFO("\nWi-Fi Connection Manager initialized.\n");
+
+    /* Seed the retry jitter with a device-specific value. */
+    seed_reconnect_policy();
+
+    /* Start without TLS sessions to resume. */
+    tls_session_cache_init();
+
+    /* Set up the receive path of the subscriber before the first connection:
+     * a resumed session delivers its queued messages right after the CONNACK.
+     */
+    if (!subscriber_init())
+    {
+        APP_LOG_ERR("Failed to create the Subscriber task queue!\n");
+        goto exit_cleanup;
+    }
 
     /* Initiate connection to the Wi-Fi AP and cleanup if the operation fails. */
     if (CY_RSLT_SUCCESS != wifi_connect())
@@ -202,19 +404,22 @@ void mqtt_client_task(void *pvParameters)
         goto exit_cleanup;
     }
 
-    /* Set-up the MQTT client and connect to the MQTT broker. Jump to the 
-     * cleanup block if any of the operations fail.
+    /* Set-up the MQTT client and connect the control connection to the MQTT
+     * broker. Jump to the cleanup block if any of the operations fail.
      */
-    if ( (CY_RSLT_SUCCESS != mqtt_init()) || (CY_RSLT_SUCCESS != mqtt_connect()) )
+    if ( (CY_RSLT_SUCCESS != mqtt_init()) ||
+         (CY_RSLT_SUCCESS != mqtt_connect(&connections[MQTT_CONNECTION_CONTROL])) )
     {
         goto exit_cleanup;
     }
 
     /* Create the subscriber task and cleanup if the operation fails. */
-    if (pdPASS != xTaskCreate(subscriber_task, "Subscriber task", SUBSCRIBER_TASK_STACK_SIZE,
-                              NULL, SUBSCRIBER_TASK_PRIORITY, &subscriber_task_handle))
+    if (pdPASS != STATIC_ALLOC_TASK_CREATE(subscriber_task, "Subscriber task",
+                                           SUBSCRIBER_TASK_STACK_SIZE, NULL,
+                                           SUBSCRIBER_TASK_PRIORITY, &subscriber_task_handle,
+                                           subscriber_task_stack, &subscriber_task_tcb))
     {
-        printf("Failed to create the Subscriber task!\n");
+        APP_LOG_ERR("Failed to create the Subscriber task!\n");
         goto exit_cleanup;
     }
 
@@ -222,86 +427,103 @@ void mqtt_client_task(void *pvParameters)
     vTaskDelay(pdMS_TO_TICKS(TASK_CREATION_DELAY_MS));
 
     /* Create the publisher task and cleanup if the operation fails. */
-    if (pdPASS != xTaskCreate(publisher_task, "Publisher task", PUBLISHER_TASK_STACK_SIZE, 
-                              NULL, PUBLISHER_TASK_PRIORITY, &publisher_task_handle))
+    if (pdPASS != STATIC_ALLOC_TASK_CREATE(publisher_task, "Publisher task",
+                                           PUBLISHER_TASK_STACK_SIZE, NULL,
+                                           PUBLISHER_TASK_PRIORITY, &publisher_task_handle,
+                                           publisher_task_stack, &publisher_task_tcb))
     {
-        printf("Failed to create Publisher task!\n");
+        APP_LOG_ERR("Failed to create Publisher task!\n");
         goto exit_cleanup;
     }
 
-    print_heap_usage("mqtt_client_task: subscriber & publisher tasks created\n");
+    heap_usage_sample("mqtt_client_task: subscriber & publisher tasks created");
+    report_startup();
+
+#if ENABLE_TELEMETRY_CONNECTION
+    /* Connect the telemetry connection once the control path runs. If the
+     * broker is not reachable, it is retried like a lost connection.
+     */
+    if (CY_RSLT_SUCCESS != mqtt_connect(&connections[MQTT_CONNECTION_TELEMETRY]))
+    {
+        mqtt_task_notify(HANDLE_DISCONNECTION);
+    }
+#endif /* ENABLE_TELEMETRY_CONNECTION */
+    print_connection_stats();
+
+#if ENABLE_BROKER_FAILOVER
+    start_command_timer("Broker ranking", pdMS_TO_TICKS(BROKER_FAILOVER_RANK_INTERVAL_MS),
+                        RANK_BROKERS, STATIC_TIMER_BUFFER(broker_rank_timer_buffer));
+#endif /* ENABLE_BROKER_FAILOVER */
+#if ENABLE_DNS_CACHE
+    /* In ticks, as a quarter of a long TTL in milliseconds overflows
+     * pdMS_TO_TICKS().
+     */
+    start_command_timer("DNS refresh", ((TickType_t) DNS_CACHE_TTL_S * configTICK_RATE_HZ) / 4u,
+                        REFRESH_DNS_CACHE, STATIC_TIMER_BUFFER(dns_refresh_timer_buffer));
+#endif /* ENABLE_DNS_CACHE */
+
+#ifdef PRINT_HEAP_USAGE
+    heap_usage_dump();
+#endif /* PRINT_HEAP_USAGE */
 
     while (true)
     {
-        /* Wait for results of MQTT operations from other tasks and callbacks. */
-        if (pdTRUE == xQueueReceive(mqtt_task_q, &mqtt_status, portMAX_DELAY))
+        /* Wait for results of MQTT operations from other tasks and callbacks.
+         * All the commands raised since the last wait are taken at once.
+         */
+        if (pdTRUE != xTaskNotifyWaitIndexed(MQTT_TASK_NOTIFY_INDEX, 0u, MQTT_TASK_CMD_ALL_BITS,
+                                             &mqtt_status, portMAX_DELAY))
         {
-            /* In this code example, the disconnection from the MQTT Broker or 
-             * the Wi-Fi network is handled by the case 'HANDLE_DISCONNECTION'. 
-             * 
-             * The publish and subscribe failures (`HANDLE_MQTT_PUBLISH_FAILURE`
-             * and `HANDLE_MQTT_SUBSCRIBE_FAILURE`) does not initiate 
-             * reconnection in this example, but they can be handled as per the 
-             * application requirement in the following swich cases.
-             */
-            switch(mqtt_status)
+            continue;
+        }
+
+        /* In this code example, the disconnection from the MQTT Broker or 
+         * the Wi-Fi network is handled by 'HANDLE_DISCONNECTION', ahead of
+         * the other commands.
+         * 
+         * The publish and subscribe failures (`HANDLE_MQTT_PUBLISH_FAILURE`
+         * and `HANDLE_MQTT_SUBSCRIBE_FAILURE`) does not initiate 
+         * reconnection in this example, but they can be handled as per the 
+         * application requirement below.
+         */
+        if (0u != (mqtt_status & MQTT_TASK_CMD_BIT(HANDLE_DISCONNECTION)))
+        {
+            if (!handle_disconnection())
             {
-                case HANDLE_MQTT_PUBLISH_FAILURE:
-                {
-                    /* Handle Publish Failure here. */
-                    break;
-                }
+                goto exit_cleanup;
+            }
+        }
 
-                case HANDLE_MQTT_SUBSCRIBE_FAILURE:
-                {
-                    /* Handle Subscribe Failure here. */
-                    break;
-                }
+        if (0u != (mqtt_status & MQTT_TASK_CMD_BIT(PERSIST_BUFFER_PROFILE)))
+        {
+            /* A packet called for a larger network buffer. */
+            buffer_profile_save();
+        }
 
-                case HANDLE_DISCONNECTION:
-                {
-                    /* Deinit the publisher before initiating reconnections. */
-                    publisher_q_data.cmd = PUBLISHER_DEINIT;
-                    xQueueSend(publisher_task_q, &publisher_q_data, portMAX_DELAY);
-
-                    /* Although the connection with the MQTT Broker is lost, 
-                     * call the MQTT disconnect API for cleanup of threads and 
-                     * other resources before reconnection.
-                     */
-                    cy_mqtt_disconnect(mqtt_connection);
-
-                    /* Check if Wi-Fi connection is active. If not, update the 
-                     * status flag and initiate Wi-Fi reconnection.
-                     */
-                    if (cy_wcm_is_connected_to_ap() == 0)
-                    {
-                        status_flag &= ~(WIFI_CONNECTED);
-                        printf("\nInitiating Wi-Fi Reconnection...\n");
-                        if (CY_RSLT_SUCCESS != wifi_connect())
-                        {
-                            goto exit_cleanup;
-                        }
-                    }
-
-                    printf("\nInitiating MQTT Reconnection...\n");
-                    if (CY_RSLT_SUCCESS != mqtt_connect())
-                    {
-                        goto exit_cleanup;
-                    }
-
-                    /* Initiate MQTT subscribe post the reconnection. */
-                    subscriber_q_data.cmd = SUBSCRIBE_TO_TOPIC;
-                    xQueueSend(subscriber_task_q, &subscriber_q_data, portMAX_DELAY);
-
-                    /* Initialize Publisher post the reconnection. */
-                    publisher_q_data.cmd = PUBLISHER_INIT;
-                    xQueueSend(publisher_task_q, &publisher_q_data, portMAX_DELAY);
-                    break;
-                }
+#if ENABLE_BROKER_FAILOVER
+        if (0u != (mqtt_status & MQTT_TASK_CMD_BIT(RANK_BROKERS)))
+        {
+            /* Refresh the ranking for the next (re)connection. */
+            rank_brokers();
+        }
+#endif /* ENABLE_BROKER_FAILOVER */
 
-                default:
-                    break;
-            }
+#if ENABLE_DNS_CACHE
+        if (0u != (mqtt_status & MQTT_TASK_CMD_BIT(REFRESH_DNS_CACHE)))
+        {
+            /* Resolve the cached broker names again ahead of their expiry. */
+            dns_cache_refresh();
+        }
+#endif /* ENABLE_DNS_CACHE */
+
+        if (0u != (mqtt_status & MQTT_TASK_CMD_BIT(HANDLE_MQTT_PUBLISH_FAILURE)))
+        {
+            /* Handle Publish Failure here. */
+        }
+
+        if (0u != (mqtt_status & MQTT_TASK_CMD_BIT(HANDLE_MQTT_SUBSCRIBE_FAILURE)))
+        {
+            /* Handle Subscribe Failure here. */
         }
     }
 
@@ -309,7 +531,7 @@ void mqtt_client_task(void *pvParameters)
      * cleanup for various operations based on the status_flag.
      */
     exit_cleanup:
-    printf("\nTerminating Publisher and Subscriber tasks...\n");
+    APP_LOG_INFO("\nTerminating Publisher and Subscriber tasks...\n");
     if (subscriber_task_handle != NULL)
     {
         vTaskDelete(subscriber_task_handle);
@@ -319,18 +541,315 @@ void mqtt_client_task(void *pvParameters)
         vTaskDelete(publisher_task_handle);
     }
     cleanup();
-    printf("\nCleanup Done\nTerminating the MQTT task...\n\n");
+    APP_LOG_INFO("\nCleanup Done\nTerminating the MQTT task...\n\n");
     vTaskDelete(NULL);
 }
 
+/******************************************************************************
+ * Function Name: handle_disconnection
+ ******************************************************************************
+ * Summary:
+ *  Restores the MQTT connections that were lost, and the Wi-Fi connection if
+ *  it was lost too. The control connection is restored first. A
+ *  disconnection raised while the previous one was being handled finds the
+ *  connections restored and is skipped.
+ *
+ *  The publisher task is paused and the subscriptions restored for the
+ *  control connection only. A connection other than the control one that
+ *  cannot be restored within its attempts is retried on a new command, so
+ *  that the control connection is never held up by it.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool : false if the Wi-Fi or the control connection could not be restored
+ *
+ ******************************************************************************/
+static bool handle_disconnection(void)
+{
+    subscriber_data_t subscriber_q_data;
+    publisher_data_t publisher_q_data;
+    bool lost[MQTT_CONNECTION_COUNT];
+    bool any_lost = false;
+#if ENABLE_DNS_CACHE
+    dns_cache_stats_t dns_before;
+    dns_cache_stats_t dns_after;
+#endif /* ENABLE_DNS_CACHE */
+
+    /* A session, and the subscriptions in it, are kept by one broker only. */
+    const cy_mqtt_broker_info_t *session_broker = connections[MQTT_CONNECTION_CONTROL].broker_info;
+
+    /* The event callback clears the flag before raising the command, and
+     * mqtt_connect() sets it once connected.
+     */
+    for (uint32_t id = 0; id < MQTT_CONNECTION_COUNT; id++)
+    {
+        lost[id] = (0u == (connections[id].flags & MQTT_CONNECTION_SUCCESS));
+        any_lost = any_lost || lost[id];
+    }
+
+    if (!any_lost)
+    {
+        taskENTER_CRITICAL();
+        control_stats.stale_disconnects++;
+        taskEXIT_CRITICAL();
+        return true;
+    }
+
+    taskENTER_CRITICAL();
+    control_stats.reconnect_cycles++;
+    taskEXIT_CRITICAL();
+
+    if (lost[MQTT_CONNECTION_CONTROL])
+    {
+        /* Time the reconnection from here until the control connection is
+         * restored.
+         */
+        reconnect_episode_begin();
+
+        /* Deinit the publisher before initiating reconnections. */
+        publisher_q_data.cmd = PUBLISHER_DEINIT;
+        xQueueSend(publisher_task_q, &publisher_q_data, portMAX_DELAY);
+    }
+
+    /* Although the connection with the MQTT Broker is lost, call the MQTT
+     * disconnect API for cleanup of threads and other resources before
+     * reconnection.
+     */
+    for (uint32_t id = 0; id < MQTT_CONNECTION_COUNT; id++)
+    {
+        if (lost[id])
+        {
+            cy_mqtt_disconnect(connections[id].handle);
+        }
+    }
+
+    /* Check if Wi-Fi connection is active. If not, update the status flag and
+     * initiate Wi-Fi reconnection.
+     */
+    if (cy_wcm_is_connected_to_ap() == 0)
+    {
+        status_flag &= ~(WIFI_CONNECTED);
+        APP_LOG_INFO("\nInitiating Wi-Fi Reconnection...\n");
+        if (CY_RSLT_SUCCESS != wifi_connect())
+        {
+            if (lost[MQTT_CONNECTION_CONTROL])
+            {
+                reconnect_episode_end(false);
+            }
+            return false;
+        }
+    }
+
+    if (lost[MQTT_CONNECTION_CONTROL])
+    {
+#if ENABLE_DNS_CACHE
+        dns_cache_get_stats(&dns_before);
+#endif /* ENABLE_DNS_CACHE */
+
+#if ENABLE_BROKER_FAILOVER
+        /* Start over at the broker that answers fastest now. A broker that
+         * went down no longer answers and is ranked last.
+         */
+        rank_brokers();
+        if (CY_RSLT_SUCCESS != mqtt_use_broker(&connections[MQTT_CONNECTION_CONTROL],
+                                               broker_failover_first()))
+        {
+            reconnect_episode_end(false);
+            return false;
+        }
+#endif /* ENABLE_BROKER_FAILOVER */
+
+        APP_LOG_INFO("\nInitiating MQTT Reconnection...\n");
+        if (CY_RSLT_SUCCESS != mqtt_connect(&connections[MQTT_CONNECTION_CONTROL]))
+        {
+            reconnect_episode_end(false);
+            return false;
+        }
+
+        reconnect_episode_end(true);
+        print_reconnect_stats();
+
+#if ENABLE_DNS_CACHE
+        /* The broker probes and the connection attempts resolve through the
+         * cache, see dns_cache.c.
+         */
+        dns_cache_get_stats(&dns_after);
+        APP_LOG_INFO("DNS cache: %u hits, %u stale hits, %u misses in the reconnection, "
+                     "about %u ms of DNS lookups saved\n",
+                     (unsigned)(dns_after.hits - dns_before.hits),
+                     (unsigned)(dns_after.stale_hits - dns_before.stale_hits),
+                     (unsigned)(dns_after.misses - dns_before.misses),
+                     (unsigned)(dns_after.saved_ms - dns_before.saved_ms));
+#endif /* ENABLE_DNS_CACHE */
+
+        /* Initiate MQTT subscribe post the reconnection, unless the broker
+         * kept the subscriptions in the session.
+         */
+        if ((connections[MQTT_CONNECTION_CONTROL].broker_info == session_broker) &&
+            mqtt_session_present())
+        {
+            APP_LOG_INFO("Resumed the persistent session, subscriptions kept by the broker.\n");
+        }
+        else
+        {
+            subscriber_q_data.cmd = SUBSCRIBE_TO_TOPIC;
+            xQueueSend(subscriber_task_q, &subscriber_q_data, portMAX_DELAY);
+        }
+
+        /* Initialize Publisher post the reconnection. */
+        publisher_q_data.cmd = PUBLISHER_INIT;
+        xQueueSend(publisher_task_q, &publisher_q_data, portMAX_DELAY);
+    }
+
+    for (uint32_t id = MQTT_CONNECTION_CONTROL + 1u; id < MQTT_CONNECTION_COUNT; id++)
+    {
+        if (lost[id])
+        {
+            APP_LOG_INFO("\nInitiating MQTT Reconnection of the %s connection...\n",
+                         connections[id].name);
+            if (CY_RSLT_SUCCESS != mqtt_connect(&connections[id]))
+            {
+                /* Handle the commands raised meanwhile, then try again. */
+                mqtt_task_notify(HANDLE_DISCONNECTION);
+            }
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: mqtt_task_notify
+ ******************************************************************************
+ * Summary:
+ *  Raises a command to the MQTT client task without blocking. A command that
+ *  is still pending is coalesced with the new one, so a flapping link costs
+ *  a single reconnection and never stalls the caller, e.g. the MQTT library
+ *  thread running the event callback.
+ *
+ * Parameters:
+ *  mqtt_task_cmd_t cmd : Command to raise
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void mqtt_task_notify(mqtt_task_cmd_t cmd)
+{
+    uint32_t previous = 0u;
+    bool raised = false;
+
+    if (mqtt_client_task_handle != NULL)
+    {
+        (void) xTaskNotifyAndQueryIndexed(mqtt_client_task_handle, MQTT_TASK_NOTIFY_INDEX,
+                                          MQTT_TASK_CMD_BIT(cmd), eSetBits, &previous);
+        raised = true;
+    }
+
+    taskENTER_CRITICAL();
+    if (!raised)
+    {
+        control_stats.dropped++;
+    }
+    else
+    {
+        control_stats.raised[cmd]++;
+        if (0u != (previous & MQTT_TASK_CMD_BIT(cmd)))
+        {
+            control_stats.coalesced[cmd]++;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: mqtt_task_get_control_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the commands raised to the MQTT client task and the reconnections
+ *  it ran.
+ *
+ * Parameters:
+ *  mqtt_task_control_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void mqtt_task_get_control_stats(mqtt_task_control_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = control_stats;
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: mqtt_task_publish
+ ******************************************************************************
+ * Summary:
+ *  Publishes a message on one of the MQTT connections, from the calling task.
+ *  Messages on the telemetry connection do not pass the publisher task, so
+ *  they neither wait behind nor delay the messages of the control connection.
+ *
+ * Parameters:
+ *  mqtt_connection_id_t id : Connection to publish on
+ *  cy_mqtt_publish_info_t *publish_info : Message to publish
+ *
+ * Return:
+ *  cy_rslt_t : Result of cy_mqtt_publish(), or an error code if the
+ *              connection does not exist or is not connected.
+ *
+ ******************************************************************************/
+cy_rslt_t mqtt_task_publish(mqtt_connection_id_t id, cy_mqtt_publish_info_t *publish_info)
+{
+    if (((uint32_t) id >= MQTT_CONNECTION_COUNT) ||
+        (0u == (connections[id].flags & MQTT_CONNECTION_SUCCESS)))
+    {
+        return ~CY_RSLT_SUCCESS;
+    }
+    return cy_mqtt_publish(connections[id].handle, publish_info);
+}
+
+/******************************************************************************
+ * Function Name: mqtt_task_get_connection_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the RAM taken by one of the MQTT connections and its connection
+ *  counters.
+ *
+ * Parameters:
+ *  mqtt_connection_id_t id : Connection to report
+ *  mqtt_connection_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  bool : false if the connection does not exist in this build
+ *
+ ******************************************************************************/
+bool mqtt_task_get_connection_stats(mqtt_connection_id_t id, mqtt_connection_stats_t *stats)
+{
+    if ((uint32_t) id >= MQTT_CONNECTION_COUNT)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = connections[id].stats;
+    stats->connected = (0u != (connections[id].flags & MQTT_CONNECTION_SUCCESS));
+    taskEXIT_CRITICAL();
+    return true;
+}
+
 /******************************************************************************
  * Function Name: wifi_connect
  ******************************************************************************
  * Summary:
  *  Function that initiates connection to the Wi-Fi Access Point using the 
  *  specified SSID and PASSWORD. The connection is retried a maximum of 
- *  'MAX_WIFI_CONN_RETRIES' times with interval of 'WIFI_CONN_RETRY_INTERVAL_MS'
- *  milliseconds.
+ *  'MAX_WIFI_CONN_RETRIES' times with a jittered exponential backoff that
+ *  starts at 'WIFI_CONN_RETRY_FIRST_INTERVAL_MS' milliseconds, grows from
+ *  'WIFI_CONN_RETRY_INTERVAL_MS' and is capped at
+ *  'WIFI_CONN_RETRY_MAX_INTERVAL_MS' milliseconds.
  *
  * Parameters:
  *  void
@@ -345,6 +864,9 @@ static cy_rslt_t wifi_connect(void)
     cy_rslt_t result = CY_RSLT_SUCCESS;
     cy_wcm_connect_params_t connect_param;
     cy_wcm_ip_address_t ip_address;
+    reconnect_backoff_t backoff;
+    TickType_t start_ticks;
+    uint32_t delay_ms;
 
     /* Check if Wi-Fi connection is already established. */
     if (cy_wcm_is_connected_to_ap() == 0)
@@ -355,16 +877,21 @@ static cy_rslt_t wifi_connect(void)
         memcpy(connect_param.ap_credentials.password, WIFI_PASSWORD, sizeof(WIFI_PASSWORD));
         connect_param.ap_credentials.security = WIFI_SECURITY;
 
-        printf("\nWi-Fi Connecting to '%s'\n", connect_param.ap_credentials.SSID);
+        APP_LOG_INFO("\nWi-Fi Connecting to '%s'\n", connect_param.ap_credentials.SSID);
+
+        reconnect_backoff_init(&backoff, WIFI_CONN_RETRY_FIRST_INTERVAL_MS,
+                               WIFI_CONN_RETRY_INTERVAL_MS, WIFI_CONN_RETRY_MAX_INTERVAL_MS);
+        start_ticks = xTaskGetTickCount();
 
         /* Connect to the Wi-Fi AP. */
         for (uint32_t retry_count = 0; retry_count < MAX_WIFI_CONN_RETRIES; retry_count++)
         {
+            reconnect_episode_attempt(RECONNECT_LINK_WIFI);
             result = cy_wcm_connect_ap(&connect_param, &ip_address);
 
             if (result == CY_RSLT_SUCCESS)
             {
-                printf("\nSuccessfully connected to Wi-Fi network '%s'.\n", connect_param.ap_credentials.SSID);
+                APP_LOG_INFO("\nSuccessfully connected to Wi-Fi network '%s'.\n", connect_param.ap_credentials.SSID);
 
                 /* Set the appropriate bit in the status_flag to denote 
                  * successful Wi-Fi connection, print the assigned IP address.
@@ -372,23 +899,24 @@ static cy_rslt_t wifi_connect(void)
                 status_flag |= WIFI_CONNECTED;
                 if (ip_address.version == CY_WCM_IP_VER_V4)
                 {
-                    printf("IPv4 Address Assigned: %s\n\n", ip4addr_ntoa((const ip4_addr_t *) &ip_address.ip.v4));
+                    APP_LOG_INFO("IPv4 Address Assigned: %s\n\n", ip4addr_ntoa((const ip4_addr_t *) &ip_address.ip.v4));
                 }
                 else if (ip_address.version == CY_WCM_IP_VER_V6)
                 {
-                    printf("IPv6 Address Assigned: %s\n\n", ip6addr_ntoa((const ip6_addr_t *) &ip_address.ip.v6));
+                    APP_LOG_INFO("IPv6 Address Assigned: %s\n\n", ip6addr_ntoa((const ip6_addr_t *) &ip_address.ip.v6));
                 }
                 return result;
             }
 
-            printf("Wi-Fi Connection failed. Error code:0x%0X. Retrying in %d ms. Retries left: %d\n",
-                (int)result, WIFI_CONN_RETRY_INTERVAL_MS, (int)(MAX_WIFI_CONN_RETRIES - retry_count - 1));
-            vTaskDelay(pdMS_TO_TICKS(WIFI_CONN_RETRY_INTERVAL_MS));
+            delay_ms = reconnect_backoff_next_delay_ms(&backoff);
+            APP_LOG_WARN("Wi-Fi Connection failed. Error code:0x%0X. Retrying in %d ms. Retries left: %d\n",
+                (int)result, (int)delay_ms, (int)(MAX_WIFI_CONN_RETRIES - retry_count - 1));
+            vTaskDelay(pdMS_TO_TICKS(delay_ms));
         }
 
-        printf("\nExceeded maximum Wi-Fi connection attempts!\n");
-        printf("Wi-Fi connection failed after retrying for %d mins\n\n", 
-            (int)(WIFI_CONN_RETRY_INTERVAL_MS * MAX_WIFI_CONN_RETRIES) / 60000u);
+        APP_LOG_ERR("\nExceeded maximum Wi-Fi connection attempts!\n");
+        APP_LOG_ERR("Wi-Fi connection failed after retrying for %d mins\n\n", 
+            (int)(((xTaskGetTickCount() - start_ticks) * portTICK_PERIOD_MS) / 60000u));
     }
     return result;
 }
@@ -397,9 +925,9 @@ static cy_rslt_t wifi_connect(void)
  * Function Name: mqtt_init
  ******************************************************************************
  * Summary:
- *  Function that initializes the MQTT library and creates an instance for the 
- *  MQTT client. The network buffer needed by the MQTT library for MQTT send 
- *  send and receive operations is also allocated by this function.  
+ *  Function that initializes the MQTT library and creates an instance of the
+ *  MQTT client for each connection. The network buffer of the control
+ *  connection is sized from the network buffer profile.
  *
  * Parameters:
  *  void
@@ -416,31 +944,118 @@ static cy_rslt_t mqtt_init(void)
 
     /* Initialize the MQTT library. */
     result = cy_mqtt_init();
-    CHECK_RESULT(result, LIBS_INITIALIZED, "\nMQTT library initialization failed!\n");
+    CHECK_RESULT(result, status_flag, LIBS_INITIALIZED, "\nMQTT library initialization failed!\n");
+
+    connections[MQTT_CONNECTION_CONTROL].stats.network_buffer_size = buffer_profile_buffer_size();
 
-    /* Allocate buffer for MQTT send and receive operations. */
-    mqtt_network_buffer = (uint8_t *) pvPortMalloc(sizeof(uint8_t) * MQTT_NETWORK_BUFFER_SIZE);
-    if(mqtt_network_buffer == NULL)
+#if ENABLE_BROKER_FAILOVER
+    /* The control connection starts at the fastest broker of the list. The
+     * ranking is bounded by 'BROKER_FAILOVER_RANK_BUDGET_MS'.
+     */
+    broker_failover_init();
+    rank_brokers();
+    connections[MQTT_CONNECTION_CONTROL].broker_info = broker_failover_first();
+#endif /* ENABLE_BROKER_FAILOVER */
+
+    for (uint32_t id = 0; id < MQTT_CONNECTION_COUNT; id++)
+    {
+        result = mqtt_create_connection(&connections[id]);
+        if (CY_RSLT_SUCCESS != result)
+        {
+            return result;
+        }
+    }
+
+    return result;
+}
+
+/******************************************************************************
+ * Function Name: mqtt_create_connection
+ ******************************************************************************
+ * Summary:
+ *  Function that allocates the network buffer needed by the MQTT library for
+ *  MQTT send and receive operations of a connection, creates its MQTT client
+ *  instance and registers the event callback for it. The heap taken is
+ *  recorded in the statistics of the connection.
+ *
+ * Parameters:
+ *  mqtt_connection_context_t *connection : Connection to create
+ *
+ * Return:
+ *  cy_rslt_t : CY_RSLT_SUCCESS on a successful creation, else an error code
+ *              indicating the failure.
+ *
+ ******************************************************************************/
+static cy_rslt_t mqtt_create_connection(mqtt_connection_context_t *connection)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t heap_before = heap_usage_in_use();
+
+    /* Allocate buffer for MQTT send and receive operations. With
+     * ENABLE_STATIC_ALLOCATION, the storage is reserved at link time.
+     */
+#if ENABLE_STATIC_ALLOCATION
+    connection->network_buffer = connection->buffer_storage;
+    connection->stats.static_bytes = connection->buffer_storage_size;
+    static_alloc_account(connection->buffer_storage_size);
+#else
+    connection->network_buffer = (uint8_t *) pvPortMalloc(sizeof(uint8_t) *
+                                                          connection->stats.network_buffer_size);
+#endif /* ENABLE_STATIC_ALLOCATION */
+    if(connection->network_buffer == NULL)
     {
         result = ~CY_RSLT_SUCCESS;
     }
-    CHECK_RESULT(result, BUFFER_INITIALIZED, "Network Buffer allocation failed!\n\n");
+    CHECK_RESULT(result, connection->flags, BUFFER_INITIALIZED, "Network Buffer allocation failed!\n\n");
 
-    /* Create the MQTT client instance. */
-    result = cy_mqtt_create(mqtt_network_buffer, MQTT_NETWORK_BUFFER_SIZE,
-                            security_info, &broker_info,MQTT_HANDLE_DESCRIPTOR,
-                            &mqtt_connection);
-                            
-    CHECK_RESULT(result, MQTT_INSTANCE_CREATED, "\nMQTT instance creation failed!\n");
+    result = mqtt_create_instance(connection);
     if(CY_RSLT_SUCCESS == result)
     {
-        /* Register a MQTT event callback */
-        result = cy_mqtt_register_event_callback( mqtt_connection, (cy_mqtt_callback_t)mqtt_event_callback, NULL );
-        if(CY_RSLT_SUCCESS == result)
-        {       
-            printf("\nMQTT library initialization successful.\n");
-        }
-    }   
+        APP_LOG_INFO("\nMQTT %s connection initialized, %u-byte network buffer.\n",
+                     connection->name, (unsigned) connection->stats.network_buffer_size);
+    }
+
+    reconnect_backoff_init(&connection->backoff, MQTT_CONN_RETRY_FIRST_INTERVAL_MS,
+                           MQTT_CONN_RETRY_INTERVAL_MS, MQTT_CONN_RETRY_MAX_INTERVAL_MS);
+    connection->stats.create_heap_bytes = heap_growth(heap_before);
+    return result;
+}
+
+/******************************************************************************
+ * Function Name: mqtt_create_instance
+ ******************************************************************************
+ * Summary:
+ *  Function that creates the MQTT client instance of a connection for its
+ *  broker and network buffer, and registers the event callback for it.
+ *
+ * Parameters:
+ *  mqtt_connection_context_t *connection : Connection to create the
+ *                                          instance of
+ *
+ * Return:
+ *  cy_rslt_t : CY_RSLT_SUCCESS on a successful creation, else an error code
+ *              indicating the failure.
+ *
+ ******************************************************************************/
+static cy_rslt_t mqtt_create_instance(mqtt_connection_context_t *connection)
+{
+    cy_rslt_t result;
+
+    /* Create the MQTT client instance. */
+    result = cy_mqtt_create(connection->network_buffer, connection->stats.network_buffer_size,
+                            security_info, connection->broker_info, connection->descriptor,
+                            &connection->handle);
+
+    CHECK_RESULT(result, connection->flags, MQTT_INSTANCE_CREATED, "\nMQTT instance creation failed!\n");
+
+    /* Register a MQTT event callback */
+    result = cy_mqtt_register_event_callback( connection->handle,
+                                              (cy_mqtt_callback_t)mqtt_event_callback,
+                                              connection );
+    if (connection == &connections[MQTT_CONNECTION_CONTROL])
+    {
+        mqtt_connection = connection->handle;
+    }
     return result;
 }
 
@@ -448,58 +1063,89 @@ static cy_rslt_t mqtt_init(void)
  * Function Name: mqtt_connect
  ******************************************************************************
  * Summary:
- *  Function that initiates MQTT connect operation. The connection is retried
- *  a maximum of 'MAX_MQTT_CONN_RETRIES' times with interval of 
- *  'MQTT_CONN_RETRY_INTERVAL_MS' milliseconds.
+ *  Function that initiates MQTT connect operation of a connection. The
+ *  connection is retried up to the number of attempts of the connection
+ *  ('MAX_MQTT_CONN_RETRIES' for the control connection) with a jittered
+ *  exponential backoff that starts at 'MQTT_CONN_RETRY_FIRST_INTERVAL_MS'
+ *  milliseconds, grows from 'MQTT_CONN_RETRY_INTERVAL_MS' and is capped at
+ *  'MQTT_CONN_RETRY_MAX_INTERVAL_MS' milliseconds. The backoff continues
+ *  from the previous call until a connection succeeds.
  *
  * Parameters:
- *  void
+ *  mqtt_connection_context_t *connection : Connection to connect
  *
  * Return:
  *  cy_rslt_t : CY_RSLT_SUCCESS upon a successful MQTT connection, else an 
  *              error code indicating the failure.
  *
  ******************************************************************************/
-static cy_rslt_t mqtt_connect(void)
+static cy_rslt_t mqtt_connect(mqtt_connection_context_t *connection)
 {
     /* Variable to indicate status of various operations. */
     cy_rslt_t result = CY_RSLT_SUCCESS;
-
-    /* MQTT client identifier string. */
-    char mqtt_client_identifier[(MQTT_CLIENT_IDENTIFIER_MAX_LEN + 1)] = MQTT_CLIENT_IDENTIFIER;
+    cy_mqtt_connect_info_t *connect_info = connection->connect_info;
+    TickType_t start_ticks;
+    uint32_t heap_before;
+    uint32_t delay_ms;
 
     /* Configure the user credentials as a part of MQTT Connect packet */
     if (strlen(MQTT_USERNAME) > 0)
     {
-        connection_info.username = MQTT_USERNAME;
-        connection_info.password = MQTT_PASSWORD;
-        connection_info.username_len = sizeof(MQTT_USERNAME) - 1;
-        connection_info.password_len = sizeof(MQTT_PASSWORD) - 1;
+        connect_info->username = MQTT_USERNAME;
+        connect_info->password = MQTT_PASSWORD;
+        connect_info->username_len = sizeof(MQTT_USERNAME) - 1;
+        connect_info->password_len = sizeof(MQTT_PASSWORD) - 1;
     }
 
     /* Generate a unique client identifier with 'MQTT_CLIENT_IDENTIFIER' string 
-     * as a prefix if the `GENERATE_UNIQUE_CLIENT_ID` macro is enabled.
+     * and the suffix of the connection as a prefix if the
+     * `GENERATE_UNIQUE_CLIENT_ID` macro is enabled.
      */
 #if GENERATE_UNIQUE_CLIENT_ID
-    result = mqtt_get_unique_client_identifier(mqtt_client_identifier);
-    CHECK_RESULT(result, 0, "Failed to generate unique client identifier for the MQTT client!\n");
+    result = mqtt_get_unique_client_identifier(connection->client_id,
+                                               connection->client_id_suffix);
+    CHECK_RESULT(result, connection->flags, 0, "Failed to generate unique client identifier for the MQTT client!\n");
+#else
+    (void) snprintf(connection->client_id, sizeof(connection->client_id),
+                    MQTT_CLIENT_IDENTIFIER "%s", connection->client_id_suffix);
 #endif /* GENERATE_UNIQUE_CLIENT_ID */
 
     /* Set the client identifier buffer and length. */
-    connection_info.client_id = mqtt_client_identifier;
-    connection_info.client_id_len = strlen(mqtt_client_identifier);
+    connect_info->client_id = connection->client_id;
+    connect_info->client_id_len = strlen(connection->client_id);
+
+    APP_LOG_INFO("\n'%.*s' connecting to MQTT broker '%.*s'...\n",
+                 connect_info->client_id_len,
+                 connect_info->client_id,
+                 connection->broker_info->hostname_len,
+                 connection->broker_info->hostname);
 
-    printf("\n'%.*s' connecting to MQTT broker '%.*s'...\n",
-           connection_info.client_id_len,
-           connection_info.client_id,
-           broker_info.hostname_len,
-           broker_info.hostname);
+    start_ticks = xTaskGetTickCount();
 
-    for (uint32_t retry_count = 0; retry_count < MAX_MQTT_CONN_RETRIES; retry_count++)
+    for (uint32_t retry_count = 0; retry_count < connection->max_retries; retry_count++)
     {
+#if ENABLE_BROKER_FAILOVER
+        /* Move down the ranking after the attempts allowed per broker. */
+        if ((connection == &connections[MQTT_CONNECTION_CONTROL]) && (retry_count > 0u) &&
+            ((retry_count % BROKER_FAILOVER_ATTEMPTS_PER_BROKER) == 0u) &&
+            (broker_failover_count() > 1u))
+        {
+            result = mqtt_use_broker(connection, broker_failover_next());
+            if (CY_RSLT_SUCCESS != result)
+            {
+                return result;
+            }
+            reconnect_backoff_reset(&connection->backoff);
+            APP_LOG_INFO("\nFailing over to MQTT broker '%.*s'...\n",
+                         connection->broker_info->hostname_len,
+                         connection->broker_info->hostname);
+        }
+#endif /* ENABLE_BROKER_FAILOVER */
+
+
         if (cy_wcm_is_connected_to_ap() == 0)
         {
-            printf("\nUnexpectedly disconnected from Wi-Fi network! \nInitiating Wi-Fi reconnection...\n");
+            APP_LOG_WARN("\nUnexpectedly disconnected from Wi-Fi network! \nInitiating Wi-Fi reconnection...\n");
             status_flag &= ~(WIFI_CONNECTED);
 
             /* Initiate Wi-Fi reconnection. */
@@ -511,29 +1157,337 @@ static cy_rslt_t mqtt_connect(void)
         }
 
         /* Establish the MQTT connection. */
-        result = cy_mqtt_connect(mqtt_connection, &connection_info);
+        reconnect_episode_attempt(RECONNECT_LINK_MQTT);
+        heap_before = heap_usage_in_use();
+        connection->flags &= ~(MQTT_SESSION_PRESENT);
+#if defined(MQTT_CONNECT_LINKER_WRAP)
+        connack_session_present = false;
+#endif /* MQTT_CONNECT_LINKER_WRAP */
+        tls_session_cache_select((uint32_t)(connection - connections),
+                                 connection->broker_info->hostname,
+                                 connection->broker_info->hostname_len,
+                                 connection->broker_info->port);
+        result = cy_mqtt_connect(connection->handle, connect_info);
 
         if (result == CY_RSLT_SUCCESS)
         {
-            printf("MQTT connection successful.\r\n");
+            uint32_t heap_bytes = heap_growth(heap_before);
+
+            APP_LOG_INFO("MQTT %s connection successful.\r\n", connection->name);
+
+#if defined(MQTT_CONNECT_LINKER_WRAP)
+            if (connack_session_present)
+            {
+                connection->flags |= MQTT_SESSION_PRESENT;
+            }
+#endif /* MQTT_CONNECT_LINKER_WRAP */
+
+            /* The network buffer profile sizes the buffer of the control
+             * connection.
+             */
+            if (connection == &connections[MQTT_CONNECTION_CONTROL])
+            {
+                buffer_profile_add(BUFFER_PROFILE_OUTGOING, connect_packet_size(connect_info));
+            }
 
-            /* Set the appropriate bit in the status_flag to denote successful
-             * MQTT connection, and return the result to the calling function.
+            taskENTER_CRITICAL();
+            if (connection->stats.connects == 0u)
+            {
+                connection->stats.connect_heap_bytes = heap_bytes;
+            }
+            connection->stats.connects++;
+            connection->stats.last_connect_ms =
+                (uint32_t)((xTaskGetTickCount() - start_ticks) * portTICK_PERIOD_MS);
+            taskEXIT_CRITICAL();
+            reconnect_backoff_reset(&connection->backoff);
+
+            /* Set the appropriate bit in the flags of the connection to
+             * denote successful MQTT connection, and return the result to
+             * the calling function.
              */
-            status_flag |= MQTT_CONNECTION_SUCCESS;
+            connection->flags |= MQTT_CONNECTION_SUCCESS;
             return result;
         }
 
-        printf("\nMQTT connection failed with error code 0x%0X. \nRetrying in %d ms. Retries left: %d\n", 
-               (int)result, MQTT_CONN_RETRY_INTERVAL_MS, (int)(MAX_MQTT_CONN_RETRIES - retry_count - 1));
-        vTaskDelay(pdMS_TO_TICKS(MQTT_CONN_RETRY_INTERVAL_MS));
+        delay_ms = reconnect_backoff_next_delay_ms(&connection->backoff);
+        APP_LOG_WARN("\nMQTT connection failed with error code 0x%0X. \nRetrying in %d ms. Retries left: %d\n", 
+                     (int)result, (int)delay_ms, (int)(connection->max_retries - retry_count - 1));
+        vTaskDelay(pdMS_TO_TICKS(delay_ms));
+    }
+
+    APP_LOG_ERR("\nExceeded maximum MQTT connection attempts of the %s connection\n",
+                connection->name);
+    APP_LOG_ERR("MQTT connection failed after retrying for %d mins\n\n", 
+                (int)(((xTaskGetTickCount() - start_ticks) * portTICK_PERIOD_MS) / 60000u));
+    return result;
+}
+
+#if ENABLE_BROKER_FAILOVER
+/******************************************************************************
+ * Function Name: rank_brokers
+ ******************************************************************************
+ * Summary:
+ *  Probes the brokers of the failover list and prints the new ranking.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void rank_brokers(void)
+{
+    broker_failover_broker_t broker;
+
+    if (!broker_failover_rank())
+    {
+        APP_LOG_WARN("No MQTT broker of the failover list answered, ranking kept.\n");
+        return;
+    }
+
+    for (uint32_t rank = 0; broker_failover_get_broker(rank, &broker); rank++)
+    {
+        if (broker.reachable)
+        {
+            APP_LOG_DEBUG("Broker %u: '%.*s:%u', TCP connect %u ms (smoothed %u ms)\n",
+                          (unsigned) rank, broker.info->hostname_len, broker.info->hostname,
+                          (unsigned) broker.info->port, (unsigned) broker.last_rtt_ms,
+                          (unsigned) broker.srtt_ms);
+        }
+        else
+        {
+            APP_LOG_DEBUG("Broker %u: '%.*s:%u', not reachable\n",
+                          (unsigned) rank, broker.info->hostname_len, broker.info->hostname,
+                          (unsigned) broker.info->port);
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: mqtt_use_broker
+ ******************************************************************************
+ * Summary:
+ *  Points a connection that is not connected at another broker. The MQTT
+ *  library takes the broker when the instance is created, so the instance
+ *  is created again; the network buffer is kept, so the old instance is
+ *  deleted first. If the new instance cannot be created, the connection is
+ *  left without a handle, which the MQTT library rejects, and the next call
+ *  creates it again.
+ *
+ * Parameters:
+ *  mqtt_connection_context_t *connection : Connection to point elsewhere
+ *  cy_mqtt_broker_info_t *info : Broker to use
+ *
+ * Return:
+ *  cy_rslt_t : CY_RSLT_SUCCESS on success, else an error code indicating
+ *              the failure.
+ *
+ ******************************************************************************/
+static cy_rslt_t mqtt_use_broker(mqtt_connection_context_t *connection,
+                                 cy_mqtt_broker_info_t *info)
+{
+    cy_rslt_t result;
+
+    if ((info == connection->broker_info) &&
+        (0u != (connection->flags & MQTT_INSTANCE_CREATED)))
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    if (0u != (connection->flags & MQTT_INSTANCE_CREATED))
+    {
+        connection->flags &= ~(MQTT_INSTANCE_CREATED);
+        if (CY_RSLT_SUCCESS != cy_mqtt_delete(connection->handle))
+        {
+            APP_LOG_ERR("MQTT delete API failed unexpectedly.\n");
+        }
+    }
+
+    /* Do not leave the deleted handle to the publisher and subscriber. */
+    connection->handle = NULL;
+    if (connection == &connections[MQTT_CONNECTION_CONTROL])
+    {
+        mqtt_connection = NULL;
+    }
+
+    connection->broker_info = info;
+    result = mqtt_create_instance(connection);
+    if (0u == (connection->flags & MQTT_INSTANCE_CREATED))
+    {
+        connection->handle = NULL;
     }
 
-    printf("\nExceeded maximum MQTT connection attempts\n");
-    printf("MQTT connection failed after retrying for %d mins\n\n", 
-           (int)(MQTT_CONN_RETRY_INTERVAL_MS * MAX_MQTT_CONN_RETRIES) / 60000u);
     return result;
 }
+#endif /* ENABLE_BROKER_FAILOVER */
+
+#if ENABLE_BROKER_FAILOVER || ENABLE_DNS_CACHE
+/******************************************************************************
+ * Function Name: start_command_timer
+ ******************************************************************************
+ * Summary:
+ *  Starts a software timer that raises a command to this task periodically,
+ *  for background work that blocks and so cannot run in the timer task.
+ *
+ * Parameters:
+ *  const char *name : Name of the timer
+ *  TickType_t period : Period of the timer in ticks
+ *  mqtt_task_cmd_t cmd : Command to raise
+ *  StaticTimer_t *buffer : Storage of the timer with ENABLE_STATIC_ALLOCATION,
+ *                          else NULL
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void start_command_timer(const char *name, TickType_t period, mqtt_task_cmd_t cmd,
+                                StaticTimer_t *buffer)
+{
+    TimerHandle_t timer;
+
+#if ENABLE_STATIC_ALLOCATION
+    timer = xTimerCreateStatic(name, period, pdTRUE, (void *)(uintptr_t) cmd,
+                               command_timer_callback, buffer);
+    static_alloc_account(sizeof(*buffer));
+#else
+    (void) buffer;
+    timer = xTimerCreate(name, period, pdTRUE, (void *)(uintptr_t) cmd,
+                         command_timer_callback);
+#endif /* ENABLE_STATIC_ALLOCATION */
+    if ((timer == NULL) || (xTimerStart(timer, 0) != pdPASS))
+    {
+        APP_LOG_ERR("Failed to start the %s timer!\n", name);
+    }
+}
+
+/******************************************************************************
+ * Function Name: command_timer_callback
+ ******************************************************************************
+ * Summary:
+ *  Software timer callback that raises the command kept in the timer ID.
+ *
+ ******************************************************************************/
+static void command_timer_callback(TimerHandle_t timer)
+{
+    mqtt_task_notify((mqtt_task_cmd_t)(uintptr_t) pvTimerGetTimerID(timer));
+}
+#endif /* ENABLE_BROKER_FAILOVER || ENABLE_DNS_CACHE */
+
+/******************************************************************************
+ * Function Name: report_startup
+ ******************************************************************************
+ * Summary:
+ *  Prints the time from the scheduler start until the publisher task was
+ *  created, and the RAM placed in static storage instead of the heap. Compare
+ *  the output of builds with ENABLE_STATIC_ALLOCATION set to 0 and 1; the
+ *  heap usage samples show the heap side of the difference.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void report_startup(void)
+{
+    static_alloc_stats_t stats;
+
+    static_alloc_get_stats(&stats);
+    APP_LOG_INFO("\nStartup: publisher task created %u ms after the scheduler start, "
+                 "%s allocation, %u bytes in %u objects kept out of the heap.\n",
+                 (unsigned)(xTaskGetTickCount() * portTICK_PERIOD_MS),
+                 ENABLE_STATIC_ALLOCATION ? "static" : "dynamic",
+                 (unsigned) stats.bytes, (unsigned) stats.objects);
+}
+
+/******************************************************************************
+ * Function Name: print_connection_stats
+ ******************************************************************************
+ * Summary:
+ *  Prints the RAM taken by each MQTT connection: the network buffer, and the
+ *  heap taken by the MQTT client instance and by the first connection. The
+ *  difference between the first and any further connection is the cost of
+ *  an extra connection over the shared Wi-Fi link.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void print_connection_stats(void)
+{
+    mqtt_connection_stats_t stats;
+
+    for (uint32_t id = 0; id < MQTT_CONNECTION_COUNT; id++)
+    {
+        (void) mqtt_task_get_connection_stats((mqtt_connection_id_t) id, &stats);
+        APP_LOG_INFO("MQTT %s connection: %s, %u-byte network buffer (%u bytes static), "
+                     "heap taken by the instance: %u bytes, by the connection: %u bytes.\n",
+                     connections[id].name, stats.connected ? "connected" : "not connected",
+                     (unsigned) stats.network_buffer_size, (unsigned) stats.static_bytes,
+                     (unsigned) stats.create_heap_bytes, (unsigned) stats.connect_heap_bytes);
+    }
+}
+
+/******************************************************************************
+ * Function Name: heap_growth
+ ******************************************************************************
+ * Summary:
+ *  Returns the growth of the heap since an earlier heap_usage_in_use()
+ *  reading, or 0 if it shrank.
+ *
+ * Parameters:
+ *  uint32_t in_use_before : Earlier reading
+ *
+ * Return:
+ *  uint32_t : Bytes allocated since
+ *
+ ******************************************************************************/
+static uint32_t heap_growth(uint32_t in_use_before)
+{
+    uint32_t in_use = heap_usage_in_use();
+
+    return (in_use > in_use_before) ? (in_use - in_use_before) : 0u;
+}
+
+/******************************************************************************
+ * Function Name: connect_packet_size
+ ******************************************************************************
+ * Summary:
+ *  Returns the size of the CONNECT packet sent for the connection
+ *  information: the MQTT 3.1.1 variable header, the client identifier, and
+ *  the will message, user name and password when present.
+ *
+ * Parameters:
+ *  const cy_mqtt_connect_info_t *info : Connection information
+ *
+ * Return:
+ *  uint32_t : Size of the packet in bytes.
+ *
+ ******************************************************************************/
+static uint32_t connect_packet_size(const cy_mqtt_connect_info_t *info)
+{
+    /* Protocol name, level, flags and keep alive. */
+    uint32_t remaining_length = 10u + 2u + info->client_id_len;
+
+    if (info->will_info != NULL)
+    {
+        remaining_length += 2u + info->will_info->topic_len + 2u + info->will_info->payload_len;
+    }
+    if (info->username != NULL)
+    {
+        remaining_length += 2u + info->username_len;
+    }
+    if (info->password != NULL)
+    {
+        remaining_length += 2u + info->password_len;
+    }
+    return buffer_profile_packet_size(remaining_length);
+}
 
 /******************************************************************************
  * Function Name: mqtt_event_callback
@@ -542,7 +1496,7 @@ static cy_rslt_t mqtt_connect(void)
  *  Callback invoked by the MQTT library for events like MQTT disconnection, 
  *  incoming MQTT subscription messages from the MQTT broker. 
  *    1. In case of MQTT disconnection, the MQTT client task is communicated 
- *       about the disconnection using a message queue. 
+ *       about the disconnection using a task notification. 
  *    2. When an MQTT subscription message is received, the subscriber callback
  *       function implemented in subscriber_task.c is invoked to handle the 
  *       incoming MQTT message.
@@ -550,7 +1504,8 @@ static cy_rslt_t mqtt_connect(void)
  * Parameters:
  *  cy_mqtt_t mqtt_handle : MQTT handle corresponding to the MQTT event (unused)
  *  cy_mqtt_event_t event : MQTT event information
- *  void *user_data : User data pointer passed during cy_mqtt_create() (unused)
+ *  void *user_data : Connection the event belongs to, registered using
+ *                    cy_mqtt_register_event_callback()
  *
  * Return:
  *  void
@@ -558,30 +1513,32 @@ static cy_rslt_t mqtt_connect(void)
  ******************************************************************************/
 static void mqtt_event_callback(cy_mqtt_t mqtt_handle, cy_mqtt_event_t event, void *user_data)
 {
+    mqtt_connection_context_t *connection = (mqtt_connection_context_t *) user_data;
     cy_mqtt_publish_info_t *received_msg;
-    mqtt_task_cmd_t mqtt_task_cmd;
 
     (void) mqtt_handle;
-    (void) user_data;
 
     switch(event.type)
     {
         case CY_MQTT_EVENT_TYPE_DISCONNECT:
         {
-            /* Clear the status flag bit to indicate MQTT disconnection. */
-            status_flag &= ~(MQTT_CONNECTION_SUCCESS);
+            /* Clear the flag bit of the connection to indicate MQTT
+             * disconnection.
+             */
+            connection->flags &= ~(MQTT_CONNECTION_SUCCESS);
+            taskENTER_CRITICAL();
+            connection->stats.disconnects++;
+            taskEXIT_CRITICAL();
 
             /* MQTT connection with the MQTT broker is broken as the client
              * is unable to communicate with the broker. Set the appropriate
              * command to be sent to the MQTT task.
              */
-            printf("\nUnexpectedly disconnected from MQTT broker!\n");
-            mqtt_task_cmd = HANDLE_DISCONNECTION;
+            APP_LOG_WARN("\nUnexpectedly disconnected from MQTT broker (%s connection)!\n",
+                         connection->name);
 
-            /* Send the message to the MQTT client task to handle the 
-             * disconnection. 
-             */
-            xQueueSend(mqtt_task_q, &mqtt_task_cmd, portMAX_DELAY);
+            /* Notify the MQTT client task to handle the disconnection. */
+            mqtt_task_notify(HANDLE_DISCONNECTION);
             break;
         }
 
@@ -594,6 +1551,10 @@ static void mqtt_event_callback(cy_mqtt_t mqtt_handle, cy_mqtt_event_t event, vo
              */
 
             received_msg = &(event.data.pub_msg.received_message);
+            buffer_profile_add(BUFFER_PROFILE_INCOMING,
+                               buffer_profile_publish_packet_size(received_msg->topic_len,
+                                                                  received_msg->payload_len,
+                                                                  (uint8_t) received_msg->qos));
 
             mqtt_subscription_callback(received_msg);
             break;
@@ -601,41 +1562,187 @@ static void mqtt_event_callback(cy_mqtt_t mqtt_handle, cy_mqtt_event_t event, vo
         default :
         {
             /* Unknown MQTT event */
-            printf("\nUnknown Event received from MQTT callback!\n");
+            APP_LOG_WARN("\nUnknown Event received from MQTT callback!\n");
             break;
         }
     }
 }
 
+/******************************************************************************
+ * Function Name: seed_reconnect_policy
+ ******************************************************************************
+ * Summary:
+ *  Seeds the reconnection jitter with the MAC address of the Wi-Fi interface,
+ *  so that devices which lose the broker at the same time do not retry in
+ *  lockstep.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void seed_reconnect_policy(void)
+{
+    cy_wcm_mac_t mac_addr;
+
+    memset(mac_addr, 0, sizeof(mac_addr));
+    (void) cy_wcm_get_mac_addr(CY_WCM_INTERFACE_TYPE_STA, &mac_addr);
+    reconnect_policy_init(mac_addr, sizeof(mac_addr));
+}
+
+/******************************************************************************
+ * Function Name: print_reconnect_stats
+ ******************************************************************************
+ * Summary:
+ *  Prints the time and the connection attempts taken by the last
+ *  reconnection, and the summary of all reconnections so far. For secure
+ *  connections, the full and resumed TLS handshakes are summarized as well.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void print_reconnect_stats(void)
+{
+    reconnect_stats_t stats;
+#if (MQTT_SECURE_CONNECTION)
+    tls_session_cache_stats_t tls_stats;
+#endif /* (MQTT_SECURE_CONNECTION) */
+
+    reconnect_get_stats(&stats);
+    APP_LOG_INFO("Reconnected in %u ms after %u Wi-Fi and %u MQTT connection attempts.\n",
+                 (unsigned) stats.last_duration_ms,
+                 (unsigned) stats.last_attempts[RECONNECT_LINK_WIFI],
+                 (unsigned) stats.last_attempts[RECONNECT_LINK_MQTT]);
+    APP_LOG_INFO("Reconnections: %u, time to reconnect (ms) mean: %u, p99 <= %u, max: %u\n\n",
+                 (unsigned) stats.episodes, (unsigned) stats.mean_duration_ms,
+                 (unsigned) stats.p99_duration_ms, (unsigned) stats.max_duration_ms);
+
+#if (MQTT_SECURE_CONNECTION)
+    tls_session_cache_get_stats(&tls_stats);
+    APP_LOG_INFO("TLS handshakes full: %u (mean %u ms, max %u ms), resumed: %u (mean %u ms, "
+                 "max %u ms), refused resumptions: %u, failed: %u\n\n",
+                 (unsigned) tls_stats.full_handshakes, (unsigned) tls_stats.full_mean_ms,
+                 (unsigned) tls_stats.full_max_ms, (unsigned) tls_stats.resumed_handshakes,
+                 (unsigned) tls_stats.resumed_mean_ms, (unsigned) tls_stats.resumed_max_ms,
+                 (unsigned) tls_stats.refused_resumptions, (unsigned) tls_stats.failed_handshakes);
+#endif /* (MQTT_SECURE_CONNECTION) */
+}
+
+/******************************************************************************
+ * Function Name: mqtt_session_present
+ ******************************************************************************
+ * Summary:
+ *  Tells whether the broker resumed a session that holds the subscriptions of
+ *  the subscriber task: the CONNACK of the control connection had the session
+ *  present flag set, and the subscriptions were acknowledged on an earlier
+ *  connection. Where the flag cannot be read (see __wrap_MQTT_Connect()), the
+ *  subscriptions are always sent again; subscribing again is harmless.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool : true if the subscriptions need not be sent again, else false.
+ *
+ ******************************************************************************/
+static bool mqtt_session_present(void)
+{
+#if ENABLE_PERSISTENT_SESSION && defined(MQTT_CONNECT_LINKER_WRAP)
+    return (0u != (connections[MQTT_CONNECTION_CONTROL].flags & MQTT_SESSION_PRESENT)) &&
+           subscriber_is_subscribed();
+#else
+    return false;
+#endif /* ENABLE_PERSISTENT_SESSION && defined(MQTT_CONNECT_LINKER_WRAP) */
+}
+
+#if defined(MQTT_CONNECT_LINKER_WRAP)
+/******************************************************************************
+ * Function Name: __wrap_MQTT_Connect
+ ******************************************************************************
+ * Summary:
+ *  Takes the place of MQTT_Connect() of coreMQTT in the image (see the
+ *  Makefile), to capture the session present flag of the CONNACK that
+ *  cy_mqtt_connect() does not report. cy_mqtt_connect() runs it in the
+ *  calling task, i.e. the MQTT client task, one connection at a time.
+ *
+ * Parameters:
+ *  As MQTT_Connect()
+ *
+ * Return:
+ *  MQTTStatus_t : Status of MQTT_Connect()
+ *
+ ******************************************************************************/
+MQTTStatus_t __wrap_MQTT_Connect(MQTTContext_t *pContext, const MQTTConnectInfo_t *pConnectInfo,
+                                 const MQTTPublishInfo_t *pWillInfo, uint32_t timeoutMs,
+                                 bool *pSessionPresent)
+{
+    MQTTStatus_t status = __real_MQTT_Connect(pContext, pConnectInfo, pWillInfo, timeoutMs,
+                                              pSessionPresent);
+
+    connack_session_present = (status == MQTTSuccess) && (pSessionPresent != NULL) &&
+                              *pSessionPresent;
+    return status;
+}
+#endif /* MQTT_CONNECT_LINKER_WRAP */
+
 #if GENERATE_UNIQUE_CLIENT_ID
 /******************************************************************************
  * Function Name: mqtt_get_unique_client_identifier
  ******************************************************************************
  * Summary:
  *  Function that generates unique client identifier for the MQTT client by
- *  appending a timestamp to a common prefix 'MQTT_CLIENT_IDENTIFIER'.
+ *  appending a timestamp to a common prefix 'MQTT_CLIENT_IDENTIFIER' and the
+ *  suffix of the connection. With a persistent session the last three bytes
+ *  of the MAC address are appended instead, so that the broker finds the
+ *  session again after reconnections and resets.
  *
  * Parameters:
  *  char *mqtt_client_identifier : Pointer to the string that stores the 
  *                                 generated unique identifier
+ *  const char *suffix : Suffix of the connection, placed ahead of the unique
+ *                       part so that truncation keeps the identifiers of
+ *                       the connections apart
  *
  * Return:
  *  cy_rslt_t : CY_RSLT_SUCCESS on successful generation of the client 
  *              identifier, else a non-zero value indicating failure.
  *
  ******************************************************************************/
-static cy_rslt_t mqtt_get_unique_client_identifier(char *mqtt_client_identifier)
+static cy_rslt_t mqtt_get_unique_client_identifier(char *mqtt_client_identifier,
+                                                   const char *suffix)
 {
     cy_rslt_t status = CY_RSLT_SUCCESS;
 
+#if ENABLE_PERSISTENT_SESSION
+    cy_wcm_mac_t mac_addr;
+
+    status = cy_wcm_get_mac_addr(CY_WCM_INTERFACE_TYPE_STA, &mac_addr);
+
+    /* Check for errors from snprintf. */
+    if ((status == CY_RSLT_SUCCESS) &&
+        (0 > snprintf(mqtt_client_identifier,
+                      (MQTT_CLIENT_IDENTIFIER_MAX_LEN + 1),
+                      MQTT_CLIENT_IDENTIFIER "%s%02x%02x%02x",
+                      suffix, mac_addr[3], mac_addr[4], mac_addr[5])))
+    {
+        status = ~CY_RSLT_SUCCESS;
+    }
+#else
     /* Check for errors from snprintf. */
     if (0 > snprintf(mqtt_client_identifier,
                      (MQTT_CLIENT_IDENTIFIER_MAX_LEN + 1),
-                     MQTT_CLIENT_IDENTIFIER "%lu",
-                     (long unsigned int)Clock_GetTimeMs()))
+                     MQTT_CLIENT_IDENTIFIER "%s%lu",
+                     suffix, (long unsigned int)Clock_GetTimeMs()))
     {
         status = ~CY_RSLT_SUCCESS;
     }
+#endif /* ENABLE_PERSISTENT_SESSION */
 
     return status;
 }
@@ -646,7 +1753,7 @@ static cy_rslt_t mqtt_get_unique_client_identifier(char *mqtt_client_identifier)
  ******************************************************************************
  * Summary:
  *  Function that invokes the deinit and cleanup functions for various 
- *  operations based on the status_flag.
+ *  operations based on the status_flag and the flags of each connection.
  *
  * Parameters:
  *  void
@@ -659,38 +1766,47 @@ static void cleanup(void)
 {
     cy_rslt_t status = CY_RSLT_SUCCESS;
 
-    /* Disconnect the MQTT connection if it was established. */
-    if (status_flag & MQTT_CONNECTION_SUCCESS)
+    for (uint32_t id = MQTT_CONNECTION_COUNT; id-- > 0u; )
     {
-        status = cy_mqtt_disconnect(mqtt_connection);
+        mqtt_connection_context_t *connection = &connections[id];
 
-        if (status == CY_RSLT_SUCCESS)
+        /* Disconnect the MQTT connection if it was established. */
+        if (connection->flags & MQTT_CONNECTION_SUCCESS)
         {
-            printf("Disconnected from the MQTT Broker...\n");
+            status = cy_mqtt_disconnect(connection->handle);
+
+            if (status == CY_RSLT_SUCCESS)
+            {
+                APP_LOG_INFO("Disconnected the %s connection from the MQTT Broker...\n",
+                             connection->name);
+            }
+            else
+            {
+                APP_LOG_ERR("MQTT disconnect API failed unexpectedly.\n");
+            }
         }
-        else
+        /* Delete the MQTT instance if it was created. */
+        if (connection->flags & MQTT_INSTANCE_CREATED)
         {
-            printf("MQTT disconnect API failed unexpectedly.\n");
-        }
-    }
-    /* Delete the MQTT instance if it was created. */
-    if (status_flag & MQTT_INSTANCE_CREATED)
-    {
-        status = cy_mqtt_delete(mqtt_connection);
+            status = cy_mqtt_delete(connection->handle);
 
-        if (status == CY_RSLT_SUCCESS)
-        {
-            printf("Removed MQTT connection info from stack...\n");
+            if (status == CY_RSLT_SUCCESS)
+            {
+                APP_LOG_INFO("Removed MQTT connection info from stack...\n");
+            }
+            else
+            {
+                APP_LOG_ERR("MQTT delete API failed unexpectedly.\n");
+            }
         }
-        else
+        /* Deallocate the network buffer. */
+#if !ENABLE_STATIC_ALLOCATION
+        if (connection->flags & BUFFER_INITIALIZED)
         {
-            printf("MQTT delete API failed unexpectedly.\n");
+            vPortFree((void *) connection->network_buffer);
         }
-    }
-    /* Deallocate the network buffer. */
-    if (status_flag & BUFFER_INITIALIZED)
-    {
-        vPortFree((void *) mqtt_network_buffer);
+#endif /* !ENABLE_STATIC_ALLOCATION */
+        connection->flags = 0u;
     }
     /* Deinit the MQTT library. */
     if (status_flag & LIBS_INITIALIZED)
@@ -699,11 +1815,11 @@ static void cleanup(void)
 
         if (status == CY_RSLT_SUCCESS)
         {
-            printf("Deinitialized MQTT stack...\n");
+            APP_LOG_INFO("Deinitialized MQTT stack...\n");
         }
         else
         {
-            printf("MQTT deinit API failed unexpectedly.\n");
+            APP_LOG_ERR("MQTT deinit API failed unexpectedly.\n");
         }
     }
     /* Disconnect from Wi-Fi AP. */
@@ -713,11 +1829,11 @@ static void cleanup(void)
 
         if (status == CY_RSLT_SUCCESS)
         {
-            printf("Disconnected from the Wi-Fi AP!\n");
+            APP_LOG_INFO("Disconnected from the Wi-Fi AP!\n");
         }
         else
         {
-            printf("WCM disconnect AP failed unexpectedly.\n");
+            APP_LOG_ERR("WCM disconnect AP failed unexpectedly.\n");
         }
     }
     /* De-initialize the Wi-Fi Connection Manager. */
@@ -727,11 +1843,11 @@ static void cleanup(void)
 
         if (status == CY_RSLT_SUCCESS)
         {
-            printf("Deinitialized Wifi connection...\n");
+            APP_LOG_INFO("Deinitialized Wifi connection...\n");
         }
         else
         {
-            printf("WCM deinit API failed unexpectedly.\n");
+            APP_LOG_ERR("WCM deinit API failed unexpectedly.\n");
         }
     }
 }
@@ -42,8 +42,10 @@
 #ifndef MQTT_TASK_H_
 #define MQTT_TASK_H_
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "FreeRTOS.h"
-#include "queue.h"
+#include "task.h"
 #include "cy_mqtt_api.h"
 
 
@@ -57,24 +59,76 @@
 /*******************************************************************************
 * Global Variables
 ********************************************************************************/
-/* Commands for the MQTT Client Task. */
+/* Commands for the MQTT Client Task. Each one is a bit of its notification
+ * value, so that a command raised again before the task handled it is
+ * coalesced with the pending one.
+ */
 typedef enum
 {
     HANDLE_MQTT_SUBSCRIBE_FAILURE,
     HANDLE_MQTT_PUBLISH_FAILURE,
-    HANDLE_DISCONNECTION
+    HANDLE_DISCONNECTION,
+    PERSIST_BUFFER_PROFILE,         /* A packet called for a larger network buffer */
+    RANK_BROKERS,                   /* Time to rank the brokers of the failover list */
+    REFRESH_DNS_CACHE,              /* Time to refresh the addresses in the DNS cache */
+    MQTT_TASK_CMD_COUNT
 } mqtt_task_cmd_t;
 
+/* Control plane counters of the MQTT Client Task. */
+typedef struct
+{
+    uint32_t raised[MQTT_TASK_CMD_COUNT];       /* mqtt_task_notify() calls */
+    uint32_t coalesced[MQTT_TASK_CMD_COUNT];    /* ... that found the command pending */
+    uint32_t dropped;                           /* ... before the task started */
+    uint32_t reconnect_cycles;                  /* Disconnections handled */
+    uint32_t stale_disconnects;                 /* Disconnections found already
+                                                 * recovered, e.g. raised during
+                                                 * the previous reconnection */
+} mqtt_task_control_stats_t;
+
+/* MQTT connections of the MQTT Client Task. The control connection serves
+ * the publisher and subscriber tasks; the telemetry connection exists with
+ * ENABLE_TELEMETRY_CONNECTION only.
+ */
+typedef enum
+{
+    MQTT_CONNECTION_CONTROL,
+    MQTT_CONNECTION_TELEMETRY
+} mqtt_connection_id_t;
+
+/* Cost and counters of one MQTT connection. The heap figures are the growth
+ * of the heap across the operation, so they include the allocations other
+ * tasks made meanwhile.
+ */
+typedef struct
+{
+    bool connected;
+    uint32_t network_buffer_size;       /* Bytes handed to the MQTT library */
+    uint32_t static_bytes;              /* RAM reserved at link time for the buffer */
+    uint32_t create_heap_bytes;         /* Heap taken by the network buffer and
+                                         * cy_mqtt_create() */
+    uint32_t connect_heap_bytes;        /* Heap taken by the first connection,
+                                         * i.e. the socket and the TLS context */
+    uint32_t connects;                  /* Successful connections */
+    uint32_t disconnects;               /* Unexpected disconnections */
+    uint32_t last_connect_ms;           /* Time taken by the last connection,
+                                         * retries included */
+} mqtt_connection_stats_t;
+
 /*******************************************************************************
  * Extern variables
  ******************************************************************************/
 extern cy_mqtt_t mqtt_connection;
-extern QueueHandle_t mqtt_task_q;
+extern TaskHandle_t mqtt_client_task_handle;
 
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
 void mqtt_client_task(void *pvParameters);
+void mqtt_task_notify(mqtt_task_cmd_t cmd);
+void mqtt_task_get_control_stats(mqtt_task_control_stats_t *stats);
+cy_rslt_t mqtt_task_publish(mqtt_connection_id_t id, cy_mqtt_publish_info_t *publish_info);
+bool mqtt_task_get_connection_stats(mqtt_connection_id_t id, mqtt_connection_stats_t *stats);
 
 #endif /* MQTT_TASK_H_ */
 
@@ -0,0 +1,465 @@
+/******************************************************************************
+* File Name:   payload_compress.c
+*
+* Description: This file implements a small LZ77 compressor for MQTT
+*              payloads, working with a fixed window and a user-provided work
+*              buffer, and the matching decompressor.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "payload_compress.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* The compressed data is a series of sequences, each made of a run of
+ * literals copied as is and a match copied from earlier output:
+ *
+ *   | token | literal length ext | literals | offset lo | offset hi | match length ext |
+ *
+ * The high nibble of the token is the number of literals and the low nibble
+ * the match length minus 'MIN_MATCH'; a nibble of 15 is followed by extension
+ * bytes added to it, the last one less than 255. The offset is the distance
+ * of the match back from the current output position. The last sequence has
+ * literals only and ends with the data.
+ */
+#define MIN_MATCH                       (4u)
+#define TOKEN_NIBBLE_MAX                (15u)
+#define LENGTH_EXT_MAX                  (255u)
+#define OFFSET_SIZE                     (2u)
+
+/* Multiplier of the Fibonacci hash of a 4-byte sequence. */
+#define HASH_MULTIPLIER                 (2654435761u)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t hash_sequence(const uint8_t *data);
+static size_t length_ext_size(size_t length);
+static uint8_t *write_length_ext(uint8_t *out, size_t length);
+static bool read_length_ext(const uint8_t **in, const uint8_t *end, size_t *length);
+static bool emit_sequence(uint8_t *out, size_t *out_len, size_t limit,
+                          const uint8_t *literals, size_t literal_len,
+                          size_t offset, size_t match_len);
+static size_t compress_block(payload_compressor_t *compressor, const uint8_t *in, size_t in_len,
+                             uint8_t *out, size_t limit);
+static bool decompress_block(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_size,
+                             size_t *out_len);
+
+/******************************************************************************
+ * Function Name: hash_sequence
+ ******************************************************************************
+ * Summary:
+ *  Hashes the 4-byte sequence at the given position.
+ *
+ ******************************************************************************/
+static uint32_t hash_sequence(const uint8_t *data)
+{
+    uint32_t sequence;
+
+    memcpy(&sequence, data, sizeof(sequence));
+    return (sequence * HASH_MULTIPLIER) >> (32u - PAYLOAD_COMPRESS_HASH_BITS);
+}
+
+/******************************************************************************
+ * Function Name: length_ext_size
+ ******************************************************************************
+ * Summary:
+ *  Number of extension bytes of a length whose token nibble is saturated.
+ *
+ ******************************************************************************/
+static size_t length_ext_size(size_t length)
+{
+    return (length < TOKEN_NIBBLE_MAX) ? 0u : (((length - TOKEN_NIBBLE_MAX) / LENGTH_EXT_MAX) + 1u);
+}
+
+/******************************************************************************
+ * Function Name: write_length_ext
+ ******************************************************************************/
+static uint8_t *write_length_ext(uint8_t *out, size_t length)
+{
+    if (length >= TOKEN_NIBBLE_MAX)
+    {
+        length -= TOKEN_NIBBLE_MAX;
+        while (length >= LENGTH_EXT_MAX)
+        {
+            *out++ = (uint8_t) LENGTH_EXT_MAX;
+            length -= LENGTH_EXT_MAX;
+        }
+        *out++ = (uint8_t) length;
+    }
+
+    return out;
+}
+
+/******************************************************************************
+ * Function Name: read_length_ext
+ ******************************************************************************/
+static bool read_length_ext(const uint8_t **in, const uint8_t *end, size_t *length)
+{
+    uint8_t byte;
+
+    if (*length < TOKEN_NIBBLE_MAX)
+    {
+        return true;
+    }
+
+    do
+    {
+        if (*in >= end)
+        {
+            return false;
+        }
+        byte = *(*in)++;
+        *length += byte;
+    } while (byte == LENGTH_EXT_MAX);
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: emit_sequence
+ ******************************************************************************
+ * Summary:
+ *  Appends a sequence to the compressed data unless it would exceed 'limit'
+ *  bytes. A 'match_len' of 0 makes the last sequence.
+ *
+ ******************************************************************************/
+static bool emit_sequence(uint8_t *out, size_t *out_len, size_t limit,
+                          const uint8_t *literals, size_t literal_len,
+                          size_t offset, size_t match_len)
+{
+    size_t match_code = (match_len != 0u) ? (match_len - MIN_MATCH) : 0u;
+    size_t needed = 1u + length_ext_size(literal_len) + literal_len;
+    uint8_t *op = &out[*out_len];
+
+    if (match_len != 0u)
+    {
+        needed += OFFSET_SIZE + length_ext_size(match_code);
+    }
+    if (needed > (limit - *out_len))
+    {
+        return false;
+    }
+
+    *op++ = (uint8_t)((((literal_len < TOKEN_NIBBLE_MAX) ? literal_len : TOKEN_NIBBLE_MAX) << 4) |
+                      ((match_code < TOKEN_NIBBLE_MAX) ? match_code : TOKEN_NIBBLE_MAX));
+    op = write_length_ext(op, literal_len);
+    memcpy(op, literals, literal_len);
+    op += literal_len;
+
+    if (match_len != 0u)
+    {
+        *op++ = (uint8_t) offset;
+        *op++ = (uint8_t)(offset >> 8);
+        op = write_length_ext(op, match_code);
+    }
+
+    *out_len += needed;
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: compress_block
+ ******************************************************************************
+ * Summary:
+ *  Greedy LZ77 parse: at each position, the last earlier occurrence of the
+ *  next four bytes within the window is extended as far as it matches.
+ *
+ * Return:
+ *  size_t : Length of the compressed data, 0 if it exceeds 'limit'
+ *
+ ******************************************************************************/
+static size_t compress_block(payload_compressor_t *compressor, const uint8_t *in, size_t in_len,
+                             uint8_t *out, size_t limit)
+{
+    size_t out_len = 0u;
+    size_t anchor = 0u;
+    size_t pos = 0u;
+
+    /* Positions are stored plus one; 0 marks an empty entry. */
+    memset(compressor->positions, 0, sizeof(compressor->positions));
+
+    while ((pos + MIN_MATCH) <= in_len)
+    {
+        uint32_t hash = hash_sequence(&in[pos]);
+        size_t candidate = compressor->positions[hash];
+
+        compressor->positions[hash] = (uint16_t)(pos + 1u);
+
+        if ((candidate != 0u) && ((pos - (candidate - 1u)) <= PAYLOAD_COMPRESS_WINDOW_SIZE) &&
+            (memcmp(&in[candidate - 1u], &in[pos], MIN_MATCH) == 0))
+        {
+            size_t match = candidate - 1u;
+            size_t match_len = MIN_MATCH;
+
+            while (((pos + match_len) < in_len) && (in[match + match_len] == in[pos + match_len]))
+            {
+                match_len++;
+            }
+
+            if (!emit_sequence(out, &out_len, limit, &in[anchor], pos - anchor,
+                               pos - match, match_len))
+            {
+                return 0u;
+            }
+
+            pos += match_len;
+            anchor = pos;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+
+    if (!emit_sequence(out, &out_len, limit, &in[anchor], in_len - anchor, 0u, 0u))
+    {
+        return 0u;
+    }
+
+    return out_len;
+}
+
+/******************************************************************************
+ * Function Name: decompress_block
+ ******************************************************************************
+ * Summary:
+ *  Decodes the sequences, checking every length and offset against the
+ *  input and the output buffer.
+ *
+ ******************************************************************************/
+static bool decompress_block(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_size,
+                             size_t *out_len)
+{
+    const uint8_t *end = in + in_len;
+    size_t op = 0u;
+
+    while (in < end)
+    {
+        uint8_t token = *in++;
+        size_t literal_len = token >> 4;
+        size_t match_len = token & TOKEN_NIBBLE_MAX;
+        size_t offset;
+
+        if (!read_length_ext(&in, end, &literal_len) ||
+            (literal_len > (size_t)(end - in)) || (literal_len > (out_size - op)))
+        {
+            return false;
+        }
+        memcpy(&out[op], in, literal_len);
+        in += literal_len;
+        op += literal_len;
+
+        /* The last sequence has no match. */
+        if (in == end)
+        {
+            break;
+        }
+
+        if ((size_t)(end - in) < OFFSET_SIZE)
+        {
+            return false;
+        }
+        offset = (size_t) in[0] | ((size_t) in[1] << 8);
+        in += OFFSET_SIZE;
+
+        if (!read_length_ext(&in, end, &match_len))
+        {
+            return false;
+        }
+        match_len += MIN_MATCH;
+
+        if ((offset == 0u) || (offset > op) || (match_len > (out_size - op)))
+        {
+            return false;
+        }
+
+        /* Byte by byte: the match may overlap the output it produces. */
+        for (size_t i = 0; i < match_len; i++, op++)
+        {
+            out[op] = out[op - offset];
+        }
+    }
+
+    *out_len = op;
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: payload_compress
+ ******************************************************************************
+ * Summary:
+ *  Chooses the form of a payload to be published: compressed if that makes
+ *  it shorter, else the plain payload, or the payload stored behind a header
+ *  if it starts with a header byte.
+ *
+ * Parameters:
+ *  payload_compressor_t *compressor : Work buffer
+ *  const void *payload : Payload
+ *  size_t payload_len : Length of the payload in bytes
+ *  void *buffer : Buffer for the compressed or stored form
+ *  size_t buffer_size : Size of the buffer; PAYLOAD_COMPRESS_BUFFER_SIZE() of
+ *                       the payload length fits every form
+ *  const void **wire : Payload to publish: 'buffer' or 'payload'
+ *  size_t *wire_len : Length of the payload to publish
+ *
+ * Return:
+ *  payload_compress_form_t : Form chosen
+ *
+ ******************************************************************************/
+payload_compress_form_t payload_compress(payload_compressor_t *compressor,
+                                         const void *payload, size_t payload_len,
+                                         void *buffer, size_t buffer_size,
+                                         const void **wire, size_t *wire_len)
+{
+    uint8_t *out = (uint8_t *) buffer;
+
+    /* The compressed form must be shorter than the payload, header included.
+     * Positions in the hash table are 16-bit.
+     */
+    if ((payload_len >= PAYLOAD_COMPRESS_MIN_SIZE) && (payload_len < UINT16_MAX) &&
+        (buffer_size > PAYLOAD_COMPRESS_HEADER_SIZE))
+    {
+        size_t limit = payload_len - PAYLOAD_COMPRESS_HEADER_SIZE - 1u;
+        size_t body_len;
+
+        if (limit > (buffer_size - PAYLOAD_COMPRESS_HEADER_SIZE))
+        {
+            limit = buffer_size - PAYLOAD_COMPRESS_HEADER_SIZE;
+        }
+
+        body_len = compress_block(compressor, (const uint8_t *) payload, payload_len,
+                                  &out[PAYLOAD_COMPRESS_HEADER_SIZE], limit);
+        if (body_len != 0u)
+        {
+            out[0] = (uint8_t) PAYLOAD_COMPRESS_MARKER_LZ;
+            *wire = buffer;
+            *wire_len = body_len + PAYLOAD_COMPRESS_HEADER_SIZE;
+            return PAYLOAD_COMPRESS_LZ;
+        }
+    }
+
+    *wire = payload;
+    *wire_len = payload_len;
+
+    if (!payload_compress_is_framed(payload, payload_len))
+    {
+        return PAYLOAD_COMPRESS_RAW;
+    }
+
+    if (PAYLOAD_COMPRESS_BUFFER_SIZE(payload_len) > buffer_size)
+    {
+        return PAYLOAD_COMPRESS_TOO_LARGE;
+    }
+
+    out[0] = (uint8_t) PAYLOAD_COMPRESS_MARKER_STORED;
+    memcpy(&out[PAYLOAD_COMPRESS_HEADER_SIZE], payload, payload_len);
+    *wire = buffer;
+    *wire_len = PAYLOAD_COMPRESS_BUFFER_SIZE(payload_len);
+    return PAYLOAD_COMPRESS_STORED;
+}
+
+/******************************************************************************
+ * Function Name: payload_compress_is_framed
+ ******************************************************************************
+ * Summary:
+ *  Checks whether a received payload starts with a compression header.
+ *
+ * Parameters:
+ *  const void *payload : Received payload
+ *  size_t payload_len : Length of the payload in bytes
+ *
+ * Return:
+ *  bool : true if the payload is to be decompressed
+ *
+ ******************************************************************************/
+bool payload_compress_is_framed(const void *payload, size_t payload_len)
+{
+    const uint8_t *data = (const uint8_t *) payload;
+
+    return (payload_len >= PAYLOAD_COMPRESS_HEADER_SIZE) &&
+           ((data[0] == PAYLOAD_COMPRESS_MARKER_LZ) || (data[0] == PAYLOAD_COMPRESS_MARKER_STORED));
+}
+
+/******************************************************************************
+ * Function Name: payload_decompress
+ ******************************************************************************
+ * Summary:
+ *  Restores a payload framed by payload_compress().
+ *
+ * Parameters:
+ *  const void *payload : Received payload, starting with its header
+ *  size_t payload_len : Length of the received payload in bytes
+ *  void *buffer : Buffer for the restored payload
+ *  size_t buffer_size : Size of the buffer
+ *  size_t *length : Length of the restored payload
+ *
+ * Return:
+ *  bool : false if the payload is not framed, malformed, or does not fit
+ *
+ ******************************************************************************/
+bool payload_decompress(const void *payload, size_t payload_len,
+                        void *buffer, size_t buffer_size, size_t *length)
+{
+    const uint8_t *data = (const uint8_t *) payload;
+
+    if (!payload_compress_is_framed(payload, payload_len))
+    {
+        return false;
+    }
+
+    if (data[0] == PAYLOAD_COMPRESS_MARKER_STORED)
+    {
+        size_t stored_len = payload_len - PAYLOAD_COMPRESS_HEADER_SIZE;
+
+        if (stored_len > buffer_size)
+        {
+            return false;
+        }
+        memcpy(buffer, &data[PAYLOAD_COMPRESS_HEADER_SIZE], stored_len);
+        *length = stored_len;
+        return true;
+    }
+
+    return decompress_block(&data[PAYLOAD_COMPRESS_HEADER_SIZE],
+                            payload_len - PAYLOAD_COMPRESS_HEADER_SIZE,
+                            (uint8_t *) buffer, buffer_size, length);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name:   payload_compress.h
+*
+* Description: This file is the public interface of payload_compress.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PAYLOAD_COMPRESS_H_
+#define PAYLOAD_COMPRESS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* A compressed payload starts with a one-byte header that tells how the rest
+ * is encoded:
+ *
+ *   | 0xC7 | LZ sequences ... |     compressed
+ *   | 0xC6 | payload ...      |     stored as is
+ *
+ * A payload that does not shrink is sent as the plain payload, like a batch of
+ * one record, unless it starts with one of the header bytes itself; then it is
+ * stored behind the 0xC6 header so that the receiver does not misread it.
+ * Neither byte starts a text payload, a CBOR device state message or a batch.
+ */
+#define PAYLOAD_COMPRESS_MARKER_LZ          (0xC7u)
+#define PAYLOAD_COMPRESS_MARKER_STORED      (0xC6u)
+#define PAYLOAD_COMPRESS_HEADER_SIZE        (1u)
+
+/* Matches are searched for in the previous 'PAYLOAD_COMPRESS_WINDOW_SIZE'
+ * bytes of the payload, through a hash table of the last position of
+ * 2^'PAYLOAD_COMPRESS_HASH_BITS' 4-byte sequences.
+ */
+#define PAYLOAD_COMPRESS_WINDOW_SIZE        (1024u)
+#define PAYLOAD_COMPRESS_HASH_BITS          (8u)
+
+/* Payloads shorter than this are not worth compressing. */
+#define PAYLOAD_COMPRESS_MIN_SIZE           (16u)
+
+/* Size of the buffer that holds the compressed form of a payload of up to
+ * 'n' bytes, whatever the form chosen.
+ */
+#define PAYLOAD_COMPRESS_BUFFER_SIZE(n)     ((n) + PAYLOAD_COMPRESS_HEADER_SIZE)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Work buffer of the compressor, provided by the user and reused across
+ * calls; it does not need to be initialized.
+ */
+typedef struct
+{
+    uint16_t positions[1u << PAYLOAD_COMPRESS_HASH_BITS];
+} payload_compressor_t;
+
+/* Form of a payload chosen by payload_compress(). */
+typedef enum
+{
+    PAYLOAD_COMPRESS_RAW,           /* Sent as the plain payload */
+    PAYLOAD_COMPRESS_LZ,            /* Compressed */
+    PAYLOAD_COMPRESS_STORED,        /* Stored behind a header */
+    PAYLOAD_COMPRESS_TOO_LARGE      /* Starts with a header byte and does not fit
+                                     * the buffer; sent as the plain payload */
+} payload_compress_form_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+payload_compress_form_t payload_compress(payload_compressor_t *compressor,
+                                         const void *payload, size_t payload_len,
+                                         void *buffer, size_t buffer_size,
+                                         const void **wire, size_t *wire_len);
+bool payload_compress_is_framed(const void *payload, size_t payload_len);
+bool payload_decompress(const void *payload, size_t payload_len,
+                        void *buffer, size_t buffer_size, size_t *length);
+
+#endif /* PAYLOAD_COMPRESS_H_ */
+
+/* [] END OF FILE */
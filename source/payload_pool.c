@@ -0,0 +1,409 @@
+/******************************************************************************
+* File Name:   payload_pool.c
+*
+* Description: This file contains a static pool of payload buffers in several
+*              size classes. Producers take a buffer from the pool, fill it
+*              and hand it to the publisher task over its queue; the
+*              publisher task returns the buffer to the pool once the publish
+*              completes. No heap allocation takes place.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+#include "payload_pool.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Buffers are kept word aligned so that producers can store binary records
+ * in place.
+ */
+#define POOL_WORDS(size)                (((size) + sizeof(uint32_t) - 1u) / sizeof(uint32_t))
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* State of one size class. Free buffers are kept on a stack of indices. */
+typedef struct
+{
+    uint8_t *storage;
+    uint16_t *free_stack;
+    uint32_t free_count;
+    payload_pool_stats_t stats;
+} pool_class_t;
+
+/* Buffer storage and free stacks of the size classes. */
+static uint32_t small_storage[PAYLOAD_POOL_SMALL_COUNT][POOL_WORDS(PAYLOAD_POOL_SMALL_SIZE)];
+static uint32_t medium_storage[PAYLOAD_POOL_MEDIUM_COUNT][POOL_WORDS(PAYLOAD_POOL_MEDIUM_SIZE)];
+static uint32_t large_storage[PAYLOAD_POOL_LARGE_COUNT][POOL_WORDS(PAYLOAD_POOL_LARGE_SIZE)];
+static uint16_t small_free[PAYLOAD_POOL_SMALL_COUNT];
+static uint16_t medium_free[PAYLOAD_POOL_MEDIUM_COUNT];
+static uint16_t large_free[PAYLOAD_POOL_LARGE_COUNT];
+
+/* Size classes in increasing order of block size. */
+static pool_class_t pool_classes[PAYLOAD_POOL_CLASS_COUNT] =
+{
+    {
+        .storage = (uint8_t *) small_storage, .free_stack = small_free,
+        .stats = { .block_size = sizeof(small_storage[0]), .block_count = PAYLOAD_POOL_SMALL_COUNT }
+    },
+    {
+        .storage = (uint8_t *) medium_storage, .free_stack = medium_free,
+        .stats = { .block_size = sizeof(medium_storage[0]), .block_count = PAYLOAD_POOL_MEDIUM_COUNT }
+    },
+    {
+        .storage = (uint8_t *) large_storage, .free_stack = large_free,
+        .stats = { .block_size = sizeof(large_storage[0]), .block_count = PAYLOAD_POOL_LARGE_COUNT }
+    }
+};
+
+/* Requests larger than the largest size class. */
+static uint32_t oversize_count;
+
+/* Set once the free stacks are populated. */
+static bool pool_initialized;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void *alloc_locked(size_t size);
+static pool_class_t *find_class(const void *buffer, uint32_t *index);
+
+/******************************************************************************
+ * Function Name: payload_pool_init
+ ******************************************************************************
+ * Summary:
+ *  Marks all the buffers free. Must be called before the first allocation;
+ *  the publisher task calls it before creating its queue.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void payload_pool_init(void)
+{
+    taskENTER_CRITICAL();
+    if (!pool_initialized)
+    {
+        for (uint32_t class_index = 0; class_index < PAYLOAD_POOL_CLASS_COUNT; class_index++)
+        {
+            pool_class_t *pool_class = &pool_classes[class_index];
+
+            for (uint32_t i = 0; i < pool_class->stats.block_count; i++)
+            {
+                pool_class->free_stack[i] = (uint16_t) i;
+            }
+            pool_class->free_count = pool_class->stats.block_count;
+        }
+        pool_initialized = true;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: alloc_locked
+ ******************************************************************************
+ * Summary:
+ *  Takes a buffer from the smallest size class that fits the request, falling
+ *  back to the larger classes when that class is empty. Must be called with
+ *  interrupts masked.
+ *
+ ******************************************************************************/
+static void *alloc_locked(size_t size)
+{
+    pool_class_t *requested = NULL;
+
+    for (uint32_t class_index = 0; class_index < PAYLOAD_POOL_CLASS_COUNT; class_index++)
+    {
+        pool_class_t *pool_class = &pool_classes[class_index];
+
+        if (size > pool_class->stats.block_size)
+        {
+            continue;
+        }
+
+        if (requested == NULL)
+        {
+            requested = pool_class;
+        }
+
+        if (pool_class->free_count > 0u)
+        {
+            uint32_t index = pool_class->free_stack[--pool_class->free_count];
+
+            if (pool_class != requested)
+            {
+                requested->stats.fallbacks++;
+            }
+
+            pool_class->stats.allocations++;
+            pool_class->stats.in_use++;
+            if (pool_class->stats.in_use > pool_class->stats.peak_in_use)
+            {
+                pool_class->stats.peak_in_use = pool_class->stats.in_use;
+            }
+
+            return &pool_class->storage[index * pool_class->stats.block_size];
+        }
+    }
+
+    if (requested == NULL)
+    {
+        oversize_count++;
+    }
+    else
+    {
+        requested->stats.exhausted++;
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * Function Name: payload_pool_alloc
+ ******************************************************************************
+ * Summary:
+ *  Takes a buffer of at least 'size' bytes from the pool.
+ *
+ * Parameters:
+ *  size_t size : Required buffer size in bytes
+ *
+ * Return:
+ *  void * : Buffer, or NULL if no buffer of sufficient size is free
+ *
+ ******************************************************************************/
+void *payload_pool_alloc(size_t size)
+{
+    void *buffer;
+
+    configASSERT(pool_initialized);
+
+    taskENTER_CRITICAL();
+    buffer = alloc_locked(size);
+    taskEXIT_CRITICAL();
+
+    return buffer;
+}
+
+/******************************************************************************
+ * Function Name: payload_pool_alloc_from_isr
+ ******************************************************************************
+ * Summary:
+ *  Interrupt safe version of payload_pool_alloc().
+ *
+ * Parameters:
+ *  size_t size : Required buffer size in bytes
+ *
+ * Return:
+ *  void * : Buffer, or NULL if no buffer of sufficient size is free
+ *
+ ******************************************************************************/
+void *payload_pool_alloc_from_isr(size_t size)
+{
+    void *buffer;
+    UBaseType_t saved_interrupt_status;
+
+    configASSERT(pool_initialized);
+
+    saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+    buffer = alloc_locked(size);
+    taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+
+    return buffer;
+}
+
+/******************************************************************************
+ * Function Name: find_class
+ ******************************************************************************
+ * Summary:
+ *  Finds the size class and the index of a buffer from its address.
+ *
+ ******************************************************************************/
+static pool_class_t *find_class(const void *buffer, uint32_t *index)
+{
+    const uint8_t *address = (const uint8_t *) buffer;
+
+    for (uint32_t class_index = 0; class_index < PAYLOAD_POOL_CLASS_COUNT; class_index++)
+    {
+        pool_class_t *pool_class = &pool_classes[class_index];
+        uint32_t class_bytes = pool_class->stats.block_size * pool_class->stats.block_count;
+
+        if ((address >= pool_class->storage) && (address < (pool_class->storage + class_bytes)))
+        {
+            uint32_t offset = (uint32_t)(address - pool_class->storage);
+
+            /* Only the start of a buffer is a valid handle. */
+            if ((offset % pool_class->stats.block_size) != 0u)
+            {
+                return NULL;
+            }
+
+            *index = offset / pool_class->stats.block_size;
+            return pool_class;
+        }
+    }
+
+    return NULL;
+}
+
+/******************************************************************************
+ * Function Name: payload_pool_free
+ ******************************************************************************
+ * Summary:
+ *  Returns a buffer to the pool.
+ *
+ * Parameters:
+ *  void *buffer : Buffer returned by payload_pool_alloc()
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void payload_pool_free(void *buffer)
+{
+    uint32_t index = 0;
+    pool_class_t *pool_class = find_class(buffer, &index);
+
+    configASSERT(pool_class != NULL);
+    if (pool_class == NULL)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    configASSERT(pool_class->free_count < pool_class->stats.block_count);
+    pool_class->free_stack[pool_class->free_count++] = (uint16_t) index;
+    pool_class->stats.in_use--;
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: payload_pool_buffer_size
+ ******************************************************************************
+ * Summary:
+ *  Returns the usable size of a pool buffer.
+ *
+ * Parameters:
+ *  const void *buffer : Buffer returned by payload_pool_alloc()
+ *
+ * Return:
+ *  size_t : Size of the buffer in bytes, or 0 if it is not a pool buffer
+ *
+ ******************************************************************************/
+size_t payload_pool_buffer_size(const void *buffer)
+{
+    uint32_t index;
+    pool_class_t *pool_class = find_class(buffer, &index);
+
+    return (pool_class != NULL) ? pool_class->stats.block_size : 0u;
+}
+
+/******************************************************************************
+ * Function Name: payload_pool_is_pool_buffer
+ ******************************************************************************
+ * Summary:
+ *  Checks whether a pointer is a buffer of the pool.
+ *
+ * Parameters:
+ *  const void *buffer : Pointer to check
+ *
+ * Return:
+ *  bool : true if the pointer is the start of a pool buffer
+ *
+ ******************************************************************************/
+bool payload_pool_is_pool_buffer(const void *buffer)
+{
+    uint32_t index;
+
+    return (find_class(buffer, &index) != NULL);
+}
+
+/******************************************************************************
+ * Function Name: payload_pool_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the usage counters of a size class.
+ *
+ * Parameters:
+ *  uint32_t size_class : Index of the size class, 0 being the smallest
+ *  payload_pool_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  bool : true if the counters were returned, false for an invalid class
+ *
+ ******************************************************************************/
+bool payload_pool_get_stats(uint32_t size_class, payload_pool_stats_t *stats)
+{
+    if ((size_class >= PAYLOAD_POOL_CLASS_COUNT) || (stats == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = pool_classes[size_class].stats;
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: payload_pool_get_oversize_count
+ ******************************************************************************
+ * Summary:
+ *  Returns the number of requests larger than the largest size class.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t : Number of oversize requests
+ *
+ ******************************************************************************/
+uint32_t payload_pool_get_oversize_count(void)
+{
+    return oversize_count;
+}
+
+/* [] END OF FILE */
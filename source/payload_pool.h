@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name:   payload_pool.h
+*
+* Description: This file is the public interface of payload_pool.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PAYLOAD_POOL_H_
+#define PAYLOAD_POOL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Number of buffer size classes of the payload pool. */
+#define PAYLOAD_POOL_CLASS_COUNT           (3u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Usage counters of one size class. */
+typedef struct
+{
+    uint32_t block_size;        /* Size of each buffer in bytes */
+    uint32_t block_count;       /* Number of buffers in the class */
+    uint32_t in_use;            /* Buffers currently allocated */
+    uint32_t peak_in_use;       /* Largest 'in_use' observed */
+    uint32_t allocations;       /* Successful allocations from this class */
+    uint32_t fallbacks;         /* Requests served by a larger class because this one was empty */
+    uint32_t exhausted;         /* Requests for this class that failed because no buffer was free */
+} payload_pool_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void payload_pool_init(void);
+void *payload_pool_alloc(size_t size);
+void *payload_pool_alloc_from_isr(size_t size);
+void payload_pool_free(void *buffer);
+size_t payload_pool_buffer_size(const void *buffer);
+bool payload_pool_is_pool_buffer(const void *buffer);
+bool payload_pool_get_stats(uint32_t size_class, payload_pool_stats_t *stats);
+uint32_t payload_pool_get_oversize_count(void);
+
+#endif /* PAYLOAD_POOL_H_ */
+
+/* [] END OF FILE */
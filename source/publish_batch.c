@@ -0,0 +1,270 @@
+/******************************************************************************
+* File Name:   publish_batch.c
+*
+* Description: This file contains the framing used by the batched publish
+*              mode. Messages to the same topic are packed into one length-
+*              prefixed multi-record payload, and received payloads are split
+*              back into records.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "publish_batch.h"
+
+/******************************************************************************
+ * Function Name: publish_batch_init
+ ******************************************************************************
+ * Summary:
+ *  Attaches the storage to a batch and empties it.
+ *
+ * Parameters:
+ *  publish_batch_t *batch : Batch to initialize
+ *  uint8_t *buffer : Storage for the framed payload
+ *  size_t buffer_size : Size of 'buffer' in bytes
+ *  uint32_t max_records : Maximum number of records per batch
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publish_batch_init(publish_batch_t *batch, uint8_t *buffer, size_t buffer_size,
+                        uint32_t max_records)
+{
+    batch->buffer = buffer;
+    batch->buffer_size = buffer_size;
+    batch->max_records = (max_records < PUBLISH_BATCH_MAX_RECORD_COUNT) ?
+                         max_records : PUBLISH_BATCH_MAX_RECORD_COUNT;
+    publish_batch_reset(batch, NULL);
+}
+
+/******************************************************************************
+ * Function Name: publish_batch_reset
+ ******************************************************************************
+ * Summary:
+ *  Empties the batch and assigns the topic of the records to be added.
+ *
+ * Parameters:
+ *  publish_batch_t *batch : Batch to reset
+ *  const char *topic : Topic shared by all the records of the batch
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publish_batch_reset(publish_batch_t *batch, const char *topic)
+{
+    batch->topic = topic;
+    batch->length = PUBLISH_BATCH_HEADER_SIZE;
+    batch->records = 0;
+}
+
+/******************************************************************************
+ * Function Name: publish_batch_add
+ ******************************************************************************
+ * Summary:
+ *  Appends a record to the batch.
+ *
+ * Parameters:
+ *  publish_batch_t *batch : Batch to append to
+ *  const void *record : Record data
+ *  size_t record_len : Length of the record in bytes
+ *
+ * Return:
+ *  bool : true if the record was added; false if the batch is full or the
+ *         record does not fit in the remaining space.
+ *
+ ******************************************************************************/
+bool publish_batch_add(publish_batch_t *batch, const void *record, size_t record_len)
+{
+    size_t needed = PUBLISH_BATCH_RECORD_HEADER_SIZE + record_len;
+
+    if ((batch->records >= batch->max_records) || (record_len > UINT16_MAX) ||
+        (needed > (batch->buffer_size - batch->length)))
+    {
+        return false;
+    }
+
+    batch->buffer[batch->length] = (uint8_t)(record_len >> 8);
+    batch->buffer[batch->length + 1] = (uint8_t)(record_len & 0xFFu);
+    memcpy(&batch->buffer[batch->length + PUBLISH_BATCH_RECORD_HEADER_SIZE], record, record_len);
+
+    batch->length += needed;
+    batch->records++;
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: publish_batch_is_full
+ ******************************************************************************
+ * Summary:
+ *  Checks whether the batch holds the maximum number of records.
+ *
+ * Parameters:
+ *  const publish_batch_t *batch : Batch to check
+ *
+ * Return:
+ *  bool : true if no more records can be added
+ *
+ ******************************************************************************/
+bool publish_batch_is_full(const publish_batch_t *batch)
+{
+    return (batch->records >= batch->max_records);
+}
+
+/******************************************************************************
+ * Function Name: publish_batch_payload
+ ******************************************************************************
+ * Summary:
+ *  Completes the framing and returns the payload to be published. A batch
+ *  with a single record returns the plain record.
+ *
+ * Parameters:
+ *  const publish_batch_t *batch : Batch to publish
+ *  size_t *payload_len : Pointer to store the payload length
+ *
+ * Return:
+ *  const uint8_t * : Payload to be published, or NULL if the batch is empty
+ *
+ ******************************************************************************/
+const uint8_t *publish_batch_payload(const publish_batch_t *batch, size_t *payload_len)
+{
+    const size_t plain_offset = PUBLISH_BATCH_HEADER_SIZE + PUBLISH_BATCH_RECORD_HEADER_SIZE;
+
+    if (batch->records == 0u)
+    {
+        *payload_len = 0;
+        return NULL;
+    }
+
+    if (batch->records == 1u)
+    {
+        *payload_len = batch->length - plain_offset;
+        return &batch->buffer[plain_offset];
+    }
+
+    batch->buffer[0] = PUBLISH_BATCH_MARKER;
+    batch->buffer[1] = (uint8_t) batch->records;
+    *payload_len = batch->length;
+
+    return batch->buffer;
+}
+
+/******************************************************************************
+ * Function Name: publish_batch_is_framed
+ ******************************************************************************
+ * Summary:
+ *  Checks whether a received payload is a batch, i.e. it carries the marker
+ *  and the records exactly cover the payload.
+ *
+ * Parameters:
+ *  const void *payload : Received payload
+ *  size_t payload_len : Length of the payload
+ *
+ * Return:
+ *  bool : true if the payload is a well-formed batch
+ *
+ ******************************************************************************/
+bool publish_batch_is_framed(const void *payload, size_t payload_len)
+{
+    const uint8_t *bytes = (const uint8_t *) payload;
+    size_t offset = 0;
+    uint32_t records = 0;
+    const uint8_t *record;
+    size_t record_len;
+
+    if ((payload_len < PUBLISH_BATCH_HEADER_SIZE) || (bytes[0] != PUBLISH_BATCH_MARKER))
+    {
+        return false;
+    }
+
+    while (publish_batch_next_record(payload, payload_len, &offset, &record, &record_len))
+    {
+        records++;
+    }
+
+    return (offset == payload_len) && (records == bytes[1]) && (records > 1u);
+}
+
+/******************************************************************************
+ * Function Name: publish_batch_next_record
+ ******************************************************************************
+ * Summary:
+ *  Iterates over the records of a batched payload. Start with '*offset' set
+ *  to 0; the header is skipped on the first call.
+ *
+ * Parameters:
+ *  const void *payload : Batched payload
+ *  size_t payload_len : Length of the payload
+ *  size_t *offset : Iterator position, updated on success
+ *  const uint8_t **record : Pointer to store the start of the record
+ *  size_t *record_len : Pointer to store the length of the record
+ *
+ * Return:
+ *  bool : true if a record was returned; false at the end of the payload or
+ *         if the remaining bytes do not form a complete record.
+ *
+ ******************************************************************************/
+bool publish_batch_next_record(const void *payload, size_t payload_len, size_t *offset,
+                               const uint8_t **record, size_t *record_len)
+{
+    const uint8_t *bytes = (const uint8_t *) payload;
+    size_t position = (*offset == 0u) ? PUBLISH_BATCH_HEADER_SIZE : *offset;
+    size_t length;
+
+    if ((payload_len < position) ||
+        ((payload_len - position) < PUBLISH_BATCH_RECORD_HEADER_SIZE))
+    {
+        return false;
+    }
+
+    length = ((size_t) bytes[position] << 8) | bytes[position + 1];
+    position += PUBLISH_BATCH_RECORD_HEADER_SIZE;
+
+    if ((payload_len - position) < length)
+    {
+        return false;
+    }
+
+    *record = &bytes[position];
+    *record_len = length;
+    *offset = position + length;
+
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/******************************************************************************
+* File Name:   publish_batch.h
+*
+* Description: This file is the public interface of publish_batch.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PUBLISH_BATCH_H_
+#define PUBLISH_BATCH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* A batched payload starts with the marker byte and the record count, followed
+ * by the records, each prefixed with its length as a 16-bit big-endian value:
+ *
+ *   | 0xBA | count | len_hi | len_lo | record 0 | len_hi | len_lo | record 1 |..
+ *
+ * A batch holding a single record is sent as the plain record, so receivers
+ * that do not understand the framing keep working under light load.
+ */
+#define PUBLISH_BATCH_MARKER               (0xBAu)
+#define PUBLISH_BATCH_HEADER_SIZE          (2u)
+#define PUBLISH_BATCH_RECORD_HEADER_SIZE   (2u)
+#define PUBLISH_BATCH_MAX_RECORD_COUNT     (255u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Batch under construction. The buffer is provided by the user. */
+typedef struct
+{
+    const char *topic;
+    uint8_t *buffer;
+    size_t buffer_size;
+    size_t length;
+    uint32_t records;
+    uint32_t max_records;
+} publish_batch_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void publish_batch_init(publish_batch_t *batch, uint8_t *buffer, size_t buffer_size,
+                        uint32_t max_records);
+void publish_batch_reset(publish_batch_t *batch, const char *topic);
+bool publish_batch_add(publish_batch_t *batch, const void *record, size_t record_len);
+bool publish_batch_is_full(const publish_batch_t *batch);
+const uint8_t *publish_batch_payload(const publish_batch_t *batch, size_t *payload_len);
+bool publish_batch_is_framed(const void *payload, size_t payload_len);
+bool publish_batch_next_record(const void *payload, size_t payload_len, size_t *offset,
+                               const uint8_t **record, size_t *record_len);
+
+#endif /* PUBLISH_BATCH_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,271 @@
+/******************************************************************************
+* File Name:   publish_latency.c
+*
+* Description: This file contains the latency instrumentation of the publish
+*              path. Every publish is stamped when it is raised, when the
+*              publisher task dequeues it, and around the cy_mqtt_publish()
+*              call; the stage durations are aggregated into log2 histograms.
+*              Define ENABLE_PUBLISH_LATENCY_STATS as 1 in
+*              mqtt_client_config.h to enable it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cyhal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+#include "publish_latency.h"
+#include "log2_histogram.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Cores with a DWT unit (CM4, CM7) are timed with the cycle counter; CM0+ falls
+ * back to the RTOS tick with millisecond resolution. The 32-bit cycle counter
+ * wraps every few tens of seconds and stops while the CPU sleeps, so a stage
+ * is timed with the tick count instead once that is longer by over a tick.
+ */
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define TIMESTAMP_TICKS_PER_US          (SystemCoreClock / 1000000u)
+#endif
+
+/* Key that unlocks the DWT registers on cores with a lock access register. */
+#define DWT_LAR_UNLOCK_KEY              (0xC5ACCE55u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if ENABLE_PUBLISH_LATENCY_STATS
+/* Per-stage latency histograms in microseconds. */
+static log2_histogram_t stage_histograms[PUBLISH_STAGE_COUNT];
+#endif /* ENABLE_PUBLISH_LATENCY_STATS */
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if ENABLE_PUBLISH_LATENCY_STATS
+static uint32_t elapsed_us(const publish_latency_timestamp_t *start,
+                           const publish_latency_timestamp_t *end);
+#endif /* ENABLE_PUBLISH_LATENCY_STATS */
+
+/******************************************************************************
+ * Function Name: publish_latency_init
+ ******************************************************************************
+ * Summary:
+ *  Starts the cycle counter used for timestamps (where available) and clears
+ *  the histograms.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publish_latency_init(void)
+{
+#if ENABLE_PUBLISH_LATENCY_STATS
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CM7_REV)
+    DWT->LAR = DWT_LAR_UNLOCK_KEY;
+#endif /* defined(__CM7_REV) */
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif /* defined(DWT_CTRL_CYCCNTENA_Msk) */
+
+    publish_latency_reset();
+#endif /* ENABLE_PUBLISH_LATENCY_STATS */
+}
+
+/******************************************************************************
+ * Function Name: publish_latency_timestamp
+ ******************************************************************************
+ * Summary:
+ *  Returns the current timestamp. Safe to call from interrupt context.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  publish_latency_timestamp_t : Free-running timestamp; only differences
+ *                                between two timestamps are meaningful.
+ *
+ ******************************************************************************/
+publish_latency_timestamp_t publish_latency_timestamp(void)
+{
+    publish_latency_timestamp_t timestamp = { 0u, 0u };
+
+#if ENABLE_PUBLISH_LATENCY_STATS
+    timestamp.ticks = (uint32_t) xTaskGetTickCountFromISR();
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    timestamp.cycles = DWT->CYCCNT;
+#endif /* defined(DWT_CTRL_CYCCNTENA_Msk) */
+#endif /* ENABLE_PUBLISH_LATENCY_STATS */
+    return timestamp;
+}
+
+#if ENABLE_PUBLISH_LATENCY_STATS
+/******************************************************************************
+ * Function Name: elapsed_us
+ ******************************************************************************
+ * Summary:
+ *  Converts the difference between two timestamps to microseconds, saturated
+ *  at UINT32_MAX (about 71 minutes).
+ *
+ ******************************************************************************/
+static uint32_t elapsed_us(const publish_latency_timestamp_t *start,
+                           const publish_latency_timestamp_t *end)
+{
+    uint64_t ticks_us = (uint64_t)(uint32_t)(end->ticks - start->ticks) * portTICK_PERIOD_MS * 1000u;
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    uint32_t cycles_us = (uint32_t)(end->cycles - start->cycles) / TIMESTAMP_TICKS_PER_US;
+
+    /* The tick count may lag the cycle counter by up to a tick. */
+    if (ticks_us <= ((uint64_t) cycles_us + (portTICK_PERIOD_MS * 1000u)))
+    {
+        return cycles_us;
+    }
+#endif /* defined(DWT_CTRL_CYCCNTENA_Msk) */
+    return (ticks_us > UINT32_MAX) ? UINT32_MAX : (uint32_t) ticks_us;
+}
+#endif /* ENABLE_PUBLISH_LATENCY_STATS */
+
+/******************************************************************************
+ * Function Name: publish_latency_record
+ ******************************************************************************
+ * Summary:
+ *  Adds the stage durations of one completed publish to the histograms.
+ *
+ * Parameters:
+ *  const publish_latency_stamps_t *stamps : Timestamps of the publish
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publish_latency_record(const publish_latency_stamps_t *stamps)
+{
+#if ENABLE_PUBLISH_LATENCY_STATS
+    uint32_t queue_us = elapsed_us(&stamps->raised, &stamps->dequeued);
+    uint32_t dispatch_us = elapsed_us(&stamps->dequeued, &stamps->publish_start);
+    uint32_t network_us = elapsed_us(&stamps->publish_start, &stamps->publish_end);
+    uint32_t total_us = elapsed_us(&stamps->raised, &stamps->publish_end);
+
+    taskENTER_CRITICAL();
+    log2_histogram_add(&stage_histograms[PUBLISH_STAGE_QUEUE], queue_us);
+    log2_histogram_add(&stage_histograms[PUBLISH_STAGE_DISPATCH], dispatch_us);
+    log2_histogram_add(&stage_histograms[PUBLISH_STAGE_NETWORK], network_us);
+    log2_histogram_add(&stage_histograms[PUBLISH_STAGE_TOTAL], total_us);
+    taskEXIT_CRITICAL();
+#else
+    (void) stamps;
+#endif /* ENABLE_PUBLISH_LATENCY_STATS */
+}
+
+/******************************************************************************
+ * Function Name: publish_latency_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the sample count, mean, p50, p99 and maximum latency of a stage.
+ *  Percentiles are upper bounds resolved to the power-of-two bucket limits.
+ *
+ * Parameters:
+ *  publish_stage_t stage : Stage of the publish path
+ *  publish_latency_stats_t *stats : Pointer to store the summary
+ *
+ * Return:
+ *  bool : true if the summary was filled, false if the instrumentation is
+ *         disabled or the stage is invalid.
+ *
+ ******************************************************************************/
+bool publish_latency_get_stats(publish_stage_t stage, publish_latency_stats_t *stats)
+{
+#if ENABLE_PUBLISH_LATENCY_STATS
+    log2_histogram_t snapshot;
+
+    if ((stage >= PUBLISH_STAGE_COUNT) || (stats == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    snapshot = stage_histograms[stage];
+    taskEXIT_CRITICAL();
+
+    stats->count = snapshot.count;
+    stats->mean_us = log2_histogram_mean(&snapshot);
+    stats->p50_us = log2_histogram_percentile(&snapshot, 50u);
+    stats->p99_us = log2_histogram_percentile(&snapshot, 99u);
+    stats->max_us = snapshot.max;
+    return true;
+#else
+    (void) stage;
+    (void) stats;
+    return false;
+#endif /* ENABLE_PUBLISH_LATENCY_STATS */
+}
+
+/******************************************************************************
+ * Function Name: publish_latency_reset
+ ******************************************************************************
+ * Summary:
+ *  Clears the histograms of all stages.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publish_latency_reset(void)
+{
+#if ENABLE_PUBLISH_LATENCY_STATS
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < PUBLISH_STAGE_COUNT; i++)
+    {
+        log2_histogram_reset(&stage_histograms[i]);
+    }
+    taskEXIT_CRITICAL();
+#endif /* ENABLE_PUBLISH_LATENCY_STATS */
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   publish_latency.h
+*
+* Description: This file is the public interface of publish_latency.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PUBLISH_LATENCY_H_
+#define PUBLISH_LATENCY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Stages of the publish path that are timed separately. */
+typedef enum
+{
+    PUBLISH_STAGE_QUEUE,        /* Request raised (e.g. button ISR) -> dequeued by the publisher task */
+    PUBLISH_STAGE_DISPATCH,     /* Dequeued -> cy_mqtt_publish() called */
+    PUBLISH_STAGE_NETWORK,      /* cy_mqtt_publish() call -> return (PUBACK/PUBCOMP for QoS 1/2) */
+    PUBLISH_STAGE_TOTAL,        /* Request raised -> cy_mqtt_publish() returned */
+    PUBLISH_STAGE_COUNT
+} publish_stage_t;
+
+/* Timestamp of publish_latency_timestamp(). The RTOS tick count covers long
+ * stages, e.g. a message held in the outbox across a reconnection; the cycle
+ * counter, where available, resolves the short ones.
+ */
+typedef struct
+{
+    uint32_t ticks;
+    uint32_t cycles;
+} publish_latency_timestamp_t;
+
+/* Timestamps of one publish. */
+typedef struct
+{
+    publish_latency_timestamp_t raised;
+    publish_latency_timestamp_t dequeued;
+    publish_latency_timestamp_t publish_start;
+    publish_latency_timestamp_t publish_end;
+} publish_latency_stamps_t;
+
+/* Summary of one stage. All times are in microseconds. */
+typedef struct
+{
+    uint32_t count;
+    uint32_t mean_us;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} publish_latency_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void publish_latency_init(void);
+publish_latency_timestamp_t publish_latency_timestamp(void);
+void publish_latency_record(const publish_latency_stamps_t *stamps);
+bool publish_latency_get_stats(publish_stage_t stage, publish_latency_stats_t *stats);
+void publish_latency_reset(void);
+
+#endif /* PUBLISH_LATENCY_H_ */
+
+/* [] END OF FILE */
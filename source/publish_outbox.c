@@ -0,0 +1,207 @@
+/******************************************************************************
+* File Name:   publish_outbox.c
+*
+* Description: This file implements the store-and-forward outbox of the
+*              publisher task: a bounded FIFO that holds the messages
+*              published while the MQTT connection is down, in order, until
+*              they are flushed after the reconnection.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "publish_outbox.h"
+
+/******************************************************************************
+ * Function Name: publish_outbox_init
+ ******************************************************************************
+ * Summary:
+ *  Sets up an empty outbox on the given storage and clears its counters.
+ *
+ * Parameters:
+ *  publish_outbox_t *outbox : Outbox to set up
+ *  publish_outbox_entry_t *entries : Array of 'capacity' entries
+ *  uint8_t *slots : Payload storage of 'capacity' * 'slot_size' bytes
+ *  uint16_t capacity : Maximum number of messages held
+ *  uint16_t slot_size : Maximum payload length of a message in bytes
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publish_outbox_init(publish_outbox_t *outbox, publish_outbox_entry_t *entries,
+                         uint8_t *slots, uint16_t capacity, uint16_t slot_size)
+{
+    outbox->entries = entries;
+    outbox->slots = slots;
+    outbox->slot_size = slot_size;
+    outbox->capacity = capacity;
+    outbox->head = 0u;
+    outbox->count = 0u;
+    memset(&outbox->stats, 0, sizeof(outbox->stats));
+    log2_histogram_reset(&outbox->stats.flush_latency_ms);
+}
+
+/******************************************************************************
+ * Function Name: publish_outbox_put
+ ******************************************************************************
+ * Summary:
+ *  Appends a copy of a message to the outbox. A full outbox evicts its oldest
+ *  message to make room, so that the most recent data survives a long outage.
+ *
+ * Parameters:
+ *  publish_outbox_t *outbox : Outbox
+ *  const char *topic : MQTT topic of the message
+ *  const void *payload : Payload of the message
+ *  size_t payload_len : Length of the payload in bytes
+ *  uint32_t now_ms : Current time in milliseconds
+ *
+ * Return:
+ *  bool : true if the message was stored, false if it is larger than a slot.
+ *
+ ******************************************************************************/
+bool publish_outbox_put(publish_outbox_t *outbox, const char *topic, const void *payload,
+                        size_t payload_len, uint32_t now_ms)
+{
+    publish_outbox_entry_t *entry;
+    uint32_t index;
+
+    if ((payload_len > outbox->slot_size) || (outbox->capacity == 0u))
+    {
+        outbox->stats.dropped_oversize++;
+        return false;
+    }
+
+    if (outbox->count == outbox->capacity)
+    {
+        outbox->head = (uint16_t)((outbox->head + 1u) % outbox->capacity);
+        outbox->count--;
+        outbox->stats.dropped_overflow++;
+    }
+
+    index = (outbox->head + outbox->count) % outbox->capacity;
+    entry = &outbox->entries[index];
+    entry->topic = topic;
+    entry->stored_ms = now_ms;
+    entry->payload_len = (uint16_t) payload_len;
+    memcpy(&outbox->slots[index * outbox->slot_size], payload, payload_len);
+
+    outbox->count++;
+    outbox->stats.stored++;
+    if (outbox->count > outbox->stats.peak_depth)
+    {
+        outbox->stats.peak_depth = outbox->count;
+    }
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: publish_outbox_peek
+ ******************************************************************************
+ * Summary:
+ *  Returns the oldest message without removing it, so that it stays in the
+ *  outbox if its publish fails.
+ *
+ * Parameters:
+ *  const publish_outbox_t *outbox : Outbox
+ *  const uint8_t **payload : Pointer to store the location of the payload
+ *
+ * Return:
+ *  const publish_outbox_entry_t * : Oldest message, or NULL if the outbox is
+ *                                   empty.
+ *
+ ******************************************************************************/
+const publish_outbox_entry_t *publish_outbox_peek(const publish_outbox_t *outbox,
+                                                  const uint8_t **payload)
+{
+    if (outbox->count == 0u)
+    {
+        return NULL;
+    }
+
+    *payload = &outbox->slots[(uint32_t) outbox->head * outbox->slot_size];
+    return &outbox->entries[outbox->head];
+}
+
+/******************************************************************************
+ * Function Name: publish_outbox_pop
+ ******************************************************************************
+ * Summary:
+ *  Removes the oldest message once it was published and records the time it
+ *  spent in the outbox.
+ *
+ * Parameters:
+ *  publish_outbox_t *outbox : Outbox
+ *  uint32_t now_ms : Current time in milliseconds
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publish_outbox_pop(publish_outbox_t *outbox, uint32_t now_ms)
+{
+    if (outbox->count == 0u)
+    {
+        return;
+    }
+
+    log2_histogram_add(&outbox->stats.flush_latency_ms,
+                       now_ms - outbox->entries[outbox->head].stored_ms);
+    outbox->head = (uint16_t)((outbox->head + 1u) % outbox->capacity);
+    outbox->count--;
+    outbox->stats.flushed++;
+}
+
+/******************************************************************************
+ * Function Name: publish_outbox_count
+ ******************************************************************************
+ * Summary:
+ *  Returns the number of messages waiting in the outbox.
+ *
+ * Parameters:
+ *  const publish_outbox_t *outbox : Outbox
+ *
+ * Return:
+ *  uint32_t : Number of messages
+ *
+ ******************************************************************************/
+uint32_t publish_outbox_count(const publish_outbox_t *outbox)
+{
+    return outbox->count;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+/******************************************************************************
+* File Name:   publish_outbox.h
+*
+* Description: This file is the public interface of publish_outbox.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PUBLISH_OUTBOX_H_
+#define PUBLISH_OUTBOX_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log2_histogram.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Message held in the outbox. Its payload is stored in the slot of the same
+ * index; the topic must remain valid until the message is flushed.
+ */
+typedef struct
+{
+    const char *topic;
+    uint32_t stored_ms;
+    uint16_t payload_len;
+} publish_outbox_entry_t;
+
+/* Outbox counters. 'flush_latency_ms' holds the time from storing to
+ * flushing of every flushed message.
+ */
+typedef struct
+{
+    uint32_t stored;
+    uint32_t flushed;
+    uint32_t dropped_overflow;      /* Oldest messages evicted by a full outbox */
+    uint32_t dropped_oversize;      /* Messages larger than a slot */
+    uint32_t peak_depth;
+    log2_histogram_t flush_latency_ms;
+} publish_outbox_stats_t;
+
+/* Bounded FIFO of messages waiting to be published. The storage is provided
+ * by the user: 'capacity' entries and 'capacity' payload slots of
+ * 'slot_size' bytes each.
+ */
+typedef struct
+{
+    publish_outbox_entry_t *entries;
+    uint8_t *slots;
+    uint16_t slot_size;
+    uint16_t capacity;
+    uint16_t head;                  /* Index of the oldest message */
+    uint16_t count;
+    publish_outbox_stats_t stats;
+} publish_outbox_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void publish_outbox_init(publish_outbox_t *outbox, publish_outbox_entry_t *entries,
+                         uint8_t *slots, uint16_t capacity, uint16_t slot_size);
+bool publish_outbox_put(publish_outbox_t *outbox, const char *topic, const void *payload,
+                        size_t payload_len, uint32_t now_ms);
+const publish_outbox_entry_t *publish_outbox_peek(const publish_outbox_t *outbox,
+                                                  const uint8_t **payload);
+void publish_outbox_pop(publish_outbox_t *outbox, uint32_t now_ms);
+uint32_t publish_outbox_count(const publish_outbox_t *outbox);
+
+#endif /* PUBLISH_OUTBOX_H_ */
+
+/* [] END OF FILE */
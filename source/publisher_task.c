@@ -45,12 +45,24 @@
 
 #include "cyhal.h"
 #include "cybsp.h"
+#include <string.h>
 #include "FreeRTOS.h"
 
 /* Task header files */
 #include "publisher_task.h"
 #include "mqtt_task.h"
 #include "subscriber_task.h"
+#include "publish_latency.h"
+#include "publish_batch.h"
+#include "payload_pool.h"
+#include "publish_outbox.h"
+#include "flash_log_qspi.h"
+#include "rate_limiter.h"
+#include "static_alloc.h"
+#include "buffer_profile.h"
+#include "device_state.h"
+#include "payload_compress.h"
+#include "app_log.h"
 
 /* Configuration file for MQTT client */
 #include "mqtt_client_config.h"
@@ -62,6 +74,9 @@
 /******************************************************************************
 * Macros
 ******************************************************************************/
+/* Log level of this module. */
+#define APP_LOG_MODULE_LEVEL            APP_LOG_LEVEL_PUBLISHER
+
 /* Interrupt priority for User Button Input. */
 #define USER_BTN_INTR_PRIORITY          (3)
 
@@ -74,9 +89,13 @@
 #define PUBLISH_RETRY_MS                (1000)
 
 /* Queue length of a message queue that is used to communicate with the 
- * publisher task.
+ * publisher task. In the batched publish mode the queue holds a full batch.
  */
+#if ENABLE_PUBLISH_BATCHING
+#define PUBLISHER_TASK_QUEUE_LENGTH     (PUBLISH_BATCH_MAX_RECORDS)
+#else
 #define PUBLISHER_TASK_QUEUE_LENGTH     (3u)
+#endif /* ENABLE_PUBLISH_BATCHING */
 
 /******************************************************************************
 * Function Prototypes
@@ -84,7 +103,28 @@
 static void publisher_init(void);
 static void publisher_deinit(void);
 static void isr_button_press(void *callback_arg, cyhal_gpio_event_t event);
-void print_heap_usage(char *msg);
+static cy_rslt_t publish_payload(const char *topic, const void *payload, size_t payload_len);
+static void wait_for_publish_token(const char *topic);
+static void count_backpressure(uint32_t *counter);
+static void publish_message(const publisher_data_t *publisher_q_data);
+static void release_payload(const publisher_data_t *publisher_q_data);
+#if ENABLE_PUBLISH_BATCHING
+static bool publish_batched_messages(publisher_data_t *publisher_q_data);
+#endif /* ENABLE_PUBLISH_BATCHING */
+#if ENABLE_PUBLISH_OUTBOX
+static void store_in_outbox(const char *topic, const void *payload, size_t payload_len);
+static TickType_t outbox_flush_wait_ticks(void);
+static void flush_outbox(void);
+static uint32_t outbox_count(void);
+static bool outbox_throttled(const char *topic);
+#endif /* ENABLE_PUBLISH_OUTBOX */
+#if ENABLE_PERSISTENT_OUTBOX
+static void mount_persistent_outbox(void);
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+#if ENABLE_PAYLOAD_COMPRESSION
+static bool is_compressed_topic(const char *topic);
+static void compress_payload(const char *topic, const void **payload, size_t *payload_len);
+#endif /* ENABLE_PAYLOAD_COMPRESSION */
 
 /******************************************************************************
 * Global Variables
@@ -95,6 +135,12 @@ TaskHandle_t publisher_task_handle;
 /* Handle of the queue holding the commands for the publisher task */
 QueueHandle_t publisher_task_q;
 
+#if ENABLE_STATIC_ALLOCATION
+/* Static storage of the queue above. */
+static uint8_t publisher_task_q_storage[PUBLISHER_TASK_QUEUE_LENGTH * sizeof(publisher_data_t)];
+static StaticQueue_t publisher_task_q_buffer;
+#endif /* ENABLE_STATIC_ALLOCATION */
+
 /* Structure to store publish message information. */
 cy_mqtt_publish_info_t publish_info =
 {
@@ -105,6 +151,84 @@ cy_mqtt_publish_info_t publish_info =
     .dup = false
 };
 
+#if ENABLE_PUBLISH_BATCHING
+/* Batch under construction and its storage. */
+static publish_batch_t batch;
+static uint8_t batch_buffer[PUBLISH_BATCH_MAX_BYTES];
+#endif /* ENABLE_PUBLISH_BATCHING */
+
+#if ENABLE_PUBLISH_OUTBOX
+/* Messages published while the MQTT connection is down, and their storage. */
+static publish_outbox_t outbox;
+static publish_outbox_entry_t outbox_entries[PUBLISH_OUTBOX_LENGTH];
+static uint8_t outbox_slots[PUBLISH_OUTBOX_LENGTH * PUBLISH_OUTBOX_SLOT_SIZE];
+
+/* Set while the MQTT connection is up, i.e. between PUBLISHER_INIT and
+ * PUBLISHER_DEINIT. The task is created once the connection is up.
+ */
+static bool publisher_online = true;
+
+/* Time of the last outbox flush attempt and the delay before the next one. */
+static TickType_t outbox_last_flush;
+static TickType_t outbox_flush_delay = pdMS_TO_TICKS(PUBLISH_OUTBOX_FLUSH_INTERVAL_MS);
+#endif /* ENABLE_PUBLISH_OUTBOX */
+
+#if ENABLE_PERSISTENT_OUTBOX
+/* Largest program page of the serial flash supported. */
+#define PERSISTENT_OUTBOX_PAGE_BUFFER_SIZE  (512u)
+
+/* Outbox log in the serial flash, the image of its page being written, and
+ * the buffer of the message being flushed. Set 'persistent_outbox_mounted'
+ * when the log is in use instead of the RAM outbox.
+ */
+static flash_log_t persistent_outbox;
+static uint8_t persistent_outbox_page[PERSISTENT_OUTBOX_PAGE_BUFFER_SIZE];
+static uint8_t persistent_outbox_record[PERSISTENT_OUTBOX_RECORD_SIZE];
+static bool persistent_outbox_mounted;
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+
+#if ENABLE_PUBLISH_RATE_LIMIT
+/* Global and per-topic token buckets of the publish path. */
+static rate_limiter_t rate_limiter;
+static rate_limiter_topic_t rate_limiter_topics[PUBLISH_RATE_LIMIT_MAX_TOPICS];
+#endif /* ENABLE_PUBLISH_RATE_LIMIT */
+
+#if ENABLE_CBOR_DEVICE_STATE
+/* Device state messages published on a button press, encoded once by
+ * publisher_init() so that the ISR only picks one of them.
+ */
+static uint8_t device_on_message[DEVICE_STATE_MAX_ENCODED_SIZE];
+static uint8_t device_off_message[DEVICE_STATE_MAX_ENCODED_SIZE];
+static uint16_t device_on_message_len;
+static uint16_t device_off_message_len;
+#endif /* ENABLE_CBOR_DEVICE_STATE */
+
+/* Rate limiting and backpressure counters; 'limiter' is filled in by
+ * publisher_get_rate_stats().
+ */
+static publisher_rate_stats_t rate_stats;
+
+#if ENABLE_PAYLOAD_COMPRESSION
+/* Topics whose payloads are compressed, expanded from
+ * 'PAYLOAD_COMPRESSION_TOPICS'.
+ */
+static const char *const compressed_topics[] =
+{
+#define COMPRESSED_TOPIC(topic)     topic,
+    PAYLOAD_COMPRESSION_TOPICS(COMPRESSED_TOPIC)
+#undef COMPRESSED_TOPIC
+};
+
+/* Work buffer of the compressor and the compressed form of the payload
+ * being published.
+ */
+static payload_compressor_t compressor;
+static uint8_t compressed_payload[PAYLOAD_COMPRESS_BUFFER_SIZE(PAYLOAD_COMPRESSION_MAX_SIZE)];
+#endif /* ENABLE_PAYLOAD_COMPRESSION */
+
+/* Payload compression counters. */
+static publisher_compression_stats_t compression_stats;
+
 /* Structure that stores the callback data for the GPIO interrupt event. */
 cyhal_gpio_callback_data_t cb_data =
 {
@@ -130,73 +254,904 @@ cyhal_gpio_callback_data_t cb_data =
  ******************************************************************************/
 void publisher_task(void *pvParameters)
 {
-    /* Status variable */
-    cy_rslt_t result;
-
     publisher_data_t publisher_q_data;
 
-    /* Command to the MQTT client task */
-    mqtt_task_cmd_t mqtt_task_cmd;
+    /* Set when 'publisher_q_data' holds a command that was dequeued while
+     * collecting a batch and is yet to be handled.
+     */
+    bool command_pending = false;
 
     /* To avoid compiler warnings */
     (void) pvParameters;
 
+    /* Start the timestamp source of the publish latency statistics. */
+    publish_latency_init();
+
+    /* Mark all the payload buffers free before producers can queue messages. */
+    payload_pool_init();
+
+#if ENABLE_PUBLISH_RATE_LIMIT
+    rate_limiter_init(&rate_limiter, rate_limiter_topics, PUBLISH_RATE_LIMIT_MAX_TOPICS,
+                      PUBLISH_RATE_LIMIT_PER_SEC, PUBLISH_RATE_LIMIT_BURST,
+                      PUBLISH_TOPIC_RATE_LIMIT_PER_SEC, PUBLISH_TOPIC_RATE_LIMIT_BURST,
+                      (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS));
+#endif /* ENABLE_PUBLISH_RATE_LIMIT */
+
+#if ENABLE_PUBLISH_BATCHING
+    publish_batch_init(&batch, batch_buffer, sizeof(batch_buffer), PUBLISH_BATCH_MAX_RECORDS);
+#endif /* ENABLE_PUBLISH_BATCHING */
+
+#if ENABLE_PUBLISH_OUTBOX
+    publish_outbox_init(&outbox, outbox_entries, outbox_slots,
+                        PUBLISH_OUTBOX_LENGTH, PUBLISH_OUTBOX_SLOT_SIZE);
+#endif /* ENABLE_PUBLISH_OUTBOX */
+
+#if ENABLE_PERSISTENT_OUTBOX
+    /* Recover the messages left undelivered before the reset. */
+    mount_persistent_outbox();
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+
     /* Initialize and set-up the user button GPIO. */
     publisher_init();
 
     /* Create a message queue to communicate with other tasks and callbacks. */
-    publisher_task_q = xQueueCreate(PUBLISHER_TASK_QUEUE_LENGTH, sizeof(publisher_data_t));
+    publisher_task_q = STATIC_ALLOC_QUEUE_CREATE(PUBLISHER_TASK_QUEUE_LENGTH, sizeof(publisher_data_t),
+                                                 publisher_task_q_storage, &publisher_task_q_buffer);
 
     while (true)
     {
+        TickType_t wait_ticks = portMAX_DELAY;
+
+#if ENABLE_PUBLISH_OUTBOX
+        /* Wake up in time for the next outbox flush. */
+        wait_ticks = outbox_flush_wait_ticks();
+#endif /* ENABLE_PUBLISH_OUTBOX */
+
         /* Wait for commands from other tasks and callbacks. */
-        if (pdTRUE == xQueueReceive(publisher_task_q, &publisher_q_data, portMAX_DELAY))
+        if (command_pending ||
+            (pdTRUE == xQueueReceive(publisher_task_q, &publisher_q_data, wait_ticks)))
         {
+            command_pending = false;
+
             switch(publisher_q_data.cmd)
             {
                 case PUBLISHER_INIT:
                 {
+#if ENABLE_PUBLISH_OUTBOX
+                    /* The user button stays enabled while disconnected.
+                     * Start flushing the messages stored meanwhile.
+                     */
+                    publisher_online = true;
+                    outbox_flush_delay = 0;
+                    APP_LOG_INFO("\nPublisher: %u message(s) in the outbox to be flushed.\n",
+                                 (unsigned int) outbox_count());
+#else
                     /* Initialize and set-up the user button GPIO. */
                     publisher_init();
+#endif /* ENABLE_PUBLISH_OUTBOX */
                     break;
                 }
 
                 case PUBLISHER_DEINIT:
                 {
+#if ENABLE_PUBLISH_OUTBOX
+                    /* Keep accepting messages; they wait in the outbox. */
+                    publisher_online = false;
+#else
                     /* Deinit the user button GPIO and corresponding interrupt. */
                     publisher_deinit();
+#endif /* ENABLE_PUBLISH_OUTBOX */
                     break;
                 }
 
                 case PUBLISH_MQTT_MSG:
                 {
+#if ENABLE_PUBLISH_OUTBOX
+                    /* Hold the message back while disconnected, and behind
+                     * the messages already waiting to keep the order.
+                     */
+                    if (!publisher_online || (outbox_count() > 0u))
+                    {
+                        store_in_outbox(publisher_q_data.topic, publisher_q_data.data,
+                                        publisher_q_data.data_len);
+                        release_payload(&publisher_q_data);
+                        break;
+                    }
+#endif /* ENABLE_PUBLISH_OUTBOX */
+
+#if ENABLE_PUBLISH_BATCHING
+                    /* Publish this and the other pending messages to the same
+                     * topic as one batch.
+                     */
+                    command_pending = publish_batched_messages(&publisher_q_data);
+#else
                     /* Publish the data received over the message queue. */
-                    publish_info.payload = publisher_q_data.data;
-                    publish_info.payload_len = strlen(publish_info.payload);
+                    publish_message(&publisher_q_data);
+#endif /* ENABLE_PUBLISH_BATCHING */
+                    break;
+                }
+            }
+        }
 
-                    printf("\nPublisher: Publishing '%s' on the topic '%s'\n",
-                           (char *) publish_info.payload, publish_info.topic);
+#if ENABLE_PUBLISH_OUTBOX
+        flush_outbox();
+#endif /* ENABLE_PUBLISH_OUTBOX */
+    }
+}
 
-                    result = cy_mqtt_publish(mqtt_connection, &publish_info);
+/******************************************************************************
+ * Function Name: publish_payload
+ ******************************************************************************
+ * Summary:
+ *  Publishes the payload on the given topic and notifies the MQTT client task
+ *  if the operation fails.
+ *
+ * Parameters:
+ *  const char *topic : MQTT topic to publish on
+ *  const void *payload : Payload to be published
+ *  size_t payload_len : Length of the payload in bytes
+ *
+ * Return:
+ *  cy_rslt_t : CY_RSLT_SUCCESS upon a successful publish, else an error code
+ *
+ ******************************************************************************/
+static cy_rslt_t publish_payload(const char *topic, const void *payload, size_t payload_len)
+{
+    /* Status variable */
+    cy_rslt_t result;
 
-                    if (result != CY_RSLT_SUCCESS)
-                    {
-                        printf("  Publisher: MQTT Publish failed with error 0x%0X.\n\n", (int)result);
+#if ENABLE_PAYLOAD_COMPRESSION
+    compress_payload(topic, &payload, &payload_len);
+#endif /* ENABLE_PAYLOAD_COMPRESSION */
 
-                        /* Communicate the publish failure with the the MQTT 
-                         * client task.
-                         */
-                        mqtt_task_cmd = HANDLE_MQTT_PUBLISH_FAILURE;
-                        xQueueSend(mqtt_task_q, &mqtt_task_cmd, portMAX_DELAY);
-                    }
+    publish_info.topic = topic;
+    publish_info.topic_len = strlen(topic);
+    publish_info.payload = payload;
+    publish_info.payload_len = payload_len;
+    buffer_profile_add(BUFFER_PROFILE_OUTGOING,
+                       buffer_profile_publish_packet_size(publish_info.topic_len, payload_len,
+                                                          (uint8_t) publish_info.qos));
 
-                    print_heap_usage("publisher_task: After publishing an MQTT message");
-                    break;
-                }
+    result = cy_mqtt_publish(mqtt_connection, &publish_info);
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        APP_LOG_ERR("  Publisher: MQTT Publish failed with error 0x%0X.\n\n", (int)result);
+
+        /* Communicate the publish failure with the the MQTT 
+         * client task.
+         */
+        mqtt_task_notify(HANDLE_MQTT_PUBLISH_FAILURE);
+    }
+
+    return result;
+}
+
+/******************************************************************************
+ * Function Name: wait_for_publish_token
+ ******************************************************************************
+ * Summary:
+ *  Waits until the rate limiter lets a message on the given topic through.
+ *  Meanwhile the queue fills up and pushes back on the producers.
+ *
+ * Parameters:
+ *  const char *topic : MQTT topic of the message
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void wait_for_publish_token(const char *topic)
+{
+#if ENABLE_PUBLISH_RATE_LIMIT
+    uint32_t wait_ms;
+
+    while (0u != (wait_ms = rate_limiter_acquire(&rate_limiter, topic,
+                                                 (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS))))
+    {
+        rate_stats.throttle_ms += wait_ms;
+        vTaskDelay((wait_ms + portTICK_PERIOD_MS - 1u) / portTICK_PERIOD_MS);
+    }
+#else
+    (void) topic;
+#endif /* ENABLE_PUBLISH_RATE_LIMIT */
+}
+
+/******************************************************************************
+ * Function Name: count_backpressure
+ ******************************************************************************
+ * Summary:
+ *  Increments a backpressure counter; safe from any task.
+ *
+ * Parameters:
+ *  uint32_t *counter : Counter in 'rate_stats'
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void count_backpressure(uint32_t *counter)
+{
+    taskENTER_CRITICAL();
+    (*counter)++;
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: publish_message
+ ******************************************************************************
+ * Summary:
+ *  Publishes a single message received over the publisher task queue.
+ *
+ * Parameters:
+ *  const publisher_data_t *publisher_q_data : Message to be published
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void publish_message(const publisher_data_t *publisher_q_data)
+{
+    /* Timestamps of the publish path */
+    publish_latency_stamps_t latency_stamps;
+
+    latency_stamps.raised = publisher_q_data->timestamp;
+    latency_stamps.dequeued = publish_latency_timestamp();
+
+    wait_for_publish_token(publisher_q_data->topic);
+
+    APP_LOG_INFO("\nPublisher: Publishing '%.*s' on the topic '%s'\n",
+                 (int) publisher_q_data->data_len, (const char *) publisher_q_data->data,
+                 publisher_q_data->topic);
+
+    latency_stamps.publish_start = publish_latency_timestamp();
+    if (CY_RSLT_SUCCESS == publish_payload(publisher_q_data->topic, publisher_q_data->data,
+                                           publisher_q_data->data_len))
+    {
+        latency_stamps.publish_end = publish_latency_timestamp();
+        publish_latency_record(&latency_stamps);
+    }
+#if ENABLE_PUBLISH_OUTBOX
+    else
+    {
+        /* The publish raced a disconnection; retry it from the outbox. */
+        store_in_outbox(publisher_q_data->topic, publisher_q_data->data,
+                        publisher_q_data->data_len);
+    }
+#endif /* ENABLE_PUBLISH_OUTBOX */
+
+    release_payload(publisher_q_data);
+}
+
+/******************************************************************************
+ * Function Name: release_payload
+ ******************************************************************************
+ * Summary:
+ *  Returns the payload of a dequeued message to the payload pool if it was
+ *  taken from the pool. Payloads in constant storage are left alone.
+ *
+ * Parameters:
+ *  const publisher_data_t *publisher_q_data : Message that is done with
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void release_payload(const publisher_data_t *publisher_q_data)
+{
+    if (payload_pool_is_pool_buffer(publisher_q_data->data))
+    {
+        payload_pool_free((void *) publisher_q_data->data);
+    }
+}
+
+/******************************************************************************
+ * Function Name: publisher_enqueue
+ ******************************************************************************
+ * Summary:
+ *  Copies a payload of any content into a payload pool buffer and hands it
+ *  to the publisher task for publishing on the given topic. The buffer is
+ *  returned to the pool once the publish completes.
+ *
+ *  Producers that build the payload in place can instead take a buffer with
+ *  payload_pool_alloc(), fill it and send a PUBLISH_MQTT_MSG command with
+ *  'data' pointing at the buffer; the ownership passes to the publisher task
+ *  once the command is queued.
+ *
+ * Parameters:
+ *  const char *topic : MQTT topic to publish on; must remain valid until the
+ *                      publish completes
+ *  const void *payload : Payload to be published
+ *  size_t payload_len : Length of the payload in bytes
+ *  TickType_t ticks_to_wait : Time to wait for space in the publisher queue
+ *
+ * Return:
+ *  publisher_enqueue_result_t : PUBLISHER_ENQUEUE_OK if the payload was
+ *         queued; PUBLISHER_ENQUEUE_WOULD_BLOCK if no pool buffer was free or
+ *         the queue stayed full, which happens while the publisher is
+ *         throttled by the rate limiter; PUBLISHER_ENQUEUE_DROPPED if the
+ *         publisher task is not running or the payload is too large.
+ *
+ ******************************************************************************/
+publisher_enqueue_result_t publisher_enqueue(const char *topic, const void *payload,
+                                             size_t payload_len, TickType_t ticks_to_wait)
+{
+    publisher_data_t publisher_q_data;
+    void *buffer;
+
+    if ((publisher_task_q == NULL) || (payload_len > PAYLOAD_POOL_LARGE_SIZE))
+    {
+        count_backpressure(&rate_stats.dropped);
+        return PUBLISHER_ENQUEUE_DROPPED;
+    }
+
+    buffer = payload_pool_alloc(payload_len);
+    if (buffer == NULL)
+    {
+        count_backpressure(&rate_stats.would_block);
+        return PUBLISHER_ENQUEUE_WOULD_BLOCK;
+    }
+
+    memcpy(buffer, payload, payload_len);
+
+    publisher_q_data.cmd = PUBLISH_MQTT_MSG;
+    publisher_q_data.topic = topic;
+    publisher_q_data.data = buffer;
+    publisher_q_data.data_len = (uint16_t) payload_len;
+    publisher_q_data.timestamp = publish_latency_timestamp();
+
+    if (pdTRUE != xQueueSend(publisher_task_q, &publisher_q_data, ticks_to_wait))
+    {
+        payload_pool_free(buffer);
+        count_backpressure(&rate_stats.would_block);
+        return PUBLISHER_ENQUEUE_WOULD_BLOCK;
+    }
+
+    return PUBLISHER_ENQUEUE_OK;
+}
+
+#if ENABLE_PUBLISH_BATCHING
+/******************************************************************************
+ * Function Name: publish_batched_messages
+ ******************************************************************************
+ * Summary:
+ *  Collects the given message and the following messages to the same topic
+ *  into one batch and publishes it. Messages are collected until the batch
+ *  holds 'PUBLISH_BATCH_MAX_RECORDS' messages, the next message does not fit
+ *  in the batch, or 'PUBLISH_BATCH_LINGER_MS' milliseconds have elapsed.
+ *
+ * Parameters:
+ *  publisher_data_t *publisher_q_data : First message of the batch. On return
+ *                                       it holds the command that ended the
+ *                                       batch, if any.
+ *
+ * Return:
+ *  bool : true if 'publisher_q_data' holds a dequeued command that is yet to
+ *         be handled.
+ *
+ ******************************************************************************/
+static bool publish_batched_messages(publisher_data_t *publisher_q_data)
+{
+    /* Timestamps of the batched messages */
+    static publish_latency_stamps_t latency_stamps[PUBLISH_BATCH_MAX_RECORDS];
+
+    const TickType_t linger_ticks = pdMS_TO_TICKS(PUBLISH_BATCH_LINGER_MS);
+    TickType_t batch_start = xTaskGetTickCount();
+    TickType_t elapsed_ticks;
+    bool command_pending = false;
+    const uint8_t *payload;
+    size_t payload_len;
+
+    publish_batch_reset(&batch, publisher_q_data->topic);
+
+    while (true)
+    {
+        if (!publish_batch_add(&batch, publisher_q_data->data, publisher_q_data->data_len))
+        {
+            if (batch.records == 0u)
+            {
+                /* The message is larger than a batch; publish it as is. */
+                publish_message(publisher_q_data);
+                return false;
             }
+
+            /* Publish the current batch; the message starts the next one. */
+            command_pending = true;
+            break;
+        }
+
+        latency_stamps[batch.records - 1u].raised = publisher_q_data->timestamp;
+        latency_stamps[batch.records - 1u].dequeued = publish_latency_timestamp();
+
+        /* The record was copied into the batch. */
+        release_payload(publisher_q_data);
+
+        if (publish_batch_is_full(&batch))
+        {
+            break;
+        }
+
+        /* Wait for more messages for the rest of the linger time. */
+        elapsed_ticks = xTaskGetTickCount() - batch_start;
+        if (pdTRUE != xQueueReceive(publisher_task_q, publisher_q_data,
+                                    (elapsed_ticks < linger_ticks) ? (linger_ticks - elapsed_ticks) : 0))
+        {
+            break;
+        }
+
+        if ((publisher_q_data->cmd != PUBLISH_MQTT_MSG) ||
+            (strcmp(publisher_q_data->topic, batch.topic) != 0))
+        {
+            command_pending = true;
+            break;
         }
     }
+
+    payload = publish_batch_payload(&batch, &payload_len);
+
+    wait_for_publish_token(batch.topic);
+
+    APP_LOG_INFO("\nPublisher: Publishing %u message(s) (%u bytes) on the topic '%s'\n",
+                 (unsigned int) batch.records, (unsigned int) payload_len, batch.topic);
+
+    publish_latency_timestamp_t publish_start = publish_latency_timestamp();
+    if (CY_RSLT_SUCCESS == publish_payload(batch.topic, payload, payload_len))
+    {
+        publish_latency_timestamp_t publish_end = publish_latency_timestamp();
+
+        for (uint32_t i = 0; i < batch.records; i++)
+        {
+            latency_stamps[i].publish_start = publish_start;
+            latency_stamps[i].publish_end = publish_end;
+            publish_latency_record(&latency_stamps[i]);
+        }
+    }
+#if ENABLE_PUBLISH_OUTBOX
+    else
+    {
+        /* The publish raced a disconnection; retry the batch from the
+         * outbox.
+         */
+        store_in_outbox(batch.topic, payload, payload_len);
+    }
+#endif /* ENABLE_PUBLISH_OUTBOX */
+
+    return command_pending;
 }
+#endif /* ENABLE_PUBLISH_BATCHING */
+
+#if ENABLE_PUBLISH_OUTBOX
+/******************************************************************************
+ * Function Name: store_in_outbox
+ ******************************************************************************
+ * Summary:
+ *  Copies a message into the outbox, to be published once the MQTT
+ *  connection is up again.
+ *
+ * Parameters:
+ *  const char *topic : MQTT topic of the message
+ *  const void *payload : Payload of the message
+ *  size_t payload_len : Length of the payload in bytes
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void store_in_outbox(const char *topic, const void *payload, size_t payload_len)
+{
+    bool stored;
+
+#if ENABLE_PERSISTENT_OUTBOX
+    if (persistent_outbox_mounted)
+    {
+        stored = (strlen(topic) + 1u + payload_len <= sizeof(persistent_outbox_record)) &&
+                 flash_log_append(&persistent_outbox, topic, payload, payload_len);
+
+        /* Program the staged page once the queue has run dry rather than
+         * for every message.
+         */
+        if (stored && (0u == uxQueueMessagesWaiting(publisher_task_q)))
+        {
+            stored = flash_log_sync(&persistent_outbox);
+        }
+
+        if (!stored)
+        {
+            APP_LOG_WARN("  Publisher: Message of %u bytes could not be stored in the flash outbox, dropped.\n",
+                         (unsigned int) payload_len);
+        }
+        return;
+    }
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+
+    taskENTER_CRITICAL();
+    stored = publish_outbox_put(&outbox, topic, payload, payload_len,
+                                (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS));
+    taskEXIT_CRITICAL();
+
+    if (!stored)
+    {
+        APP_LOG_WARN("  Publisher: Message of %u bytes is too large for the outbox, dropped.\n",
+                     (unsigned int) payload_len);
+    }
+}
+
+/******************************************************************************
+ * Function Name: outbox_flush_wait_ticks
+ ******************************************************************************
+ * Summary:
+ *  Returns how long the task may wait for commands before the next outbox
+ *  flush is due.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  TickType_t : Ticks until the next flush, or portMAX_DELAY if there is
+ *               nothing to flush.
+ *
+ ******************************************************************************/
+static TickType_t outbox_flush_wait_ticks(void)
+{
+    TickType_t elapsed;
+
+    if (!publisher_online || (outbox_count() == 0u))
+    {
+        return portMAX_DELAY;
+    }
+
+    elapsed = xTaskGetTickCount() - outbox_last_flush;
+    return (elapsed < outbox_flush_delay) ? (outbox_flush_delay - elapsed) : 0;
+}
+
+/******************************************************************************
+ * Function Name: outbox_throttled
+ ******************************************************************************
+ * Summary:
+ *  Takes a rate limiter token for the next outbox message. Without one the
+ *  flush is postponed until the token is due instead of blocking the task.
+ *
+ * Parameters:
+ *  const char *topic : MQTT topic of the next outbox message
+ *
+ * Return:
+ *  bool : true if the flush has to wait.
+ *
+ ******************************************************************************/
+static bool outbox_throttled(const char *topic)
+{
+#if ENABLE_PUBLISH_RATE_LIMIT
+    uint32_t wait_ms = rate_limiter_acquire(&rate_limiter, topic,
+                                            (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS));
+
+    if (wait_ms != 0u)
+    {
+        outbox_flush_delay = pdMS_TO_TICKS(wait_ms) + 1u;
+        return true;
+    }
+#else
+    (void) topic;
+#endif /* ENABLE_PUBLISH_RATE_LIMIT */
+    return false;
+}
+
+/******************************************************************************
+ * Function Name: flush_outbox
+ ******************************************************************************
+ * Summary:
+ *  Publishes the oldest message of the outbox when a flush is due. Messages
+ *  are flushed one every 'PUBLISH_OUTBOX_FLUSH_INTERVAL_MS' milliseconds, so
+ *  that a long outage does not end in a burst towards the broker. A failed
+ *  publish keeps the message and is retried after 'PUBLISH_RETRY_MS'.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void flush_outbox(void)
+{
+    const publish_outbox_entry_t *entry;
+    const uint8_t *payload;
+
+    if (outbox_flush_wait_ticks() != 0)
+    {
+        return;
+    }
+
+#if ENABLE_PERSISTENT_OUTBOX
+    if (persistent_outbox_mounted)
+    {
+        flash_log_record_t record;
+
+        outbox_last_flush = xTaskGetTickCount();
+        if (!flash_log_peek(&persistent_outbox, &record, persistent_outbox_record,
+                            sizeof(persistent_outbox_record)))
+        {
+            return;
+        }
+
+        if (outbox_throttled(record.topic))
+        {
+            return;
+        }
+
+        if (CY_RSLT_SUCCESS == publish_payload(record.topic, record.payload, record.payload_len))
+        {
+            (void) flash_log_consume(&persistent_outbox);
+            outbox_flush_delay = pdMS_TO_TICKS(PUBLISH_OUTBOX_FLUSH_INTERVAL_MS);
+        }
+        else
+        {
+            outbox_flush_delay = pdMS_TO_TICKS(PUBLISH_RETRY_MS);
+        }
+        return;
+    }
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+
+    entry = publish_outbox_peek(&outbox, &payload);
+    outbox_last_flush = xTaskGetTickCount();
+
+    if (outbox_throttled(entry->topic))
+    {
+        return;
+    }
+
+    if (CY_RSLT_SUCCESS == publish_payload(entry->topic, payload, entry->payload_len))
+    {
+        taskENTER_CRITICAL();
+        publish_outbox_pop(&outbox, (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS));
+        taskEXIT_CRITICAL();
+        outbox_flush_delay = pdMS_TO_TICKS(PUBLISH_OUTBOX_FLUSH_INTERVAL_MS);
+    }
+    else
+    {
+        outbox_flush_delay = pdMS_TO_TICKS(PUBLISH_RETRY_MS);
+    }
+}
+
+/******************************************************************************
+ * Function Name: outbox_count
+ ******************************************************************************
+ * Summary:
+ *  Returns the number of messages waiting in the outbox in use.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t : Number of messages
+ *
+ ******************************************************************************/
+static uint32_t outbox_count(void)
+{
+#if ENABLE_PERSISTENT_OUTBOX
+    if (persistent_outbox_mounted)
+    {
+        return flash_log_pending(&persistent_outbox);
+    }
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+
+    return publish_outbox_count(&outbox);
+}
+#endif /* ENABLE_PUBLISH_OUTBOX */
+
+#if ENABLE_PERSISTENT_OUTBOX
+/******************************************************************************
+ * Function Name: mount_persistent_outbox
+ ******************************************************************************
+ * Summary:
+ *  Mounts the outbox log in the serial flash, recovering the messages that
+ *  were not delivered before the reset. If the flash region is unusable, the
+ *  RAM outbox is used instead.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void mount_persistent_outbox(void)
+{
+    const flash_log_device_t *device = flash_log_qspi_device(PERSISTENT_OUTBOX_SIZE);
+
+    persistent_outbox_mounted = (device != NULL) &&
+                                (device->page_size <= sizeof(persistent_outbox_page)) &&
+                                flash_log_mount(&persistent_outbox, device, persistent_outbox_page,
+                                                PERSISTENT_OUTBOX_ACK_INTERVAL);
+
+    if (persistent_outbox_mounted)
+    {
+        APP_LOG_INFO("Publisher: Flash outbox mounted, %u message(s) recovered.\n",
+                     (unsigned int) flash_log_pending(&persistent_outbox));
+    }
+    else
+    {
+        APP_LOG_WARN("Publisher: Flash outbox could not be mounted, using the RAM outbox.\n");
+    }
+}
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+
+/******************************************************************************
+ * Function Name: publisher_get_outbox_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the outbox counters: messages stored and flushed, messages lost
+ *  to overflow or to their size, the peak depth, and the time the flushed
+ *  messages spent in the outbox. All zero when the outbox is disabled.
+ *
+ * Parameters:
+ *  publish_outbox_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publisher_get_outbox_stats(publish_outbox_stats_t *stats)
+{
+#if ENABLE_PUBLISH_OUTBOX
+    taskENTER_CRITICAL();
+    *stats = outbox.stats;
+    taskEXIT_CRITICAL();
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif /* ENABLE_PUBLISH_OUTBOX */
+}
+
+/******************************************************************************
+ * Function Name: publisher_get_persistent_outbox_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the counters of the outbox log in the serial flash: messages
+ *  appended, drained and lost, and the page programs and sector erases spent.
+ *
+ * Parameters:
+ *  flash_log_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  bool : true if the flash outbox is in use, false if the RAM outbox is.
+ *
+ ******************************************************************************/
+bool publisher_get_persistent_outbox_stats(flash_log_stats_t *stats)
+{
+#if ENABLE_PERSISTENT_OUTBOX
+    if (persistent_outbox_mounted)
+    {
+        taskENTER_CRITICAL();
+        *stats = persistent_outbox.stats;
+        taskEXIT_CRITICAL();
+        return true;
+    }
+#endif /* ENABLE_PERSISTENT_OUTBOX */
+
+    memset(stats, 0, sizeof(*stats));
+    return false;
+}
+
+/******************************************************************************
+ * Function Name: publisher_get_rate_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the rate limiter counters, the time the publisher task waited for
+ *  tokens, and the messages the producers could not queue.
+ *
+ * Parameters:
+ *  publisher_rate_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publisher_get_rate_stats(publisher_rate_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = rate_stats;
+#if ENABLE_PUBLISH_RATE_LIMIT
+    stats->limiter = rate_limiter.stats;
+#endif /* ENABLE_PUBLISH_RATE_LIMIT */
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: publisher_get_compression_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the payload compression counters.
+ *
+ * Parameters:
+ *  publisher_compression_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void publisher_get_compression_stats(publisher_compression_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = compression_stats;
+    taskEXIT_CRITICAL();
+}
+
+#if ENABLE_PAYLOAD_COMPRESSION
+/******************************************************************************
+ * Function Name: is_compressed_topic
+ ******************************************************************************
+ * Summary:
+ *  Checks whether the payloads of a topic are to be compressed.
+ *
+ * Parameters:
+ *  const char *topic : MQTT topic
+ *
+ * Return:
+ *  bool : true if the topic is in 'PAYLOAD_COMPRESSION_TOPICS'
+ *
+ ******************************************************************************/
+static bool is_compressed_topic(const char *topic)
+{
+    for (size_t i = 0; i < (sizeof(compressed_topics) / sizeof(compressed_topics[0])); i++)
+    {
+        if (strcmp(compressed_topics[i], topic) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/******************************************************************************
+ * Function Name: compress_payload
+ ******************************************************************************
+ * Summary:
+ *  Replaces a payload to be published on a compressed topic with its
+ *  compressed form, built in 'compressed_payload', when that is shorter.
+ *  Payloads of other topics are left alone.
+ *
+ * Parameters:
+ *  const char *topic : MQTT topic to publish on
+ *  const void **payload : Payload, replaced with the one to publish
+ *  size_t *payload_len : Length of the payload, replaced likewise
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void compress_payload(const char *topic, const void **payload, size_t *payload_len)
+{
+    size_t original_len = *payload_len;
+    payload_compress_form_t form;
+
+    if (!is_compressed_topic(topic))
+    {
+        return;
+    }
+
+    form = payload_compress(&compressor, *payload, original_len, compressed_payload,
+                            sizeof(compressed_payload), payload, payload_len);
+
+    taskENTER_CRITICAL();
+    switch (form)
+    {
+        case PAYLOAD_COMPRESS_LZ:        compression_stats.compressed++; break;
+        case PAYLOAD_COMPRESS_STORED:    compression_stats.stored++;     break;
+        case PAYLOAD_COMPRESS_RAW:       compression_stats.raw++;        break;
+        case PAYLOAD_COMPRESS_TOO_LARGE: compression_stats.too_large++;  break;
+    }
+    compression_stats.bytes_in += (uint32_t) original_len;
+    compression_stats.bytes_out += (uint32_t) *payload_len;
+    taskEXIT_CRITICAL();
+
+    if (form == PAYLOAD_COMPRESS_TOO_LARGE)
+    {
+        APP_LOG_WARN("\nPublisher: A %u-byte payload starting with a compression header "
+                     "byte is published as is on the topic '%s'\n", (unsigned) original_len, topic);
+    }
+}
+
+#endif /* ENABLE_PAYLOAD_COMPRESSION */
 
 /******************************************************************************
  * Function Name: publisher_init
@@ -214,6 +1169,16 @@ void publisher_task(void *pvParameters)
  ******************************************************************************/
 static void publisher_init(void)
 {
+#if ENABLE_CBOR_DEVICE_STATE
+    device_state_t message = { .state = DEVICE_ON_STATE };
+
+    device_on_message_len = (uint16_t) device_state_encode(&message, DEVICE_STATE_FIELD_STATE,
+                                                           device_on_message, sizeof(device_on_message));
+    message.state = DEVICE_OFF_STATE;
+    device_off_message_len = (uint16_t) device_state_encode(&message, DEVICE_STATE_FIELD_STATE,
+                                                            device_off_message, sizeof(device_off_message));
+#endif /* ENABLE_CBOR_DEVICE_STATE */
+
     /* Initialize the user button GPIO and register interrupt on falling edge. */
     cyhal_gpio_init(CYBSP_USER_BTN, CYHAL_GPIO_DIR_INPUT,
                     CYHAL_GPIO_DRIVE_PULLUP, CYBSP_BTN_OFF);
@@ -221,8 +1186,13 @@ static void publisher_init(void)
     cyhal_gpio_enable_event(CYBSP_USER_BTN, CYHAL_GPIO_IRQ_FALL,
                             USER_BTN_INTR_PRIORITY, true);
     
-    printf("\nPress the user button (SW2) to publish \"%s\"/\"%s\" on the topic '%s'...\n", 
-           MQTT_DEVICE_ON_MESSAGE, MQTT_DEVICE_OFF_MESSAGE, publish_info.topic);
+#if ENABLE_CBOR_DEVICE_STATE
+    APP_LOG_INFO("\nPress the user button (SW2) to publish the CBOR device state on the topic '%s'...\n",
+                 publish_info.topic);
+#else
+    APP_LOG_INFO("\nPress the user button (SW2) to publish \"%s\"/\"%s\" on the topic '%s'...\n", 
+                 MQTT_DEVICE_ON_MESSAGE, MQTT_DEVICE_OFF_MESSAGE, publish_info.topic);
+#endif /* ENABLE_CBOR_DEVICE_STATE */
 }
 
 /******************************************************************************
@@ -276,19 +1246,44 @@ static void isr_button_press(void *callback_arg, cyhal_gpio_event_t event)
 
     /* Assign the publish command to be sent to the publisher task. */
     publisher_q_data.cmd = PUBLISH_MQTT_MSG;
+    publisher_q_data.topic = MQTT_PUB_TOPIC;
+    publisher_q_data.timestamp = publish_latency_timestamp();
 
     /* Assign the publish message payload so that the device state toggles. */
+#if ENABLE_CBOR_DEVICE_STATE
     if (current_device_state == DEVICE_ON_STATE)
     {
-        publisher_q_data.data = (char *)MQTT_DEVICE_OFF_MESSAGE;
+        publisher_q_data.data = device_off_message;
+        publisher_q_data.data_len = device_off_message_len;
     }
     else
     {
-        publisher_q_data.data = (char *)MQTT_DEVICE_ON_MESSAGE;
+        publisher_q_data.data = device_on_message;
+        publisher_q_data.data_len = device_on_message_len;
     }
+#else
+    if (current_device_state == DEVICE_ON_STATE)
+    {
+        publisher_q_data.data = MQTT_DEVICE_OFF_MESSAGE;
+        publisher_q_data.data_len = sizeof(MQTT_DEVICE_OFF_MESSAGE) - 1;
+    }
+    else
+    {
+        publisher_q_data.data = MQTT_DEVICE_ON_MESSAGE;
+        publisher_q_data.data_len = sizeof(MQTT_DEVICE_ON_MESSAGE) - 1;
+    }
+#endif /* ENABLE_CBOR_DEVICE_STATE */
 
-    /* Send the command and data to publisher task over the queue */
-    xQueueSendFromISR(publisher_task_q, &publisher_q_data, &xHigherPriorityTaskWoken);
+    /* Send the command and data to publisher task over the queue. A press
+     * that finds the queue full is dropped and counted.
+     */
+    if (pdTRUE != xQueueSendFromISR(publisher_task_q, &publisher_q_data,
+                                    &xHigherPriorityTaskWoken))
+    {
+        UBaseType_t interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+        rate_stats.dropped++;
+        taskEXIT_CRITICAL_FROM_ISR(interrupt_status);
+    }
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
@@ -42,9 +42,14 @@
 #ifndef PUBLISHER_TASK_H_
 #define PUBLISHER_TASK_H_
 
+#include <stdbool.h>
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "publish_outbox.h"
+#include "flash_log.h"
+#include "rate_limiter.h"
+#include "publish_latency.h"
 
 /*******************************************************************************
 * Macros
@@ -67,9 +72,46 @@ typedef enum
 /* Struct to be passed via the publisher task queue */
 typedef struct{
     publisher_cmd_t cmd;
-    char *data;
+    const char *topic;
+    const void *data;       /* Constant data, or a payload pool buffer owned by the publisher task */
+    uint16_t data_len;
+    publish_latency_timestamp_t timestamp;  /* publish_latency_timestamp() when raised */
 } publisher_data_t;
 
+/* Result of publisher_enqueue(). */
+typedef enum
+{
+    PUBLISHER_ENQUEUE_OK,
+    PUBLISHER_ENQUEUE_WOULD_BLOCK,  /* No payload buffer free or the queue stayed
+                                     * full: the publisher is throttled or busy;
+                                     * retry later */
+    PUBLISHER_ENQUEUE_DROPPED       /* Not queued: the publisher task is not
+                                     * running or the payload is too large */
+} publisher_enqueue_result_t;
+
+/* Rate limiting and backpressure counters. */
+typedef struct
+{
+    rate_limiter_stats_t limiter;
+    uint32_t throttle_ms;           /* Time the publisher task waited for tokens */
+    uint32_t would_block;           /* publisher_enqueue() calls that found no payload
+                                     * buffer free or the queue full */
+    uint32_t dropped;               /* Messages dropped by publisher_enqueue() and
+                                     * button presses that found the queue full */
+} publisher_rate_stats_t;
+
+/* Payload compression counters. */
+typedef struct
+{
+    uint32_t compressed;            /* Payloads published compressed */
+    uint32_t stored;                /* Payloads stored behind a header */
+    uint32_t raw;                   /* Payloads published as is as they did not shrink */
+    uint32_t too_large;             /* Payloads that needed a header but did not fit
+                                     * the compression buffer, published as is */
+    uint32_t bytes_in;              /* Length of the payloads before compression */
+    uint32_t bytes_out;             /* Length of the payloads published */
+} publisher_compression_stats_t;
+
 /*******************************************************************************
 * Extern Variables
 ********************************************************************************/
@@ -80,6 +122,12 @@ extern QueueHandle_t publisher_task_q;
 * Function Prototypes
 ********************************************************************************/
 void publisher_task(void *pvParameters);
+publisher_enqueue_result_t publisher_enqueue(const char *topic, const void *payload,
+                                             size_t payload_len, TickType_t ticks_to_wait);
+void publisher_get_outbox_stats(publish_outbox_stats_t *stats);
+bool publisher_get_persistent_outbox_stats(flash_log_stats_t *stats);
+void publisher_get_rate_stats(publisher_rate_stats_t *stats);
+void publisher_get_compression_stats(publisher_compression_stats_t *stats);
 
 #endif /* PUBLISHER_TASK_H_ */
 
@@ -0,0 +1,312 @@
+/******************************************************************************
+* File Name:   rate_limiter.c
+*
+* Description: This file implements the token buckets that limit the publish
+*              rate, globally and per topic, so that bursts are smoothed on
+*              the device instead of tripping the rate limits of the broker.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "rate_limiter.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Bucket levels are kept in thousandths of a token. */
+#define MILLI_TOKENS_PER_TOKEN          (1000u)
+
+/* FNV-1a parameters used to hash the topics. */
+#define FNV_OFFSET_BASIS                (2166136261u)
+#define FNV_PRIME                       (16777619u)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void token_bucket_refill(token_bucket_t *bucket, uint32_t now_ms);
+static uint32_t topic_hash(const char *topic);
+static token_bucket_t *topic_bucket(rate_limiter_t *limiter, const char *topic,
+                                    uint32_t now_ms);
+
+/******************************************************************************
+ * Function Name: token_bucket_init
+ ******************************************************************************
+ * Summary:
+ *  Initializes a full bucket.
+ *
+ * Parameters:
+ *  token_bucket_t *bucket : Bucket
+ *  uint32_t rate_per_s : Tokens added per second; 0 for unlimited
+ *  uint32_t burst : Maximum number of tokens (at least 1)
+ *  uint32_t now_ms : Current time in milliseconds
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void token_bucket_init(token_bucket_t *bucket, uint32_t rate_per_s, uint32_t burst,
+                       uint32_t now_ms)
+{
+    bucket->rate_per_s = rate_per_s;
+    bucket->capacity = ((burst > 0u) ? burst : 1u) * MILLI_TOKENS_PER_TOKEN;
+    bucket->level = bucket->capacity;
+    bucket->last_ms = now_ms;
+}
+
+/******************************************************************************
+ * Function Name: token_bucket_refill
+ ******************************************************************************
+ * Summary:
+ *  Adds the tokens earned since the last refill. A rate of R tokens per
+ *  second is R thousandths of a token per millisecond.
+ *
+ ******************************************************************************/
+static void token_bucket_refill(token_bucket_t *bucket, uint32_t now_ms)
+{
+    uint32_t elapsed_ms = now_ms - bucket->last_ms;
+    uint32_t missing = bucket->capacity - bucket->level;
+
+    bucket->last_ms = now_ms;
+    if ((bucket->rate_per_s == 0u) || (elapsed_ms >= (missing / bucket->rate_per_s) + 1u))
+    {
+        bucket->level = bucket->capacity;
+    }
+    else
+    {
+        bucket->level += elapsed_ms * bucket->rate_per_s;
+    }
+}
+
+/******************************************************************************
+ * Function Name: token_bucket_wait_ms
+ ******************************************************************************
+ * Summary:
+ *  Returns how long it takes until the bucket holds a whole token.
+ *
+ * Parameters:
+ *  token_bucket_t *bucket : Bucket
+ *  uint32_t now_ms : Current time in milliseconds
+ *
+ * Return:
+ *  uint32_t : 0 if a token is available, else the wait in milliseconds
+ *
+ ******************************************************************************/
+uint32_t token_bucket_wait_ms(token_bucket_t *bucket, uint32_t now_ms)
+{
+    uint32_t missing;
+
+    token_bucket_refill(bucket, now_ms);
+    if (bucket->level >= MILLI_TOKENS_PER_TOKEN)
+    {
+        return 0;
+    }
+
+    missing = MILLI_TOKENS_PER_TOKEN - bucket->level;
+    return (missing + bucket->rate_per_s - 1u) / bucket->rate_per_s;
+}
+
+/******************************************************************************
+ * Function Name: token_bucket_take
+ ******************************************************************************
+ * Summary:
+ *  Takes a token. To be called after token_bucket_wait_ms() returned 0.
+ *
+ * Parameters:
+ *  token_bucket_t *bucket : Bucket
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void token_bucket_take(token_bucket_t *bucket)
+{
+    if ((bucket->rate_per_s != 0u) && (bucket->level >= MILLI_TOKENS_PER_TOKEN))
+    {
+        bucket->level -= MILLI_TOKENS_PER_TOKEN;
+    }
+}
+
+/******************************************************************************
+ * Function Name: rate_limiter_init
+ ******************************************************************************
+ * Summary:
+ *  Initializes a limiter with a global bucket and an empty table of topic
+ *  buckets.
+ *
+ * Parameters:
+ *  rate_limiter_t *limiter : Limiter
+ *  rate_limiter_topic_t *topics : Storage for the topic buckets
+ *  uint32_t topic_count : Number of entries in 'topics'
+ *  uint32_t rate_per_s : Global rate in messages per second; 0 for unlimited
+ *  uint32_t burst : Global burst in messages
+ *  uint32_t topic_rate_per_s : Rate of each topic; 0 for unlimited
+ *  uint32_t topic_burst : Burst of each topic
+ *  uint32_t now_ms : Current time in milliseconds
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void rate_limiter_init(rate_limiter_t *limiter, rate_limiter_topic_t *topics,
+                       uint32_t topic_count, uint32_t rate_per_s, uint32_t burst,
+                       uint32_t topic_rate_per_s, uint32_t topic_burst, uint32_t now_ms)
+{
+    memset(limiter, 0, sizeof(*limiter));
+    memset(topics, 0, topic_count * sizeof(topics[0]));
+
+    token_bucket_init(&limiter->global, rate_per_s, burst, now_ms);
+    limiter->topics = topics;
+    limiter->topic_count = topic_count;
+    limiter->topic_rate_per_s = topic_rate_per_s;
+    limiter->topic_burst = topic_burst;
+}
+
+/******************************************************************************
+ * Function Name: topic_hash
+ ******************************************************************************
+ * Summary:
+ *  Returns the FNV-1a hash of a topic.
+ *
+ ******************************************************************************/
+static uint32_t topic_hash(const char *topic)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    for (; *topic != '\0'; topic++)
+    {
+        hash = (hash ^ (uint8_t) *topic) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/******************************************************************************
+ * Function Name: topic_bucket
+ ******************************************************************************
+ * Summary:
+ *  Returns the bucket of a topic, taking over a free entry or the least
+ *  recently used one for a topic not seen before.
+ *
+ ******************************************************************************/
+static token_bucket_t *topic_bucket(rate_limiter_t *limiter, const char *topic,
+                                    uint32_t now_ms)
+{
+    uint32_t hash = topic_hash(topic);
+    rate_limiter_topic_t *victim = NULL;
+
+    for (uint32_t i = 0; i < limiter->topic_count; i++)
+    {
+        rate_limiter_topic_t *entry = &limiter->topics[i];
+
+        if (entry->used && (entry->topic_hash == hash))
+        {
+            entry->last_used_ms = now_ms;
+            return &entry->bucket;
+        }
+
+        if ((victim == NULL) || !entry->used ||
+            (victim->used &&
+             ((now_ms - entry->last_used_ms) > (now_ms - victim->last_used_ms))))
+        {
+            victim = entry;
+        }
+    }
+
+    if (victim == NULL)
+    {
+        return NULL;
+    }
+
+    limiter->stats.topic_evictions += victim->used ? 1u : 0u;
+    victim->used = true;
+    victim->topic_hash = hash;
+    victim->last_used_ms = now_ms;
+    token_bucket_init(&victim->bucket, limiter->topic_rate_per_s, limiter->topic_burst, now_ms);
+    return &victim->bucket;
+}
+
+/******************************************************************************
+ * Function Name: rate_limiter_acquire
+ ******************************************************************************
+ * Summary:
+ *  Takes the tokens to publish a message on a topic if both the global and
+ *  the topic bucket have one, else takes nothing and returns how long to
+ *  wait before trying again.
+ *
+ * Parameters:
+ *  rate_limiter_t *limiter : Limiter
+ *  const char *topic : MQTT topic of the message
+ *  uint32_t now_ms : Current time in milliseconds
+ *
+ * Return:
+ *  uint32_t : 0 if the message may be published now, else the wait in
+ *             milliseconds
+ *
+ ******************************************************************************/
+uint32_t rate_limiter_acquire(rate_limiter_t *limiter, const char *topic, uint32_t now_ms)
+{
+    token_bucket_t *bucket = topic_bucket(limiter, topic, now_ms);
+    uint32_t wait_ms = token_bucket_wait_ms(&limiter->global, now_ms);
+
+    if (bucket != NULL)
+    {
+        uint32_t topic_wait_ms = token_bucket_wait_ms(bucket, now_ms);
+
+        wait_ms = (topic_wait_ms > wait_ms) ? topic_wait_ms : wait_ms;
+    }
+
+    if (wait_ms > 0u)
+    {
+        limiter->stats.throttled++;
+        if (wait_ms > limiter->stats.max_wait_ms)
+        {
+            limiter->stats.max_wait_ms = wait_ms;
+        }
+        return wait_ms;
+    }
+
+    token_bucket_take(&limiter->global);
+    if (bucket != NULL)
+    {
+        token_bucket_take(bucket);
+    }
+    limiter->stats.passed++;
+    return 0;
+}
+
+/* [] END OF FILE */
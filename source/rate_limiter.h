@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name:   rate_limiter.h
+*
+* Description: This file is the public interface of rate_limiter.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RATE_LIMITER_H_
+#define RATE_LIMITER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Token bucket refilled at 'rate_per_s' tokens per second up to 'burst'
+ * tokens. Levels are kept in thousandths of a token. A rate of 0 means
+ * unlimited.
+ */
+typedef struct
+{
+    uint32_t rate_per_s;
+    uint32_t capacity;              /* burst * 1000 */
+    uint32_t level;
+    uint32_t last_ms;
+} token_bucket_t;
+
+/* Bucket of one topic, keyed by the hash of the topic so that the caller's
+ * string need not outlive the call. Topics with the same hash share a bucket.
+ */
+typedef struct
+{
+    bool used;
+    uint32_t topic_hash;
+    uint32_t last_used_ms;
+    token_bucket_t bucket;
+} rate_limiter_topic_t;
+
+/* Limiter counters. */
+typedef struct
+{
+    uint32_t passed;                /* Messages that got their tokens */
+    uint32_t throttled;             /* Requests refused for lack of tokens */
+    uint32_t max_wait_ms;           /* Longest wait returned */
+    uint32_t topic_evictions;       /* Topic buckets reused for another topic */
+} rate_limiter_stats_t;
+
+/* Global bucket plus one bucket per topic. A message needs a token from both.
+ * The topic buckets live in a fixed table; when it is full, the bucket of the
+ * least recently used topic is taken over.
+ */
+typedef struct
+{
+    token_bucket_t global;
+    rate_limiter_topic_t *topics;
+    uint32_t topic_count;
+    uint32_t topic_rate_per_s;
+    uint32_t topic_burst;
+    rate_limiter_stats_t stats;
+} rate_limiter_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void token_bucket_init(token_bucket_t *bucket, uint32_t rate_per_s, uint32_t burst,
+                       uint32_t now_ms);
+uint32_t token_bucket_wait_ms(token_bucket_t *bucket, uint32_t now_ms);
+void token_bucket_take(token_bucket_t *bucket);
+
+void rate_limiter_init(rate_limiter_t *limiter, rate_limiter_topic_t *topics,
+                       uint32_t topic_count, uint32_t rate_per_s, uint32_t burst,
+                       uint32_t topic_rate_per_s, uint32_t topic_burst, uint32_t now_ms);
+uint32_t rate_limiter_acquire(rate_limiter_t *limiter, const char *topic, uint32_t now_ms);
+
+#endif /* RATE_LIMITER_H_ */
+
+/* [] END OF FILE */
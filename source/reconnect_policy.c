@@ -0,0 +1,367 @@
+/******************************************************************************
+* File Name:   reconnect_policy.c
+*
+* Description: This file implements the reconnection policy of the MQTT
+*              client task: capped exponential backoff with full jitter for
+*              the Wi-Fi and MQTT connection retries, and time-to-reconnect
+*              and attempt-count metrics for every disconnection.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "reconnect_policy.h"
+#include "log2_histogram.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* FNV-1a parameters used to fold the seed material into the PRNG state. */
+#define FNV1A_OFFSET_BASIS              (2166136261u)
+#define FNV1A_PRIME                     (16777619u)
+
+/* Any non-zero value keeps xorshift32 out of its fixed point. */
+#define PRNG_FALLBACK_STATE             (0x9E3779B9u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* State of the xorshift32 generator behind the jitter. Only the MQTT client
+ * task draws from it.
+ */
+static uint32_t prng_state = PRNG_FALLBACK_STATE;
+
+/* Reconnection episode in progress, and the metrics of the completed ones. */
+static bool episode_active;
+static TickType_t episode_start;
+static uint32_t episode_attempts[RECONNECT_LINK_COUNT];
+static reconnect_stats_t episode_stats;
+static log2_histogram_t episode_durations;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t prng_next(void);
+static uint32_t random_up_to(uint32_t limit);
+
+/******************************************************************************
+ * Function Name: reconnect_policy_init
+ ******************************************************************************
+ * Summary:
+ *  Seeds the jitter generator and clears the reconnection metrics. The seed
+ *  must differ between devices, e.g. the MAC address, so that devices that
+ *  lose the broker at the same time spread their retries instead of
+ *  reconnecting in lockstep. The current tick count is mixed in as well.
+ *
+ * Parameters:
+ *  const void *entropy : Device-specific seed material
+ *  size_t entropy_len : Length of the seed material in bytes
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void reconnect_policy_init(const void *entropy, size_t entropy_len)
+{
+    const uint8_t *bytes = (const uint8_t *) entropy;
+    uint32_t hash = FNV1A_OFFSET_BASIS;
+
+    for (size_t i = 0; i < entropy_len; i++)
+    {
+        hash = (hash ^ bytes[i]) * FNV1A_PRIME;
+    }
+    hash ^= (uint32_t) xTaskGetTickCount();
+
+    prng_state = (hash != 0u) ? hash : PRNG_FALLBACK_STATE;
+
+    taskENTER_CRITICAL();
+    episode_active = false;
+    memset(&episode_stats, 0, sizeof(episode_stats));
+    log2_histogram_reset(&episode_durations);
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: prng_next
+ ******************************************************************************
+ * Summary:
+ *  Advances the xorshift32 generator.
+ *
+ ******************************************************************************/
+static uint32_t prng_next(void)
+{
+    uint32_t x = prng_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    prng_state = x;
+    return x;
+}
+
+/******************************************************************************
+ * Function Name: random_up_to
+ ******************************************************************************
+ * Summary:
+ *  Returns a uniformly distributed value in [0, limit].
+ *
+ ******************************************************************************/
+static uint32_t random_up_to(uint32_t limit)
+{
+    if (limit == UINT32_MAX)
+    {
+        return prng_next();
+    }
+    return (uint32_t)(((uint64_t) prng_next() * ((uint64_t) limit + 1u)) >> 32);
+}
+
+/******************************************************************************
+ * Function Name: reconnect_backoff_init
+ ******************************************************************************
+ * Summary:
+ *  Configures a backoff sequence and rewinds it to the first retry.
+ *
+ * Parameters:
+ *  reconnect_backoff_t *backoff : Backoff sequence
+ *  uint32_t first_delay_ms : Upper bound of the first retry delay
+ *  uint32_t base_delay_ms : Upper bound of the second retry delay, doubled for
+ *                           every further retry
+ *  uint32_t max_delay_ms : Cap of the upper bound
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void reconnect_backoff_init(reconnect_backoff_t *backoff, uint32_t first_delay_ms,
+                            uint32_t base_delay_ms, uint32_t max_delay_ms)
+{
+    backoff->first_delay_ms = first_delay_ms;
+    backoff->base_delay_ms = base_delay_ms;
+    backoff->max_delay_ms = max_delay_ms;
+    backoff->attempt = 0u;
+}
+
+/******************************************************************************
+ * Function Name: reconnect_backoff_reset
+ ******************************************************************************
+ * Summary:
+ *  Rewinds a backoff sequence to the first retry after a successful
+ *  connection.
+ *
+ * Parameters:
+ *  reconnect_backoff_t *backoff : Backoff sequence
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void reconnect_backoff_reset(reconnect_backoff_t *backoff)
+{
+    backoff->attempt = 0u;
+}
+
+/******************************************************************************
+ * Function Name: reconnect_backoff_next_delay_ms
+ ******************************************************************************
+ * Summary:
+ *  Returns the delay before the next retry and advances the sequence. The
+ *  delay is drawn uniformly between zero and the exponential upper bound
+ *  ("full jitter"), which spreads the retries of many devices evenly over the
+ *  window instead of clustering them at its end.
+ *
+ * Parameters:
+ *  reconnect_backoff_t *backoff : Backoff sequence
+ *
+ * Return:
+ *  uint32_t : Delay in milliseconds
+ *
+ ******************************************************************************/
+uint32_t reconnect_backoff_next_delay_ms(reconnect_backoff_t *backoff)
+{
+    uint32_t ceiling;
+
+    if (backoff->attempt == 0u)
+    {
+        ceiling = backoff->first_delay_ms;
+    }
+    else
+    {
+        uint32_t shift = backoff->attempt - 1u;
+
+        ceiling = backoff->max_delay_ms;
+        if ((shift < 32u) && (backoff->base_delay_ms <= (backoff->max_delay_ms >> shift)))
+        {
+            ceiling = backoff->base_delay_ms << shift;
+        }
+    }
+
+    if (backoff->attempt < UINT32_MAX)
+    {
+        backoff->attempt++;
+    }
+
+    return random_up_to(ceiling);
+}
+
+/******************************************************************************
+ * Function Name: reconnect_episode_begin
+ ******************************************************************************
+ * Summary:
+ *  Marks the start of a reconnection episode, i.e. the handling of a
+ *  disconnection.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void reconnect_episode_begin(void)
+{
+    taskENTER_CRITICAL();
+    episode_active = true;
+    episode_start = xTaskGetTickCount();
+    memset(episode_attempts, 0, sizeof(episode_attempts));
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: reconnect_episode_attempt
+ ******************************************************************************
+ * Summary:
+ *  Counts one connection attempt of a link. Attempts made outside of a
+ *  reconnection episode, such as the initial connection, are not counted.
+ *
+ * Parameters:
+ *  reconnect_link_t link : Link being connected
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void reconnect_episode_attempt(reconnect_link_t link)
+{
+    if (episode_active && (link < RECONNECT_LINK_COUNT))
+    {
+        taskENTER_CRITICAL();
+        episode_attempts[link]++;
+        taskEXIT_CRITICAL();
+    }
+}
+
+/******************************************************************************
+ * Function Name: reconnect_episode_end
+ ******************************************************************************
+ * Summary:
+ *  Closes the reconnection episode in progress and adds it to the metrics.
+ *
+ * Parameters:
+ *  bool reconnected : true if the MQTT connection was restored, false if the
+ *                     reconnection gave up
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void reconnect_episode_end(bool reconnected)
+{
+    uint32_t duration_ms;
+
+    if (!episode_active)
+    {
+        return;
+    }
+
+    duration_ms = (uint32_t)(xTaskGetTickCount() - episode_start) * portTICK_PERIOD_MS;
+
+    taskENTER_CRITICAL();
+    episode_active = false;
+    if (reconnected)
+    {
+        episode_stats.episodes++;
+        episode_stats.last_duration_ms = duration_ms;
+        log2_histogram_add(&episode_durations, duration_ms);
+    }
+    else
+    {
+        episode_stats.failed_episodes++;
+    }
+    for (uint32_t link = 0; link < RECONNECT_LINK_COUNT; link++)
+    {
+        episode_stats.last_attempts[link] = episode_attempts[link];
+        episode_stats.total_attempts[link] += episode_attempts[link];
+        if (episode_attempts[link] > episode_stats.max_attempts[link])
+        {
+            episode_stats.max_attempts[link] = episode_attempts[link];
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: reconnect_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the metrics of the completed reconnection episodes. The duration
+ *  summary covers the successful episodes only.
+ *
+ * Parameters:
+ *  reconnect_stats_t *stats : Pointer to store the metrics
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void reconnect_get_stats(reconnect_stats_t *stats)
+{
+    log2_histogram_t snapshot;
+
+    taskENTER_CRITICAL();
+    *stats = episode_stats;
+    snapshot = episode_durations;
+    taskEXIT_CRITICAL();
+
+    stats->mean_duration_ms = log2_histogram_mean(&snapshot);
+    stats->p50_duration_ms = log2_histogram_percentile(&snapshot, 50u);
+    stats->p99_duration_ms = log2_histogram_percentile(&snapshot, 99u);
+    stats->max_duration_ms = snapshot.max;
+}
+
+/* [] END OF FILE */
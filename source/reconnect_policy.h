@@ -0,0 +1,107 @@
+/******************************************************************************
+* File Name:   reconnect_policy.h
+*
+* Description: This file is the public interface of reconnect_policy.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RECONNECT_POLICY_H_
+#define RECONNECT_POLICY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Capped exponential backoff with full jitter. The first retry waits at most
+ * 'first_delay_ms'; retry 'n' (n >= 1) waits a uniformly random time in
+ * [0, min(max_delay_ms, base_delay_ms * 2^(n-1))].
+ */
+typedef struct
+{
+    uint32_t first_delay_ms;
+    uint32_t base_delay_ms;
+    uint32_t max_delay_ms;
+    uint32_t attempt;
+} reconnect_backoff_t;
+
+/* Links whose connection attempts are counted separately. */
+typedef enum
+{
+    RECONNECT_LINK_WIFI,
+    RECONNECT_LINK_MQTT,
+    RECONNECT_LINK_COUNT
+} reconnect_link_t;
+
+/* Summary of the reconnection episodes, i.e. the time from a disconnection to
+ * the restored MQTT connection. Durations are in milliseconds; percentiles are
+ * upper bounds resolved to power-of-two bucket limits.
+ */
+typedef struct
+{
+    uint32_t episodes;                                  /* Successful reconnections */
+    uint32_t failed_episodes;                           /* Reconnections that gave up */
+    uint32_t last_duration_ms;
+    uint32_t last_attempts[RECONNECT_LINK_COUNT];
+    uint32_t max_attempts[RECONNECT_LINK_COUNT];
+    uint32_t total_attempts[RECONNECT_LINK_COUNT];
+    uint32_t mean_duration_ms;
+    uint32_t p50_duration_ms;
+    uint32_t p99_duration_ms;
+    uint32_t max_duration_ms;
+} reconnect_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void reconnect_policy_init(const void *entropy, size_t entropy_len);
+
+void reconnect_backoff_init(reconnect_backoff_t *backoff, uint32_t first_delay_ms,
+                            uint32_t base_delay_ms, uint32_t max_delay_ms);
+void reconnect_backoff_reset(reconnect_backoff_t *backoff);
+uint32_t reconnect_backoff_next_delay_ms(reconnect_backoff_t *backoff);
+
+void reconnect_episode_begin(void);
+void reconnect_episode_attempt(reconnect_link_t link);
+void reconnect_episode_end(bool reconnected);
+void reconnect_get_stats(reconnect_stats_t *stats);
+
+#endif /* RECONNECT_POLICY_H_ */
+
+/* [] END OF FILE */
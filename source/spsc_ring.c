@@ -0,0 +1,335 @@
+/******************************************************************************
+* File Name:   spsc_ring.c
+*
+* Description: This file contains a lock-free single-producer single-consumer
+*              ring with a configurable overflow policy. It lets an interrupt
+*              or callback context hand items to a task without ever
+*              blocking.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "spsc_ring.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define LOAD_ACQUIRE(ptr)               __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(ptr, value)       __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define MEMORY_BARRIER()                __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/* Bits of 'latest_state'. The producer sets WRITING and bumps the generation
+ * when it claims the overflow slot; the consumer sets CONSUMED when it takes
+ * the item. Both change the state with a compare-and-swap, so an item is
+ * either taken or dropped, never both.
+ */
+#define LATEST_WRITING                  (1u)
+#define LATEST_CONSUMED                 (2u)
+#define LATEST_GENERATION               (4u)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool compare_and_swap(volatile uint32_t *target, uint32_t expected, uint32_t desired);
+static void note_fill_level(spsc_ring_t *ring, uint32_t fill_level);
+
+/******************************************************************************
+ * Function Name: compare_and_swap
+ ******************************************************************************
+ * Summary:
+ *  Atomically replaces '*target' by 'desired' if it equals 'expected'.
+ *  ARMv6-M (CM0+) has no exclusive access instructions; there the swap runs
+ *  with interrupts masked for a few instructions instead.
+ *
+ ******************************************************************************/
+static bool compare_and_swap(volatile uint32_t *target, uint32_t expected, uint32_t desired)
+{
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask;
+    bool swapped = false;
+
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+    if (*target == expected)
+    {
+        *target = desired;
+        swapped = true;
+    }
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+
+    return swapped;
+#else
+    return __atomic_compare_exchange_n(target, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif /* defined(__ARM_ARCH_6M__) */
+}
+
+/******************************************************************************
+ * Function Name: note_fill_level
+ ******************************************************************************
+ * Summary:
+ *  Updates the high-water counter. Called by the producer only.
+ *
+ ******************************************************************************/
+static void note_fill_level(spsc_ring_t *ring, uint32_t fill_level)
+{
+    if (fill_level > ring->stats.high_water)
+    {
+        ring->stats.high_water = fill_level;
+    }
+}
+
+/******************************************************************************
+ * Function Name: spsc_ring_init
+ ******************************************************************************
+ * Summary:
+ *  Initializes an empty ring on the given storage.
+ *
+ * Parameters:
+ *  spsc_ring_t *ring : Ring to initialize
+ *  void *storage : Storage for 'capacity' items of 'item_size' bytes
+ *  uint32_t item_size : Size of an item in bytes
+ *  uint32_t capacity : Number of items; must be a power of two
+ *  void *latest : Storage for one item, used by SPSC_RING_OVERWRITE_LATEST;
+ *                 may be NULL with the other policies
+ *  spsc_ring_policy_t policy : What to do when the ring is full
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void spsc_ring_init(spsc_ring_t *ring, void *storage, uint32_t item_size, uint32_t capacity,
+                    void *latest, spsc_ring_policy_t policy)
+{
+    memset(ring, 0, sizeof(*ring));
+    ring->storage = (uint8_t *) storage;
+    ring->latest = (uint8_t *) latest;
+    ring->item_size = item_size;
+    ring->capacity = capacity;
+    ring->policy = ((policy == SPSC_RING_OVERWRITE_LATEST) && (latest == NULL)) ?
+                   SPSC_RING_DROP_NEWEST : policy;
+    ring->latest_state = LATEST_CONSUMED;
+}
+
+/******************************************************************************
+ * Function Name: spsc_ring_push
+ ******************************************************************************
+ * Summary:
+ *  Adds an item to the ring; called by the producer only. Never blocks: when
+ *  the ring is full the overflow policy decides which item is lost.
+ *
+ * Parameters:
+ *  spsc_ring_t *ring : Ring to push to
+ *  const void *item : Item to copy into the ring
+ *
+ * Return:
+ *  bool : true if the item was stored, false if it was dropped
+ *
+ ******************************************************************************/
+bool spsc_ring_push(spsc_ring_t *ring, const void *item)
+{
+    uint32_t head = ring->head;
+    uint32_t tail;
+
+    if (ring->policy == SPSC_RING_OVERWRITE_LATEST)
+    {
+        uint32_t state = LOAD_ACQUIRE(&ring->latest_state);
+        uint32_t generation;
+
+        /* While an overflow item is pending, newer items replace it so that
+         * nothing newer than it is queued ahead of it.
+         */
+        if (((state & LATEST_CONSUMED) == 0u) ||
+            ((head - LOAD_ACQUIRE(&ring->tail)) >= ring->capacity))
+        {
+            /* Claim the slot. The pending item is dropped only if the
+             * consumer did not take it before the claim.
+             */
+            do
+            {
+                state = LOAD_ACQUIRE(&ring->latest_state);
+                generation = (state & ~(LATEST_WRITING | LATEST_CONSUMED)) + LATEST_GENERATION;
+            } while (!compare_and_swap(&ring->latest_state, state, generation | LATEST_WRITING));
+
+            memcpy(ring->latest, item, ring->item_size);
+            STORE_RELEASE(&ring->latest_state, generation);
+
+            if ((state & LATEST_CONSUMED) == 0u)
+            {
+                ring->stats.dropped++;
+            }
+            ring->stats.pushed++;
+            note_fill_level(ring, ring->capacity + 1u);
+            return true;
+        }
+    }
+    else
+    {
+        while (true)
+        {
+            tail = LOAD_ACQUIRE(&ring->tail);
+            if ((head - tail) < ring->capacity)
+            {
+                break;
+            }
+
+            if (ring->policy == SPSC_RING_DROP_NEWEST)
+            {
+                ring->stats.dropped++;
+                return false;
+            }
+
+            /* Drop the oldest item unless the consumer takes it first. */
+            if (compare_and_swap(&ring->tail, tail, tail + 1u))
+            {
+                ring->stats.dropped++;
+                break;
+            }
+        }
+    }
+
+    memcpy(&ring->storage[(head & (ring->capacity - 1u)) * ring->item_size], item, ring->item_size);
+    STORE_RELEASE(&ring->head, head + 1u);
+
+    ring->stats.pushed++;
+    note_fill_level(ring, head + 1u - LOAD_ACQUIRE(&ring->tail));
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: spsc_ring_pop
+ ******************************************************************************
+ * Summary:
+ *  Takes the oldest item from the ring; called by the consumer only.
+ *
+ * Parameters:
+ *  spsc_ring_t *ring : Ring to pop from
+ *  void *item : Buffer to copy the item into
+ *
+ * Return:
+ *  bool : true if an item was returned, false if the ring is empty
+ *
+ ******************************************************************************/
+bool spsc_ring_pop(spsc_ring_t *ring, void *item)
+{
+    while (true)
+    {
+        uint32_t tail = LOAD_ACQUIRE(&ring->tail);
+        uint32_t head = LOAD_ACQUIRE(&ring->head);
+        uint32_t state;
+
+        if (tail != head)
+        {
+            memcpy(item, &ring->storage[(tail & (ring->capacity - 1u)) * ring->item_size],
+                   ring->item_size);
+
+            if (ring->policy == SPSC_RING_DROP_OLDEST)
+            {
+                /* The producer may have dropped this item, and be overwriting
+                 * its slot, while it was copied; the copy is then discarded.
+                 */
+                if (!compare_and_swap(&ring->tail, tail, tail + 1u))
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                STORE_RELEASE(&ring->tail, tail + 1u);
+            }
+
+            ring->stats.popped++;
+            return true;
+        }
+
+        if (ring->policy != SPSC_RING_OVERWRITE_LATEST)
+        {
+            return false;
+        }
+
+        /* Nothing pending, or the producer is writing the overflow slot; the
+         * producer signals the consumer again once it is done.
+         */
+        state = LOAD_ACQUIRE(&ring->latest_state);
+        if ((state & (LATEST_CONSUMED | LATEST_WRITING)) != 0u)
+        {
+            return false;
+        }
+
+        /* Items queued before the overflow item must be popped first. */
+        if (LOAD_ACQUIRE(&ring->head) != tail)
+        {
+            continue;
+        }
+
+        memcpy(item, ring->latest, ring->item_size);
+        MEMORY_BARRIER();
+
+        /* Fails if the producer claimed the slot meanwhile; the copy may be
+         * torn and is discarded.
+         */
+        if (compare_and_swap(&ring->latest_state, state, state | LATEST_CONSUMED))
+        {
+            ring->stats.popped++;
+            return true;
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: spsc_ring_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns a snapshot of the ring counters.
+ *
+ * Parameters:
+ *  const spsc_ring_t *ring : Ring to read
+ *  spsc_ring_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void spsc_ring_get_stats(const spsc_ring_t *ring, spsc_ring_stats_t *stats)
+{
+    stats->pushed = ring->stats.pushed;
+    stats->popped = ring->stats.popped;
+    stats->dropped = ring->stats.dropped;
+    stats->high_water = ring->stats.high_water;
+}
+
+/* [] END OF FILE */
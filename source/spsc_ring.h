@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name:   spsc_ring.h
+*
+* Description: This file is the public interface of spsc_ring.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SPSC_RING_H_
+#define SPSC_RING_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* What spsc_ring_push() does when the ring is full. */
+typedef enum
+{
+    SPSC_RING_DROP_NEWEST,          /* The new item is discarded */
+    SPSC_RING_DROP_OLDEST,          /* The oldest queued item is discarded */
+    SPSC_RING_OVERWRITE_LATEST      /* The new item goes to an overflow slot that
+                                     * keeps only the most recent item; it is
+                                     * popped after the queued items */
+} spsc_ring_policy_t;
+
+/* Ring counters. */
+typedef struct
+{
+    uint32_t pushed;                /* Items accepted by spsc_ring_push() */
+    uint32_t popped;                /* Items returned by spsc_ring_pop() */
+    uint32_t dropped;               /* Items lost to the overflow policy */
+    uint32_t high_water;            /* Largest number of queued items observed */
+} spsc_ring_stats_t;
+
+/* Single-producer single-consumer ring. One context may push and one other
+ * context may pop concurrently without locks; neither ever blocks.
+ */
+typedef struct
+{
+    uint8_t *storage;               /* 'capacity' items of 'item_size' bytes */
+    uint8_t *latest;                /* Overflow slot for SPSC_RING_OVERWRITE_LATEST */
+    uint32_t item_size;
+    uint32_t capacity;              /* Power of two */
+    spsc_ring_policy_t policy;
+    volatile uint32_t head;         /* Items ever written; owned by the producer */
+    volatile uint32_t tail;         /* Items ever consumed or dropped */
+    volatile uint32_t latest_state; /* State of the overflow slot, see spsc_ring.c */
+    volatile spsc_ring_stats_t stats;
+} spsc_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void spsc_ring_init(spsc_ring_t *ring, void *storage, uint32_t item_size, uint32_t capacity,
+                    void *latest, spsc_ring_policy_t policy);
+bool spsc_ring_push(spsc_ring_t *ring, const void *item);
+bool spsc_ring_pop(spsc_ring_t *ring, void *item);
+void spsc_ring_get_stats(const spsc_ring_t *ring, spsc_ring_stats_t *stats);
+
+#endif /* SPSC_RING_H_ */
+
+/* [] END OF FILE */
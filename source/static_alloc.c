@@ -0,0 +1,173 @@
+/******************************************************************************
+* File Name:   static_alloc.c
+*
+* Description: Creation of the tasks and queues of this example from static
+*              storage, and the account of the bytes thereby kept out of the
+*              heap.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "static_alloc.h"
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Objects placed in static storage so far. */
+static static_alloc_stats_t static_alloc_stats;
+
+#if ENABLE_STATIC_ALLOCATION
+/******************************************************************************
+ * Function Name: static_alloc_task_create
+ ******************************************************************************
+ * Summary:
+ *  Creates a task with xTaskCreateStatic() and counts its stack and TCB.
+ *
+ * Parameters:
+ *  TaskFunction_t function : Task function
+ *  const char *name : Task name
+ *  uint32_t depth : Number of StackType_t words of 'stack'
+ *  void *parameters : Task parameter
+ *  UBaseType_t priority : Task priority
+ *  TaskHandle_t *handle : Pointer to store the task handle; may be NULL
+ *  StackType_t *stack : Stack of the task
+ *  StaticTask_t *tcb : Control block of the task
+ *
+ * Return:
+ *  BaseType_t : pdPASS if the task was created, else pdFAIL.
+ *
+ ******************************************************************************/
+BaseType_t static_alloc_task_create(TaskFunction_t function, const char *name,
+                                    uint32_t depth, void *parameters,
+                                    UBaseType_t priority, TaskHandle_t *handle,
+                                    StackType_t *stack, StaticTask_t *tcb)
+{
+    TaskHandle_t task = xTaskCreateStatic(function, name, depth, parameters, priority,
+                                          stack, tcb);
+
+    if (handle != NULL)
+    {
+        *handle = task;
+    }
+    if (task == NULL)
+    {
+        return pdFAIL;
+    }
+
+    static_alloc_account((depth * sizeof(StackType_t)) + sizeof(StaticTask_t));
+    return pdPASS;
+}
+
+/******************************************************************************
+ * Function Name: static_alloc_queue_create
+ ******************************************************************************
+ * Summary:
+ *  Creates a queue with xQueueCreateStatic() and counts its storage and
+ *  control block.
+ *
+ * Parameters:
+ *  UBaseType_t length : Maximum number of items
+ *  UBaseType_t item_size : Size of an item
+ *  uint8_t *storage : Storage of length * item_size bytes
+ *  size_t storage_size : Size of 'storage'
+ *  StaticQueue_t *buffer : Control block of the queue
+ *
+ * Return:
+ *  QueueHandle_t : Handle of the queue, or NULL.
+ *
+ ******************************************************************************/
+QueueHandle_t static_alloc_queue_create(UBaseType_t length, UBaseType_t item_size,
+                                        uint8_t *storage, size_t storage_size,
+                                        StaticQueue_t *buffer)
+{
+    QueueHandle_t queue;
+
+    configASSERT(storage_size >= ((size_t) length * item_size));
+
+    queue = xQueueCreateStatic(length, item_size, storage, buffer);
+    if (queue != NULL)
+    {
+        static_alloc_account(storage_size + sizeof(StaticQueue_t));
+    }
+    return queue;
+}
+#endif /* ENABLE_STATIC_ALLOCATION */
+
+/******************************************************************************
+ * Function Name: static_alloc_account
+ ******************************************************************************
+ * Summary:
+ *  Counts an object placed in static storage that the dynamic build takes
+ *  from the heap.
+ *
+ * Parameters:
+ *  size_t bytes : Size of the object
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void static_alloc_account(size_t bytes)
+{
+    taskENTER_CRITICAL();
+    static_alloc_stats.objects++;
+    static_alloc_stats.bytes += (uint32_t) bytes;
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: static_alloc_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the number and size of the objects placed in static storage so
+ *  far, i.e. the heap bytes saved compared with the dynamic build, allocator
+ *  overhead excluded.
+ *
+ * Parameters:
+ *  static_alloc_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void static_alloc_get_stats(static_alloc_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = static_alloc_stats;
+    taskEXIT_CRITICAL();
+}
+
+/* [] END OF FILE */
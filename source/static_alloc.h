@@ -0,0 +1,123 @@
+/******************************************************************************
+* File Name:   static_alloc.h
+*
+* Description: Creation of the tasks and queues of this example from static
+*              storage when ENABLE_STATIC_ALLOCATION is set, and from the
+*              heap otherwise.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STATIC_ALLOC_H_
+#define STATIC_ALLOC_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Include the MQTT client configuration header file. */
+#include "mqtt_client_config.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Multiplier of the stack depths of the statically allocated tasks. The host
+ * build sets it to the factor its xTaskCreate() wrapper applies, as a static
+ * stack cannot be enlarged at run time.
+ */
+#ifndef STATIC_ALLOC_STACK_SCALE
+#define STATIC_ALLOC_STACK_SCALE            (1u)
+#endif
+
+/* Number of StackType_t words of the stack of a statically allocated task. */
+#define STATIC_ALLOC_STACK_DEPTH(depth)     ((depth) * STATIC_ALLOC_STACK_SCALE)
+
+/* Creates a task; returns pdPASS or pdFAIL like xTaskCreate(). 'stack' is a
+ * StackType_t array of STATIC_ALLOC_STACK_DEPTH(depth) words and 'tcb' a
+ * StaticTask_t; both are only referenced when ENABLE_STATIC_ALLOCATION is set,
+ * so they need to be declared only then.
+ */
+#if ENABLE_STATIC_ALLOCATION
+#define STATIC_ALLOC_TASK_CREATE(function, name, depth, parameters, priority, handle, stack, tcb) \
+    static_alloc_task_create((function), (name), (uint32_t)(sizeof(stack) / sizeof(StackType_t)), \
+                             (parameters), (priority), (handle), (stack), (tcb))
+#else
+#define STATIC_ALLOC_TASK_CREATE(function, name, depth, parameters, priority, handle, stack, tcb) \
+    xTaskCreate((function), (name), (depth), (parameters), (priority), (handle))
+#endif /* ENABLE_STATIC_ALLOCATION */
+
+/* Creates a queue; returns the handle or NULL like xQueueCreate(). 'storage'
+ * is a uint8_t array of length * item_size bytes and 'buffer' a
+ * StaticQueue_t; both are only referenced when ENABLE_STATIC_ALLOCATION is
+ * set.
+ */
+#if ENABLE_STATIC_ALLOCATION
+#define STATIC_ALLOC_QUEUE_CREATE(length, item_size, storage, buffer) \
+    static_alloc_queue_create((length), (item_size), (storage), sizeof(storage), (buffer))
+#else
+#define STATIC_ALLOC_QUEUE_CREATE(length, item_size, storage, buffer) \
+    xQueueCreate((length), (item_size))
+#endif /* ENABLE_STATIC_ALLOCATION */
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Objects placed in static storage instead of the heap. */
+typedef struct
+{
+    uint32_t objects;               /* Tasks, queues, timers and buffers */
+    uint32_t bytes;                 /* Their size, control blocks included */
+} static_alloc_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+#if ENABLE_STATIC_ALLOCATION
+BaseType_t static_alloc_task_create(TaskFunction_t function, const char *name,
+                                    uint32_t depth, void *parameters,
+                                    UBaseType_t priority, TaskHandle_t *handle,
+                                    StackType_t *stack, StaticTask_t *tcb);
+QueueHandle_t static_alloc_queue_create(UBaseType_t length, UBaseType_t item_size,
+                                        uint8_t *storage, size_t storage_size,
+                                        StaticQueue_t *buffer);
+#endif /* ENABLE_STATIC_ALLOCATION */
+void static_alloc_account(size_t bytes);
+void static_alloc_get_stats(static_alloc_stats_t *stats);
+
+#endif /* STATIC_ALLOC_H_ */
+
+/* [] END OF FILE */
@@ -50,6 +50,14 @@
 /* Task header files */
 #include "subscriber_task.h"
 #include "mqtt_task.h"
+#include "publish_batch.h"
+#include "topic_trie.h"
+#include "spsc_ring.h"
+#include "command_table.h"
+#include "device_state.h"
+#include "payload_compress.h"
+#include "static_alloc.h"
+#include "app_log.h"
 
 /* Configuration file for MQTT client */
 #include "mqtt_client_config.h"
@@ -61,6 +69,9 @@
 /******************************************************************************
 * Macros
 ******************************************************************************/
+/* Log level of this module. */
+#define APP_LOG_MODULE_LEVEL            APP_LOG_LEVEL_SUBSCRIBER
+
 /* Maximum number of retries for MQTT subscribe operation */
 #define MAX_SUBSCRIBE_RETRIES                   (3u)
 
@@ -68,12 +79,36 @@
 #define MQTT_SUBSCRIBE_RETRY_INTERVAL_MS        (1000)
 
 /* The number of MQTT topics to be subscribed to. */
-#define SUBSCRIPTION_COUNT                      (1)
+#define SUBSCRIPTION_COUNT                      (sizeof(subscriptions) / sizeof(subscriptions[0]))
+
+/* Maximum number of levels of a subscribed topic filter, and the resulting
+ * storage of the topic filter trie.
+ */
+#define SUBSCRIPTION_MAX_TOPIC_LEVELS           (8u)
+#define SUBSCRIPTION_TRIE_MAX_NODES             ((SUBSCRIPTION_COUNT * SUBSCRIPTION_MAX_TOPIC_LEVELS) + 1u)
+#define SUBSCRIPTION_TRIE_SLOT_COUNT            TOPIC_TRIE_SLOT_COUNT(SUBSCRIPTION_TRIE_MAX_NODES)
+
+/* The number of device commands of 'MQTT_DEVICE_COMMANDS'. */
+#define DEVICE_COMMAND_COUNT                    (sizeof(device_commands) / sizeof(device_commands[0]))
 
 /* Queue length of a message queue that is used to communicate with the 
- * subscriber task.
+ * subscriber task. One entry is kept for the doorbell of the ingest ring.
  */
-#define SUBSCRIBER_TASK_QUEUE_LENGTH            (1u)
+#define SUBSCRIBER_TASK_QUEUE_LENGTH            (2u)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void subscribe_to_topic(void);
+static void unsubscribe_from_topic(void);
+static void build_subscription_table(void);
+static void dispatch_message(void *user_data, void *callback_arg);
+static void handle_device_state_topic(cy_mqtt_publish_info_t *received_msg_info);
+static void handle_device_message(const char *received_msg, int received_msg_len);
+static void update_device_state(uint8_t device_state);
+#if ENABLE_PAYLOAD_COMPRESSION
+static bool is_compressed_topic(const char *topic, size_t topic_len);
+#endif /* ENABLE_PAYLOAD_COMPRESSION */
 
 /******************************************************************************
 * Global Variables
@@ -84,25 +119,122 @@ TaskHandle_t subscriber_task_handle;
 /* Handle of the queue holding the commands for the subscriber task */
 QueueHandle_t subscriber_task_q;
 
+#if ENABLE_STATIC_ALLOCATION
+/* Static storage of the queue above. */
+static uint8_t subscriber_task_q_storage[SUBSCRIBER_TASK_QUEUE_LENGTH * sizeof(subscriber_data_t)];
+static StaticQueue_t subscriber_task_q_buffer;
+#endif /* ENABLE_STATIC_ALLOCATION */
+
 /* Variable to denote the current state of the user LED that is also used by 
  * the publisher task.
  */
 uint32_t current_device_state = DEVICE_OFF_STATE;
 
-/* Configure the subscription information structure. */
-static cy_mqtt_subscribe_info_t subscribe_info =
+/* Set once the subscriptions of the table below were acknowledged by the
+ * broker, cleared when they are removed.
+ */
+static volatile bool subscriptions_active;
+
+/* Topic filters subscribed to by this task and the handlers of the messages
+ * received on them. Add entries to this table to subscribe to more topics;
+ * the MQTT wildcards '+' and '#' are supported. A message is handed to every
+ * entry whose filter matches its topic.
+ */
+static const subscription_t subscriptions[] =
 {
-    .qos = (cy_mqtt_qos_t) MQTT_MESSAGES_QOS,
-    .topic = MQTT_SUB_TOPIC,
-    .topic_len = (sizeof(MQTT_SUB_TOPIC) - 1)
+    { MQTT_SUB_TOPIC, (cy_mqtt_qos_t) MQTT_MESSAGES_QOS, handle_device_state_topic },
 };
 
+/* Subscription information structures built from the table above. */
+static cy_mqtt_subscribe_info_t subscribe_info[SUBSCRIPTION_COUNT];
+
+/* Topic filter trie that maps the topic of a received message to the
+ * entries of the subscription table, and its storage.
+ */
+static topic_trie_t subscription_trie;
+static topic_trie_node_t subscription_trie_nodes[SUBSCRIPTION_TRIE_MAX_NODES];
+static uint16_t subscription_trie_slots[SUBSCRIPTION_TRIE_SLOT_COUNT];
+static topic_trie_entry_t subscription_trie_entries[SUBSCRIPTION_COUNT];
+
+_Static_assert(SUBSCRIPTION_TRIE_SLOT_COUNT > SUBSCRIPTION_TRIE_MAX_NODES,
+               "Too many subscriptions for the topic filter trie");
+
+/* Lock-free ring that carries the device state updates from the MQTT
+ * subscription callback to this task, and its storage. The callback never
+ * blocks on it; when the ring is full 'SUBSCRIBER_INGEST_OVERFLOW_POLICY'
+ * decides which update is lost.
+ */
+static spsc_ring_t ingest_ring;
+static subscriber_data_t ingest_ring_storage[SUBSCRIBER_INGEST_RING_LENGTH];
+static subscriber_data_t ingest_ring_latest;
+
+/* Device commands expanded from 'MQTT_DEVICE_COMMANDS', with their lengths
+ * computed by the compiler, and their perfect hash table.
+ */
+static const command_entry_t device_commands[] =
+{
+#define DEVICE_COMMAND(message, device_state)   COMMAND_ENTRY(message, device_state),
+    MQTT_DEVICE_COMMANDS(DEVICE_COMMAND)
+#undef DEVICE_COMMAND
+};
+static command_table_t device_command_table;
+static uint8_t device_command_slots[COMMAND_TABLE_SLOT_COUNT(DEVICE_COMMAND_COUNT)];
+static uint16_t device_command_displacements[COMMAND_TABLE_BUCKET_COUNT(DEVICE_COMMAND_COUNT)];
+
+#if ENABLE_PAYLOAD_COMPRESSION
+/* Topics whose payloads may arrive compressed, expanded from
+ * 'PAYLOAD_COMPRESSION_TOPICS'.
+ */
+static const char *const compressed_topics[] =
+{
+#define COMPRESSED_TOPIC(topic)     topic,
+    PAYLOAD_COMPRESSION_TOPICS(COMPRESSED_TOPIC)
+#undef COMPRESSED_TOPIC
+};
+
+/* Payload of a received message restored from its compressed form. Only the
+ * MQTT subscription callback uses it.
+ */
+static uint8_t restored_payload[PAYLOAD_COMPRESSION_MAX_SIZE];
+#endif /* ENABLE_PAYLOAD_COMPRESSION */
+
 /******************************************************************************
-* Function Prototypes
-*******************************************************************************/
-static void subscribe_to_topic(void);
-static void unsubscribe_from_topic(void);
-void print_heap_usage(char *msg);
+ * Function Name: subscriber_init
+ ******************************************************************************
+ * Summary:
+ *  Creates the message queue of the subscriber task and sets up the ingest
+ *  ring and the subscription table. Called by the MQTT client task before
+ *  the first connection, as a broker that resumes a persistent session
+ *  delivers the queued messages right after the CONNACK, i.e. before the
+ *  subscriber task runs.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool : true on success, false if the queue could not be created.
+ *
+ ******************************************************************************/
+bool subscriber_init(void)
+{
+    /* Create a message queue to communicate with other tasks and callbacks. */
+    subscriber_task_q = STATIC_ALLOC_QUEUE_CREATE(SUBSCRIBER_TASK_QUEUE_LENGTH, sizeof(subscriber_data_t),
+                                                  subscriber_task_q_storage, &subscriber_task_q_buffer);
+    if (subscriber_task_q == NULL)
+    {
+        return false;
+    }
+
+    /* Set up the ingest path and the subscription table before messages can
+     * arrive.
+     */
+    spsc_ring_init(&ingest_ring, ingest_ring_storage, sizeof(subscriber_data_t),
+                   SUBSCRIBER_INGEST_RING_LENGTH, &ingest_ring_latest,
+                   SUBSCRIBER_INGEST_OVERFLOW_POLICY);
+    build_subscription_table();
+
+    return true;
+}
 
 /******************************************************************************
  * Function Name: subscriber_task
@@ -134,9 +266,6 @@ void subscriber_task(void *pvParameters)
     /* Subscribe to the specified MQTT topic. */
     subscribe_to_topic();
 
-    /* Create a message queue to communicate with other tasks and callbacks. */
-    subscriber_task_q = xQueueCreate(SUBSCRIBER_TASK_QUEUE_LENGTH, sizeof(subscriber_data_t));
-
     while (true)
     {
         /* Wait for commands from other tasks and callbacks. */
@@ -158,26 +287,120 @@ void subscriber_task(void *pvParameters)
 
                 case UPDATE_DEVICE_STATE:
                 {
-                    /* Update the LED state as per received notification. */
-                    cyhal_gpio_write(CYBSP_USER_LED, subscriber_q_data.data);
-
-                    /* Update the current device state extern variable. */
-                    current_device_state = subscriber_q_data.data;
+                    update_device_state(subscriber_q_data.data);
+                    break;
+                }
 
-                    print_heap_usage("subscriber_task: After updating LED state");
+                case PROCESS_RECEIVED_MESSAGES:
+                {
+                    /* The ingest ring is drained below. */
                     break;
                 }
             }
+
+            /* Apply the device state updates queued by the MQTT subscription
+             * callback. Draining after every command ensures that no update
+             * is left behind when a doorbell could not be queued.
+             */
+            while (spsc_ring_pop(&ingest_ring, &subscriber_q_data))
+            {
+                update_device_state(subscriber_q_data.data);
+            }
         }
     }
 }
 
+/******************************************************************************
+ * Function Name: update_device_state
+ ******************************************************************************
+ * Summary:
+ *  Drives the user LED to the given device state.
+ *
+ * Parameters:
+ *  uint8_t device_state : DEVICE_ON_STATE or DEVICE_OFF_STATE
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void update_device_state(uint8_t device_state)
+{
+    /* Update the LED state as per received notification. */
+    cyhal_gpio_write(CYBSP_USER_LED, device_state);
+
+    /* Update the current device state extern variable. */
+    current_device_state = device_state;
+}
+
+/******************************************************************************
+ * Function Name: subscriber_get_ingest_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the counters of the ingest ring between the MQTT subscription
+ *  callback and the subscriber task, including the updates dropped by the
+ *  overflow policy.
+ *
+ * Parameters:
+ *  spsc_ring_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void subscriber_get_ingest_stats(spsc_ring_stats_t *stats)
+{
+    spsc_ring_get_stats(&ingest_ring, stats);
+}
+
+/******************************************************************************
+ * Function Name: build_subscription_table
+ ******************************************************************************
+ * Summary:
+ *  Fills the subscription information structures, compiles the topic
+ *  filters of the subscription table into the topic filter trie, and builds
+ *  the perfect hash of the device commands.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void build_subscription_table(void)
+{
+    topic_trie_init(&subscription_trie,
+                    subscription_trie_nodes, SUBSCRIPTION_TRIE_MAX_NODES,
+                    subscription_trie_slots, SUBSCRIPTION_TRIE_SLOT_COUNT,
+                    subscription_trie_entries, SUBSCRIPTION_COUNT);
+
+    for (uint32_t i = 0; i < SUBSCRIPTION_COUNT; i++)
+    {
+        subscribe_info[i].qos = subscriptions[i].qos;
+        subscribe_info[i].topic = subscriptions[i].topic_filter;
+        subscribe_info[i].topic_len = strlen(subscriptions[i].topic_filter);
+
+        if (!topic_trie_add(&subscription_trie, subscribe_info[i].topic, subscribe_info[i].topic_len,
+                            (void *) &subscriptions[i]))
+        {
+            APP_LOG_ERR("Invalid topic filter '%s' or subscription table full!\n",
+                        subscriptions[i].topic_filter);
+        }
+    }
+
+    if (!command_table_init(&device_command_table, device_commands, DEVICE_COMMAND_COUNT,
+                            device_command_slots, device_command_displacements))
+    {
+        APP_LOG_ERR("Duplicate or too many commands in MQTT_DEVICE_COMMANDS!\n");
+    }
+}
+
 /******************************************************************************
  * Function Name: subscribe_to_topic
  ******************************************************************************
  * Summary:
- *  Function that subscribes to the MQTT topic specified by the macro 
- *  'MQTT_SUB_TOPIC'. This operation is retried a maximum of 
+ *  Function that subscribes to the MQTT topics of the subscription table.
+ *  This operation is retried a maximum of 
  *  'MAX_SUBSCRIBE_RETRIES' times with interval of 
  *  'MQTT_SUBSCRIBE_RETRY_INTERVAL_MS' milliseconds.
  *
@@ -193,17 +416,18 @@ static void subscribe_to_topic(void)
     /* Status variable */
     cy_rslt_t result = CY_RSLT_SUCCESS;
 
-    /* Command to the MQTT client task */
-    mqtt_task_cmd_t mqtt_task_cmd;
-
     /* Subscribe with the configured parameters. */
     for (uint32_t retry_count = 0; retry_count < MAX_SUBSCRIBE_RETRIES; retry_count++)
     {
-        result = cy_mqtt_subscribe(mqtt_connection, &subscribe_info, SUBSCRIPTION_COUNT);
+        result = cy_mqtt_subscribe(mqtt_connection, subscribe_info, SUBSCRIPTION_COUNT);
         if (result == CY_RSLT_SUCCESS)
         {
-            printf("\nMQTT client subscribed to the topic '%.*s' successfully.\n", 
-                    subscribe_info.topic_len, subscribe_info.topic);
+            subscriptions_active = true;
+            for (uint32_t i = 0; i < SUBSCRIPTION_COUNT; i++)
+            {
+                APP_LOG_INFO("\nMQTT client subscribed to the topic '%.*s' successfully.\n", 
+                              subscribe_info[i].topic_len, subscribe_info[i].topic);
+            }
             break;
         }
 
@@ -212,23 +436,52 @@ static void subscribe_to_topic(void)
 
     if (result != CY_RSLT_SUCCESS)
     {
-        printf("\nMQTT Subscribe failed with error 0x%0X after %d retries...\n\n", 
-               (int)result, MAX_SUBSCRIBE_RETRIES);
+        APP_LOG_ERR("\nMQTT Subscribe failed with error 0x%0X after %d retries...\n\n", 
+                    (int)result, MAX_SUBSCRIBE_RETRIES);
 
         /* Notify the MQTT client task about the subscription failure */
-        mqtt_task_cmd = HANDLE_MQTT_SUBSCRIBE_FAILURE;
-        xQueueSend(mqtt_task_q, &mqtt_task_cmd, portMAX_DELAY);
+        mqtt_task_notify(HANDLE_MQTT_SUBSCRIBE_FAILURE);
     }
 }
 
+#if ENABLE_PAYLOAD_COMPRESSION
+/******************************************************************************
+ * Function Name: is_compressed_topic
+ ******************************************************************************
+ * Summary:
+ *  Checks whether the payloads of a received topic may be compressed.
+ *
+ * Parameters:
+ *  const char *topic : MQTT topic, not NUL-terminated
+ *  size_t topic_len : Length of the topic
+ *
+ * Return:
+ *  bool : true if the topic is in 'PAYLOAD_COMPRESSION_TOPICS'
+ *
+ ******************************************************************************/
+static bool is_compressed_topic(const char *topic, size_t topic_len)
+{
+    for (size_t i = 0; i < (sizeof(compressed_topics) / sizeof(compressed_topics[0])); i++)
+    {
+        if ((strlen(compressed_topics[i]) == topic_len) &&
+            (memcmp(compressed_topics[i], topic, topic_len) == 0))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif /* ENABLE_PAYLOAD_COMPRESSION */
+
 /******************************************************************************
  * Function Name: mqtt_subscription_callback
  ******************************************************************************
  * Summary:
- *  Callback to handle incoming MQTT messages. This callback prints the 
- *  contents of the incoming message and informs the subscriber task, via a 
- *  message queue, to turn on / turn off the device based on the received 
- *  message.
+ *  Callback to handle incoming MQTT messages. This callback restores a
+ *  compressed payload on the topics of 'PAYLOAD_COMPRESSION_TOPICS', prints
+ *  the contents of the incoming message and hands it to the handler of every
+ *  subscription whose topic filter matches the topic of the message.
  *
  * Parameters:
  *  cy_mqtt_publish_info_t *received_msg_info : Information structure of the 
@@ -240,53 +493,174 @@ static void subscribe_to_topic(void)
  ******************************************************************************/
 void mqtt_subscription_callback(cy_mqtt_publish_info_t *received_msg_info)
 {
-    /* Received MQTT message */
-    const char *received_msg = received_msg_info->payload;
-    int received_msg_len = received_msg_info->payload_len;
+#if ENABLE_PAYLOAD_COMPRESSION
+    cy_mqtt_publish_info_t restored_msg_info;
+    size_t restored_len;
+
+    /* Hand the handlers the payload as it was before compression. Payloads of
+     * other topics are passed on as they are, whatever their first byte.
+     */
+    if (is_compressed_topic(received_msg_info->topic, received_msg_info->topic_len) &&
+        payload_compress_is_framed(received_msg_info->payload, received_msg_info->payload_len))
+    {
+        if (!payload_decompress(received_msg_info->payload, received_msg_info->payload_len,
+                                restored_payload, sizeof(restored_payload), &restored_len))
+        {
+            APP_LOG_WARN("  Subscriber: Dropped a compressed MQTT message that could not be restored!\n");
+            return;
+        }
 
-    /* Data to be sent to the subscriber task queue. */
-    subscriber_data_t subscriber_q_data;
+        restored_msg_info = *received_msg_info;
+        restored_msg_info.payload = (const char *) restored_payload;
+        restored_msg_info.payload_len = restored_len;
+        received_msg_info = &restored_msg_info;
+    }
+#endif /* ENABLE_PAYLOAD_COMPRESSION */
 
-    printf("  \nSubsciber: Incoming MQTT message received:\n"
-           "    Publish topic name: %.*s\n"
-           "    Publish QoS: %d\n"
-           "    Publish payload: %.*s\n",
-           received_msg_info->topic_len, received_msg_info->topic,
-           (int) received_msg_info->qos,
-           (int) received_msg_info->payload_len, (const char *)received_msg_info->payload);
+    APP_LOG_INFO("  \nSubsciber: Incoming MQTT message received:\n"
+                 "    Publish topic name: %.*s\n"
+                 "    Publish QoS: %d\n"
+                 "    Publish payload: %.*s\n",
+                 received_msg_info->topic_len, received_msg_info->topic,
+                 (int) received_msg_info->qos,
+                 (int) received_msg_info->payload_len, (const char *)received_msg_info->payload);
 
-    /* Assign the command to be sent to the subscriber task. */
-    subscriber_q_data.cmd = UPDATE_DEVICE_STATE;
+    uint32_t overflows = subscription_trie.overflows;
 
-    /* Assign the device state depending on the received MQTT message. */
-    if ((strlen(MQTT_DEVICE_ON_MESSAGE) == received_msg_len) &&
-        (strncmp(MQTT_DEVICE_ON_MESSAGE, received_msg, received_msg_len) == 0))
+    if (0u == topic_trie_match(&subscription_trie, received_msg_info->topic,
+                               received_msg_info->topic_len, dispatch_message, received_msg_info))
     {
-        subscriber_q_data.data = DEVICE_ON_STATE;
+        APP_LOG_WARN("  Subscriber: No handler for the topic of the received MQTT message!\n");
     }
-    else if ((strlen(MQTT_DEVICE_OFF_MESSAGE) == received_msg_len) &&
-             (strncmp(MQTT_DEVICE_OFF_MESSAGE, received_msg, received_msg_len) == 0))
+
+    if (overflows != subscription_trie.overflows)
     {
-        subscriber_q_data.data = DEVICE_OFF_STATE;
+        APP_LOG_WARN("  Subscriber: Topic matches too many filters, handlers skipped (%u times)!\n",
+                     (unsigned int) subscription_trie.overflows);
+    }
+}
+
+/******************************************************************************
+ * Function Name: dispatch_message
+ ******************************************************************************
+ * Summary:
+ *  Topic filter trie callback that hands a received message to the handler
+ *  of a matching subscription.
+ *
+ * Parameters:
+ *  void *user_data : Matching entry of the subscription table
+ *  void *callback_arg : Information structure of the received MQTT message
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void dispatch_message(void *user_data, void *callback_arg)
+{
+    const subscription_t *subscription = (const subscription_t *) user_data;
+
+    subscription->handler((cy_mqtt_publish_info_t *) callback_arg);
+}
+
+/******************************************************************************
+ * Function Name: handle_device_state_topic
+ ******************************************************************************
+ * Summary:
+ *  Handler of the messages received on 'MQTT_SUB_TOPIC'. Informs the
+ *  subscriber task to turn on / turn off the device based on the received
+ *  message. Batched payloads are split into their messages.
+ *
+ * Parameters:
+ *  cy_mqtt_publish_info_t *received_msg_info : Information structure of the 
+ *                                              received MQTT message
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void handle_device_state_topic(cy_mqtt_publish_info_t *received_msg_info)
+{
+    /* A batch from a publisher in the batched publish mode carries several
+     * messages; handle them in order.
+     */
+    if (publish_batch_is_framed(received_msg_info->payload, received_msg_info->payload_len))
+    {
+        size_t offset = 0;
+        const uint8_t *record;
+        size_t record_len;
+
+        while (publish_batch_next_record(received_msg_info->payload, received_msg_info->payload_len,
+                                         &offset, &record, &record_len))
+        {
+            handle_device_message((const char *) record, (int) record_len);
+        }
+    }
+    else
+    {
+        handle_device_message(received_msg_info->payload, (int) received_msg_info->payload_len);
+    }
+}
+
+/******************************************************************************
+ * Function Name: handle_device_message
+ ******************************************************************************
+ * Summary:
+ *  Informs the subscriber task, via the ingest ring, to turn on / turn off the
+ *  device based on a received message. Never blocks.
+ *
+ * Parameters:
+ *  const char *received_msg : Received message
+ *  int received_msg_len : Length of the received message
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void handle_device_message(const char *received_msg, int received_msg_len)
+{
+    /* Data to be sent to the subscriber task queue. */
+    subscriber_data_t subscriber_q_data;
+    const command_entry_t *command;
+    device_state_t message;
+
+    /* Look up the device state of the received MQTT message: one of the text
+     * commands, or else a CBOR device state message.
+     */
+    command = command_table_lookup(&device_command_table, received_msg, (size_t) received_msg_len);
+    if (command != NULL)
+    {
+        subscriber_q_data.data = command->value;
+    }
+    else if (device_state_decode(received_msg, (size_t) received_msg_len, &message, NULL) &&
+             ((message.state == DEVICE_ON_STATE) || (message.state == DEVICE_OFF_STATE)))
+    {
+        subscriber_q_data.data = (uint8_t) message.state;
     }
     else
     {
-        printf("  Subscriber: Received MQTT message not in valid format!\n");
+        APP_LOG_WARN("  Subscriber: Received MQTT message not in valid format!\n");
         return;
     }
 
-    print_heap_usage("MQTT subscription callback");
+    /* Assign the command to be sent to the subscriber task. */
+    subscriber_q_data.cmd = UPDATE_DEVICE_STATE;
+
+    /* Hand the update to the subscriber task without blocking the MQTT
+     * receive context, then ring the doorbell. If the queue is full the
+     * subscriber task has a command pending anyway and drains the ring after
+     * handling it.
+     */
+    (void) spsc_ring_push(&ingest_ring, &subscriber_q_data);
 
-    /* Send the command and data to subscriber task queue */
-    xQueueSend(subscriber_task_q, &subscriber_q_data, portMAX_DELAY);
+    subscriber_q_data.cmd = PROCESS_RECEIVED_MESSAGES;
+    (void) xQueueSend(subscriber_task_q, &subscriber_q_data, 0);
 }
 
 /******************************************************************************
  * Function Name: unsubscribe_from_topic
  ******************************************************************************
  * Summary:
- *  Function that unsubscribes from the topic specified by the macro 
- *  'MQTT_SUB_TOPIC'.
+ *  Function that unsubscribes from the topics of the subscription table.
  *
  * Parameters:
  *  void 
@@ -298,13 +672,37 @@ void mqtt_subscription_callback(cy_mqtt_publish_info_t *received_msg_info)
 static void unsubscribe_from_topic(void)
 {
     cy_rslt_t result = cy_mqtt_unsubscribe(mqtt_connection, 
-                                           (cy_mqtt_unsubscribe_info_t *) &subscribe_info, 
+                                           (cy_mqtt_unsubscribe_info_t *) subscribe_info, 
                                            SUBSCRIPTION_COUNT);
 
     if (result != CY_RSLT_SUCCESS)
     {
-        printf("MQTT Unsubscribe operation failed with error 0x%0X!\n", (int)result);
+        APP_LOG_ERR("MQTT Unsubscribe operation failed with error 0x%0X!\n", (int)result);
+    }
+    else
+    {
+        subscriptions_active = false;
     }
 }
 
+/******************************************************************************
+ * Function Name: subscriber_is_subscribed
+ ******************************************************************************
+ * Summary:
+ *  Tells whether the broker has acknowledged the subscriptions of this task
+ *  and they have not been removed since. With a persistent session the broker
+ *  keeps them across reconnections.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool : true if the subscriptions are in place, else false.
+ *
+ ******************************************************************************/
+bool subscriber_is_subscribed(void)
+{
+    return subscriptions_active;
+}
+
 /* [] END OF FILE */
@@ -46,6 +46,7 @@
 #include "task.h"
 #include "queue.h"
 #include "cy_mqtt_api.h"
+#include "spsc_ring.h"
 
 /*******************************************************************************
 * Macros
@@ -66,9 +67,21 @@ typedef enum
 {
     SUBSCRIBE_TO_TOPIC,
     UNSUBSCRIBE_FROM_TOPIC,
-    UPDATE_DEVICE_STATE
+    UPDATE_DEVICE_STATE,
+    PROCESS_RECEIVED_MESSAGES
 } subscriber_cmd_t;
 
+/* Handler of the messages received on a subscribed topic. */
+typedef void (*subscription_handler_t)(cy_mqtt_publish_info_t *received_msg_info);
+
+/* Entry of the subscription table. */
+typedef struct
+{
+    const char *topic_filter;
+    cy_mqtt_qos_t qos;
+    subscription_handler_t handler;
+} subscription_t;
+
 /* Struct to be passed via the subscriber task queue */
 typedef struct{
     subscriber_cmd_t cmd;
@@ -85,8 +98,11 @@ extern uint32_t current_device_state;
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
+bool subscriber_init(void);
 void subscriber_task(void *pvParameters);
 void mqtt_subscription_callback(cy_mqtt_publish_info_t *received_msg_info);
+void subscriber_get_ingest_stats(spsc_ring_stats_t *stats);
+bool subscriber_is_subscribed(void);
 
 #endif /* SUBSCRIBER_TASK_H_ */
 
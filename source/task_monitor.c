@@ -0,0 +1,405 @@
+/******************************************************************************
+* File Name:   task_monitor.c
+*
+* Description: This file contains the low priority task that samples the
+*              state of all the RTOS tasks and publishes their CPU usage and
+*              stack headroom on a diagnostics topic, and the run time clock
+*              of the FreeRTOS run time stats.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cyhal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+#include "task_monitor.h"
+#include "publisher_task.h"
+#include "mqtt_task.h"
+#include "static_alloc.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* Cores with a DWT unit (CM4, CM7) count the run time with the cycle counter;
+ * CM0+ and the host fall back to the RTOS tick with millisecond resolution.
+ */
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define RUN_TIME_CYCLES_PER_US          (SystemCoreClock / 1000000u)
+#endif
+
+/* Key that unlocks the DWT registers on cores with a lock access register. */
+#define DWT_LAR_UNLOCK_KEY              (0xC5ACCE55u)
+
+/* Room left in the snapshot for the entry of one more task. */
+#define SNAPSHOT_ENTRY_MAX_LEN          (configMAX_TASK_NAME_LEN + 24u)
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+/* Cycle counter value at the last read, and the cycles not yet counted as a
+ * whole microsecond. The 32-bit cycle counter wraps every few tens of seconds;
+ * extending it into microseconds at every context switch keeps the run time
+ * counters consistent for over an hour.
+ */
+static uint32_t run_time_last_cycles;
+static uint32_t run_time_cycles;
+static uint32_t run_time_us;
+#endif /* defined(DWT_CTRL_CYCCNTENA_Msk) */
+
+#if ENABLE_TASK_MONITOR
+/* Run time counter of a task at the previous snapshot. */
+typedef struct
+{
+    UBaseType_t task_number;
+    uint32_t run_time;
+} task_run_time_t;
+
+/* Task states of the current snapshot, and the run time counters of the
+ * previous one.
+ */
+static TaskStatus_t task_states[TASK_MONITOR_MAX_TASKS];
+static task_run_time_t previous_run_times[TASK_MONITOR_MAX_TASKS];
+static uint32_t previous_task_count;
+static TickType_t previous_snapshot_ticks;
+
+/* Text of the snapshot. */
+static char snapshot[TASK_MONITOR_SNAPSHOT_SIZE];
+
+static task_monitor_stats_t monitor_stats;
+
+#if ENABLE_STATIC_ALLOCATION
+/* Static storage of the task. */
+static StackType_t task_monitor_stack[STATIC_ALLOC_STACK_DEPTH(TASK_MONITOR_TASK_STACK_SIZE)];
+static StaticTask_t task_monitor_tcb;
+#endif /* ENABLE_STATIC_ALLOCATION */
+#endif /* ENABLE_TASK_MONITOR */
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if ENABLE_TASK_MONITOR
+static void task_monitor_task(void *pvParameters);
+static size_t take_snapshot(void);
+static bool publish_snapshot(size_t snapshot_len);
+static uint32_t previous_run_time(UBaseType_t task_number);
+#endif /* ENABLE_TASK_MONITOR */
+
+/******************************************************************************
+ * Function Name: task_monitor_start_run_time_clock
+ ******************************************************************************
+ * Summary:
+ *  Starts the cycle counter behind the run time clock, where available.
+ *  Called by the kernel when the scheduler starts.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void task_monitor_start_run_time_clock(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CM7_REV)
+    DWT->LAR = DWT_LAR_UNLOCK_KEY;
+#endif /* defined(__CM7_REV) */
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    run_time_last_cycles = DWT->CYCCNT;
+#endif /* defined(DWT_CTRL_CYCCNTENA_Msk) */
+}
+
+/******************************************************************************
+ * Function Name: task_monitor_run_time_clock
+ ******************************************************************************
+ * Summary:
+ *  Returns the run time clock in microseconds. Called by the kernel at every
+ *  context switch, from task and interrupt context. The cycle counter stops
+ *  while the CPU sleeps, so the clock counts the time the CPU was awake.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  uint32_t : Microseconds; wraps around after about 71 minutes.
+ *
+ ******************************************************************************/
+uint32_t task_monitor_run_time_clock(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    UBaseType_t interrupt_status = portSET_INTERRUPT_MASK_FROM_ISR();
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t now_us;
+
+    run_time_cycles += cycles - run_time_last_cycles;
+    run_time_last_cycles = cycles;
+    run_time_us += run_time_cycles / RUN_TIME_CYCLES_PER_US;
+    run_time_cycles %= RUN_TIME_CYCLES_PER_US;
+    now_us = run_time_us;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(interrupt_status);
+    return now_us;
+#else
+    return (uint32_t)(xTaskGetTickCountFromISR() * portTICK_PERIOD_MS * 1000u);
+#endif /* defined(DWT_CTRL_CYCCNTENA_Msk) */
+}
+
+/******************************************************************************
+ * Function Name: task_monitor_start
+ ******************************************************************************
+ * Summary:
+ *  Creates the task monitor if enabled.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  bool : false if the task could not be created.
+ *
+ ******************************************************************************/
+bool task_monitor_start(void)
+{
+#if ENABLE_TASK_MONITOR
+    return (pdPASS == STATIC_ALLOC_TASK_CREATE(task_monitor_task, "Task monitor",
+                                               TASK_MONITOR_TASK_STACK_SIZE, NULL,
+                                               TASK_MONITOR_TASK_PRIORITY, NULL,
+                                               task_monitor_stack, &task_monitor_tcb));
+#else
+    return true;
+#endif /* ENABLE_TASK_MONITOR */
+}
+
+/******************************************************************************
+ * Function Name: task_monitor_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the counters of the task monitor.
+ *
+ * Parameters:
+ *  task_monitor_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void task_monitor_get_stats(task_monitor_stats_t *stats)
+{
+#if ENABLE_TASK_MONITOR
+    taskENTER_CRITICAL();
+    *stats = monitor_stats;
+    taskEXIT_CRITICAL();
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif /* ENABLE_TASK_MONITOR */
+}
+
+#if ENABLE_TASK_MONITOR
+/******************************************************************************
+ * Function Name: task_monitor_task
+ ******************************************************************************
+ * Summary:
+ *  Takes a snapshot of all the tasks every 'TASK_MONITOR_PERIOD_MS'
+ *  milliseconds and publishes it on 'TASK_MONITOR_TOPIC'. Snapshots taken
+ *  while the connection is down or the publisher task is not running are
+ *  dropped.
+ *
+ * Parameters:
+ *  void *pvParameters : Task parameter defined during task creation (unused)
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void task_monitor_task(void *pvParameters)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+    size_t snapshot_len;
+
+    /* To avoid compiler warnings */
+    (void) pvParameters;
+
+    while (true)
+    {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(TASK_MONITOR_PERIOD_MS));
+
+        snapshot_len = take_snapshot();
+        if (publish_snapshot(snapshot_len))
+        {
+            taskENTER_CRITICAL();
+            monitor_stats.published++;
+            taskEXIT_CRITICAL();
+        }
+    }
+}
+
+/******************************************************************************
+ * Function Name: publish_snapshot
+ ******************************************************************************
+ * Summary:
+ *  Publishes the snapshot on the telemetry connection from this task, or
+ *  without ENABLE_TELEMETRY_CONNECTION hands it to the publisher task.
+ *
+ * Parameters:
+ *  size_t snapshot_len : Length of the snapshot
+ *
+ * Return:
+ *  bool : true if the snapshot was published or queued
+ *
+ ******************************************************************************/
+static bool publish_snapshot(size_t snapshot_len)
+{
+#if ENABLE_TELEMETRY_CONNECTION
+    cy_mqtt_publish_info_t publish_info =
+    {
+        .qos = (cy_mqtt_qos_t) MQTT_TELEMETRY_QOS,
+        .topic = TASK_MONITOR_TOPIC,
+        .topic_len = (uint16_t)(sizeof(TASK_MONITOR_TOPIC) - 1),
+        .payload = snapshot,
+        .payload_len = snapshot_len,
+        .retain = false,
+        .dup = false
+    };
+
+    return (CY_RSLT_SUCCESS == mqtt_task_publish(MQTT_CONNECTION_TELEMETRY, &publish_info));
+#else
+    return (PUBLISHER_ENQUEUE_OK == publisher_enqueue(TASK_MONITOR_TOPIC, snapshot,
+                                                      snapshot_len, 0));
+#endif /* ENABLE_TELEMETRY_CONNECTION */
+}
+
+/******************************************************************************
+ * Function Name: previous_run_time
+ ******************************************************************************
+ * Summary:
+ *  Returns the run time counter of a task at the previous snapshot, or 0 for
+ *  a task created since.
+ *
+ ******************************************************************************/
+static uint32_t previous_run_time(UBaseType_t task_number)
+{
+    for (uint32_t i = 0; i < previous_task_count; i++)
+    {
+        if (previous_run_times[i].task_number == task_number)
+        {
+            return previous_run_times[i].run_time;
+        }
+    }
+    return 0u;
+}
+
+/******************************************************************************
+ * Function Name: take_snapshot
+ ******************************************************************************
+ * Summary:
+ *  Samples the state of all the tasks and formats the snapshot:
+ *
+ *    up=<s>;<task name>,<CPU %>,<free stack bytes>;...
+ *
+ *  The CPU usage of a task is the run time it got since the previous
+ *  snapshot over the wall-clock time elapsed, with one decimal. The free
+ *  stack is the smallest headroom the task ever had.
+ *
+ * Return:
+ *  size_t : Length of the snapshot.
+ *
+ ******************************************************************************/
+static size_t take_snapshot(void)
+{
+    TickType_t now_ticks = xTaskGetTickCount();
+    uint32_t elapsed_us = (uint32_t)((now_ticks - previous_snapshot_ticks) * portTICK_PERIOD_MS * 1000u);
+    UBaseType_t task_count;
+    size_t len;
+    bool truncated;
+
+    task_count = uxTaskGetSystemState(task_states, TASK_MONITOR_MAX_TASKS, NULL);
+    truncated = (task_count == 0u) && (uxTaskGetNumberOfTasks() > TASK_MONITOR_MAX_TASKS);
+
+    len = (size_t) snprintf(snapshot, sizeof(snapshot), "up=%u",
+                            (unsigned)((now_ticks * portTICK_PERIOD_MS) / 1000u));
+
+    for (UBaseType_t i = 0; i < task_count; i++)
+    {
+        const TaskStatus_t *task = &task_states[i];
+        uint32_t run_us = task->ulRunTimeCounter - previous_run_time(task->xTaskNumber);
+        uint32_t permille = (elapsed_us == 0u) ? 0u :
+                            (uint32_t)(((uint64_t) run_us * 1000u) / elapsed_us);
+
+        if (permille > 1000u)
+        {
+            permille = 1000u;
+        }
+
+        if ((len + SNAPSHOT_ENTRY_MAX_LEN) >= sizeof(snapshot))
+        {
+            truncated = true;
+        }
+        else
+        {
+            len += (size_t) snprintf(&snapshot[len], sizeof(snapshot) - len, ";%s,%u.%u,%u",
+                                     task->pcTaskName, (unsigned)(permille / 10u),
+                                     (unsigned)(permille % 10u),
+                                     (unsigned)(task->usStackHighWaterMark * sizeof(StackType_t)));
+        }
+    }
+
+    /* Keep the counters for the next snapshot. */
+    for (UBaseType_t i = 0; i < task_count; i++)
+    {
+        previous_run_times[i].task_number = task_states[i].xTaskNumber;
+        previous_run_times[i].run_time = task_states[i].ulRunTimeCounter;
+    }
+    previous_task_count = task_count;
+    previous_snapshot_ticks = now_ticks;
+
+    taskENTER_CRITICAL();
+    monitor_stats.snapshots++;
+    monitor_stats.truncated += truncated ? 1u : 0u;
+    taskEXIT_CRITICAL();
+
+    return len;
+}
+#endif /* ENABLE_TASK_MONITOR */
+
+/* [] END OF FILE */
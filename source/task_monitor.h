@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:   task_monitor.h
+*
+* Description: This file is the public interface of task_monitor.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TASK_MONITOR_H_
+#define TASK_MONITOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Task parameters for the Task Monitor. It runs above the idle task only. */
+#define TASK_MONITOR_TASK_PRIORITY          (1)
+#define TASK_MONITOR_TASK_STACK_SIZE        (1024 * 1)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Counters of the task monitor. */
+typedef struct
+{
+    uint32_t snapshots;             /* Snapshots taken */
+    uint32_t published;             /* Snapshots published on the telemetry
+                                     * connection or handed to the publisher task */
+    uint32_t truncated;             /* Snapshots that did not list every task */
+} task_monitor_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+bool task_monitor_start(void);
+void task_monitor_get_stats(task_monitor_stats_t *stats);
+
+/* Run time clock of the FreeRTOS run time stats, in microseconds; see
+ * portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() in FreeRTOSConfig.h.
+ */
+void task_monitor_start_run_time_clock(void);
+uint32_t task_monitor_run_time_clock(void);
+
+#endif /* TASK_MONITOR_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,510 @@
+/******************************************************************************
+* File Name:   tls_session_cache.c
+*
+* Description: This file implements a TLS session cache that lets each MQTT
+*              connection resume the TLS session of its last handshake with
+*              the same broker (TLS 1.2 session ID or ticket) instead of
+*              repeating the full handshake on every reconnection, and counts
+*              the full and resumed handshakes.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "tls_session_cache.h"
+#include "log2_histogram.h"
+
+/* Configuration file for MQTT client */
+#include "mqtt_client_config.h"
+
+#if defined(TLS_SESSION_CACHE_LINKER_WRAP)
+#include "mbedtls/ssl.h"
+#endif /* TLS_SESSION_CACHE_LINKER_WRAP */
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/* The cache takes part in the handshakes only where mbedtls_ssl_handshake()
+ * is wrapped (see the Makefile) and the connections are secure.
+ */
+#if (MQTT_SECURE_CONNECTION) && (ENABLE_TLS_SESSION_CACHE) && defined(TLS_SESSION_CACHE_LINKER_WRAP)
+#define TLS_SESSION_CACHE_ACTIVE        (1)
+#else
+#define TLS_SESSION_CACHE_ACTIVE        (0)
+#endif
+
+#if TLS_SESSION_CACHE_ACTIVE
+/* Mbed TLS 3 marks the session fields private; Mbed TLS 2 does not. */
+#ifndef MBEDTLS_PRIVATE
+#define MBEDTLS_PRIVATE(member)         member
+#endif
+
+/* FNV-1a parameters used to key the cached sessions on the broker. */
+#define FNV1A_OFFSET_BASIS              (2166136261u)
+#define FNV1A_PRIME                     (16777619u)
+
+/* One session per MQTT connection, like MQTT_CONNECTION_COUNT in mqtt_task.c. */
+#define SESSION_SLOTS                   (1u + ENABLE_TELEMETRY_CONNECTION)
+
+/* Size of the TLS 1.2 master secret, which a resumed session keeps. */
+#define MASTER_SECRET_SIZE              (48u)
+#endif /* TLS_SESSION_CACHE_ACTIVE */
+
+/******************************************************************************
+* Global Variables
+*******************************************************************************/
+#if TLS_SESSION_CACHE_ACTIVE
+/* Serialized session of the last successful handshake of a connection, and
+ * the broker it belongs to.
+ */
+typedef struct
+{
+    uint8_t data[TLS_SESSION_CACHE_MAX_SIZE];
+    size_t len;
+    uint32_t broker_key;
+} cached_session_t;
+
+/* One session per MQTT connection. Only the MQTT client task, which runs the
+ * handshakes, accesses the sessions and the handshake state.
+ */
+static cached_session_t sessions[SESSION_SLOTS];
+
+/* Connection and broker of the next handshake, see tls_session_cache_select(). */
+static uint32_t handshake_slot = TLS_SESSION_CACHE_NO_SLOT;
+static uint32_t handshake_broker_key;
+
+/* Handshake in progress: its SSL context, its start, and the master secret
+ * of the offered session, which a resumed handshake keeps.
+ */
+static const mbedtls_ssl_context *handshake_ssl;
+static TickType_t handshake_start_ticks;
+static bool handshake_offered;
+static uint8_t offered_master[MASTER_SECRET_SIZE];
+#endif /* TLS_SESSION_CACHE_ACTIVE */
+
+/* Handshake counters and duration histograms. */
+static tls_session_cache_stats_t cache_stats;
+static log2_histogram_t full_durations;
+static log2_histogram_t resumed_durations;
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+#if TLS_SESSION_CACHE_ACTIVE
+static uint32_t broker_key(const char *hostname, size_t hostname_len, uint16_t port);
+static void offer_session(mbedtls_ssl_context *ssl);
+static void handshake_done(const mbedtls_ssl_context *ssl, uint32_t duration_ms);
+static void handshake_failed(void);
+static bool handshake_pending(int ret);
+#endif /* TLS_SESSION_CACHE_ACTIVE */
+
+#if defined(TLS_SESSION_CACHE_LINKER_WRAP)
+int __real_mbedtls_ssl_handshake(mbedtls_ssl_context *ssl);
+int __wrap_mbedtls_ssl_handshake(mbedtls_ssl_context *ssl);
+#endif /* TLS_SESSION_CACHE_LINKER_WRAP */
+
+/******************************************************************************
+ * Function Name: tls_session_cache_init
+ ******************************************************************************
+ * Summary:
+ *  Empties the cache and clears the handshake counters.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void tls_session_cache_init(void)
+{
+#if TLS_SESSION_CACHE_ACTIVE
+    memset(sessions, 0, sizeof(sessions));
+    handshake_slot = TLS_SESSION_CACHE_NO_SLOT;
+    handshake_ssl = NULL;
+#endif /* TLS_SESSION_CACHE_ACTIVE */
+
+    taskENTER_CRITICAL();
+    memset(&cache_stats, 0, sizeof(cache_stats));
+    log2_histogram_reset(&full_durations);
+    log2_histogram_reset(&resumed_durations);
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: tls_session_cache_select
+ ******************************************************************************
+ * Summary:
+ *  Names the connection and the broker of the next TLS handshake, i.e. of the
+ *  next cy_mqtt_connect() of the MQTT client task. The handshake is offered
+ *  the session cached for the connection if it was issued by the same
+ *  broker, and its session is cached for the connection.
+ *
+ * Parameters:
+ *  uint32_t slot : Index of the MQTT connection, or
+ *                  TLS_SESSION_CACHE_NO_SLOT to leave the handshake alone
+ *  const char *hostname : Host name of the broker
+ *  size_t hostname_len : Length of the host name
+ *  uint16_t port : Port of the broker
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void tls_session_cache_select(uint32_t slot, const char *hostname, size_t hostname_len,
+                              uint16_t port)
+{
+#if TLS_SESSION_CACHE_ACTIVE
+    handshake_slot = (slot < SESSION_SLOTS) ? slot : TLS_SESSION_CACHE_NO_SLOT;
+    handshake_broker_key = broker_key(hostname, hostname_len, port);
+#else
+    (void) slot;
+    (void) hostname;
+    (void) hostname_len;
+    (void) port;
+#endif /* TLS_SESSION_CACHE_ACTIVE */
+}
+
+/******************************************************************************
+ * Function Name: tls_session_cache_invalidate
+ ******************************************************************************
+ * Summary:
+ *  Drops the session cached for a connection, so that its next handshake is
+ *  a full handshake. The session data is wiped as it holds key material.
+ *
+ * Parameters:
+ *  uint32_t slot : Index of the MQTT connection
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void tls_session_cache_invalidate(uint32_t slot)
+{
+#if TLS_SESSION_CACHE_ACTIVE
+    if (slot < SESSION_SLOTS)
+    {
+        memset(&sessions[slot], 0, sizeof(sessions[slot]));
+    }
+#else
+    (void) slot;
+#endif /* TLS_SESSION_CACHE_ACTIVE */
+}
+
+/******************************************************************************
+ * Function Name: tls_session_cache_get_stats
+ ******************************************************************************
+ * Summary:
+ *  Returns the handshake counters and the mean and maximum durations of the
+ *  full and the resumed handshakes.
+ *
+ * Parameters:
+ *  tls_session_cache_stats_t *stats : Pointer to store the counters
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void tls_session_cache_get_stats(tls_session_cache_stats_t *stats)
+{
+    log2_histogram_t full_snapshot;
+    log2_histogram_t resumed_snapshot;
+
+    taskENTER_CRITICAL();
+    *stats = cache_stats;
+    full_snapshot = full_durations;
+    resumed_snapshot = resumed_durations;
+    taskEXIT_CRITICAL();
+
+    stats->full_mean_ms = log2_histogram_mean(&full_snapshot);
+    stats->full_max_ms = full_snapshot.max;
+    stats->resumed_mean_ms = log2_histogram_mean(&resumed_snapshot);
+    stats->resumed_max_ms = resumed_snapshot.max;
+}
+
+#if TLS_SESSION_CACHE_ACTIVE
+/******************************************************************************
+ * Function Name: broker_key
+ ******************************************************************************
+ * Summary:
+ *  Hashes the broker host name and port, so that a session is only offered
+ *  to the broker that issued it.
+ *
+ ******************************************************************************/
+static uint32_t broker_key(const char *hostname, size_t hostname_len, uint16_t port)
+{
+    uint32_t hash = FNV1A_OFFSET_BASIS;
+
+    for (size_t i = 0; (hostname != NULL) && (i < hostname_len); i++)
+    {
+        hash = (hash ^ (uint8_t) hostname[i]) * FNV1A_PRIME;
+    }
+    hash = (hash ^ (uint8_t)(port >> 8)) * FNV1A_PRIME;
+    hash = (hash ^ (uint8_t) port) * FNV1A_PRIME;
+    return hash;
+}
+
+/******************************************************************************
+ * Function Name: offer_session
+ ******************************************************************************
+ * Summary:
+ *  Offers the session cached for the connection of the handshake, if it was
+ *  issued by the same broker. Called before the handshake starts. A session
+ *  that can no longer be loaded is dropped and the handshake proceeds as a
+ *  full handshake.
+ *
+ * Parameters:
+ *  mbedtls_ssl_context *ssl : SSL context of the handshake
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void offer_session(mbedtls_ssl_context *ssl)
+{
+    cached_session_t *cached = &sessions[handshake_slot];
+    mbedtls_ssl_session session;
+
+    handshake_offered = false;
+    if ((cached->len == 0u) || (cached->broker_key != handshake_broker_key))
+    {
+        return;
+    }
+
+    mbedtls_ssl_session_init(&session);
+    if ((0 == mbedtls_ssl_session_load(&session, cached->data, cached->len)) &&
+        (0 == mbedtls_ssl_set_session(ssl, &session)))
+    {
+        memcpy(offered_master, session.MBEDTLS_PRIVATE(master), sizeof(offered_master));
+        handshake_offered = true;
+    }
+    mbedtls_ssl_session_free(&session);
+
+    if (!handshake_offered)
+    {
+        tls_session_cache_invalidate(handshake_slot);
+    }
+}
+
+/******************************************************************************
+ * Function Name: handshake_done
+ ******************************************************************************
+ * Summary:
+ *  Records a successful handshake and caches its session for the next
+ *  handshake of the connection. A resumed session keeps the master secret of
+ *  the offered one, whether it was resumed by session ID or by ticket; a full
+ *  handshake derives a new one.
+ *
+ * Parameters:
+ *  const mbedtls_ssl_context *ssl : SSL context of the handshake
+ *  uint32_t duration_ms : Duration of the handshake in milliseconds
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void handshake_done(const mbedtls_ssl_context *ssl, uint32_t duration_ms)
+{
+    cached_session_t *cached = &sessions[handshake_slot];
+    mbedtls_ssl_session session;
+    size_t saved_len = 0u;
+    bool resumed = false;
+    bool oversize = false;
+
+    mbedtls_ssl_session_init(&session);
+    if (0 == mbedtls_ssl_get_session(ssl, &session))
+    {
+        resumed = handshake_offered &&
+                  (0 == memcmp(session.MBEDTLS_PRIVATE(master), offered_master,
+                               sizeof(offered_master)));
+
+        if (0 == mbedtls_ssl_session_save(&session, cached->data, sizeof(cached->data),
+                                          &saved_len))
+        {
+            cached->len = saved_len;
+            cached->broker_key = handshake_broker_key;
+        }
+        else
+        {
+            /* Keep no partial session around. */
+            oversize = (saved_len > sizeof(cached->data));
+            tls_session_cache_invalidate(handshake_slot);
+        }
+    }
+    else
+    {
+        tls_session_cache_invalidate(handshake_slot);
+    }
+    mbedtls_ssl_session_free(&session);
+
+    taskENTER_CRITICAL();
+    if (oversize)
+    {
+        cache_stats.oversize_sessions++;
+    }
+    if (resumed)
+    {
+        cache_stats.resumed_handshakes++;
+        log2_histogram_add(&resumed_durations, duration_ms);
+    }
+    else
+    {
+        cache_stats.full_handshakes++;
+        log2_histogram_add(&full_durations, duration_ms);
+        if (handshake_offered)
+        {
+            cache_stats.refused_resumptions++;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: handshake_failed
+ ******************************************************************************
+ * Summary:
+ *  Records a failed handshake. If it offered the cached session, the session
+ *  is dropped, so that the next attempt falls back to a full handshake.
+ *
+ * Parameters:
+ *  void
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+static void handshake_failed(void)
+{
+    if (handshake_offered)
+    {
+        tls_session_cache_invalidate(handshake_slot);
+    }
+
+    taskENTER_CRITICAL();
+    cache_stats.failed_handshakes++;
+    taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ * Function Name: handshake_pending
+ ******************************************************************************
+ * Summary:
+ *  Tells whether mbedtls_ssl_handshake() returned before the end of the
+ *  handshake and is to be called again.
+ *
+ ******************************************************************************/
+static bool handshake_pending(int ret)
+{
+    return (ret == MBEDTLS_ERR_SSL_WANT_READ) ||
+#if defined(MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS)
+           (ret == MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS) ||
+#endif
+#if defined(MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS)
+           (ret == MBEDTLS_ERR_SSL_CRYPTO_IN_PROGRESS) ||
+#endif
+           (ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+}
+#endif /* TLS_SESSION_CACHE_ACTIVE */
+
+#if defined(TLS_SESSION_CACHE_LINKER_WRAP)
+/******************************************************************************
+ * Function Name: __wrap_mbedtls_ssl_handshake
+ ******************************************************************************
+ * Summary:
+ *  Takes the place of mbedtls_ssl_handshake() in the image (see the
+ *  Makefile), so that the handshake run by cy_tls_connect() of the
+ *  secure-sockets library for the MQTT library offers the cached session and
+ *  caches the new one. Handshakes that were not selected with
+ *  tls_session_cache_select() are passed through.
+ *
+ * Parameters:
+ *  mbedtls_ssl_context *ssl : SSL context of the handshake
+ *
+ * Return:
+ *  int : result of mbedtls_ssl_handshake()
+ *
+ ******************************************************************************/
+int __wrap_mbedtls_ssl_handshake(mbedtls_ssl_context *ssl)
+{
+#if TLS_SESSION_CACHE_ACTIVE
+    int ret;
+
+    if (handshake_slot == TLS_SESSION_CACHE_NO_SLOT)
+    {
+        return __real_mbedtls_ssl_handshake(ssl);
+    }
+
+    /* The session is set before the first step of the handshake. */
+    if (ssl != handshake_ssl)
+    {
+        handshake_ssl = ssl;
+        handshake_start_ticks = xTaskGetTickCount();
+        offer_session(ssl);
+    }
+
+    ret = __real_mbedtls_ssl_handshake(ssl);
+    if (handshake_pending(ret))
+    {
+        return ret;
+    }
+
+    if (ret == 0)
+    {
+        handshake_done(ssl, (uint32_t)((xTaskGetTickCount() - handshake_start_ticks) *
+                                       portTICK_PERIOD_MS));
+    }
+    else
+    {
+        handshake_failed();
+    }
+
+    memset(offered_master, 0, sizeof(offered_master));
+    handshake_offered = false;
+    handshake_ssl = NULL;
+    handshake_slot = TLS_SESSION_CACHE_NO_SLOT;
+    return ret;
+#else
+    return __real_mbedtls_ssl_handshake(ssl);
+#endif /* TLS_SESSION_CACHE_ACTIVE */
+}
+#endif /* TLS_SESSION_CACHE_LINKER_WRAP */
+
+/* [] END OF FILE */
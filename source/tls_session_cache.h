@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name:   tls_session_cache.h
+*
+* Description: This file is the public interface of tls_session_cache.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef TLS_SESSION_CACHE_H_
+#define TLS_SESSION_CACHE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Slot value that leaves the next handshake alone. */
+#define TLS_SESSION_CACHE_NO_SLOT       (UINT32_MAX)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Handshake counters and durations in milliseconds. A refused resumption is
+ * a handshake for which a cached session was offered but the broker chose a
+ * full handshake; it is also counted as a full handshake.
+ */
+typedef struct
+{
+    uint32_t full_handshakes;
+    uint32_t resumed_handshakes;
+    uint32_t refused_resumptions;
+    uint32_t failed_handshakes;
+    uint32_t oversize_sessions;         /* Sessions too large to be cached */
+    uint32_t full_mean_ms;
+    uint32_t full_max_ms;
+    uint32_t resumed_mean_ms;
+    uint32_t resumed_max_ms;
+} tls_session_cache_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void tls_session_cache_init(void);
+void tls_session_cache_select(uint32_t slot, const char *hostname, size_t hostname_len,
+                              uint16_t port);
+void tls_session_cache_invalidate(uint32_t slot);
+void tls_session_cache_get_stats(tls_session_cache_stats_t *stats);
+
+#endif /* TLS_SESSION_CACHE_H_ */
+
+/* [] END OF FILE */
@@ -0,0 +1,600 @@
+/******************************************************************************
+* File Name:   topic_trie.c
+*
+* Description: This file contains the topic filter trie. Topic filters,
+*              including the MQTT '+' and '#' wildcards, are compiled into a
+*              trie of topic levels so that an incoming topic is matched
+*              against all the filters in a single pass over the topic. The
+*              trie uses user provided storage only.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "topic_trie.h"
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+#define TOPIC_LEVEL_SEPARATOR           '/'
+#define TOPIC_WILDCARD_SINGLE           '+'
+#define TOPIC_WILDCARD_MULTI            '#'
+
+/* Root node; it stands for the empty prefix before the first level. */
+#define TOPIC_TRIE_ROOT                 (0u)
+
+/* FNV-1a parameters used to hash the level text. */
+#define FNV_OFFSET_BASIS                (2166136261u)
+#define FNV_PRIME                       (16777619u)
+
+/* Multiplier that spreads the parent index over the hash. */
+#define PARENT_HASH_MULTIPLIER          (0x9E3779B1u)
+
+/******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t level_hash(const char *level, size_t level_len);
+static uint32_t slot_index(const topic_trie_t *trie, uint16_t parent, uint32_t hash);
+static uint16_t find_child(const topic_trie_t *trie, uint16_t parent, const char *level,
+                           size_t level_len, uint32_t hash);
+static uint16_t new_node(topic_trie_t *trie, uint16_t parent, const char *level,
+                         size_t level_len, uint32_t hash);
+static uint32_t report_entries(const topic_trie_t *trie, uint16_t node,
+                               topic_trie_match_callback_t callback, void *callback_arg);
+
+/******************************************************************************
+ * Function Name: level_hash
+ ******************************************************************************
+ * Summary:
+ *  Returns the FNV-1a hash of a topic level.
+ *
+ ******************************************************************************/
+static uint32_t level_hash(const char *level, size_t level_len)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    for (size_t i = 0; i < level_len; i++)
+    {
+        hash = (hash ^ (uint8_t) level[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/******************************************************************************
+ * Function Name: slot_index
+ ******************************************************************************
+ * Summary:
+ *  Returns the first hash table slot probed for a child of 'parent'.
+ *
+ ******************************************************************************/
+static uint32_t slot_index(const topic_trie_t *trie, uint16_t parent, uint32_t hash)
+{
+    return (hash ^ ((uint32_t) parent * PARENT_HASH_MULTIPLIER)) & (trie->slot_count - 1u);
+}
+
+/******************************************************************************
+ * Function Name: find_child
+ ******************************************************************************
+ * Summary:
+ *  Looks up the child of 'parent' for a literal topic level.
+ *
+ * Return:
+ *  uint16_t : Index of the child, or TOPIC_TRIE_NONE if there is none
+ *
+ ******************************************************************************/
+static uint16_t find_child(const topic_trie_t *trie, uint16_t parent, const char *level,
+                           size_t level_len, uint32_t hash)
+{
+    uint32_t slot = slot_index(trie, parent, hash);
+
+    /* Linear probing; the table always has an empty slot as it is larger
+     * than the number of nodes.
+     */
+    while (trie->slots[slot] != TOPIC_TRIE_NONE)
+    {
+        const topic_trie_node_t *node = &trie->nodes[trie->slots[slot]];
+
+        if ((node->parent == parent) && (node->level_hash == hash) &&
+            (node->level_len == level_len) && (memcmp(node->level, level, level_len) == 0))
+        {
+            return trie->slots[slot];
+        }
+
+        slot = (slot + 1u) & (trie->slot_count - 1u);
+    }
+
+    return TOPIC_TRIE_NONE;
+}
+
+/******************************************************************************
+ * Function Name: new_node
+ ******************************************************************************
+ * Summary:
+ *  Allocates a node. Literal levels are also entered into the hash table;
+ *  wildcard levels are linked from the parent by the caller.
+ *
+ * Return:
+ *  uint16_t : Index of the node, or TOPIC_TRIE_NONE if the storage is full
+ *
+ ******************************************************************************/
+static uint16_t new_node(topic_trie_t *trie, uint16_t parent, const char *level,
+                         size_t level_len, uint32_t hash)
+{
+    uint16_t index;
+    topic_trie_node_t *node;
+
+    if ((trie->node_count >= trie->max_nodes) || (trie->node_count >= TOPIC_TRIE_NONE))
+    {
+        return TOPIC_TRIE_NONE;
+    }
+
+    index = (uint16_t) trie->node_count++;
+    node = &trie->nodes[index];
+    node->level = level;
+    node->level_len = (uint16_t) level_len;
+    node->level_hash = hash;
+    node->parent = parent;
+    node->plus_child = TOPIC_TRIE_NONE;
+    node->hash_child = TOPIC_TRIE_NONE;
+    node->first_entry = TOPIC_TRIE_NONE;
+
+    if ((parent != TOPIC_TRIE_NONE) &&
+        !((level_len == 1u) && ((level[0] == TOPIC_WILDCARD_SINGLE) || (level[0] == TOPIC_WILDCARD_MULTI))))
+    {
+        uint32_t slot = slot_index(trie, parent, hash);
+
+        while (trie->slots[slot] != TOPIC_TRIE_NONE)
+        {
+            slot = (slot + 1u) & (trie->slot_count - 1u);
+        }
+        trie->slots[slot] = index;
+    }
+
+    return index;
+}
+
+/******************************************************************************
+ * Function Name: topic_trie_init
+ ******************************************************************************
+ * Summary:
+ *  Initializes an empty trie on the given storage.
+ *
+ * Parameters:
+ *  topic_trie_t *trie : Trie to initialize
+ *  topic_trie_node_t *nodes : Node storage; one node per distinct filter level
+ *                             plus the root
+ *  uint32_t max_nodes : Number of entries in 'nodes'
+ *  uint16_t *slots : Hash table storage
+ *  uint32_t slot_count : Number of entries in 'slots'; a power of two larger
+ *                        than 'max_nodes'
+ *  topic_trie_entry_t *entries : Registration storage
+ *  uint32_t max_entries : Number of entries in 'entries'
+ *
+ * Return:
+ *  void
+ *
+ ******************************************************************************/
+void topic_trie_init(topic_trie_t *trie, topic_trie_node_t *nodes, uint32_t max_nodes,
+                     uint16_t *slots, uint32_t slot_count,
+                     topic_trie_entry_t *entries, uint32_t max_entries)
+{
+    trie->nodes = nodes;
+    trie->max_nodes = max_nodes;
+    trie->slots = slots;
+    trie->slot_count = slot_count;
+    trie->entries = entries;
+    trie->max_entries = max_entries;
+    trie->node_count = 0;
+    trie->entry_count = 0;
+    trie->overflows = 0;
+
+    for (uint32_t i = 0; i < slot_count; i++)
+    {
+        slots[i] = TOPIC_TRIE_NONE;
+    }
+
+    (void) new_node(trie, TOPIC_TRIE_NONE, NULL, 0, 0);
+}
+
+/******************************************************************************
+ * Function Name: topic_filter_is_valid
+ ******************************************************************************
+ * Summary:
+ *  Checks a topic filter against the MQTT rules: it is not empty, and the
+ *  wildcards occupy a whole level, with '#' only as the last level.
+ *
+ * Parameters:
+ *  const char *filter : Topic filter
+ *  size_t filter_len : Length of the filter
+ *
+ * Return:
+ *  bool : true if the filter is valid
+ *
+ ******************************************************************************/
+bool topic_filter_is_valid(const char *filter, size_t filter_len)
+{
+    if (filter_len == 0u)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < filter_len; i++)
+    {
+        bool level_start = (i == 0u) || (filter[i - 1u] == TOPIC_LEVEL_SEPARATOR);
+        bool level_end = ((i + 1u) == filter_len) || (filter[i + 1u] == TOPIC_LEVEL_SEPARATOR);
+
+        if ((filter[i] == TOPIC_WILDCARD_SINGLE) && !(level_start && level_end))
+        {
+            return false;
+        }
+
+        if ((filter[i] == TOPIC_WILDCARD_MULTI) && !(level_start && ((i + 1u) == filter_len)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: topic_trie_add
+ ******************************************************************************
+ * Summary:
+ *  Adds a topic filter to the trie. The filter text is referenced, not
+ *  copied, and must remain valid for the lifetime of the trie. Filters
+ *  registered more than once report every registration, in order.
+ *
+ * Parameters:
+ *  topic_trie_t *trie : Trie to add to
+ *  const char *filter : Topic filter, e.g. "home/+/temperature" or "home/#"
+ *  size_t filter_len : Length of the filter
+ *  void *user_data : Value passed to the match callback
+ *
+ * Return:
+ *  bool : true if the filter was added; false if it is invalid or the
+ *         storage is full.
+ *
+ ******************************************************************************/
+bool topic_trie_add(topic_trie_t *trie, const char *filter, size_t filter_len, void *user_data)
+{
+    uint16_t node = TOPIC_TRIE_ROOT;
+    size_t position = 0;
+    topic_trie_entry_t *entry;
+
+    if (!topic_filter_is_valid(filter, filter_len) || (trie->entry_count >= trie->max_entries))
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        const char *level = &filter[position];
+        const char *separator = memchr(level, TOPIC_LEVEL_SEPARATOR, filter_len - position);
+        size_t level_len = (separator != NULL) ? (size_t)(separator - level) : (filter_len - position);
+        uint32_t hash = level_hash(level, level_len);
+        uint16_t child;
+
+        if ((level_len == 1u) && (level[0] == TOPIC_WILDCARD_SINGLE))
+        {
+            child = trie->nodes[node].plus_child;
+            if (child == TOPIC_TRIE_NONE)
+            {
+                child = new_node(trie, node, level, level_len, hash);
+                trie->nodes[node].plus_child = child;
+            }
+        }
+        else if ((level_len == 1u) && (level[0] == TOPIC_WILDCARD_MULTI))
+        {
+            child = trie->nodes[node].hash_child;
+            if (child == TOPIC_TRIE_NONE)
+            {
+                child = new_node(trie, node, level, level_len, hash);
+                trie->nodes[node].hash_child = child;
+            }
+        }
+        else
+        {
+            child = find_child(trie, node, level, level_len, hash);
+            if (child == TOPIC_TRIE_NONE)
+            {
+                child = new_node(trie, node, level, level_len, hash);
+            }
+        }
+
+        if (child == TOPIC_TRIE_NONE)
+        {
+            return false;
+        }
+
+        node = child;
+
+        if (separator == NULL)
+        {
+            break;
+        }
+        position += level_len + 1u;
+    }
+
+    /* Append the registration to those of the same filter. */
+    entry = &trie->entries[trie->entry_count];
+    entry->user_data = user_data;
+    entry->next = TOPIC_TRIE_NONE;
+
+    if (trie->nodes[node].first_entry == TOPIC_TRIE_NONE)
+    {
+        trie->nodes[node].first_entry = (uint16_t) trie->entry_count;
+    }
+    else
+    {
+        uint16_t last = trie->nodes[node].first_entry;
+
+        while (trie->entries[last].next != TOPIC_TRIE_NONE)
+        {
+            last = trie->entries[last].next;
+        }
+        trie->entries[last].next = (uint16_t) trie->entry_count;
+    }
+
+    trie->entry_count++;
+
+    return true;
+}
+
+/******************************************************************************
+ * Function Name: report_entries
+ ******************************************************************************
+ * Summary:
+ *  Invokes the callback for every registration of the filter ending at
+ *  'node'.
+ *
+ * Return:
+ *  uint32_t : Number of registrations reported
+ *
+ ******************************************************************************/
+static uint32_t report_entries(const topic_trie_t *trie, uint16_t node,
+                               topic_trie_match_callback_t callback, void *callback_arg)
+{
+    uint32_t reported = 0;
+
+    for (uint16_t entry = trie->nodes[node].first_entry; entry != TOPIC_TRIE_NONE;
+         entry = trie->entries[entry].next)
+    {
+        if (callback != NULL)
+        {
+            callback(trie->entries[entry].user_data, callback_arg);
+        }
+        reported++;
+    }
+
+    return reported;
+}
+
+/******************************************************************************
+ * Function Name: topic_trie_match
+ ******************************************************************************
+ * Summary:
+ *  Matches a topic against all the filters of the trie in one pass over the
+ *  topic levels. At each level the literal child and the '+' child of every
+ *  active node are followed, and '#' children report their registrations.
+ *  As required by MQTT, wildcards at the first level do not match topics
+ *  starting with '$'. If more than TOPIC_TRIE_MAX_ACTIVE_NODES nodes are
+ *  active at one level, the extra ones are not followed and 'overflows' of
+ *  the trie is incremented, so that some matching filters may not be
+ *  reported.
+ *
+ * Parameters:
+ *  topic_trie_t *trie : Trie to match against
+ *  const char *topic : Topic name of the received message
+ *  size_t topic_len : Length of the topic
+ *  topic_trie_match_callback_t callback : Called for every matching
+ *                                         registration; may be NULL
+ *  void *callback_arg : Passed to the callback
+ *
+ * Return:
+ *  uint32_t : Number of matching registrations
+ *
+ ******************************************************************************/
+uint32_t topic_trie_match(topic_trie_t *trie, const char *topic, size_t topic_len,
+                          topic_trie_match_callback_t callback, void *callback_arg)
+{
+    uint16_t active[2][TOPIC_TRIE_MAX_ACTIVE_NODES];
+    uint32_t active_count = 1;
+    uint32_t current = 0;
+    uint32_t matches = 0;
+    bool overflow = false;
+    size_t position = 0;
+    bool wildcards_allowed = (topic_len > 0u) && (topic[0] != '$');
+
+    if (topic_len == 0u)
+    {
+        return 0;
+    }
+
+    active[current][0] = TOPIC_TRIE_ROOT;
+
+    while (true)
+    {
+        const char *level = &topic[position];
+        uint32_t hash = FNV_OFFSET_BASIS;
+        size_t level_len = 0;
+        uint32_t next_count = 0;
+
+        /* Hash the level while looking for its end. */
+        while (((position + level_len) < topic_len) && (level[level_len] != TOPIC_LEVEL_SEPARATOR))
+        {
+            hash = (hash ^ (uint8_t) level[level_len]) * FNV_PRIME;
+            level_len++;
+        }
+
+        for (uint32_t i = 0; i < active_count; i++)
+        {
+            const topic_trie_node_t *node = &trie->nodes[active[current][i]];
+            uint16_t child;
+
+            if (wildcards_allowed && (node->hash_child != TOPIC_TRIE_NONE))
+            {
+                /* '#' matches this and all the remaining levels. */
+                matches += report_entries(trie, node->hash_child, callback, callback_arg);
+            }
+
+            child = find_child(trie, active[current][i], level, level_len, hash);
+            if (child != TOPIC_TRIE_NONE)
+            {
+                if (next_count < TOPIC_TRIE_MAX_ACTIVE_NODES)
+                {
+                    active[current ^ 1u][next_count++] = child;
+                }
+                else
+                {
+                    overflow = true;
+                }
+            }
+
+            if (wildcards_allowed && (node->plus_child != TOPIC_TRIE_NONE))
+            {
+                if (next_count < TOPIC_TRIE_MAX_ACTIVE_NODES)
+                {
+                    active[current ^ 1u][next_count++] = node->plus_child;
+                }
+                else
+                {
+                    overflow = true;
+                }
+            }
+        }
+
+        current ^= 1u;
+        active_count = next_count;
+        wildcards_allowed = true;
+
+        if ((active_count == 0u) || ((position + level_len) >= topic_len))
+        {
+            break;
+        }
+        position += level_len + 1u;
+    }
+
+    /* Filters ending at the last level, and "x/#" filters matching "x". */
+    for (uint32_t i = 0; i < active_count; i++)
+    {
+        const topic_trie_node_t *node = &trie->nodes[active[current][i]];
+
+        matches += report_entries(trie, active[current][i], callback, callback_arg);
+        if (node->hash_child != TOPIC_TRIE_NONE)
+        {
+            matches += report_entries(trie, node->hash_child, callback, callback_arg);
+        }
+    }
+
+    if (overflow)
+    {
+        trie->overflows++;
+    }
+
+    return matches;
+}
+
+/******************************************************************************
+ * Function Name: topic_filter_matches
+ ******************************************************************************
+ * Summary:
+ *  Matches a topic against a single filter by comparing level by level.
+ *  This is the linear reference for topic_trie_match().
+ *
+ * Parameters:
+ *  const char *filter : Topic filter
+ *  size_t filter_len : Length of the filter
+ *  const char *topic : Topic name
+ *  size_t topic_len : Length of the topic
+ *
+ * Return:
+ *  bool : true if the topic matches the filter
+ *
+ ******************************************************************************/
+bool topic_filter_matches(const char *filter, size_t filter_len,
+                          const char *topic, size_t topic_len)
+{
+    size_t f = 0;
+    size_t t = 0;
+
+    if ((topic_len == 0u) || (filter_len == 0u))
+    {
+        return false;
+    }
+
+    if ((topic[0] == '$') &&
+        ((filter[0] == TOPIC_WILDCARD_SINGLE) || (filter[0] == TOPIC_WILDCARD_MULTI)))
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        const char *filter_level = &filter[f];
+        const char *topic_level = &topic[t];
+        const char *filter_end = memchr(filter_level, TOPIC_LEVEL_SEPARATOR, filter_len - f);
+        const char *topic_end = memchr(topic_level, TOPIC_LEVEL_SEPARATOR, topic_len - t);
+        size_t filter_level_len = (filter_end != NULL) ? (size_t)(filter_end - filter_level) : (filter_len - f);
+        size_t topic_level_len = (topic_end != NULL) ? (size_t)(topic_end - topic_level) : (topic_len - t);
+
+        if ((filter_level_len == 1u) && (filter_level[0] == TOPIC_WILDCARD_MULTI))
+        {
+            return true;
+        }
+
+        if (!((filter_level_len == 1u) && (filter_level[0] == TOPIC_WILDCARD_SINGLE)) &&
+            ((filter_level_len != topic_level_len) ||
+             (strncmp(filter_level, topic_level, topic_level_len) != 0)))
+        {
+            return false;
+        }
+
+        if ((filter_end == NULL) || (topic_end == NULL))
+        {
+            /* "x/#" also matches "x". */
+            return (filter_end == NULL) ? (topic_end == NULL) :
+                   (((filter_len - f - filter_level_len) == 2u) &&
+                    (filter_end[1] == TOPIC_WILDCARD_MULTI));
+        }
+
+        f += filter_level_len + 1u;
+        t += topic_level_len + 1u;
+    }
+}
+
+/* [] END OF FILE */
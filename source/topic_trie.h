@@ -0,0 +1,134 @@
+/******************************************************************************
+* File Name:   topic_trie.h
+*
+* Description: This file is the public interface of topic_trie.c
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2026, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TOPIC_TRIE_H_
+#define TOPIC_TRIE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Value of a node or registration link that points nowhere. */
+#define TOPIC_TRIE_NONE                    (0xFFFFu)
+
+/* Maximum number of trie nodes that can be active at once while matching,
+ * i.e. the number of distinct filters that can be partially matched by a
+ * topic at the same level. Each '+' level at most doubles the active set.
+ * The filters of the nodes beyond it are not matched; see 'overflows'.
+ */
+#ifndef TOPIC_TRIE_MAX_ACTIVE_NODES
+#define TOPIC_TRIE_MAX_ACTIVE_NODES        (16u)
+#endif
+
+/* Number of hash table slots for 'n' nodes: the next power of two larger
+ * than 'n', or 0 if 'n' is too large for the 16-bit node indexes. Use it to
+ * size the 'slots' array passed to topic_trie_init().
+ */
+#define TOPIC_TRIE_SLOT_COUNT(n)                                               \
+    (((n) < 16u) ? 16u : ((n) < 32u) ? 32u : ((n) < 64u) ? 64u :               \
+     ((n) < 128u) ? 128u : ((n) < 256u) ? 256u : ((n) < 512u) ? 512u :         \
+     ((n) < 1024u) ? 1024u : ((n) < 2048u) ? 2048u : ((n) < 4096u) ? 4096u :   \
+     ((n) < 8192u) ? 8192u : ((n) < 16384u) ? 16384u :                         \
+     ((n) < 32768u) ? 32768u : ((n) < TOPIC_TRIE_NONE) ? 65536u : 0u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* One topic level of a filter. Nodes are found from their parent through a
+ * hash table keyed on the parent index and the level text; the '+' and '#'
+ * children are linked from the parent directly.
+ */
+typedef struct
+{
+    const char *level;          /* Level text inside the registered filter */
+    uint32_t level_hash;
+    uint16_t level_len;
+    uint16_t parent;
+    uint16_t plus_child;        /* Child for the '+' level */
+    uint16_t hash_child;        /* Child for the '#' level */
+    uint16_t first_entry;       /* Registrations of filters ending at this node */
+} topic_trie_node_t;
+
+/* One registered filter. */
+typedef struct
+{
+    void *user_data;
+    uint16_t next;              /* Next registration of the same filter */
+} topic_trie_entry_t;
+
+/* Trie and its storage. The storage is provided by the user; 'slots' must
+ * have a power-of-two size larger than 'max_nodes'.
+ */
+typedef struct
+{
+    topic_trie_node_t *nodes;
+    uint16_t *slots;
+    topic_trie_entry_t *entries;
+    uint32_t max_nodes;
+    uint32_t slot_count;
+    uint32_t max_entries;
+    uint32_t node_count;
+    uint32_t entry_count;
+    uint32_t overflows;         /* Matches that exceeded TOPIC_TRIE_MAX_ACTIVE_NODES */
+} topic_trie_t;
+
+/* Called for every registration whose filter matches a topic. */
+typedef void (*topic_trie_match_callback_t)(void *user_data, void *callback_arg);
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void topic_trie_init(topic_trie_t *trie, topic_trie_node_t *nodes, uint32_t max_nodes,
+                     uint16_t *slots, uint32_t slot_count,
+                     topic_trie_entry_t *entries, uint32_t max_entries);
+bool topic_trie_add(topic_trie_t *trie, const char *filter, size_t filter_len, void *user_data);
+uint32_t topic_trie_match(topic_trie_t *trie, const char *topic, size_t topic_len,
+                          topic_trie_match_callback_t callback, void *callback_arg);
+bool topic_filter_is_valid(const char *filter, size_t filter_len);
+bool topic_filter_matches(const char *filter, size_t filter_len,
+                          const char *topic, size_t topic_len);
+
+#endif /* TOPIC_TRIE_H_ */
+
+/* [] END OF FILE */